@@ -0,0 +1,41 @@
+#!/usr/bin/env bash
+
+# Run the benchmarks and save the results as benchmark-results/<commit>.json.
+# With a baseline, e.g. ./bench.sh benchmark-results/<other commit>.json,
+# the new results are compared against it.
+#
+# Extra benchmark flags can be passed with BENCHMARK_FLAGS, e.g.
+#   BENCHMARK_FLAGS=--benchmark_filter=BM_ParseCatalog ./bench.sh
+
+set -o errexit
+
+build_dir=build-cmake-release
+results_dir=benchmark-results
+baseline=${1:-}
+
+mkdir -p ${build_dir} ${results_dir}
+cmake -S . -B ${build_dir} \
+    -DCMAKE_BUILD_TYPE=Release \
+    -DCMAKE_EXPORT_COMPILE_COMMANDS=OFF \
+    -DEOB_ENABLE_CLANG_TIDY=OFF \
+    -DEOB_COMPILE_WARNINGS_AS_ERRORS=OFF \
+    -DBENCHMARK_ENABLE_LTO=true
+cmake --build ${build_dir} -j 6
+
+commit=$(git rev-parse --short HEAD)
+if ! git diff --quiet; then
+    commit=${commit}-dirty
+fi
+results=${results_dir}/${commit}.json
+
+./${build_dir}/tests/benchmarksearthorbit \
+    --benchmark_repetitions=5 \
+    --benchmark_report_aggregates_only=true \
+    --benchmark_out=${results} \
+    --benchmark_out_format=json \
+    ${BENCHMARK_FLAGS}
+
+if [ -n "${baseline}" ]; then
+    python3 ${build_dir}/_deps/googlebenchmark-src/tools/compare.py \
+        benchmarks "${baseline}" "${results}"
+fi
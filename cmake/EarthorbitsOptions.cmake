@@ -36,9 +36,77 @@ if (CMAKE_CXX_COMPILER_ID STREQUAL "AppleClang" OR CMAKE_CXX_COMPILER_ID STREQUA
             -fsanitize-memory-track-origins
             -Wthread-safety
         )
+        set(EARTHORBITS_PRIVATE_LINK_OPTIONS
+            -fsanitize=address,undefined,memory
+        )
+    endif()
+elseif (CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+    message(STATUS "::EARTHORBITS:: Configuring 'GNU' compiler options")
+    set(EARTHORBITS_PRIVATE_COMPILE_OPTIONS
+        -Wall
+        -Wcast-align
+        -Wconversion
+        -Wextra
+        -Wformat=2
+        -Wimplicit-fallthrough
+        -Wnon-virtual-dtor
+        -Wold-style-cast
+        -Woverloaded-virtual
+        -Wpedantic
+        -Wshadow
+        -Wsign-conversion
+        -Wunused
+    )
+
+    if (EOB_COMPILE_WARNINGS_AS_ERRORS)
+        list(APPEND EARTHORBITS_PRIVATE_COMPILE_OPTIONS
+            -Werror
+        )
     endif()
 
-    message(STATUS "::EARTHORBITS:: ${EARTHORBITS_PRIVATE_COMPILE_OPTIONS}")
+    if (EOB_COMPILE_SANITIZERS)
+        # https://gcc.gnu.org/onlinedocs/gcc/Instrumentation-Options.html
+        # GCC has no memory sanitizer
+        list(APPEND EARTHORBITS_PRIVATE_COMPILE_OPTIONS
+            -fsanitize=address,undefined
+            -fno-omit-frame-pointer
+        )
+        set(EARTHORBITS_PRIVATE_LINK_OPTIONS
+            -fsanitize=address,undefined
+        )
+    endif()
 else()
     message(FATAL_ERROR "::EARTHORBITS:: Unsupported compiler detected: ${CMAKE_CXX_COMPILER_ID}")
 endif()
+
+# No fused multiply-adds unless written out, so the AVX2 and AVX-512 kernels
+# of EOB_ENABLE_ISA_DISPATCH give the same bits as the baseline ones
+list(APPEND EARTHORBITS_PRIVATE_COMPILE_OPTIONS
+    -ffp-contract=off
+)
+
+# Profile guided optimization in two builds, first with EOB_PGO=GENERATE,
+# run the benchmarks, then with EOB_PGO=USE and the same EOB_PGO_DIR
+if (EOB_PGO STREQUAL "GENERATE")
+    list(APPEND EARTHORBITS_PRIVATE_COMPILE_OPTIONS -fprofile-generate=${EOB_PGO_DIR})
+    list(APPEND EARTHORBITS_PRIVATE_LINK_OPTIONS -fprofile-generate=${EOB_PGO_DIR})
+elseif (EOB_PGO STREQUAL "USE")
+    if (CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        # Code the training run didn't reach stays optimized for speed
+        list(APPEND EARTHORBITS_PRIVATE_COMPILE_OPTIONS
+            -fprofile-use=${EOB_PGO_DIR}
+            -fprofile-partial-training
+            -Wno-missing-profile
+        )
+    else()
+        # Clang reads one merged file, llvm-profdata merge -o default.profdata
+        list(APPEND EARTHORBITS_PRIVATE_COMPILE_OPTIONS
+            -fprofile-use=${EOB_PGO_DIR}/default.profdata
+            -Wno-profile-instr-unprofiled
+        )
+    endif()
+elseif (NOT EOB_PGO STREQUAL "OFF")
+    message(FATAL_ERROR "::EARTHORBITS:: EOB_PGO must be OFF, GENERATE or USE, not ${EOB_PGO}")
+endif()
+
+message(STATUS "::EARTHORBITS:: ${EARTHORBITS_PRIVATE_COMPILE_OPTIONS}")
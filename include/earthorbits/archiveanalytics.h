@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "earthorbits/parsetle.h"
+#include "earthorbits/tlearchive.h"
+
+/// Maneuver and decay detection over TLE histories.
+///
+/// Each element set of an object is compared with the previous one
+/// propagated to its epoch with SGP4: the osculating mean motion,
+/// inclination and RAAN of the two states there. A residual well
+/// outside the spread of the residuals in a trailing window is a maneuver.
+/// A mean motion derivative or B* that is high and rising over the window
+/// is a decay. Whole archives are scanned an object per thread:
+///
+///   const TleArchiveReader archive("catalog.eobtle");
+///   for (const auto &event : AnalyzeArchive(archive)) {
+///     Report(event);
+///   }
+///
+/// Both states are at about the same point of the orbit, so most of the
+/// short period terms cancel. Element sets SGP4 can't be initialized or
+/// propagated for aren't compared.
+
+namespace eob {
+enum class ArchiveEventKind : std::uint8_t {
+  kManeuver = 0,
+  kDecay,
+};
+
+/// @brief Something that happened to an object between two element sets
+struct ArchiveEvent {
+  std::uint32_t satellite_number;
+  ArchiveEventKind kind;
+  /// maneuvers: the elements that jumped
+  bool mean_motion_jump;
+  bool inclination_jump;
+  bool raan_jump;
+  /// epoch of the element set the event was detected in and of the one
+  /// before, it happened in between
+  std::chrono::system_clock::time_point epoch;
+  std::chrono::system_clock::time_point previous_epoch;
+  /// actual - predicted, revolutions / day and degrees
+  double mean_motion_residual;
+  double inclination_residual;
+  double raan_residual;
+  /// maneuvers: largest residual in window standard deviations
+  double significance;
+  /// of the element set at epoch, TLE units
+  double mean_motion_dot;
+  double bstar;
+};
+
+struct ArchiveAnalyticsOptions {
+  /// residuals in the trailing window, flagged ones aren't added
+  std::size_t window = 16;
+  /// residuals the window needs before anything is flagged
+  std::size_t min_window = 4;
+  /// standard deviations from the window mean that make a maneuver
+  double threshold = 8.0;
+  /// floors of the window standard deviations, the rounding and fit noise
+  /// of TLEs, revolutions / day and degrees. RAAN is compared as the angle
+  /// the orbit plane turns, the RAAN residual times sin(inclination).
+  double mean_motion_floor = 1e-5;
+  double inclination_floor = 1e-3;
+  double raan_floor = 1e-3;
+  /// decaying once the window mean of the mean motion derivative, TLE
+  /// units of revolutions / day^2, or of B*, 1 / Earth radii, is above
+  /// these and rising
+  double decay_mean_motion_dot = 5e-4;
+  double decay_bstar = 5e-3;
+  /// 0 for std::thread::hardware_concurrency()
+  std::size_t threads = 0;
+};
+
+/// @brief Events of the history of one object, ordered by epoch
+///
+/// Element sets with the epoch of the one before, re-publications, are
+/// skipped. A decay is reported once, when it starts.
+[[nodiscard]] std::vector<ArchiveEvent> AnalyzeHistory(
+    std::span<const Tle> history, const ArchiveAnalyticsOptions &options = {});
+
+/// @brief Events of every object of archive, ordered by satellite number
+/// and epoch
+[[nodiscard]] std::vector<ArchiveEvent> AnalyzeArchive(
+    const TleArchiveReader &archive,
+    const ArchiveAnalyticsOptions &options = {});
+}  // namespace eob
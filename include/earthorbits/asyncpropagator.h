@@ -0,0 +1,205 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "earthorbits/sgp4.h"
+
+/// Coroutine based batch propagation for services that handle many
+/// concurrent requests.
+///
+/// A request is split into chunks of states at one time of the window.
+/// Chunks run on the propagator's worker threads and are streamed back as
+/// they finish, so a client can start sending results before the whole
+/// window is done:
+///
+///   Task Serve(AsyncPropagator &propagator, PropagationRequest request) {
+///     auto stream = propagator.Submit(std::move(request));
+///     while (auto chunk = co_await stream.Next()) {
+///       Send(*chunk);
+///     }
+///   }
+
+namespace eob {
+/// @brief Propagate every state to start, start + step, ...
+struct PropagationRequest {
+  std::vector<Sgp4State> states;
+  std::chrono::system_clock::time_point start;
+  std::chrono::system_clock::duration step = std::chrono::minutes(1);
+  std::size_t steps = 1;
+  /// states per chunk, the unit of work and of streaming
+  std::size_t chunk_size = 1024;
+};
+
+/// @brief Results of states [first_state, first_state + teme.size()) at one
+/// time of the window
+struct PropagationChunk {
+  std::size_t step;
+  std::chrono::system_clock::time_point time;
+  std::size_t first_state;
+  std::vector<TemeState> teme;
+  std::vector<Sgp4Errc> errors;
+};
+
+namespace async_detail {
+struct Executor;
+struct Job;
+}  // namespace async_detail
+
+/// @brief Results of a submitted request, in the order chunks finish
+///
+/// Only one coroutine may await Next at a time. Destroying the stream
+/// cancels the job, a moved-from stream is done and Next returns
+/// std::nullopt right away.
+class PropagationStream {
+ public:
+  class NextAwaiter {
+   public:
+    /// @param job nullptr for a stream without a job
+    explicit NextAwaiter(async_detail::Job *job) noexcept : job_{job} {}
+    [[nodiscard]] bool await_ready() const noexcept;
+    [[nodiscard]] bool await_suspend(std::coroutine_handle<> handle) const;
+    /// @returns the next chunk, std::nullopt when the job is done or
+    /// cancelled
+    [[nodiscard]] std::optional<PropagationChunk> await_resume() const;
+
+   private:
+    async_detail::Job *job_;
+  };
+
+  explicit PropagationStream(std::shared_ptr<async_detail::Job> job) noexcept;
+  ~PropagationStream();
+  PropagationStream(const PropagationStream &) = delete;
+  PropagationStream &operator=(const PropagationStream &) = delete;
+  PropagationStream(PropagationStream &&) noexcept = default;
+  /// @brief Cancels the job of this stream, then takes over that of other
+  PropagationStream &operator=(PropagationStream &&other) noexcept;
+
+  [[nodiscard]] NextAwaiter Next() const noexcept {
+    return NextAwaiter{job_.get()};
+  }
+
+  /// @brief Stop scheduling chunks, chunks already running still finish but
+  /// aren't delivered. Next returns std::nullopt once they are done.
+  void Cancel() noexcept;
+
+  [[nodiscard]] bool cancelled() const noexcept;
+  [[nodiscard]] std::size_t chunk_count() const noexcept;
+
+ private:
+  std::shared_ptr<async_detail::Job> job_;
+};
+
+/// @brief Fixed pool of worker threads running propagation jobs
+///
+/// A job has at most one chunk per worker queued at a time and queues the
+/// next when one finishes, so concurrent jobs share the workers instead of
+/// running one after the other. Coroutines awaiting a stream are resumed on
+/// the workers.
+class AsyncPropagator {
+ public:
+  /// @param threads workers, 0 for std::thread::hardware_concurrency()
+  explicit AsyncPropagator(std::size_t threads = 0);
+  /// @brief Finishes all queued work, cancel streams first to finish fast
+  ~AsyncPropagator();
+  AsyncPropagator(const AsyncPropagator &) = delete;
+  AsyncPropagator &operator=(const AsyncPropagator &) = delete;
+  AsyncPropagator(AsyncPropagator &&) = delete;
+  AsyncPropagator &operator=(AsyncPropagator &&) = delete;
+
+  /// @brief Start propagating request
+  ///
+  /// Throws MyException<std::string> if chunk_size is 0 or step isn't
+  /// positive for more than one step.
+  [[nodiscard]] PropagationStream Submit(PropagationRequest request);
+
+  [[nodiscard]] std::size_t threads() const noexcept;
+
+ private:
+  std::unique_ptr<async_detail::Executor> executor_;
+};
+
+/// @brief Coroutine return type for work that is started and waited for
+///
+/// Starts running when called. Wait blocks until the coroutine returned and
+/// rethrows what escaped it.
+class Task {
+ public:
+  struct promise_type {
+    std::shared_ptr<std::atomic<bool>> done =
+        std::make_shared<std::atomic<bool>>(false);
+    std::exception_ptr exception;
+
+    Task get_return_object() noexcept {
+      return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    auto final_suspend() noexcept {
+      struct Notify {
+        bool await_ready() noexcept { return false; }
+        void await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+          // the waiting thread may destroy the frame as soon as done is set
+          auto done = h.promise().done;
+          done->store(true, std::memory_order_release);
+          done->notify_all();
+        }
+        void await_resume() noexcept {}
+      };
+      return Notify{};
+    }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept {
+      exception = std::current_exception();
+    }
+  };
+
+  Task(Task &&other) noexcept
+      : handle_{std::exchange(other.handle_, nullptr)} {}
+  Task &operator=(Task &&other) noexcept {
+    if (this != &other) {
+      destroy();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+  /// @brief Waits for the coroutine to finish
+  ~Task() { destroy(); }
+
+  [[nodiscard]] bool done() const noexcept {
+    return !handle_ || handle_.promise().done->load(std::memory_order_acquire);
+  }
+
+  void Wait() const {
+    if (!handle_) {
+      return;
+    }
+    handle_.promise().done->wait(false, std::memory_order_acquire);
+    if (handle_.promise().exception) {
+      std::rethrow_exception(handle_.promise().exception);
+    }
+  }
+
+ private:
+  explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+      : handle_{handle} {}
+
+  void destroy() noexcept {
+    if (handle_) {
+      handle_.promise().done->wait(false, std::memory_order_acquire);
+      handle_.destroy();
+      handle_ = nullptr;
+    }
+  }
+
+  std::coroutine_handle<promise_type> handle_;
+};
+}  // namespace eob
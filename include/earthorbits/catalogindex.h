@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "earthorbits/parsetle.h"
+
+namespace eob {
+/// @brief Coarse orbit classification, checked in enumerator order
+enum class OrbitRegime : std::uint8_t {
+  kHeo = 0,  ///< eccentricity >= 0.25
+  kLeo,      ///< apogee altitude < 2000 km
+  kGeo,      ///< perigee and apogee altitude within 500 km of 35786 km
+  kMeo,      ///< apogee altitude below the GEO band
+  kOther,    ///< beyond the GEO band
+};
+constexpr std::size_t orbit_regime_count = 5;
+
+/// @brief Geometry derived from a TLE's mean motion and eccentricity
+struct OrbitSummary {
+  double semi_major_axis;   ///< km
+  double perigee_altitude;  ///< km above the equatorial radius
+  double apogee_altitude;   ///< km above the equatorial radius
+  double inclination;       ///< degrees
+  OrbitRegime regime;
+};
+
+/// @brief Summarize the orbit of line 2 of a TLE
+///
+/// The semi-major axis comes from Kepler's third law applied to the mean
+/// motion, i.e. it ignores the J2 correction SGP4 applies. The result is
+/// meant for prefiltering, where a few km don't matter.
+[[nodiscard]] OrbitSummary SummarizeOrbit(const TleLine2 &line_2) noexcept;
+
+/// @brief Fixed size set of catalog rows, one bit per row
+class CatalogBitset {
+ public:
+  CatalogBitset() = default;
+  explicit CatalogBitset(std::size_t size)
+      : words_((size + word_bits - 1) / word_bits), size_{size} {}
+
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+  void Set(std::size_t row) noexcept {
+    words_[row / word_bits] |= std::uint64_t{1} << (row % word_bits);
+  }
+  [[nodiscard]] bool Test(std::size_t row) const noexcept {
+    return ((words_[row / word_bits] >> (row % word_bits)) & 1U) != 0;
+  }
+  [[nodiscard]] std::size_t Count() const noexcept;
+
+  /// @brief Intersect with other, which must have the same size
+  CatalogBitset &operator&=(const CatalogBitset &other) noexcept;
+
+  /// @brief Call f(row) for each set row, in increasing order
+  template <typename F>
+  void ForEach(F &&f) const {
+    for (std::size_t w = 0; w < words_.size(); ++w) {
+      auto word = words_[w];
+      while (word != 0) {
+        f(w * word_bits + static_cast<std::size_t>(std::countr_zero(word)));
+        word &= word - 1;  // clear lowest set bit
+      }
+    }
+  }
+
+  /// @brief Set rows, in increasing order
+  [[nodiscard]] std::vector<std::size_t> Rows() const;
+
+ private:
+  static constexpr std::size_t word_bits = 64;
+
+  std::vector<std::uint64_t> words_;
+  std::size_t size_ = 0;
+};
+
+/// @brief Inclusive range [min, max]
+struct ValueRange {
+  double min;
+  double max;
+};
+
+/// @brief Predicates to intersect, unset predicates match every row
+struct CatalogQuery {
+  std::optional<ValueRange> semi_major_axis{};   ///< km
+  std::optional<ValueRange> perigee_altitude{};  ///< km
+  std::optional<ValueRange> apogee_altitude{};   ///< km
+  std::optional<ValueRange> inclination{};       ///< degrees
+  std::optional<OrbitRegime> regime{};
+};
+
+/// @brief Prefilter index answering "which objects could possibly matter"
+///
+/// Each OrbitSummary column is kept sorted (with the row it came from) so a
+/// range predicate is two binary searches, O(log n), plus the rows it
+/// selects. Regimes are precomputed bitsets. Predicates of a query are
+/// intersected as bitsets, unless the most selective predicate matches few
+/// rows in which case those rows are checked directly.
+///
+/// Rows are the positions of the TLEs in the span the index was built from.
+class CatalogIndex {
+ public:
+  explicit CatalogIndex(std::span<const Tle> catalog);
+
+  [[nodiscard]] std::size_t size() const noexcept { return regime_.size(); }
+
+  /// @brief Summary of the orbit at row
+  [[nodiscard]] OrbitSummary summary(std::size_t row) const noexcept;
+
+  [[nodiscard]] CatalogBitset Query(const CatalogQuery &query) const;
+
+ private:
+  enum Column : std::uint8_t {
+    kSemiMajorAxis = 0,
+    kPerigeeAltitude,
+    kApogeeAltitude,
+    kInclination,
+    kColumnCount,
+  };
+
+  /// @brief Values of one column, sorted, and the row each came from
+  struct SortedColumn {
+    std::vector<double> values;
+    std::vector<std::uint32_t> rows;
+  };
+
+  /// @brief Rows [first, last) of a sorted column inside a range
+  struct Selection {
+    Column column;
+    std::size_t first;
+    std::size_t last;
+  };
+
+  [[nodiscard]] Selection Select(Column column, ValueRange range) const;
+
+  /// columns by row, for checking predicates of a single row
+  std::array<std::vector<double>, kColumnCount> values_;
+  std::array<SortedColumn, kColumnCount> sorted_;
+  std::vector<OrbitRegime> regime_;
+  std::array<CatalogBitset, orbit_regime_count> regime_rows_;
+  std::array<std::size_t, orbit_regime_count> regime_counts_{};
+};
+}  // namespace eob
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "earthorbits/sgp4.h"
+
+/// Ground coverage and revisit statistics of a constellation.
+///
+/// Each satellite's footprint, the cap of the Earth that sees it above a
+/// minimum elevation, is projected onto a global latitude/longitude grid at
+/// each time sample, visiting only the cells inside the cap:
+///
+///   const CoverageGrid grid(1.0);
+///   const auto cells = CalcCoverage(states, grid, {.start = start,
+///                                                  .min_elevation = 0.17});
+///   const auto &cell = cells[grid.index(row, col)];
+///
+/// The Earth is a sphere of the WGS-72 equatorial radius here, which moves
+/// the footprint edge by at most a few tens of km, about a quarter of a
+/// degree, from the ellipsoidal answer of CalcLookAngles.
+
+namespace eob {
+/// @brief Earth central angle from the sub-satellite point to the edge of
+/// the footprint
+/// @param altitude km above the spherical Earth
+/// @param min_elevation radians
+/// @returns radians, 0 for altitudes <= 0
+[[nodiscard]] double FootprintRadius(double altitude,
+                                     double min_elevation) noexcept;
+
+/// @brief Equal angle latitude/longitude grid, rows south to north and
+/// columns east from -180 degrees
+class CoverageGrid {
+ public:
+  /// @param resolution cell size in degrees, has to divide 180
+  explicit CoverageGrid(double resolution);
+
+  /// @brief degrees
+  [[nodiscard]] double resolution() const noexcept { return resolution_; }
+  [[nodiscard]] std::size_t rows() const noexcept { return rows_; }
+  [[nodiscard]] std::size_t cols() const noexcept { return 2 * rows_; }
+  [[nodiscard]] std::size_t size() const noexcept { return rows() * cols(); }
+  [[nodiscard]] std::size_t index(std::size_t row,
+                                  std::size_t col) const noexcept {
+    return row * cols() + col;
+  }
+
+  /// @brief Latitude of the centers of the cells of row, radians
+  [[nodiscard]] double latitude(std::size_t row) const noexcept;
+  /// @brief Longitude of the centers of the cells of col, radians
+  [[nodiscard]] double longitude(std::size_t col) const noexcept;
+
+ private:
+  double resolution_;
+  std::size_t rows_;
+};
+
+struct CoverageOptions {
+  std::chrono::system_clock::time_point start;
+  std::chrono::system_clock::duration step = std::chrono::minutes(1);
+  /// time samples start + i * step for i in [0, samples)
+  std::size_t samples = 1441;
+  /// radians, a cell sees a satellite above this elevation
+  double min_elevation = 0.0;
+  /// 0 for std::thread::hardware_concurrency(), each thread takes a
+  /// contiguous part of the samples and keeps its own statistics of the
+  /// whole grid, i.e. 24 bytes per cell and thread
+  std::size_t threads = 0;
+};
+
+/// @brief Statistics of one cell over the samples of a CalcCoverage
+///
+/// A pass is a run of consecutive samples with at least one satellite in
+/// view. A revisit gap is the time from the last sample of one pass to the
+/// first sample of the next, so the time before the first and after the
+/// last pass doesn't count.
+struct CellCoverage {
+  std::uint32_t samples_in_view = 0;
+  std::uint32_t passes = 0;
+  std::chrono::system_clock::duration max_revisit_gap{0};
+  /// zero with fewer than two passes
+  std::chrono::system_clock::duration mean_revisit_gap{0};
+};
+
+/// @brief Coverage of each cell of grid by states
+///
+/// Satellites are skipped at the samples where propagation fails.
+/// @returns cells[grid.index(row, col)]
+[[nodiscard]] std::vector<CellCoverage> CalcCoverage(
+    std::span<const Sgp4State> states, const CoverageGrid &grid,
+    const CoverageOptions &options);
+}  // namespace eob
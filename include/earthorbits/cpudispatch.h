@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+/// Instruction set the hot batch kernels run with.
+///
+/// With the CMake option EOB_ENABLE_ISA_DISPATCH, on by default, and GCC or
+/// Clang on x86-64 the batch kernels are compiled once per Isa into the
+/// library. On first use the best variant the CPU supports is picked with
+/// CPUID. Elsewhere, or with the option off, only kBaseline exists and the
+/// kernels are compiled for whatever the build targets.
+///
+/// Dispatched: the span versions of wrap_to_2pi, wrap_to_86400, sincos and
+/// solve_kepler, batch PropagateSgp4, batch TemeToEcef and
+/// GroundStation::Look over a span.
+///
+/// All variants give bitwise identical results, the library is compiled
+/// with -ffp-contract=off so none of them fuses multiplies and adds.
+
+namespace eob {
+enum class Isa : std::uint8_t {
+  kBaseline = 0,  ///< what the build targets, e.g. x86-64 with SSE2
+  kAvx2,          ///< AVX2 and FMA, x86-64-v3
+  kAvx512,        ///< AVX-512 F, DQ and VL, x86-64-v4
+};
+
+[[nodiscard]] std::string_view to_string(Isa isa) noexcept;
+
+[[nodiscard]] constexpr bool isa_dispatch_enabled() noexcept {
+#if defined(EOB_ENABLE_ISA_DISPATCH) && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__))
+  return true;
+#else
+  return false;
+#endif
+}
+
+/// @brief Whether the library has kernels for isa and the CPU runs them
+[[nodiscard]] bool IsaSupported(Isa isa) noexcept;
+
+/// @brief Best supported Isa, the one used unless SetIsa was called
+[[nodiscard]] Isa DetectIsa() noexcept;
+
+/// @brief Isa the kernels currently run with
+[[nodiscard]] Isa ActiveIsa() noexcept;
+
+/// @brief Run the kernels with isa from now on, e.g. to compare variants
+///
+/// Affects all threads, calls already running finish with the previous Isa.
+/// @returns false, changing nothing, if isa isn't supported
+bool SetIsa(Isa isa) noexcept;
+}  // namespace eob
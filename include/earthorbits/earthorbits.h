@@ -1,8 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <numbers>
 #include <source_location>
+#include <span>
 #include <stdexcept>
 #include <string>
 
@@ -44,4 +49,44 @@ using eob_seconds = std::chrono::duration<double, std::chrono::seconds::period>;
 /// @return seconds, wrapped to 86400 seconds
 [[nodiscard]] eob_seconds calc_gmst(
     const std::chrono::time_point<std::chrono::system_clock> &tp) noexcept;
+
+/// @brief Sidereal seconds calc_gmst advances per UTC second within a day,
+/// from the rotation of Earth, 7.29211510e-5 radians per second
+/// @see https://celestrak.org/columns/v02n01/
+constexpr double gmst_rate = 7.29211510e-5 * 86400.0 / (2.0 * std::numbers::pi);
+
+/// @brief calc_gmst of start + i * StepSeconds for each element of gmst
+///
+/// For pass prediction and other fixed step grids. GMST grows linearly
+/// within a UTC day, so only the first sample of each day goes through
+/// calc_gmst and the rest add a step known at compile time. Equal to
+/// calling calc_gmst per sample up to rounding.
+template <std::int64_t StepSeconds>
+void calc_gmst_grid(
+    const std::chrono::time_point<std::chrono::system_clock> &start,
+    std::span<eob_seconds> gmst) noexcept {
+  static_assert(StepSeconds > 0 && StepSeconds <= 86400,
+                "step has to be positive and at most a day");
+  using namespace std::chrono;
+  constexpr auto step = seconds(StepSeconds);
+  constexpr double gmst_step = gmst_rate * static_cast<double>(StepSeconds);
+
+  std::size_t i = 0;
+  while (i < gmst.size()) {
+    const auto tp = start + step * static_cast<std::int64_t>(i);
+    const auto midnight = floor<days>(tp) + days(1);
+    // samples before midnight, rounded up
+    const auto in_day = static_cast<std::size_t>(
+        (midnight - tp + step - system_clock::duration(1)) / step);
+    const auto end = std::min(gmst.size(), i + in_day);
+    const double first = calc_gmst(tp).count();
+    for (std::size_t k = 0; i < end; ++i, ++k) {
+      double value = first + gmst_step * static_cast<double>(k);
+      while (value >= 86400.0) {
+        value -= 86400.0;
+      }
+      gmst[i] = eob_seconds{value};
+    }
+  }
+}
 }  // namespace eob
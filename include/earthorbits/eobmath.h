@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cmath>
+#include <numbers>
+#include <span>
+
+/// Angle and epoch math for hot loops.
+///
+/// Each kernel has a scalar version, which is the reference, and a version
+/// over spans written so the compiler can vectorize it: no calls into libm
+/// and no data dependent branches in the main loop. The span versions
+/// process min of the sizes of their arguments and may work in place.
+
+namespace eob {
+/// @brief angle_radians wrapped to [0, 2 pi)
+[[nodiscard]] inline double wrap_to_2pi(double angle_radians) noexcept {
+  constexpr double two_pi = 2.0 * std::numbers::pi;
+  return angle_radians - two_pi * std::floor(angle_radians / two_pi);
+}
+
+/// @brief seconds wrapped to [0, 86400)
+[[nodiscard]] inline double wrap_to_86400(double seconds) noexcept {
+  return seconds - 86400.0 * std::floor(seconds / 86400.0);
+}
+
+/// @brief degrees wrapped to [0, 360)
+[[nodiscard]] inline double wrap_to_360(double degrees) noexcept {
+  return degrees - 360.0 * std::floor(degrees / 360.0);
+}
+
+/// @brief Eccentric anomaly E of Kepler's equation M = E - e sin(E)
+///
+/// Newton's method until the correction is below 1e-15 rad.
+/// @param mean_anomaly M, radians, any value
+/// @param eccentricity e, [0, 1)
+/// @returns E in [0, 2 pi]
+[[nodiscard]] double solve_kepler(double mean_anomaly,
+                                  double eccentricity) noexcept;
+
+/// @brief Same as the scalar version for each angle
+///
+/// Matches it to a few ulp of the angle for |angle / (2 pi)| < 2^51,
+/// beyond that the result is meaningless either way.
+void wrap_to_2pi(std::span<const double> angles,
+                 std::span<double> wrapped) noexcept;
+
+/// @brief Same as the scalar version for each value with
+/// |seconds / 86400| < 2^51
+void wrap_to_86400(std::span<const double> seconds,
+                   std::span<double> wrapped) noexcept;
+
+/// @brief sin and cos of each angle with one shared argument reduction
+///
+/// Within 2 ulp of std::sin and std::cos for |angle| <= 1e6 rad, larger
+/// angles fall back to them.
+void sincos(std::span<const double> angles, std::span<double> sines,
+            std::span<double> cosines) noexcept;
+
+/// @brief std::atan2 of each pair of y and x
+///
+/// Within 2 ulp of std::atan2, including signed zeros. Inputs are either 0
+/// or of magnitude above 1e-290, denormals lose precision.
+void atan2(std::span<const double> y, std::span<const double> x,
+           std::span<double> angles) noexcept;
+
+/// @brief solve_kepler for each pair of mean anomaly and eccentricity
+///
+/// Runs a fixed number of Newton iterations, instead of iterating each
+/// element to convergence, so all lanes do the same work. The result is
+/// converged to double precision for e <= 0.99, use the scalar version for
+/// more eccentric orbits.
+void solve_kepler(std::span<const double> mean_anomalies,
+                  std::span<const double> eccentricities,
+                  std::span<double> eccentric_anomalies) noexcept;
+}  // namespace eob
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "earthorbits/earthorbits.h"
+
+namespace eob {
+/// @brief Earth orientation parameters at one instant
+struct EopValues {
+  double ut1_utc = 0.0;  ///< seconds
+  double x_pole = 0.0;   ///< arcseconds
+  double y_pole = 0.0;   ///< arcseconds
+};
+
+/// @brief Daily Earth orientation parameters with O(1) interpolation
+///
+/// Days are consecutive starting at first_mjd, so a lookup is an index
+/// computation and a linear interpolation between two adjacent days. Values
+/// are stored as floats, which is far below the precision they are
+/// published with, to keep decades of data in a few hundred kB.
+///
+/// An empty table interpolates to zeros, i.e. UT1 = UTC and no polar motion,
+/// the same as not using a table at all.
+class EopTable {
+ public:
+  EopTable() = default;
+  /// @param days values at 0h UTC of first_mjd, first_mjd + 1, ...
+  EopTable(int first_mjd, const std::vector<EopValues> &days);
+
+  [[nodiscard]] bool empty() const noexcept { return days_.empty(); }
+  [[nodiscard]] std::size_t size() const noexcept { return days_.size(); }
+  [[nodiscard]] int first_mjd() const noexcept { return first_mjd_; }
+  [[nodiscard]] int last_mjd() const noexcept {
+    return first_mjd_ + static_cast<int>(days_.size()) - 1;
+  }
+
+  /// @brief Values at tp, held constant before the first and after the
+  /// last day
+  ///
+  /// UT1-UTC jumps by a second at leap seconds, on the day before a jump
+  /// the value after it is shifted back by the jump before interpolating.
+  [[nodiscard]] EopValues Interpolate(
+      const std::chrono::system_clock::time_point &tp) const noexcept;
+
+ private:
+  struct Day {
+    float ut1_utc;
+    float x_pole;
+    float y_pole;
+  };
+
+  int first_mjd_ = 0;
+  std::vector<Day> days_;
+};
+
+/// @brief Parse IERS finals2000A.all / finals2000A.data, Bulletin A values
+///
+/// Lines without UT1-UTC, at the end of the prediction, are skipped.
+/// Throws MyException<std::string> with the offending line if a line can't
+/// be parsed or days are missing.
+/// @see https://datacenter.iers.org/versionMetadata.php?filename=latestVersionMeta/10_FINALS.DATA_IAU2000_V2013_0110.txt
+[[nodiscard]] EopTable ParseFinals2000A(std::string_view text);
+
+/// @brief Parse the CelesTrak EOP CSV format, e.g. EOP-All.csv
+/// @see https://celestrak.org/SpaceData/
+[[nodiscard]] EopTable ParseCelestrakEop(std::string_view text);
+
+/// @brief Read a local EOP file in either format, detected from the content
+[[nodiscard]] EopTable LoadEopTable(const std::string &path);
+
+/// @brief calc_gmst at UT1 instead of UTC
+[[nodiscard]] eob_seconds calc_gmst(
+    const std::chrono::time_point<std::chrono::system_clock> &tp,
+    const EopTable &eop) noexcept;
+}  // namespace eob
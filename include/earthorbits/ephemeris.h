@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "earthorbits/sgp4.h"
+
+namespace eob {
+struct EphemerisOptions {
+  double segment_minutes = 60.0;  ///< first try, halved until within tolerance
+  double min_segment_minutes = 0.5;
+  int degree = 12;                    ///< of the Chebyshev polynomials
+  double position_tolerance = 1e-3;   ///< km
+  double velocity_tolerance = 1e-6;   ///< km/s
+};
+
+/// @brief Piecewise Chebyshev fit of propagated TEME states
+///
+/// The fitted window is split into equal segments, each with its own
+/// polynomials for the three position and three velocity components, so a
+/// query is a division to find the segment and a Clenshaw recurrence of
+/// degree multiply-adds per component.
+///
+/// Times are minutes since the epoch of the TLE, like PropagateSgp4.
+class ChebyshevEphemeris {
+ public:
+  ChebyshevEphemeris() = default;
+
+  [[nodiscard]] std::chrono::system_clock::time_point epoch() const noexcept {
+    return epoch_;
+  }
+  [[nodiscard]] double first() const noexcept { return first_; }
+  [[nodiscard]] double last() const noexcept {
+    return first_ + segment_minutes_ * static_cast<double>(segment_count());
+  }
+  [[nodiscard]] double segment_minutes() const noexcept {
+    return segment_minutes_;
+  }
+  [[nodiscard]] int degree() const noexcept { return degree_; }
+  [[nodiscard]] std::size_t segment_count() const noexcept;
+
+  /// @brief Largest differences to PropagateSgp4 seen when fitting, at
+  /// points in between the fit nodes
+  [[nodiscard]] double max_position_error() const noexcept {
+    return max_position_error_;
+  }
+  [[nodiscard]] double max_velocity_error() const noexcept {
+    return max_velocity_error_;
+  }
+
+  /// @brief Memory of the coefficients
+  [[nodiscard]] std::size_t bytes() const noexcept {
+    return coefficients_.size() * sizeof(double);
+  }
+
+  /// @brief State at minutes since epoch, false if outside [first, last]
+  [[nodiscard]] bool Evaluate(double minutes, TemeState &teme) const noexcept;
+
+  friend Sgp4Errc FitEphemeris(const Sgp4State &state, double first,
+                               double last, const EphemerisOptions &options,
+                               ChebyshevEphemeris &ephemeris);
+  friend void WriteEphemeris(std::ostream &os,
+                             const ChebyshevEphemeris &ephemeris);
+  friend ChebyshevEphemeris ReadEphemeris(std::istream &is);
+
+ private:
+  std::chrono::system_clock::time_point epoch_{};
+  double first_ = 0.0;
+  double segment_minutes_ = 0.0;
+  int degree_ = 0;
+  double max_position_error_ = 0.0;
+  double max_velocity_error_ = 0.0;
+  /// per segment, per coefficient, the 6 components
+  std::vector<double> coefficients_;
+};
+
+/// @brief Fit state over [first, last] minutes since epoch
+///
+/// Segments are halved until every segment is within the tolerances of
+/// options or min_segment_minutes or 2^24 segments are reached, check
+/// max_position_error() for the latter. ephemeris is only written on
+/// success. Throws MyException<double> unless both segment lengths are
+/// positive, first and last are finite and [first, last] fits in 2^24
+/// segments.
+[[nodiscard]] Sgp4Errc FitEphemeris(const Sgp4State &state, double first,
+                                    double last,
+                                    const EphemerisOptions &options,
+                                    ChebyshevEphemeris &ephemeris);
+
+/// @brief Binary form, a small header followed by the coefficients as
+/// little endian doubles
+void WriteEphemeris(std::ostream &os, const ChebyshevEphemeris &ephemeris);
+
+/// @brief Read what WriteEphemeris wrote, throws MyException<std::string>
+/// on a malformed or truncated stream
+[[nodiscard]] ChebyshevEphemeris ReadEphemeris(std::istream &is);
+}  // namespace eob
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "earthorbits/parsetle.h"
+
+namespace eob {
+/// Characters of one formatted TLE, two lines of 69 and the line break
+/// between them
+constexpr std::size_t formatted_tle_size = 139;
+
+/// @brief Write tle as canonical TLE text, the inverse of ParseTle
+///
+/// Fields are written in the fixed columns ParseTle reads: implied decimal
+/// eccentricity, normalized "exponential" fields (" 21418-3"), and zero
+/// as " 00000-0". Line numbers and checksums are written fresh, the ones
+/// stored in tle are ignored. Doesn't allocate.
+///
+/// Doubles are rounded to the digits of their field, so formatting a Tle
+/// returned by ParseTle gives back the same values when parsed. Text that
+/// was canonical to begin with comes back byte for byte.
+///
+/// @param out written to only on success, needs formatted_tle_size chars,
+///   no line break is written after line 2
+/// @return TleErrc::kInvalidSize if out is too small, TleErrc::kOutOfDomain
+///   for a field that ParseTle would reject or that doesn't fit its
+///   columns, e.g. a satellite number above 99999
+[[nodiscard]] TleError FormatTle(const Tle &tle, std::span<char> out) noexcept;
+
+/// @brief FormatTle for each Tle followed by a line break, as catalog files
+/// have them
+///
+/// Each record takes formatted_tle_size + 1 chars of out. Stops at the
+/// first Tle that can't be formatted or doesn't fit in out.
+///
+/// @param error why the Tle after the last one written couldn't be
+///   formatted, kOk if all were
+/// @return number of Tle written
+[[nodiscard]] std::size_t FormatTles(std::span<const Tle> tles,
+                                     std::span<char> out,
+                                     TleError &error) noexcept;
+}  // namespace eob
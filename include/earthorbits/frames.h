@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <span>
+
+#include "earthorbits/eop.h"
+#include "earthorbits/sgp4.h"
+
+namespace eob {
+/// @brief Position and velocity in the Earth fixed frame, ITRF when polar
+/// motion is applied and PEF otherwise
+template <typename T>
+struct BasicEcefState {
+  std::array<T, 3> position;  ///< km
+  std::array<T, 3> velocity;  ///< km/s
+};
+using EcefState = BasicEcefState<double>;
+using EcefStateF = BasicEcefState<float>;
+
+/// @brief Rotate a TEME state to the Earth fixed frame at tp, UTC
+///
+/// Rotates by GMST about the pole, then by polar motion. Without an EOP
+/// table UT1 = UTC and there's no polar motion, which is off by up to
+/// ~400 m at the surface.
+/// @see Vallado et al., "Revisiting Spacetrack Report #3", appendix C
+/// @see https://celestrak.org/publications/AIAA/2006-6753/
+[[nodiscard]] EcefState TemeToEcef(
+    const TemeState &teme,
+    const std::chrono::system_clock::time_point &tp) noexcept;
+
+[[nodiscard]] EcefState TemeToEcef(
+    const TemeState &teme, const std::chrono::system_clock::time_point &tp,
+    const EopTable &eop) noexcept;
+
+/// @brief TemeToEcef for each state, all at tp
+///
+/// The rotation is computed once, in double, and applied in the precision
+/// of the states. Pass an empty EopTable for UT1 = UTC and no polar motion.
+/// ecef[i] belongs to teme[i], the spans have to be the same size.
+void TemeToEcef(std::span<const TemeState> teme,
+                const std::chrono::system_clock::time_point &tp,
+                const EopTable &eop, std::span<EcefState> ecef) noexcept;
+void TemeToEcef(std::span<const TemeStateF> teme,
+                const std::chrono::system_clock::time_point &tp,
+                const EopTable &eop, std::span<EcefStateF> ecef) noexcept;
+}  // namespace eob
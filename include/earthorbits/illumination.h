@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "earthorbits/sgp4.h"
+
+/// Low precision Sun and Moon positions and Earth shadow tests.
+///
+/// Positions are geocentric, in km, in the mean equator and equinox of date,
+/// which is within the precision of the models (about 0.01 degrees for the
+/// Sun, 0.3 degrees for the Moon) of the TEME frame SGP4 uses.
+/// @see Vallado, Fundamentals of Astrodynamics and Applications,
+/// algorithms 29 and 31
+
+namespace eob {
+using Vector3 = std::array<double, 3>;
+
+[[nodiscard]] Vector3 SunPosition(
+    const std::chrono::system_clock::time_point &tp) noexcept;
+
+[[nodiscard]] Vector3 MoonPosition(
+    const std::chrono::system_clock::time_point &tp) noexcept;
+
+enum class ShadowModel : std::uint8_t {
+  kCylindrical = 0,  ///< Sun at infinity, no penumbra
+  kConical,          ///< umbra and penumbra cones of the Sun's disk
+};
+
+enum class Illumination : std::uint8_t {
+  kSunlit = 0,
+  kPenumbra,
+  kUmbra,
+};
+
+/// @brief Fraction of the Sun's disk visible from satellite, conical model
+/// @param satellite geocentric position, km
+/// @param sun geocentric position, km
+[[nodiscard]] double SunlitFraction(const Vector3 &satellite,
+                                    const Vector3 &sun) noexcept;
+
+[[nodiscard]] Illumination CalcIllumination(const Vector3 &satellite,
+                                            const Vector3 &sun,
+                                            ShadowModel model) noexcept;
+
+/// @brief CalcIllumination for each satellite, all at the time of sun
+void CalcIllumination(std::span<const Vector3> satellites, const Vector3 &sun,
+                      ShadowModel model, std::span<Illumination> out) noexcept;
+
+/// @brief Sun and Moon positions on an evenly spaced time grid
+///
+/// Computed once and shared by every satellite evaluated on the grid.
+class SunMoonGrid {
+ public:
+  SunMoonGrid(std::chrono::system_clock::time_point start,
+              std::chrono::system_clock::duration step, std::size_t size);
+
+  [[nodiscard]] std::size_t size() const noexcept { return sun_.size(); }
+  [[nodiscard]] std::chrono::system_clock::time_point start() const noexcept {
+    return start_;
+  }
+  [[nodiscard]] std::chrono::system_clock::duration step() const noexcept {
+    return step_;
+  }
+  [[nodiscard]] std::chrono::system_clock::time_point time(
+      std::size_t i) const noexcept {
+    return start_ + step_ * static_cast<std::int64_t>(i);
+  }
+  [[nodiscard]] const Vector3 &sun(std::size_t i) const noexcept {
+    return sun_[i];
+  }
+  [[nodiscard]] const Vector3 &moon(std::size_t i) const noexcept {
+    return moon_[i];
+  }
+
+ private:
+  std::chrono::system_clock::time_point start_;
+  std::chrono::system_clock::duration step_;
+  std::vector<Vector3> sun_;
+  std::vector<Vector3> moon_;
+};
+
+/// @brief Time in shadow, for the conical model penumbra counts as shadow
+struct EclipseInterval {
+  std::chrono::system_clock::time_point entry;
+  std::chrono::system_clock::time_point exit;
+};
+
+/// @brief Find the eclipses of a satellite during a grid
+///
+/// Illumination is sampled at the grid times, transitions are then refined
+/// by bisection to within precision. Eclipses that start before or end
+/// after the grid are cut off at its first or last time. Eclipses shorter
+/// than the grid step can be missed.
+///
+/// Throws MyException<std::string> if precision isn't positive.
+[[nodiscard]] Sgp4Errc FindEclipses(
+    const Sgp4State &state, const SunMoonGrid &grid, ShadowModel model,
+    std::vector<EclipseInterval> &eclipses,
+    std::chrono::system_clock::duration precision = std::chrono::seconds(1));
+
+/// @brief FindEclipses for each state of a catalog
+///
+/// errors[i] is the error of states[i], eclipses[i] is empty on error.
+void FindEclipses(
+    std::span<const Sgp4State> states, const SunMoonGrid &grid,
+    ShadowModel model, std::vector<std::vector<EclipseInterval>> &eclipses,
+    std::vector<Sgp4Errc> &errors,
+    std::chrono::system_clock::duration precision = std::chrono::seconds(1));
+}  // namespace eob
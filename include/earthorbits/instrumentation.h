@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/// Optional hot path instrumentation, enabled with the CMake option
+/// EOB_ENABLE_INSTRUMENTATION. When disabled EOB_COUNT and EOB_SCOPED_TIMER
+/// expand to nothing and snapshots are empty.
+///
+/// Each thread owns its counters so recording is a couple of relaxed
+/// stores, counters are only summed when a snapshot is taken.
+
+namespace eob {
+/// @brief Instrumented operations, timers nest so times are inclusive
+enum class Probe : std::uint8_t {
+  kParseTle = 0,
+  kValidateTle,
+  kCalcGmst,
+  kPropagate,
+  kFormat,
+};
+constexpr std::size_t probe_count = 5;
+
+[[nodiscard]] std::string_view to_string(Probe probe) noexcept;
+
+[[nodiscard]] constexpr bool instrumentation_enabled() noexcept {
+#if defined(EOB_ENABLE_INSTRUMENTATION)
+  return true;
+#else
+  return false;
+#endif
+}
+
+struct ProbeStats {
+  std::uint64_t calls = 0;
+  std::uint64_t ticks = 0;  ///< only accumulated by EOB_SCOPED_TIMER
+  double seconds = 0.0;     ///< ticks converted with ticks_per_second
+};
+
+/// @brief Counters summed over all threads that have recorded anything
+struct InstrumentationSnapshot {
+  std::array<ProbeStats, probe_count> probes{};
+  double ticks_per_second = 0.0;
+  std::size_t threads = 0;  ///< threads that are still alive and recorded
+
+  [[nodiscard]] const ProbeStats &operator[](Probe probe) const noexcept {
+    return probes[static_cast<std::size_t>(probe)];
+  }
+};
+
+[[nodiscard]] InstrumentationSnapshot TakeInstrumentationSnapshot();
+
+/// @brief Zero all counters, including those of exited threads
+void ResetInstrumentation();
+
+/// @brief One line per probe, "name calls=N seconds=S"
+[[nodiscard]] std::string ToText(const InstrumentationSnapshot &snapshot);
+[[nodiscard]] std::string ToJson(const InstrumentationSnapshot &snapshot);
+
+namespace instrumentation_detail {
+/// @brief Counters owned by one thread, only that thread writes to them
+struct ThreadCounters {
+  ThreadCounters() noexcept;
+  ~ThreadCounters();
+  ThreadCounters(const ThreadCounters &) = delete;
+  ThreadCounters &operator=(const ThreadCounters &) = delete;
+  ThreadCounters(ThreadCounters &&) = delete;
+  ThreadCounters &operator=(ThreadCounters &&) = delete;
+
+  void Add(Probe probe, std::uint64_t elapsed) noexcept {
+    const auto i = static_cast<std::size_t>(probe);
+    // single writer, so load + store is enough and cheaper than fetch_add
+    calls[i].store(calls[i].load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+    ticks[i].store(ticks[i].load(std::memory_order_relaxed) + elapsed,
+                   std::memory_order_relaxed);
+  }
+
+  std::array<std::atomic<std::uint64_t>, probe_count> calls{};
+  std::array<std::atomic<std::uint64_t>, probe_count> ticks{};
+};
+
+/// @brief Counters of the calling thread, registered on first use
+[[nodiscard]] ThreadCounters &thread_counters() noexcept;
+
+/// @brief Current value of the tick counter, the TSC on x86-64 and
+/// std::chrono::steady_clock elsewhere
+[[nodiscard]] std::uint64_t read_ticks() noexcept;
+
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(Probe probe) noexcept
+      : counters_{thread_counters()}, probe_{probe}, start_{read_ticks()} {}
+  ~ScopedTimer() { counters_.Add(probe_, read_ticks() - start_); }
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+  ScopedTimer(ScopedTimer &&) = delete;
+  ScopedTimer &operator=(ScopedTimer &&) = delete;
+
+ private:
+  ThreadCounters &counters_;
+  Probe probe_;
+  std::uint64_t start_;
+};
+}  // namespace instrumentation_detail
+}  // namespace eob
+
+#define EOB_INSTRUMENTATION_CONCAT_IMPL(a, b) a##b
+#define EOB_INSTRUMENTATION_CONCAT(a, b) EOB_INSTRUMENTATION_CONCAT_IMPL(a, b)
+
+#if defined(EOB_ENABLE_INSTRUMENTATION)
+/// @brief Count a call of probe
+#define EOB_COUNT(probe) \
+  ::eob::instrumentation_detail::thread_counters().Add(probe, 0)
+/// @brief Count a call of probe and time the rest of the enclosing scope
+#define EOB_SCOPED_TIMER(probe)                                           \
+  const ::eob::instrumentation_detail::ScopedTimer                        \
+      EOB_INSTRUMENTATION_CONCAT(eob_scoped_timer_, __LINE__) { probe }
+#else
+#define EOB_COUNT(probe) static_cast<void>(0)
+#define EOB_SCOPED_TIMER(probe) static_cast<void>(0)
+#endif
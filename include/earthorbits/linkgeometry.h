@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "earthorbits/frames.h"
+#include "earthorbits/topocentric.h"
+
+/// Link geometry of station contacts for RF scheduling.
+///
+/// A contact is a station and the Earth fixed track of a satellite sampled
+/// over the time of the contact, e.g. at 1 Hz from PropagateSgp4 and
+/// TemeToEcef. Every sample gets range, range rate, Doppler factor and look
+/// angles, as structure of arrays:
+///
+///   std::vector<LinkGeometry> links;
+///   CalcLinkGeometry(stations, contacts, links);
+///   const double rx_hz = tx_hz * links[c].doppler[i];
+///
+/// Samples are done in chunks that stay in L1, each a few loops the
+/// compiler vectorizes, with the angles from the atan2 of eobmath.h instead
+/// of libm. Contacts are spread over threads.
+
+namespace eob {
+/// @brief km/s
+constexpr double speed_of_light_km_per_s = 299792.458;
+
+/// @brief Link geometry at each sample of a contact
+struct LinkGeometry {
+  std::vector<double> range;       ///< km
+  std::vector<double> range_rate;  ///< km/s, positive when receding
+  /// received / transmitted frequency of a one way link, 1 - range rate / c,
+  /// square it for a two way link
+  std::vector<double> doppler;
+  std::vector<double> azimuth;    ///< radians, clockwise from north, [0, 2 pi)
+  std::vector<double> elevation;  ///< radians above the horizon
+
+  [[nodiscard]] std::size_t size() const noexcept { return range.size(); }
+  void resize(std::size_t size);
+};
+
+/// @brief A satellite track seen from one station
+struct Contact {
+  std::size_t station;                ///< index into the stations
+  std::span<const EcefState> track;  ///< Earth fixed states at the samples
+};
+
+/// @brief Link geometry of track seen from station, resizes out to the
+/// size of track
+///
+/// Equal to GroundStation::Look per sample within a few ulp.
+void CalcLinkGeometry(const GroundStation &station,
+                      std::span<const EcefState> track, LinkGeometry &out);
+
+/// @brief Link geometry of each contact, out[i] belongs to contacts[i]
+/// @param threads 0 for std::thread::hardware_concurrency()
+void CalcLinkGeometry(std::span<const GroundStation> stations,
+                      std::span<const Contact> contacts,
+                      std::vector<LinkGeometry> &out, std::size_t threads = 0);
+}  // namespace eob
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+
+/// Monte Carlo propagation of TLE uncertainty.
+///
+/// Draws element sets around a TLE from a covariance of its elements,
+/// propagates each and reduces the states at every requested time to mean,
+/// covariance and percentiles of the distance from the nominal orbit, e.g.
+/// for the risk of a close approach:
+///
+///   const auto cov = ToCovariance({.mean_anomaly = 0.01, .bstar = 1e-5});
+///   const auto stats = PropagateMonteCarlo(tle, cov, times, {.samples = n});
+///   const double p99 = stats[t].DistancePercentile(0.99);
+///
+/// Samples come from a counter based generator, sample i is the same for
+/// any batch size or number of threads. They are initialized and
+/// propagated in batches, spread over threads, and only the running sums
+/// of each thread are kept, memory doesn't grow with the number of
+/// samples.
+
+namespace eob {
+/// @brief Perturbed elements, in the order of ElementCovariance
+enum class TleElement : std::uint8_t {
+  kInclination = 0,
+  kRaan,
+  kEccentricity,
+  kArgumentOfPerigee,
+  kMeanAnomaly,
+  kMeanMotion,
+  kBstar,
+};
+
+constexpr std::size_t tle_elements = 7;
+
+/// @brief Covariance of the elements of a TLE, in the order of TleElement
+/// and the units of the TLE: degrees, revolutions / day and 1 / Earth radii
+using ElementCovariance =
+    std::array<std::array<double, tle_elements>, tle_elements>;
+
+/// @brief Standard deviations of uncorrelated elements, units of the TLE
+struct ElementSigmas {
+  double inclination = 0.0;          ///< degrees
+  double raan = 0.0;                 ///< degrees
+  double eccentricity = 0.0;
+  double argument_of_perigee = 0.0;  ///< degrees
+  double mean_anomaly = 0.0;         ///< degrees
+  double mean_motion = 0.0;          ///< revolutions per day
+  double bstar = 0.0;                ///< 1 / Earth radii
+};
+
+/// @brief Diagonal covariance of sigmas
+[[nodiscard]] ElementCovariance ToCovariance(
+    const ElementSigmas &sigmas) noexcept;
+
+/// @brief Perturbed element sets around a TLE
+///
+/// Sample i is nominal + L z, with L L^T the covariance and z 7 standard
+/// normal numbers drawn from a hash of (seed, i). Inclination is clamped to
+/// [0, 180] degrees, eccentricity to [0, 0.999] and the angles wrapped to
+/// [0, 360), all other fields are those of the nominal TLE.
+class ElementCloud {
+ public:
+  /// @throws MyException<std::string> if covariance isn't symmetric
+  /// positive semidefinite
+  ElementCloud(const Tle &nominal, const ElementCovariance &covariance,
+               std::uint64_t seed = 0);
+
+  [[nodiscard]] const Tle &nominal() const noexcept { return nominal_; }
+
+  /// @brief Sample i
+  [[nodiscard]] Tle operator[](std::uint64_t i) const noexcept;
+
+  /// @brief Samples first, first + 1, ... into out
+  void Sample(std::uint64_t first, std::span<Tle> out) const noexcept;
+
+ private:
+  Tle nominal_;
+  ElementCovariance cholesky_;  ///< lower triangular
+  std::uint64_t seed_;
+};
+
+struct MonteCarloOptions {
+  std::size_t samples = 10000;
+  std::uint64_t seed = 0;
+  /// 0 for std::thread::hardware_concurrency(), 1 for the calling thread
+  /// only. The statistics only depend on the samples and the number of
+  /// threads, which sets the order the sums are added up in.
+  std::size_t threads = 0;
+};
+
+/// @brief Statistics of the samples at one time
+struct MonteCarloStats {
+  /// Distance histogram over the squared distance, bins_per_octave bins
+  /// evenly spaced in each power of 2 from 2^-40 km^2 (about 1 mm) to 2^34
+  /// km^2 (131000 km), below and above go into the first and last bin.
+  /// The bin of a sample is read off the exponent and mantissa bits.
+  static constexpr std::size_t bins_per_octave = 8;
+  static constexpr int min_octave = -40;
+  static constexpr std::size_t octaves = 74;
+  static constexpr std::size_t bins = bins_per_octave * octaves;
+
+  std::chrono::system_clock::time_point time;
+  std::size_t samples = 0;  ///< propagated without error
+  std::size_t failed = 0;   ///< rejected by InitSgp4 or PropagateSgp4
+
+  /// propagation of the nominal TLE, the statistics are computed relative
+  /// to it, zero if it fails
+  TemeState nominal{};
+  Sgp4Errc nominal_errc = Sgp4Errc::kOk;
+
+  /// km and km / s, position then velocity
+  std::array<double, 6> mean{};
+  /// sample covariance of position then velocity
+  std::array<std::array<double, 6>, 6> covariance{};
+  /// counts of the distance of the sample positions from the nominal, km
+  std::array<std::uint64_t, bins> distance_histogram{};
+
+  /// @brief Distance from the nominal position below which fraction p of
+  /// the samples lie, km, interpolated within the bin
+  ///
+  /// Resolution is a bin, at most 6 %. NaN without samples or if the nominal
+  /// failed to propagate.
+  [[nodiscard]] double DistancePercentile(double p) const noexcept;
+};
+
+/// @brief Statistics of the cloud's states at each of times
+/// @returns result[i] belongs to times[i]
+[[nodiscard]] std::vector<MonteCarloStats> PropagateMonteCarlo(
+    const ElementCloud &cloud,
+    std::span<const std::chrono::system_clock::time_point> times,
+    const MonteCarloOptions &options = {});
+
+/// @brief The same for ElementCloud(tle, covariance, options.seed)
+/// @throws MyException<std::string> if covariance isn't symmetric
+/// positive semidefinite
+[[nodiscard]] std::vector<MonteCarloStats> PropagateMonteCarlo(
+    const Tle &tle, const ElementCovariance &covariance,
+    std::span<const std::chrono::system_clock::time_point> times,
+    const MonteCarloOptions &options = {});
+
+/// @brief Bytes PropagateMonteCarlo works in for a number of times, the
+/// same for any number of samples
+[[nodiscard]] std::size_t MonteCarloBytes(
+    std::size_t times, const MonteCarloOptions &options = {}) noexcept;
+}  // namespace eob
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <string_view>
 
 namespace eob {
 /// TODO there likely is a more memory efficient way of defining these
@@ -53,9 +55,85 @@ struct Tle {
 
 std::ostream &operator<<(std::ostream &os, const Tle &tle);
 
+/// @brief Reason a TLE record was rejected
+enum class TleErrc : std::uint8_t {
+  kOk = 0,
+  kInvalidSize,
+  kMissingLineBreak,
+  kInvalidCharacter,
+  kInvalidField,  ///< field could not be decoded, e.g. "24097.815.9284"
+  kInvalidLineNumber,
+  kInvalidClassification,
+  kOutOfDomain,  ///< field decoded but is outside its physical domain
+  kChecksumMismatch,
+  kSatelliteNumberMismatch,
+};
+
+/// @brief Fields of a TLE, in the order they appear in the record
+enum class TleField : std::uint8_t {
+  kNone = 0,
+  kLine1Number,
+  kLine1SatelliteNumber,
+  kClassification,
+  kLaunchYear,
+  kLaunchNumber,
+  kLaunchPiece,
+  kEpochYear,
+  kEpochDay,
+  kMeanMotionDot,
+  kMeanMotionDdot,
+  kBstarDrag,
+  kEphemerisType,
+  kElementNumber,
+  kLine1Checksum,
+  kLine2Number,
+  kLine2SatelliteNumber,
+  kInclination,
+  kRaan,
+  kEccentricity,
+  kArgumentOfPerigree,
+  kMeanAnomaly,
+  kMeanMotion,
+  kRevAtEpoch,
+  kLine2Checksum,
+};
+
+/// @brief Compact description of why a TLE was rejected
+///
+/// Cheap to create and copy (4 bytes), so rejecting malformed records
+/// doesn't allocate. Use to_string() to get human readable text when it
+/// is actually needed.
+struct TleError {
+  TleErrc code = TleErrc::kOk;
+  TleField field = TleField::kNone;
+  std::uint8_t line = 0;    ///< 1 or 2, 0 if not specific to a line
+  std::uint8_t column = 0;  ///< 1-based column within line, 0 if unknown
+
+  [[nodiscard]] constexpr bool ok() const noexcept {
+    return code == TleErrc::kOk;
+  }
+};
+
+[[nodiscard]] std::string_view to_string(TleErrc code) noexcept;
+[[nodiscard]] std::string_view to_string(TleField field) noexcept;
+[[nodiscard]] std::string to_string(const TleError &err);
+
+/// @brief Non-throwing TLE parse, same checks as ParseTle
+///
+/// @param str string containing all characters of one TLE
+/// @param tle only written to when parsing succeeds
+///
+/// @return TleError with code TleErrc::kOk on success
+[[nodiscard]] TleError TryParseTle(std::string_view str, Tle &tle) noexcept;
+
+/// @brief Check that str is a valid TLE without keeping the parsed result
+[[nodiscard]] TleError ValidateTle(std::string_view str) noexcept;
+
 /// @brief Convert string TLE to EOB struct
 ///
-/// @throws EobError
+/// Thin wrapper around TryParseTle that throws on the first error found.
+///
+/// @throws MyException<std::string> with the formatted TleError
 /// Provides the Strong Exception Guarentee
 ///
 /// @param str string containing all characters of one TLE
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+
+namespace eob {
+/// @brief Identity of a TLE, a new element set of the same satellite gets
+/// a new element number and epoch
+struct PropagatorKey {
+  int satellite_number;
+  int element_number;
+  int epoch_year;
+  double epoch_day;
+
+  bool operator==(const PropagatorKey &) const = default;
+};
+
+[[nodiscard]] PropagatorKey MakePropagatorKey(const Tle &tle) noexcept;
+
+struct PropagatorCacheStats {
+  std::uint64_t hits = 0;
+  std::uint64_t misses = 0;
+  std::uint64_t evictions = 0;
+  std::size_t size = 0;      ///< cached states
+  std::size_t capacity = 0;  ///< states that fit before evicting
+  std::size_t bytes = 0;     ///< approximate memory of the cached states
+};
+
+/// @brief Bounded cache of initialized SGP4 states
+///
+/// Initializing SGP4 costs about as much as dozens of propagation steps, so
+/// a service propagating the same TLEs over and over keeps their states
+/// here. States live in contiguous pools, one per shard, and the least
+/// recently used state of a shard is evicted when the shard is full.
+///
+/// Keys are spread over shards that are locked independently, so threads
+/// mostly don't contend. States are returned by value, they stay valid
+/// whatever other threads do to the cache. A miss initializes outside the
+/// lock; TLEs that fail to initialize are not cached.
+class PropagatorCache {
+ public:
+  /// @param capacity states kept before evicting. Each shard holds an even
+  /// part plus some headroom for uneven hashing, so with several shards up
+  /// to a few percent more are kept, @see PropagatorCacheStats::capacity
+  /// @param shards independently locked parts, fewer for small capacities
+  explicit PropagatorCache(std::size_t capacity, std::size_t shards = 16);
+  ~PropagatorCache();
+  PropagatorCache(const PropagatorCache &) = delete;
+  PropagatorCache &operator=(const PropagatorCache &) = delete;
+  PropagatorCache(PropagatorCache &&) noexcept;
+  PropagatorCache &operator=(PropagatorCache &&) noexcept;
+
+  /// @brief State of tle, initialized and inserted on a miss
+  [[nodiscard]] Sgp4Errc Get(const Tle &tle, Sgp4State &state);
+
+  /// @brief Get followed by PropagateSgp4
+  [[nodiscard]] Sgp4Errc Propagate(const Tle &tle, double minutes,
+                                   TemeState &teme);
+
+  [[nodiscard]] bool Contains(const PropagatorKey &key) const;
+
+  /// @brief Drop all states, statistics are kept
+  void Clear();
+
+  [[nodiscard]] PropagatorCacheStats Stats() const;
+
+  /// @brief Approximate bytes per cached state, including index overhead
+  [[nodiscard]] static std::size_t bytes_per_entry() noexcept;
+
+ private:
+  struct Shard;
+
+  [[nodiscard]] Shard &shard(std::size_t hash) const noexcept;
+
+  std::unique_ptr<Shard[]> shards_;
+  std::size_t shard_count_ = 0;
+};
+}  // namespace eob
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "earthorbits/parsetle.h"
+
+namespace eob {
+/// @brief Reason SGP4 initialization or propagation failed
+///
+/// Propagation codes follow the error codes of the reference implementation.
+/// @see https://celestrak.org/publications/AIAA/2006-6753/
+enum class Sgp4Errc : std::uint8_t {
+  kOk = 0,
+  kInvalidElements,          ///< mean motion or eccentricity out of domain
+  kEccentricityOutOfRange,   ///< mean eccentricity left [0, 1), code 1
+  kMeanMotionNegative,       ///< code 2
+  /// eccentricity with the lunar-solar periodics left [0, 1], code 3
+  kPerturbedEccentricityOutOfRange,
+  kSemiLatusRectumNegative,  ///< code 4
+  kDecayed,                  ///< orbit radius below the Earth's, code 6
+};
+
+[[nodiscard]] std::string_view to_string(Sgp4Errc errc) noexcept;
+
+/// @brief Position and velocity in the TEME frame SGP4 works in
+template <typename T>
+struct BasicTemeState {
+  std::array<T, 3> position;  ///< km
+  std::array<T, 3> velocity;  ///< km/s
+};
+using TemeState = BasicTemeState<double>;
+using TemeStateF = BasicTemeState<float>;
+
+/// @brief Lunar-solar periodics and resonance terms of SDP4, the deep space
+/// part of SGP4 for periods of 225 minutes or more
+template <typename T>
+struct BasicDeepSpaceTerms {
+  std::int32_t irez;  ///< 0 none, 1 one day, 2 half day resonance
+  T gsto;             ///< Greenwich sidereal angle at the epoch
+
+  // lunar-solar periodics, dpper
+  T e3;
+  T ee2;
+  T se2;
+  T se3;
+  T sgh2;
+  T sgh3;
+  T sgh4;
+  T sh2;
+  T sh3;
+  T si2;
+  T si3;
+  T sl2;
+  T sl3;
+  T sl4;
+  T xgh2;
+  T xgh3;
+  T xgh4;
+  T xh2;
+  T xh3;
+  T xi2;
+  T xi3;
+  T xl2;
+  T xl3;
+  T xl4;
+  T zmol;
+  T zmos;
+
+  // lunar-solar secular rates and resonances, dspace
+  T dedt;
+  T didt;
+  T dmdt;
+  T dnodt;
+  T domdt;
+  T d2201;
+  T d2211;
+  T d3210;
+  T d3222;
+  T d4410;
+  T d4422;
+  T d5220;
+  T d5232;
+  T d5421;
+  T d5433;
+  T del1;
+  T del2;
+  T del3;
+  T xfact;
+  T xlamo;
+};
+
+/// @brief SGP4 constants derived from a TLE, everything propagation needs
+///
+/// Computing these (recovering the un-Kozai'd mean motion, the drag and
+/// secular rate coefficients) is the expensive part of SGP4, so reuse a
+/// state when propagating the same TLE many times, @see PropagatorCache.
+/// Angles are radians, times minutes and lengths Earth radii.
+///
+/// Sgp4StateF propagates in single precision for bulk work such as map
+/// rendering and screening: it is half the size, and terms that grow with
+/// time since the epoch are still accumulated in double so positions stay
+/// within a few hundred meters of double precision over a week. The deep
+/// space terms are applied in double for both.
+template <typename T>
+struct BasicSgp4State {
+  std::chrono::system_clock::time_point epoch;
+  /// perigee below 220 km or deep space, drop higher order drag terms
+  bool simplified;
+  bool deep_space;  ///< period of 225 minutes or more, SDP4
+
+  T bstar;
+  T eccentricity;
+  T inclination;
+  T raan;
+  T argument_of_perigee;
+  T mean_anomaly;
+  T mean_motion;  ///< un-Kozai'd, radians / minute
+
+  T aycof;
+  T con41;
+  T cc1;
+  T cc4;
+  T cc5;
+  T d2;
+  T d3;
+  T d4;
+  T delmo;
+  T eta;
+  T argpdot;
+  T omgcof;
+  T sinmao;
+  T t2cof;
+  T t3cof;
+  T t4cof;
+  T t5cof;
+  T x1mth2;
+  T x7thm1;
+  T mdot;
+  T nodedot;
+  T xlcof;
+  T xmcof;
+  T nodecf;
+
+  BasicDeepSpaceTerms<T> deep;  ///< only set for deep space
+};
+using Sgp4State = BasicSgp4State<double>;
+using Sgp4StateF = BasicSgp4State<float>;
+
+/// @brief Epoch of a TLE, two digit years 57-99 are 1957-1999
+[[nodiscard]] std::chrono::system_clock::time_point TleEpoch(
+    const TleLine1 &line_1) noexcept;
+
+/// @brief Initialize SGP4 for tle, WGS-72 constants
+///
+/// Orbits with periods of 225 minutes or more get the deep space terms of
+/// SDP4, lunar-solar perturbations and the one day and half day
+/// resonances. state is only written on success.
+[[nodiscard]] Sgp4Errc InitSgp4(const Tle &tle, Sgp4State &state) noexcept;
+
+/// @brief Round the constants of state to single precision
+[[nodiscard]] Sgp4StateF ToSinglePrecision(const Sgp4State &state) noexcept;
+
+/// @brief Propagate to minutes since the epoch of state
+[[nodiscard]] Sgp4Errc PropagateSgp4(const Sgp4State &state, double minutes,
+                                     TemeState &teme) noexcept;
+[[nodiscard]] Sgp4Errc PropagateSgp4(const Sgp4StateF &state, double minutes,
+                                     TemeStateF &teme) noexcept;
+
+/// @brief Propagate each state to tp
+///
+/// teme[i] and errors[i] belong to states[i], the spans have to be the same
+/// size.
+void PropagateSgp4(std::span<const Sgp4State> states,
+                   const std::chrono::system_clock::time_point &tp,
+                   std::span<TemeState> teme,
+                   std::span<Sgp4Errc> errors) noexcept;
+void PropagateSgp4(std::span<const Sgp4StateF> states,
+                   const std::chrono::system_clock::time_point &tp,
+                   std::span<TemeStateF> teme,
+                   std::span<Sgp4Errc> errors) noexcept;
+
+/// @brief Minutes from the epoch of state to tp
+template <typename T>
+[[nodiscard]] double MinutesSinceEpoch(
+    const BasicSgp4State<T> &state,
+    const std::chrono::system_clock::time_point &tp) noexcept {
+  const std::chrono::duration<double, std::chrono::minutes::period> minutes =
+      tp - state.epoch;
+  return minutes.count();
+}
+}  // namespace eob
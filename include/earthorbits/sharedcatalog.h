@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+
+/// Catalog in POSIX shared memory, parsed and initialized once per host.
+///
+/// A loader publishes the catalog, every worker process maps it read-only
+/// and uses the SGP4 states in place, there is nothing to parse or
+/// allocate:
+///
+///   // loader
+///   SharedCatalogPublisher publisher("/eobcatalog");
+///   publisher.Publish(tles);
+///
+///   // worker
+///   SharedCatalog catalog("/eobcatalog");
+///   PropagateSgp4(catalog.states(), tp, teme, errors);
+///   if (catalog.Stale()) {
+///     catalog.Refresh();
+///   }
+///
+/// Each publication is an immutable shared memory object of its own,
+/// "<name>.<generation>". The object "<name>" holds the number of the
+/// latest generation, which Publish increments after the new generation
+/// is complete and before it unlinks the previous one. Workers keep their
+/// mapping of an unlinked generation until they refresh, so a publication
+/// never changes memory a worker reads.
+
+namespace eob {
+/// @brief Publishes catalogs under a shared memory name
+///
+/// One publisher per name at a time. Throws MyException<std::string> with
+/// the name when shared memory can't be created or mapped.
+class SharedCatalogPublisher {
+ public:
+  /// @param name of the form "/name", continues the generations of a
+  /// catalog published under it before
+  explicit SharedCatalogPublisher(const std::string &name);
+  /// @brief Unmaps, the catalog stays published, @see RemoveSharedCatalog
+  ~SharedCatalogPublisher();
+  SharedCatalogPublisher(const SharedCatalogPublisher &) = delete;
+  SharedCatalogPublisher &operator=(const SharedCatalogPublisher &) = delete;
+  SharedCatalogPublisher(SharedCatalogPublisher &&) = delete;
+  SharedCatalogPublisher &operator=(SharedCatalogPublisher &&) = delete;
+
+  /// @brief Initialize SGP4 for catalog and publish it as a new generation
+  ///
+  /// Objects are ordered by satellite number, of several element sets of
+  /// a satellite the one with the latest epoch is kept. Element sets SGP4
+  /// can't be initialized for are left out.
+  /// @returns number of objects published
+  std::size_t Publish(std::span<const Tle> catalog);
+
+  /// @brief Latest published generation, 0 before the first
+  [[nodiscard]] std::uint64_t generation() const noexcept;
+
+ private:
+  std::string name_;
+  void *control_ = nullptr;
+  std::atomic<std::uint64_t> *generation_ = nullptr;
+};
+
+/// @brief Unlink the shared memory of a catalog, mapped catalogs stay
+/// valid
+void RemoveSharedCatalog(const std::string &name) noexcept;
+
+/// @brief Read-only mapping of the latest generation of a shared catalog
+///
+/// Throws MyException<std::string> with the name when nothing is
+/// published under it or the shared memory is malformed. Const members
+/// may be called from multiple threads.
+class SharedCatalog {
+ public:
+  explicit SharedCatalog(const std::string &name);
+  ~SharedCatalog();
+  SharedCatalog(const SharedCatalog &) = delete;
+  SharedCatalog &operator=(const SharedCatalog &) = delete;
+  SharedCatalog(SharedCatalog &&other) noexcept;
+  SharedCatalog &operator=(SharedCatalog &&other) noexcept;
+
+  /// @brief Generation mapped
+  [[nodiscard]] std::uint64_t generation() const noexcept {
+    return generation_;
+  }
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+  /// @brief Bytes mapped for the catalog
+  [[nodiscard]] std::size_t bytes() const noexcept { return bytes_; }
+
+  /// @brief Satellite number of each object, increasing
+  [[nodiscard]] std::span<const std::uint32_t> satellite_numbers()
+      const noexcept {
+    return {satellite_numbers_, size_};
+  }
+  /// @brief SGP4 state of each object
+  [[nodiscard]] std::span<const Sgp4State> states() const noexcept {
+    return {states_, size_};
+  }
+  /// @brief TLE text of object i, as FormatTle writes it
+  [[nodiscard]] std::string_view tle(std::size_t i) const noexcept;
+
+  /// @brief Index of the object with satellite_number
+  [[nodiscard]] std::optional<std::size_t> Find(
+      std::uint32_t satellite_number) const noexcept;
+
+  /// @brief Whether a newer generation was published
+  [[nodiscard]] bool Stale() const noexcept;
+
+  /// @brief Map the latest generation if it is newer, which invalidates
+  /// spans and views of the catalog
+  /// @returns whether a newer generation was mapped
+  bool Refresh();
+
+ private:
+  void Map();
+  void Unmap() noexcept;
+
+  std::string name_;
+  const void *control_ = nullptr;
+  const std::atomic<std::uint64_t> *latest_ = nullptr;
+  const char *data_ = nullptr;
+  std::size_t bytes_ = 0;
+  std::uint64_t generation_ = 0;
+  std::size_t size_ = 0;
+  const std::uint32_t *satellite_numbers_ = nullptr;
+  const Sgp4State *states_ = nullptr;
+  const char *text_ = nullptr;
+};
+}  // namespace eob
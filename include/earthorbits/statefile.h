@@ -0,0 +1,140 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "earthorbits/sgp4.h"
+
+/// Columnar binary files of propagated states.
+///
+/// States are stored in blocks; within a block each of time, object,
+/// position x, y, z and velocity x, y, z is a column of its own. Blocks are
+/// encoded independently and indexed at the end of the file, so a reader
+/// can map the file and decode any block without touching the others.
+///
+/// With StateCodec::kDeltaXor times are stored as varint delta-of-deltas,
+/// a byte per state for a fixed step, and each double is XORed with its
+/// quadratic prediction from the three previous values of the column,
+/// keeping only the bytes that differ. Both are lossless.
+///
+/// Layout, all integers little endian:
+///   header  "EOBSTAT1", u32 codec, u32 0, u64 block size, u64 0
+///   blocks  per column u32 bytes followed by the encoded column
+///   index   per block u64 offset, u64 bytes, u64 states, i64 first time,
+///           i64 last time, times in nanoseconds since 1970
+///   trailer u64 index offset, u64 blocks, "EOBSTEND"
+
+namespace eob {
+enum class StateCodec : std::uint32_t {
+  kRaw = 0,   ///< fixed width columns
+  kDeltaXor,  ///< delta-of-delta times, XOR predicted doubles
+};
+
+struct StateFileOptions {
+  std::size_t block_size = 4096;  ///< states per block
+  StateCodec codec = StateCodec::kDeltaXor;
+  /// encoded blocks are collected and written in writes of about this size
+  std::size_t buffer_bytes = std::size_t{1} << 20;
+};
+
+/// @brief One propagated state of an object
+struct StateRecord {
+  std::chrono::system_clock::time_point time;
+  std::uint32_t object;  ///< e.g. the satellite number
+  TemeState state;
+};
+
+/// @brief Index entry of a block
+struct StateBlockInfo {
+  std::uint64_t offset;
+  std::uint64_t bytes;
+  std::uint64_t states;
+  std::chrono::system_clock::time_point first_time;  ///< earliest state
+  std::chrono::system_clock::time_point last_time;   ///< latest state
+};
+
+/// @brief Writes a state file sequentially
+///
+/// States of any number of objects may be appended in any order, the
+/// encoding works best when consecutive states are of the same object at
+/// a fixed step. Throws MyException<std::string> with the path when the
+/// file can't be written.
+class StateFileWriter {
+ public:
+  StateFileWriter(const std::string &path, const StateFileOptions &options);
+  explicit StateFileWriter(const std::string &path)
+      : StateFileWriter(path, StateFileOptions{}) {}
+  /// @brief Closes the file if Close wasn't called, errors are lost
+  ~StateFileWriter();
+  StateFileWriter(const StateFileWriter &) = delete;
+  StateFileWriter &operator=(const StateFileWriter &) = delete;
+  StateFileWriter(StateFileWriter &&) = delete;
+  StateFileWriter &operator=(StateFileWriter &&) = delete;
+
+  void Append(const StateRecord &record);
+  void Append(std::span<const StateRecord> records);
+
+  /// @brief Write the last block, the index and the trailer
+  void Close();
+
+  [[nodiscard]] std::uint64_t states() const noexcept { return states_; }
+  /// @brief Bytes written so far, the file size after Close
+  [[nodiscard]] std::uint64_t bytes() const noexcept { return bytes_; }
+
+ private:
+  void FlushBlock();
+  void FlushBuffer();
+
+  std::string path_;
+  StateFileOptions options_;
+  std::ofstream file_;
+  bool closed_ = false;
+  std::uint64_t states_ = 0;
+  std::uint64_t bytes_ = 0;
+
+  std::vector<StateRecord> block_;
+  std::vector<char> buffer_;
+  std::vector<StateBlockInfo> index_;
+};
+
+/// @brief Memory maps a state file for random access to its blocks
+///
+/// Throws MyException<std::string> when the file can't be mapped or its
+/// header, index or a block is malformed.
+class StateFileReader {
+ public:
+  explicit StateFileReader(const std::string &path);
+  ~StateFileReader();
+  StateFileReader(const StateFileReader &) = delete;
+  StateFileReader &operator=(const StateFileReader &) = delete;
+  StateFileReader(StateFileReader &&other) noexcept;
+  StateFileReader &operator=(StateFileReader &&other) noexcept;
+
+  [[nodiscard]] StateCodec codec() const noexcept { return codec_; }
+  [[nodiscard]] std::size_t block_count() const noexcept {
+    return index_.size();
+  }
+  [[nodiscard]] std::uint64_t state_count() const noexcept;
+  [[nodiscard]] const StateBlockInfo &block(std::size_t i) const noexcept {
+    return index_[i];
+  }
+
+  /// @brief Decode block i into records, replacing their contents. Throws
+  /// MyException<std::string> if there is no block i or it is malformed.
+  void ReadBlock(std::size_t i, std::vector<StateRecord> &records) const;
+
+ private:
+  void Unmap() noexcept;
+
+  std::string path_;
+  const char *data_ = nullptr;
+  std::size_t size_ = 0;
+  StateCodec codec_ = StateCodec::kRaw;
+  std::vector<StateBlockInfo> index_;
+};
+}  // namespace eob
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ratio>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/eop.h"
+
+/// Time scales beyond the UTC of std::chrono::system_clock.
+///
+/// system_clock, like POSIX time, counts UTC days of 86400 seconds and so
+/// can't represent leap seconds. The clocks here count seconds of their own
+/// scale since 1970-01-01 00:00:00 of that scale:
+///
+///   TAI  atomic time, continuous, ahead of UTC by the leap seconds so far
+///   TT   terrestrial time, TAI + 32.184 s, the argument of ephemerides
+///   UT1  Earth rotation angle as a time, UTC + UT1-UTC from the IERS
+///
+/// Converting from UTC looks TAI-UTC up in a LeapSecondTable in constant
+/// time, conversions between TAI and TT are constexpr. The clocks are
+/// prefixed so as not to clash with std::chrono::tai_clock, which counts
+/// from 1958 and isn't available in every standard library yet.
+///
+///   const auto tai = UtcToTai(system_clock::now());
+///   const double jd_tt = JulianDate(TaiToTt(tai));
+///   const auto gmst = calc_gmst(UtcToUt1(tp, eop));
+
+namespace eob {
+/// @brief International Atomic Time
+struct eob_tai_clock {
+  using rep = std::chrono::system_clock::rep;
+  using period = std::chrono::system_clock::period;
+  using duration = std::chrono::system_clock::duration;
+  using time_point = std::chrono::time_point<eob_tai_clock>;
+  static constexpr bool is_steady = false;
+  /// @brief Now with the embedded leap seconds
+  static time_point now() noexcept;
+};
+
+/// @brief Terrestrial Time
+struct eob_tt_clock {
+  using rep = std::chrono::system_clock::rep;
+  using period = std::chrono::system_clock::period;
+  using duration = std::chrono::system_clock::duration;
+  using time_point = std::chrono::time_point<eob_tt_clock>;
+  static constexpr bool is_steady = false;
+  /// @brief Now with the embedded leap seconds
+  static time_point now() noexcept;
+};
+
+/// @brief Universal Time UT1, no now() since it needs Earth orientation
+/// parameters
+struct eob_ut1_clock {
+  using rep = std::chrono::system_clock::rep;
+  using period = std::chrono::system_clock::period;
+  using duration = std::chrono::system_clock::duration;
+  using time_point = std::chrono::time_point<eob_ut1_clock>;
+  static constexpr bool is_steady = false;
+};
+
+/// @brief TT - TAI, exact by definition
+constexpr std::chrono::milliseconds tt_minus_tai{32184};
+
+[[nodiscard]] constexpr eob_tt_clock::time_point TaiToTt(
+    const eob_tai_clock::time_point &tai) noexcept {
+  return eob_tt_clock::time_point{tai.time_since_epoch() + tt_minus_tai};
+}
+[[nodiscard]] constexpr eob_tai_clock::time_point TtToTai(
+    const eob_tt_clock::time_point &tt) noexcept {
+  return eob_tai_clock::time_point{tt.time_since_epoch() - tt_minus_tai};
+}
+
+/// @brief Clocks counting from 1970-01-01 00:00:00 in their time scale
+template <typename Clock>
+constexpr bool is_time_scale_clock_v =
+    std::is_same_v<Clock, std::chrono::system_clock> ||
+    std::is_same_v<Clock, eob_tai_clock> ||
+    std::is_same_v<Clock, eob_tt_clock> || std::is_same_v<Clock, eob_ut1_clock>;
+
+/// @brief Julian date 1970-01-01 00:00:00
+constexpr double unix_epoch_julian_date = 2440587.5;
+
+/// @brief Julian date in the scale of the clock, e.g. JD(TT) of a TT time
+template <typename Clock, typename Duration>
+  requires is_time_scale_clock_v<Clock>
+[[nodiscard]] constexpr double JulianDate(
+    const std::chrono::time_point<Clock, Duration> &tp) noexcept {
+  return std::chrono::duration<double, std::ratio<86400>>(
+             tp.time_since_epoch())
+             .count() +
+         unix_epoch_julian_date;
+}
+
+/// @brief TAI - UTC takes a new value at 0h UTC of day
+struct LeapSecond {
+  std::chrono::sys_days day;
+  std::chrono::seconds tai_minus_utc;
+};
+
+/// @brief TAI - UTC over time with constant time lookup
+///
+/// Days are cut into buckets of 28 days, each holding the value at its
+/// start and the day and size of the jump in it, so a lookup is a division
+/// and a table read. That requires leap seconds at least 28 days apart,
+/// which they are since the IERS only schedules them at the start of a
+/// month and no month is shorter.
+///
+/// Before the first entry, when UTC still had fractional offsets, the first
+/// value is used.
+class LeapSecondTable {
+ public:
+  /// @brief The leap seconds up to 2017-01-01, TAI - UTC = 37 s, the last
+  /// one announced when this was written
+  LeapSecondTable();
+  /// @param leaps in increasing order of day, at least 28 days apart,
+  /// throws MyException<std::string> otherwise
+  /// @param expires end of validity of the list, if known
+  explicit LeapSecondTable(
+      std::vector<LeapSecond> leaps,
+      std::optional<std::chrono::sys_days> expires = std::nullopt);
+
+  /// @brief The embedded table of the default constructor
+  [[nodiscard]] static const LeapSecondTable &Embedded();
+
+  [[nodiscard]] std::span<const LeapSecond> leaps() const noexcept {
+    return leaps_;
+  }
+  [[nodiscard]] std::optional<std::chrono::sys_days> expires()
+      const noexcept {
+    return expires_;
+  }
+
+  /// @brief TAI - UTC at utc
+  [[nodiscard]] std::chrono::seconds TaiMinusUtc(
+      const std::chrono::system_clock::time_point &utc) const noexcept {
+    using namespace std::chrono;
+    const auto day = floor<days>(utc) - first_day_;
+    if (day.count() < 0) {
+      return seconds{first_};
+    }
+    const auto d = static_cast<std::uint64_t>(day.count());
+    const auto b = d / bucket_days;
+    if (b >= buckets_.size()) {
+      return seconds{last_};
+    }
+    const auto &bucket = buckets_[b];
+    return seconds{d % bucket_days >= bucket.day
+                       ? bucket.before + bucket.step
+                       : bucket.before};
+  }
+
+ private:
+  static constexpr std::uint64_t bucket_days = 28;
+
+  struct Bucket {
+    std::int16_t before;  ///< TAI - UTC at the start of the bucket
+    std::int8_t step;     ///< jump at day
+    std::uint8_t day;     ///< day of the jump, bucket_days if none
+  };
+
+  std::vector<LeapSecond> leaps_;
+  std::optional<std::chrono::sys_days> expires_;
+  std::chrono::sys_days first_day_{};
+  std::int16_t first_ = 0;
+  std::int16_t last_ = 0;
+  std::vector<Bucket> buckets_;
+};
+
+/// @brief Parse the IERS / NIST leap-seconds.list format
+///
+/// Lines are "<NTP seconds> <TAI - UTC>" with '#' comments, "#@ <NTP
+/// seconds>" is the expiry date. Throws MyException<std::string> with the
+/// offending line.
+/// @see https://hpiers.obspm.fr/iers/bul/bulc/ntp/leap-seconds.list
+[[nodiscard]] LeapSecondTable ParseLeapSecondsList(std::string_view text);
+
+/// @brief Read a leap-seconds.list file
+[[nodiscard]] LeapSecondTable LoadLeapSecondTable(const std::string &path);
+
+[[nodiscard]] inline eob_tai_clock::time_point UtcToTai(
+    const std::chrono::system_clock::time_point &utc,
+    const LeapSecondTable &table = LeapSecondTable::Embedded()) noexcept {
+  return eob_tai_clock::time_point{utc.time_since_epoch() +
+                               table.TaiMinusUtc(utc)};
+}
+
+/// @brief UTC of tai, a time in a leap second maps to the last instant
+/// before it, 23:59:59.999999999, as system_clock can't represent 23:59:60
+[[nodiscard]] std::chrono::system_clock::time_point TaiToUtc(
+    const eob_tai_clock::time_point &tai,
+    const LeapSecondTable &table = LeapSecondTable::Embedded()) noexcept;
+
+[[nodiscard]] inline eob_tt_clock::time_point UtcToTt(
+    const std::chrono::system_clock::time_point &utc,
+    const LeapSecondTable &table = LeapSecondTable::Embedded()) noexcept {
+  return TaiToTt(UtcToTai(utc, table));
+}
+
+[[nodiscard]] inline std::chrono::system_clock::time_point TtToUtc(
+    const eob_tt_clock::time_point &tt,
+    const LeapSecondTable &table = LeapSecondTable::Embedded()) noexcept {
+  return TaiToUtc(TtToTai(tt), table);
+}
+
+/// @brief UT1 of utc, UT1 = UTC with an empty table
+[[nodiscard]] eob_ut1_clock::time_point UtcToUt1(
+    const std::chrono::system_clock::time_point &utc,
+    const EopTable &eop) noexcept;
+
+/// @brief UTC of ut1, UT1-UTC changes by milliseconds a day so a second
+/// lookup at the first estimate is exact
+[[nodiscard]] std::chrono::system_clock::time_point Ut1ToUtc(
+    const eob_ut1_clock::time_point &ut1, const EopTable &eop) noexcept;
+
+/// @brief UtcToTai etc. of each element, out has to be the size of in
+void UtcToTai(std::span<const std::chrono::system_clock::time_point> utc,
+              std::span<eob_tai_clock::time_point> tai,
+              const LeapSecondTable &table = LeapSecondTable::Embedded());
+void TaiToUtc(std::span<const eob_tai_clock::time_point> tai,
+              std::span<std::chrono::system_clock::time_point> utc,
+              const LeapSecondTable &table = LeapSecondTable::Embedded());
+void UtcToTt(std::span<const std::chrono::system_clock::time_point> utc,
+             std::span<eob_tt_clock::time_point> tt,
+             const LeapSecondTable &table = LeapSecondTable::Embedded());
+void TtToUtc(std::span<const eob_tt_clock::time_point> tt,
+             std::span<std::chrono::system_clock::time_point> utc,
+             const LeapSecondTable &table = LeapSecondTable::Embedded());
+
+/// @brief Greenwich mean sidereal time at ut1, calc_gmst takes UTC for UT1
+[[nodiscard]] eob_seconds calc_gmst(
+    const eob_ut1_clock::time_point &ut1) noexcept;
+}  // namespace eob
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "earthorbits/parsetle.h"
+
+/// Compressed archives of TLE histories.
+///
+/// Element sets are stored in blocks of a single object ordered by epoch;
+/// within a block each field is a column of its own. Fields with a fixed
+/// number of decimals in TLE text are stored as varint deltas of their
+/// scaled integer, so an update of an element usually takes a byte or
+/// two, and the exponent fields as varint mantissa and exponent. Values
+/// that aren't exactly such decimals are stored XORed with the previous
+/// value of the column instead, so any Tle round trips bit for bit.
+///
+/// Blocks are indexed by satellite number and epoch range at the end of
+/// the file, a reader maps the file and decodes only the blocks of the
+/// object and time it is asked for.
+///
+/// Layout, all integers little endian:
+///   header  "EOBTLEA1", u32 0, u32 0, u64 block size, u64 0
+///   blocks  per column u32 bytes followed by the encoded column
+///   index   per block u32 satellite number, u32 element sets, i64 first
+///           epoch, i64 last epoch, u64 offset, u64 bytes, epochs in
+///           nanoseconds since 1970, sorted by satellite and first epoch
+///   trailer u64 index offset, u64 blocks, "EOBTLEND"
+
+namespace eob {
+struct TleArchiveOptions {
+  std::size_t block_size = 1024;  ///< element sets per block
+  /// element sets held back to fill blocks, above this the blocks of all
+  /// objects are written even if they aren't full
+  std::size_t max_buffered = std::size_t{1} << 20;
+  /// encoded blocks are collected and written in writes of about this size
+  std::size_t buffer_bytes = std::size_t{1} << 20;
+};
+
+/// @brief Index entry of a block
+struct TleBlockInfo {
+  std::uint32_t satellite_number;
+  std::uint32_t records;
+  std::chrono::system_clock::time_point first_epoch;
+  std::chrono::system_clock::time_point last_epoch;
+  std::uint64_t offset;
+  std::uint64_t bytes;
+};
+
+/// @brief Writes a TLE archive
+///
+/// Element sets of any number of objects may be appended in any order,
+/// e.g. catalog after catalog. Throws MyException<std::string> with the
+/// path when the file can't be written and MyException<int> with the
+/// satellite number for a Tle the archive can't hold, e.g. line numbers
+/// other than 1 and 2 or a launch piece of more than three characters.
+class TleArchiveWriter {
+ public:
+  TleArchiveWriter(const std::string &path, const TleArchiveOptions &options);
+  explicit TleArchiveWriter(const std::string &path)
+      : TleArchiveWriter(path, TleArchiveOptions{}) {}
+  /// @brief Closes the file if Close wasn't called, errors are lost
+  ~TleArchiveWriter();
+  TleArchiveWriter(const TleArchiveWriter &) = delete;
+  TleArchiveWriter &operator=(const TleArchiveWriter &) = delete;
+  TleArchiveWriter(TleArchiveWriter &&) = delete;
+  TleArchiveWriter &operator=(TleArchiveWriter &&) = delete;
+
+  void Append(const Tle &tle);
+  void Append(std::span<const Tle> tles);
+
+  /// @brief Write the buffered blocks, the index and the trailer
+  void Close();
+
+  [[nodiscard]] std::uint64_t records() const noexcept { return records_; }
+  /// @brief Bytes written so far, the file size after Close
+  [[nodiscard]] std::uint64_t bytes() const noexcept { return bytes_; }
+
+ private:
+  void FlushBlock(std::uint32_t satellite_number, std::vector<Tle> &tles);
+  void FlushBuffer();
+
+  std::string path_;
+  TleArchiveOptions options_;
+  std::ofstream file_;
+  bool closed_ = false;
+  std::uint64_t records_ = 0;
+  std::uint64_t bytes_ = 0;
+
+  std::map<std::uint32_t, std::vector<Tle>> pending_;
+  std::size_t buffered_ = 0;
+  std::vector<char> buffer_;
+  std::vector<TleBlockInfo> index_;
+};
+
+/// @brief Memory maps a TLE archive for the history of single objects and
+/// scans of all of them
+///
+/// Throws MyException<std::string> when the file can't be mapped or its
+/// header, index or a block is malformed. Const members may be called
+/// from multiple threads.
+class TleArchiveReader {
+ public:
+  explicit TleArchiveReader(const std::string &path);
+  ~TleArchiveReader();
+  TleArchiveReader(const TleArchiveReader &) = delete;
+  TleArchiveReader &operator=(const TleArchiveReader &) = delete;
+  TleArchiveReader(TleArchiveReader &&other) noexcept;
+  TleArchiveReader &operator=(TleArchiveReader &&other) noexcept;
+
+  [[nodiscard]] std::size_t block_count() const noexcept {
+    return index_.size();
+  }
+  [[nodiscard]] std::uint64_t record_count() const noexcept;
+  [[nodiscard]] const TleBlockInfo &block(std::size_t i) const noexcept {
+    return index_[i];
+  }
+
+  /// @brief Satellite numbers in the archive, in increasing order
+  [[nodiscard]] std::vector<std::uint32_t> Objects() const;
+
+  /// @brief Decode block i into tles, replacing their contents
+  void ReadBlock(std::size_t i, std::vector<Tle> &tles) const;
+
+  /// @brief Element sets of an object with epochs in [from, to), ordered
+  /// by epoch, replacing the contents of tles
+  void History(std::uint32_t satellite_number,
+               std::chrono::system_clock::time_point from,
+               std::chrono::system_clock::time_point to,
+               std::vector<Tle> &tles) const;
+
+  /// @brief Call fn with the history of each object, ordered by epoch
+  ///
+  /// Objects are decoded on up to threads threads, 0 for
+  /// std::thread::hardware_concurrency(), and fn is called concurrently
+  /// from them. Rethrows the first exception of fn or a malformed block.
+  void ScanObjects(const std::function<void(std::span<const Tle>)> &fn,
+                   std::size_t threads = 0) const;
+
+ private:
+  /// @brief Append the records of blocks [first, last), which are of one
+  /// object, ordered by epoch
+  void ReadObject(std::size_t first, std::size_t last,
+                  std::vector<Tle> &tles) const;
+  void Unmap() noexcept;
+
+  std::string path_;
+  const char *data_ = nullptr;
+  std::size_t size_ = 0;
+  std::vector<TleBlockInfo> index_;
+};
+}  // namespace eob
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+
+/// Differential correction of TLEs against state vectors.
+///
+/// Finds the mean elements and B* whose SGP4 propagation best matches a set
+/// of observed TEME states in the least squares sense, e.g. to derive a
+/// fresh element set from tracking data or to refit a catalog to states
+/// from a better propagator:
+///
+///   std::vector<TleObservation> observations = ...;
+///   const auto fit = FitTle(last_published, observations);
+///   if (fit.code == TleFitErrc::kOk) {
+///     Publish(fit.tle);
+///   }
+///
+/// Levenberg-Marquardt iterations, the Jacobian is computed by forward
+/// differences, one SGP4 initialization and propagation over all
+/// observations per fitted element, spread over threads.
+
+namespace eob {
+/// @brief Why a fit failed
+enum class TleFitErrc : std::uint8_t {
+  kOk = 0,
+  kTooFewObservations,  ///< fewer residuals than fitted elements
+  kInitialTleInvalid,   ///< InitSgp4 rejects the initial TLE
+  kPropagationFailed,   ///< the initial TLE can't reach every observation
+  kSingular,            ///< the observations don't determine the elements
+  kNotConverged,        ///< max_iterations reached
+};
+
+[[nodiscard]] std::string_view to_string(TleFitErrc errc) noexcept;
+
+/// @brief Observed state at time, TEME like SGP4's output
+struct TleObservation {
+  std::chrono::system_clock::time_point time;
+  TemeState state;
+};
+
+struct TleFitOptions {
+  /// Jacobian evaluations, each costs one propagation per fitted element
+  std::size_t max_iterations = 25;
+  /// done once an iteration reduces the sum of squared residuals by less
+  /// than this fraction
+  double tolerance = 1e-10;
+  /// seconds, velocity residuals are multiplied by it to weigh them
+  /// against position residuals in km, 0 fits positions only
+  double velocity_weight = 100.0;
+  bool fit_bstar = true;
+  /// threads computing Jacobian columns, 0 for
+  /// std::thread::hardware_concurrency(), 1 for the calling thread only
+  std::size_t threads = 0;
+};
+
+struct TleFitResult {
+  /// initial TLE with fitted inclination, RAAN, eccentricity, argument of
+  /// perigee, mean anomaly, mean motion and B*, the epoch and all other
+  /// fields are kept. The last accepted elements if code isn't kOk.
+  Tle tle;
+  TleFitErrc code = TleFitErrc::kOk;
+  std::size_t iterations = 0;
+  /// km, root mean square of the position residuals of tle
+  double position_rms = 0.0;
+};
+
+/// @brief Fit the elements of initial to observations
+///
+/// initial is the starting guess and supplies the epoch, which isn't
+/// fitted. Near the solution convergence is quadratic. Elements a long way
+/// off, e.g. a mean anomaly off by tens of degrees, may end in a local
+/// minimum.
+[[nodiscard]] TleFitResult FitTle(std::span<const TleObservation> observations,
+                                  const Tle &initial,
+                                  const TleFitOptions &options = {});
+
+/// @brief One satellite of a FitTles batch
+struct TleFitProblem {
+  Tle initial;
+  std::vector<TleObservation> observations;
+};
+
+/// @brief FitTle for each problem
+///
+/// Satellites are spread over options.threads threads and each is fitted
+/// on a single thread, which scales better than parallel columns once
+/// there are more satellites than threads.
+/// @returns results[i] belongs to problems[i]
+[[nodiscard]] std::vector<TleFitResult> FitTles(
+    std::span<const TleFitProblem> problems, const TleFitOptions &options = {});
+}  // namespace eob
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "earthorbits/parsetle.h"
+
+namespace eob {
+/// @brief Lazily decoded, non-owning view over the raw text of one TLE
+///
+/// Structural validation (size, line break, character set, line numbers,
+/// classification, checksums and matching satellite numbers) is done once,
+/// when the view is made. Numeric fields are only decoded the first time
+/// they are read and cached afterwards, so filtering a catalog on a couple
+/// of fields doesn't pay for decoding all of them.
+///
+/// The viewed string must outlive the view. Reading a field mutates the
+/// cache, so a single view must not be read from multiple threads at once.
+class TleView {
+ public:
+  TleView() = default;
+
+  /// @brief Validate str and view it
+  /// @throws MyException<std::string> if str fails structural validation
+  explicit TleView(std::string_view str);
+
+  [[nodiscard]] std::string_view str() const noexcept { return str_; }
+
+  /// Accessors below mirror TleLine1 and TleLine2. Those that decode a
+  /// number throw MyException<std::string> if the field is malformed or
+  /// outside of its domain (the same checks ParseTle does).
+  [[nodiscard]] int satellite_number() const {
+    return static_cast<int>(get(TleField::kLine1SatelliteNumber));
+  }
+  [[nodiscard]] char classification() const noexcept;
+  [[nodiscard]] int launch_year() const {
+    return static_cast<int>(get(TleField::kLaunchYear));
+  }
+  [[nodiscard]] int launch_number() const {
+    return static_cast<int>(get(TleField::kLaunchNumber));
+  }
+  [[nodiscard]] std::string_view launch_piece() const noexcept;
+  [[nodiscard]] int epoch_year() const {
+    return static_cast<int>(get(TleField::kEpochYear));
+  }
+  [[nodiscard]] double epoch_day() const { return get(TleField::kEpochDay); }
+  [[nodiscard]] double mean_motion_dot() const {
+    return get(TleField::kMeanMotionDot);
+  }
+  [[nodiscard]] double mean_motion_ddot() const {
+    return get(TleField::kMeanMotionDdot);
+  }
+  [[nodiscard]] double bstar_drag() const { return get(TleField::kBstarDrag); }
+  [[nodiscard]] int ephemeris_type() const {
+    return static_cast<int>(get(TleField::kEphemerisType));
+  }
+  [[nodiscard]] int element_number() const {
+    return static_cast<int>(get(TleField::kElementNumber));
+  }
+  [[nodiscard]] double inclination() const {
+    return get(TleField::kInclination);
+  }
+  [[nodiscard]] double raan() const { return get(TleField::kRaan); }
+  [[nodiscard]] double eccentricity() const {
+    return get(TleField::kEccentricity);
+  }
+  [[nodiscard]] double argument_of_perigree() const {
+    return get(TleField::kArgumentOfPerigree);
+  }
+  [[nodiscard]] double mean_anomaly() const {
+    return get(TleField::kMeanAnomaly);
+  }
+  [[nodiscard]] double mean_motion() const {
+    return get(TleField::kMeanMotion);
+  }
+  [[nodiscard]] int rev_at_epoch() const {
+    return static_cast<int>(get(TleField::kRevAtEpoch));
+  }
+
+  /// @brief Decode (the remaining) fields, same result as ParseTle(str())
+  /// @throws MyException<std::string> if any field is malformed
+  [[nodiscard]] Tle ToTle() const;
+
+ private:
+  friend TleError TryMakeTleView(std::string_view str, TleView &view) noexcept;
+
+  /// @brief Decoded value of a numeric field, decoding it if needed
+  [[nodiscard]] double get(TleField field) const {
+    const auto index = static_cast<std::size_t>(field);
+    if ((decoded_ & (std::uint32_t{1} << index)) == 0) {
+      decode(field);
+    }
+    return values_[index];
+  }
+
+  /// @throws MyException<std::string> if the field can't be decoded
+  void decode(TleField field) const;
+
+  static constexpr std::size_t field_count =
+      static_cast<std::size_t>(TleField::kLine2Checksum) + 1;
+  static_assert(field_count <= 32, "decoded_ needs a bit per field");
+
+  std::string_view str_;
+  /// bit i set once field TleField{i} has been decoded into values_[i],
+  /// integer fields are stored exactly as doubles
+  mutable std::uint32_t decoded_ = 0;
+  mutable std::array<double, field_count> values_{};
+};
+
+/// @brief Non-throwing construction of a TleView
+///
+/// @param view only written to when validation succeeds
+[[nodiscard]] TleError TryMakeTleView(std::string_view str,
+                                      TleView &view) noexcept;
+}  // namespace eob
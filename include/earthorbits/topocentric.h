@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <span>
+
+#include "earthorbits/frames.h"
+
+/// Look angles from ground stations to satellites.
+///
+/// Stations are on the WGS-72 ellipsoid, like everything else derived from
+/// TLEs. Satellites are given in the Earth fixed frame, see TemeToEcef.
+
+namespace eob {
+/// @brief Geodetic coordinates, radians and km above the ellipsoid
+struct Geodetic {
+  double latitude;
+  double longitude;
+  double altitude;
+};
+
+/// @brief Satellite as seen from a station
+struct LookAngles {
+  double azimuth;     ///< radians, clockwise from north, [0, 2 pi)
+  double elevation;   ///< radians above the horizon
+  double range;       ///< km
+  double range_rate;  ///< km/s, positive when receding
+};
+
+[[nodiscard]] std::array<double, 3> GeodeticToEcef(
+    const Geodetic &geodetic) noexcept;
+
+/// @brief Look angles computed from the geodetic coordinates of station
+///
+/// Evaluates the station's position and horizon on every call, for
+/// stations that change from call to call. @see GroundStation
+[[nodiscard]] LookAngles CalcLookAngles(const Geodetic &station,
+                                        const EcefState &satellite) noexcept;
+
+/// @brief A station with its position and horizon precomputed
+///
+/// Pass prediction evaluates the same few stations millions of times, all
+/// trigonometry of the station is done once by the constructor and a look
+/// is a few dot products, a sqrt, an asin and an atan2.
+class GroundStation {
+ public:
+  explicit GroundStation(const Geodetic &geodetic) noexcept;
+
+  [[nodiscard]] const Geodetic &geodetic() const noexcept { return geodetic_; }
+  [[nodiscard]] const std::array<double, 3> &ecef() const noexcept {
+    return ecef_;
+  }
+  /// @brief Unit vectors of the horizon in the Earth fixed frame
+  [[nodiscard]] const std::array<double, 3> &east() const noexcept {
+    return east_;
+  }
+  [[nodiscard]] const std::array<double, 3> &north() const noexcept {
+    return north_;
+  }
+  [[nodiscard]] const std::array<double, 3> &up() const noexcept {
+    return up_;
+  }
+
+  [[nodiscard]] LookAngles Look(const EcefState &satellite) const noexcept;
+
+  /// @brief Look for each satellite, out[i] belongs to satellites[i]
+  void Look(std::span<const EcefState> satellites,
+            std::span<LookAngles> out) const noexcept;
+
+ private:
+  Geodetic geodetic_;
+  std::array<double, 3> ecef_;
+  std::array<double, 3> east_;
+  std::array<double, 3> north_;
+  std::array<double, 3> up_;
+};
+}  // namespace eob
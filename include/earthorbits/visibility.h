@@ -0,0 +1,114 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <vector>
+
+#include "earthorbits/sgp4.h"
+#include "earthorbits/topocentric.h"
+
+/// Precomputed "what is above this station" index.
+///
+/// Time is cut into buckets and for each bucket and station the index
+/// keeps the satellites that can be above the minimum elevation at some
+/// time of the bucket. A query propagates only those candidates:
+///
+///   VisibilityIndex index(states, stations, now);
+///   index.Extend(now + std::chrono::hours(6));
+///   std::vector<VisibleSatellite> above;
+///   if (index.Visible(station, tp, above)) {
+///     ...
+///   }
+///   index.DropBefore(tp);  // as time advances
+///
+/// Candidates are found from the position at the middle of the bucket and
+/// a bound on the distance a satellite moves in the Earth fixed frame in
+/// half a bucket, so no satellite is missed and short buckets give short
+/// candidate lists.
+
+namespace eob {
+struct VisibilityIndexOptions {
+  std::chrono::system_clock::duration bucket = std::chrono::minutes(1);
+  /// radians
+  double min_elevation = 0.0;
+  /// threads computing buckets in Extend, 0 for
+  /// std::thread::hardware_concurrency()
+  std::size_t threads = 0;
+};
+
+struct VisibleSatellite {
+  std::uint32_t satellite;  ///< index into the states of the index
+  LookAngles look;
+};
+
+class VisibilityIndex {
+ public:
+  /// @param start beginning of the first bucket, the window is empty until
+  /// Extend
+  VisibilityIndex(std::vector<Sgp4State> states,
+                  std::vector<GroundStation> stations,
+                  std::chrono::system_clock::time_point start,
+                  const VisibilityIndexOptions &options = {});
+
+  [[nodiscard]] std::span<const Sgp4State> states() const noexcept {
+    return states_;
+  }
+  [[nodiscard]] std::span<const GroundStation> stations() const noexcept {
+    return stations_;
+  }
+  /// @brief The window [start, end) of the buckets
+  [[nodiscard]] std::chrono::system_clock::time_point start() const noexcept {
+    return start_;
+  }
+  [[nodiscard]] std::chrono::system_clock::time_point end() const noexcept {
+    return start_ +
+           options_.bucket * static_cast<std::int64_t>(buckets_.size());
+  }
+  [[nodiscard]] std::size_t bucket_count() const noexcept {
+    return buckets_.size();
+  }
+  /// @brief Heap memory of the index, excluding states and stations
+  [[nodiscard]] std::size_t MemoryBytes() const noexcept;
+
+  /// @brief Add buckets until the window reaches end
+  void Extend(std::chrono::system_clock::time_point end);
+
+  /// @brief Forget the buckets that end at or before tp
+  void DropBefore(std::chrono::system_clock::time_point tp);
+
+  /// @brief Satellites that can be above station during the bucket of tp,
+  /// in increasing order, empty outside the window
+  [[nodiscard]] std::span<const std::uint32_t> Candidates(
+      std::size_t station,
+      std::chrono::system_clock::time_point tp) const noexcept;
+
+  /// @brief Satellites above the minimum elevation of station at tp, in
+  /// increasing order
+  /// @returns false if tp is outside the window, out is empty then
+  [[nodiscard]] bool Visible(std::size_t station,
+                             std::chrono::system_clock::time_point tp,
+                             std::vector<VisibleSatellite> &out) const;
+
+ private:
+  /// @brief Candidates of all stations, those of station s are
+  /// satellites[offsets[s], offsets[s + 1])
+  struct Bucket {
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> satellites;
+  };
+
+  [[nodiscard]] Bucket MakeBucket(
+      std::chrono::system_clock::time_point begin) const;
+
+  std::vector<Sgp4State> states_;
+  std::vector<GroundStation> stations_;
+  /// km/s, bound of the Earth fixed speed of each state
+  std::vector<double> max_speeds_;
+  std::chrono::system_clock::time_point start_;
+  VisibilityIndexOptions options_;
+  std::deque<Bucket> buckets_;
+};
+}  // namespace eob
@@ -0,0 +1,294 @@
+#include "earthorbits/archiveanalytics.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <mutex>
+#include <numbers>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include "constants.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/tlearchive.h"
+
+namespace eob {
+namespace {
+constexpr double deg_to_rad = std::numbers::pi / 180.0;
+
+/// @brief Last values of a series, the oldest is overwritten
+///
+/// Statistics are recomputed over the window rather than kept as running
+/// sums, RAAN residuals carry a bias much larger than their spread that
+/// subtracting sums would cancel. They don't depend on the order of the
+/// values, so the storage is read as is.
+class Window {
+ public:
+  explicit Window(std::size_t capacity) : values_(capacity) {}
+
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+  void Push(double value) noexcept {
+    values_[next_] = value;
+    next_ = next_ + 1 == values_.size() ? 0 : next_ + 1;
+    size_ = std::min(size_ + 1, values_.size());
+  }
+
+  [[nodiscard]] double Mean() const noexcept {
+    double sum = 0.0;
+    for (std::size_t k = 0; k < size_; ++k) {
+      sum += values_[k];
+    }
+    return sum / static_cast<double>(size_);
+  }
+
+  [[nodiscard]] double StdDev(double mean) const noexcept {
+    double sum = 0.0;
+    for (std::size_t k = 0; k < size_; ++k) {
+      sum += (values_[k] - mean) * (values_[k] - mean);
+    }
+    return size_ > 1 ? std::sqrt(sum / static_cast<double>(size_ - 1)) : 0.0;
+  }
+
+  /// @brief Least squares slope against times, a window of the same
+  /// capacity pushed along with this one
+  [[nodiscard]] double Slope(const Window &times) const noexcept {
+    const double mean_t = times.Mean();
+    const double mean_x = Mean();
+    double sxt = 0.0;
+    double stt = 0.0;
+    for (std::size_t k = 0; k < size_; ++k) {
+      const double t = times.values_[k] - mean_t;
+      sxt += t * (values_[k] - mean_x);
+      stt += t * t;
+    }
+    return stt > 0.0 ? sxt / stt : 0.0;
+  }
+
+ private:
+  std::vector<double> values_;
+  std::size_t next_ = 0;
+  std::size_t size_ = 0;
+};
+
+[[nodiscard]] double wrap_to_180(double degrees) noexcept {
+  const double wrapped = std::fmod(degrees + 180.0, 360.0);
+  return (wrapped < 0.0 ? wrapped + 360.0 : wrapped) - 180.0;
+}
+
+/// @brief The compared elements of an orbit, osculating at one time
+struct Osculating {
+  double mean_motion;  ///< revolutions / day
+  double inclination;  ///< degrees
+  double raan;         ///< degrees
+};
+
+/// @brief Osculating elements of teme, false for an unbound orbit
+[[nodiscard]] bool osculating(const TemeState &teme,
+                              Osculating &elements) noexcept {
+  const auto &r = teme.position;
+  const auto &v = teme.velocity;
+  const std::array<double, 3> h{r[1] * v[2] - r[2] * v[1],
+                                r[2] * v[0] - r[0] * v[2],
+                                r[0] * v[1] - r[1] * v[0]};
+  const double v2 = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+  const double a =
+      1.0 / (2.0 / std::hypot(r[0], r[1], r[2]) - v2 / wgs72_mu_km3_per_s2);
+  if (!(a > 0.0)) {
+    return false;
+  }
+  elements.mean_motion = std::sqrt(wgs72_mu_km3_per_s2 / (a * a * a)) *
+                         seconds_per_day / pi2;
+  elements.inclination =
+      std::acos(h[2] / std::hypot(h[0], h[1], h[2])) / deg_to_rad;
+  elements.raan = std::atan2(h[0], -h[1]) / deg_to_rad;
+  return true;
+}
+
+/// @brief Residuals of an element set and the windows they are judged by
+class Analyzer {
+ public:
+  explicit Analyzer(const ArchiveAnalyticsOptions &options)
+      : options_{options},
+        mean_motion_{capacity(options)},
+        inclination_{capacity(options)},
+        raan_{capacity(options)},
+        times_{capacity(options)},
+        mean_motion_dot_{capacity(options)},
+        bstar_{capacity(options)} {}
+
+  void Run(std::span<const Tle> history, std::vector<ArchiveEvent> &events) {
+    if (history.empty()) {
+      return;
+    }
+    const auto start = TleEpoch(history.front().line_1);
+    auto previous_epoch = start;
+    Sgp4State previous;
+    bool previous_ok = InitSgp4(history.front(), previous) == Sgp4Errc::kOk;
+    for (std::size_t k = 1; k < history.size(); ++k) {
+      const auto &tle = history[k];
+      const auto epoch = TleEpoch(tle.line_1);
+      Sgp4State state;
+      const bool ok = InitSgp4(tle, state) == Sgp4Errc::kOk;
+      if (epoch > previous_epoch) {  // else re-published
+        if (ok && previous_ok) {
+          Compare(previous, state, tle, previous_epoch, events);
+        }
+        CheckDecay(tle, Days(epoch - start).count(), previous_epoch, epoch,
+                   events);
+        previous_epoch = epoch;
+      }
+      previous = state;
+      previous_ok = ok;
+    }
+  }
+
+ private:
+  using Days = std::chrono::duration<double, std::chrono::days::period>;
+
+  [[nodiscard]] static std::size_t capacity(
+      const ArchiveAnalyticsOptions &options) noexcept {
+    return std::max<std::size_t>(options.window, 2);
+  }
+
+  /// @brief Residual in window standard deviations, 0 while the window is
+  /// too short to tell
+  [[nodiscard]] double Significance(const Window &window, double residual,
+                                    double floor) const noexcept {
+    if (window.size() < options_.min_window) {
+      return 0.0;
+    }
+    const double mean = window.Mean();
+    return std::abs(residual - mean) / std::max(window.StdDev(mean), floor);
+  }
+
+  /// @brief Compare state, of tle, with previous propagated to its epoch
+  void Compare(const Sgp4State &previous, const Sgp4State &state,
+               const Tle &tle,
+               std::chrono::system_clock::time_point previous_epoch,
+               std::vector<ArchiveEvent> &events) {
+    TemeState teme;
+    Osculating predicted{};
+    if (PropagateSgp4(previous, MinutesSinceEpoch(previous, state.epoch),
+                      teme) != Sgp4Errc::kOk ||
+        !osculating(teme, predicted)) {
+      return;
+    }
+    Osculating actual{};
+    if (PropagateSgp4(state, 0.0, teme) != Sgp4Errc::kOk ||
+        !osculating(teme, actual)) {
+      return;
+    }
+    const double mean_motion = actual.mean_motion - predicted.mean_motion;
+    const double inclination = actual.inclination - predicted.inclination;
+    const double raan = wrap_to_180(actual.raan - predicted.raan);
+    const double plane = raan * std::sin(actual.inclination * deg_to_rad);
+
+    const double sn = Significance(mean_motion_, mean_motion,
+                                   options_.mean_motion_floor);
+    const double si = Significance(inclination_, inclination,
+                                   options_.inclination_floor);
+    const double sr = Significance(raan_, plane, options_.raan_floor);
+    const bool n_jump = sn > options_.threshold;
+    const bool i_jump = si > options_.threshold;
+    const bool r_jump = sr > options_.threshold;
+    if (n_jump || i_jump || r_jump) {
+      events.push_back({.satellite_number = static_cast<std::uint32_t>(
+                            tle.line_1.satellite_number),
+                        .kind = ArchiveEventKind::kManeuver,
+                        .mean_motion_jump = n_jump,
+                        .inclination_jump = i_jump,
+                        .raan_jump = r_jump,
+                        .epoch = state.epoch,
+                        .previous_epoch = previous_epoch,
+                        .mean_motion_residual = mean_motion,
+                        .inclination_residual = inclination,
+                        .raan_residual = raan,
+                        .significance = std::max({sn, si, sr}),
+                        .mean_motion_dot = tle.line_1.mean_motion_dot,
+                        .bstar = tle.line_1.bstar_drag});
+      return;  // an outlier, keep it out of the windows
+    }
+    mean_motion_.Push(mean_motion);
+    inclination_.Push(inclination);
+    raan_.Push(plane);
+  }
+
+  void CheckDecay(const Tle &tle, double days,
+                  std::chrono::system_clock::time_point previous_epoch,
+                  std::chrono::system_clock::time_point epoch,
+                  std::vector<ArchiveEvent> &events) {
+    const auto &l1 = tle.line_1;
+    times_.Push(days);
+    mean_motion_dot_.Push(l1.mean_motion_dot);
+    bstar_.Push(l1.bstar_drag);
+    if (times_.size() < options_.min_window) {
+      return;
+    }
+    const bool decaying =
+        (mean_motion_dot_.Mean() > options_.decay_mean_motion_dot &&
+         mean_motion_dot_.Slope(times_) > 0.0) ||
+        (bstar_.Mean() > options_.decay_bstar && bstar_.Slope(times_) > 0.0);
+    if (decaying && !decaying_) {
+      events.push_back({.satellite_number =
+                            static_cast<std::uint32_t>(l1.satellite_number),
+                        .kind = ArchiveEventKind::kDecay,
+                        .mean_motion_jump = false,
+                        .inclination_jump = false,
+                        .raan_jump = false,
+                        .epoch = epoch,
+                        .previous_epoch = previous_epoch,
+                        .mean_motion_residual = 0.0,
+                        .inclination_residual = 0.0,
+                        .raan_residual = 0.0,
+                        .significance = 0.0,
+                        .mean_motion_dot = l1.mean_motion_dot,
+                        .bstar = l1.bstar_drag});
+    }
+    decaying_ = decaying;
+  }
+
+  ArchiveAnalyticsOptions options_;
+  Window mean_motion_;
+  Window inclination_;
+  Window raan_;  ///< residual times sin(inclination)
+  Window times_;  ///< days since the first epoch
+  Window mean_motion_dot_;
+  Window bstar_;
+  bool decaying_ = false;
+};
+}  // namespace
+
+[[nodiscard]] std::vector<ArchiveEvent> AnalyzeHistory(
+    std::span<const Tle> history, const ArchiveAnalyticsOptions &options) {
+  std::vector<ArchiveEvent> events;
+  Analyzer(options).Run(history, events);
+  return events;
+}
+
+[[nodiscard]] std::vector<ArchiveEvent> AnalyzeArchive(
+    const TleArchiveReader &archive, const ArchiveAnalyticsOptions &options) {
+  std::vector<ArchiveEvent> events;
+  std::mutex events_mutex;
+  archive.ScanObjects(
+      [&](std::span<const Tle> history) {
+        auto found = AnalyzeHistory(history, options);
+        if (!found.empty()) {
+          const std::lock_guard lock(events_mutex);
+          events.insert(events.end(), found.begin(), found.end());
+        }
+      },
+      options.threads);
+  // objects finish in any order
+  std::stable_sort(events.begin(), events.end(),
+                   [](const ArchiveEvent &a, const ArchiveEvent &b) {
+                     return std::tie(a.satellite_number, a.epoch) <
+                            std::tie(b.satellite_number, b.epoch);
+                   });
+  return events;
+}
+}  // namespace eob
@@ -0,0 +1,266 @@
+#include "earthorbits/asyncpropagator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "earthorbits/earthorbits.h"
+
+namespace eob {
+namespace async_detail {
+/// @brief Worker threads taking work from one FIFO queue
+struct Executor {
+  explicit Executor(std::size_t threads) {
+    workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+      workers.emplace_back([this] { Work(); });
+    }
+  }
+
+  ~Executor() {
+    {
+      const std::lock_guard lock(mutex);
+      stopping = true;
+    }
+    ready.notify_all();
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  Executor(const Executor &) = delete;
+  Executor &operator=(const Executor &) = delete;
+  Executor(Executor &&) = delete;
+  Executor &operator=(Executor &&) = delete;
+
+  void Post(std::function<void()> work) {
+    {
+      const std::lock_guard lock(mutex);
+      queue.push_back(std::move(work));
+    }
+    ready.notify_one();
+  }
+
+  /// @brief Run work until stopping and the queue is empty, work may post
+  /// more work while stopping
+  void Work() {
+    while (true) {
+      std::function<void()> work;
+      {
+        std::unique_lock lock(mutex);
+        ready.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+          return;
+        }
+        work = std::move(queue.front());
+        queue.pop_front();
+      }
+      work();
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable ready;
+  std::deque<std::function<void()>> queue;
+  bool stopping = false;
+  std::vector<std::thread> workers;
+};
+
+/// @brief A submitted request and the chunks it delivered but that weren't
+/// taken yet
+struct Job {
+  /// only used while chunks are queued or running, ~Executor runs its queue
+  /// dry first, so the executor outlives every use even if the stream
+  /// outlives the AsyncPropagator
+  Executor *executor = nullptr;
+  PropagationRequest request;
+  std::size_t chunks_per_step = 0;
+  std::size_t chunk_count = 0;
+  std::atomic<std::size_t> next_chunk = 0;
+  std::atomic<bool> cancelled = false;
+
+  std::mutex mutex;
+  std::deque<PropagationChunk> ready;
+  std::size_t workers = 0;  ///< chunks queued or running
+  bool finished = false;
+  std::coroutine_handle<> waiter;
+
+  /// @brief Wake the awaiting coroutine, if any, on the executor. Called
+  /// with mutex locked.
+  void Wake() {
+    if (waiter) {
+      executor->Post([handle = std::exchange(waiter, nullptr)] {
+        handle.resume();
+      });
+    }
+  }
+
+  void Deliver(PropagationChunk &&chunk) {
+    const std::lock_guard lock(mutex);
+    if (!cancelled.load(std::memory_order_relaxed)) {
+      ready.push_back(std::move(chunk));
+      Wake();
+    }
+  }
+
+  void WorkerDone() {
+    const std::lock_guard lock(mutex);
+    if (--workers == 0) {
+      finished = true;
+      Wake();
+    }
+  }
+};
+
+namespace {
+[[nodiscard]] PropagationChunk propagate_chunk(const Job &job,
+                                               std::size_t index) {
+  const auto &request = job.request;
+  PropagationChunk chunk;
+  chunk.step = index / job.chunks_per_step;
+  chunk.time = request.start +
+               request.step * static_cast<std::int64_t>(chunk.step);
+  chunk.first_state = (index % job.chunks_per_step) * request.chunk_size;
+  const auto count = std::min(request.chunk_size,
+                              request.states.size() - chunk.first_state);
+  chunk.teme.resize(count);
+  chunk.errors.resize(count);
+  PropagateSgp4(std::span(request.states).subspan(chunk.first_state, count),
+                chunk.time, chunk.teme, chunk.errors);
+  return chunk;
+}
+
+/// @brief Propagate the next chunk of job, then queue the next one behind
+/// whatever other jobs queued in the meantime
+void run_chunk(const std::shared_ptr<Job> &job) {
+  const auto index = job->next_chunk.fetch_add(1, std::memory_order_relaxed);
+  if (index >= job->chunk_count ||
+      job->cancelled.load(std::memory_order_relaxed)) {
+    job->WorkerDone();
+    return;
+  }
+  job->Deliver(propagate_chunk(*job, index));
+  job->executor->Post([job] { run_chunk(job); });
+}
+}  // namespace
+}  // namespace async_detail
+
+[[nodiscard]] bool PropagationStream::NextAwaiter::await_ready()
+    const noexcept {
+  if (job_ == nullptr) {
+    return true;
+  }
+  const std::lock_guard lock(job_->mutex);
+  return !job_->ready.empty() || job_->finished;
+}
+
+[[nodiscard]] bool PropagationStream::NextAwaiter::await_suspend(
+    std::coroutine_handle<> handle) const {
+  const std::lock_guard lock(job_->mutex);
+  if (!job_->ready.empty() || job_->finished) {
+    return false;
+  }
+  job_->waiter = handle;
+  return true;
+}
+
+[[nodiscard]] std::optional<PropagationChunk>
+PropagationStream::NextAwaiter::await_resume() const {
+  if (job_ == nullptr) {
+    return std::nullopt;
+  }
+  const std::lock_guard lock(job_->mutex);
+  if (job_->ready.empty()) {
+    return std::nullopt;
+  }
+  auto chunk = std::move(job_->ready.front());
+  job_->ready.pop_front();
+  return chunk;
+}
+
+PropagationStream::PropagationStream(
+    std::shared_ptr<async_detail::Job> job) noexcept
+    : job_{std::move(job)} {}
+
+PropagationStream::~PropagationStream() { Cancel(); }
+
+PropagationStream &PropagationStream::operator=(
+    PropagationStream &&other) noexcept {
+  if (this != &other) {
+    Cancel();
+    job_ = std::move(other.job_);
+  }
+  return *this;
+}
+
+void PropagationStream::Cancel() noexcept {
+  if (!job_) {
+    return;
+  }
+  job_->cancelled.store(true, std::memory_order_relaxed);
+  const std::lock_guard lock(job_->mutex);
+  job_->ready.clear();
+}
+
+[[nodiscard]] bool PropagationStream::cancelled() const noexcept {
+  return job_ && job_->cancelled.load(std::memory_order_relaxed);
+}
+
+[[nodiscard]] std::size_t PropagationStream::chunk_count() const noexcept {
+  return job_ ? job_->chunk_count : 0;
+}
+
+AsyncPropagator::AsyncPropagator(std::size_t threads)
+    : executor_{std::make_unique<async_detail::Executor>(
+          threads > 0 ? threads
+                      : std::max<std::size_t>(
+                            std::thread::hardware_concurrency(), 1))} {}
+
+AsyncPropagator::~AsyncPropagator() = default;
+
+[[nodiscard]] PropagationStream AsyncPropagator::Submit(
+    PropagationRequest request) {
+  if (request.chunk_size == 0) {
+    throw MyException<std::string>("chunk_size must be positive", "0");
+  }
+  if (request.steps > 1 &&
+      request.step <= std::chrono::system_clock::duration::zero()) {
+    throw MyException<std::string>("step must be positive",
+                                   std::to_string(request.step.count()));
+  }
+
+  auto job = std::make_shared<async_detail::Job>();
+  job->executor = executor_.get();
+  job->chunks_per_step = (request.states.size() + request.chunk_size - 1) /
+                         request.chunk_size;
+  job->chunk_count = job->chunks_per_step * request.steps;
+  job->request = std::move(request);
+
+  // as many chunks in flight as there are workers, so a lone job uses them
+  // all and concurrent jobs take turns
+  const auto workers = std::min(job->chunk_count, threads());
+  job->workers = workers;
+  job->finished = workers == 0;
+  for (std::size_t i = 0; i < workers; ++i) {
+    executor_->Post([job] { async_detail::run_chunk(job); });
+  }
+  return PropagationStream(std::move(job));
+}
+
+[[nodiscard]] std::size_t AsyncPropagator::threads() const noexcept {
+  return executor_->workers.size();
+}
+}  // namespace eob
@@ -0,0 +1,241 @@
+#include "earthorbits/catalogindex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "constants.h"
+#include "earthorbits/earthorbits.h"
+
+namespace eob {
+namespace {
+/// GEO altitude, km, and allowed deviation for the kGeo regime
+constexpr double geo_altitude = 35786.0;
+constexpr double geo_band = 500.0;
+constexpr double leo_max_apogee_altitude = 2000.0;
+constexpr double heo_min_eccentricity = 0.25;
+
+/// With fewer candidate rows than size / sparse_ratio the candidates are
+/// checked directly instead of intersecting full bitsets
+constexpr std::size_t sparse_ratio = 32;
+
+[[nodiscard]] constexpr OrbitRegime classify(double eccentricity,
+                                             double perigee_altitude,
+                                             double apogee_altitude) noexcept {
+  if (eccentricity >= heo_min_eccentricity) {
+    return OrbitRegime::kHeo;
+  }
+  if (apogee_altitude < leo_max_apogee_altitude) {
+    return OrbitRegime::kLeo;
+  }
+  if (geo_altitude - geo_band <= perigee_altitude &&
+      apogee_altitude <= geo_altitude + geo_band) {
+    return OrbitRegime::kGeo;
+  }
+  if (apogee_altitude < geo_altitude - geo_band) {
+    return OrbitRegime::kMeo;
+  }
+  return OrbitRegime::kOther;
+}
+
+[[nodiscard]] constexpr bool contains(ValueRange range,
+                                      double value) noexcept {
+  return range.min <= value && value <= range.max;
+}
+}  // namespace
+
+[[nodiscard]] OrbitSummary SummarizeOrbit(const TleLine2 &line_2) noexcept {
+  // Kepler's third law, a^3 = mu / n^2 with n in radians per second
+  const double n = line_2.mean_motion * pi2 / seconds_per_day;
+  const double a = std::cbrt(wgs72_mu_km3_per_s2 / (n * n));
+  const double e = line_2.eccentricity;
+  const double perigee = a * (1.0 - e) - wgs72_earth_radius_km;
+  const double apogee = a * (1.0 + e) - wgs72_earth_radius_km;
+  return OrbitSummary{
+      .semi_major_axis = a,
+      .perigee_altitude = perigee,
+      .apogee_altitude = apogee,
+      .inclination = line_2.inclination,
+      .regime = classify(e, perigee, apogee),
+  };
+}
+
+[[nodiscard]] std::size_t CatalogBitset::Count() const noexcept {
+  std::size_t count = 0;
+  for (auto word : words_) {
+    count += static_cast<std::size_t>(std::popcount(word));
+  }
+  return count;
+}
+
+CatalogBitset &CatalogBitset::operator&=(const CatalogBitset &other) noexcept {
+  for (std::size_t i = 0; i < words_.size(); ++i) {
+    words_[i] &= other.words_[i];
+  }
+  return *this;
+}
+
+[[nodiscard]] std::vector<std::size_t> CatalogBitset::Rows() const {
+  std::vector<std::size_t> rows;
+  rows.reserve(Count());
+  ForEach([&rows](std::size_t row) { rows.push_back(row); });
+  return rows;
+}
+
+CatalogIndex::CatalogIndex(std::span<const Tle> catalog)
+    : regime_(catalog.size()) {
+  const auto size = catalog.size();
+  if (size > std::numeric_limits<std::uint32_t>::max()) {
+    throw MyException<std::size_t>("catalog too large to index", size);
+  }
+
+  for (auto &column : values_) {
+    column.resize(size);
+  }
+  for (auto &rows : regime_rows_) {
+    rows = CatalogBitset(size);
+  }
+
+  for (std::size_t row = 0; row < size; ++row) {
+    const auto summary = SummarizeOrbit(catalog[row].line_2);
+    values_[kSemiMajorAxis][row] = summary.semi_major_axis;
+    values_[kPerigeeAltitude][row] = summary.perigee_altitude;
+    values_[kApogeeAltitude][row] = summary.apogee_altitude;
+    values_[kInclination][row] = summary.inclination;
+    regime_[row] = summary.regime;
+    regime_rows_[static_cast<std::size_t>(summary.regime)].Set(row);
+  }
+
+  for (std::size_t r = 0; r < orbit_regime_count; ++r) {
+    regime_counts_[r] = regime_rows_[r].Count();
+  }
+
+  std::vector<std::uint32_t> order(size);
+  for (std::size_t c = 0; c < kColumnCount; ++c) {
+    const auto &values = values_[c];
+    std::iota(order.begin(), order.end(), std::uint32_t{0});
+    std::sort(order.begin(), order.end(),
+              [&values](std::uint32_t lhs, std::uint32_t rhs) {
+                return values[lhs] < values[rhs];
+              });
+
+    auto &sorted = sorted_[c];
+    sorted.rows = order;
+    sorted.values.resize(size);
+    std::transform(order.begin(), order.end(), sorted.values.begin(),
+                   [&values](std::uint32_t row) { return values[row]; });
+  }
+}
+
+[[nodiscard]] OrbitSummary CatalogIndex::summary(
+    std::size_t row) const noexcept {
+  return OrbitSummary{
+      .semi_major_axis = values_[kSemiMajorAxis][row],
+      .perigee_altitude = values_[kPerigeeAltitude][row],
+      .apogee_altitude = values_[kApogeeAltitude][row],
+      .inclination = values_[kInclination][row],
+      .regime = regime_[row],
+  };
+}
+
+[[nodiscard]] CatalogIndex::Selection CatalogIndex::Select(
+    Column column, ValueRange range) const {
+  const auto &values = sorted_[column].values;
+  const auto first =
+      std::lower_bound(values.begin(), values.end(), range.min);
+  const auto last = std::upper_bound(first, values.end(), range.max);
+  return Selection{
+      .column = column,
+      .first = static_cast<std::size_t>(first - values.begin()),
+      .last = static_cast<std::size_t>(std::max(first, last) - values.begin()),
+  };
+}
+
+[[nodiscard]] CatalogBitset CatalogIndex::Query(
+    const CatalogQuery &query) const {
+  const std::array<std::optional<ValueRange>, kColumnCount> ranges{
+      query.semi_major_axis, query.perigee_altitude, query.apogee_altitude,
+      query.inclination};
+
+  // inactive columns select "everything" so they sort behind active ones
+  std::array<Selection, kColumnCount> selections{};
+  std::size_t selection_count = 0;
+  for (std::size_t c = 0; c < kColumnCount; ++c) {
+    const auto column = static_cast<Column>(c);
+    if (ranges[c]) {
+      selections[c] = Select(column, *ranges[c]);
+      ++selection_count;
+    } else {
+      selections[c] =
+          Selection{.column = column,
+                    .first = 0,
+                    .last = std::numeric_limits<std::size_t>::max()};
+    }
+  }
+  std::sort(selections.begin(), selections.end(),
+            [](const Selection &lhs, const Selection &rhs) {
+              return lhs.last - lhs.first < rhs.last - rhs.first;
+            });
+  const std::span<const Selection> active(selections.data(), selection_count);
+
+  const auto regime_index =
+      query.regime ? static_cast<std::size_t>(*query.regime) : 0;
+  const auto regime_count = query.regime
+                                ? regime_counts_[regime_index]
+                                : std::numeric_limits<std::size_t>::max();
+
+  CatalogBitset result(size());
+
+  // Few candidates: check the other predicates row by row
+  if (!active.empty()) {
+    const auto &driver = active.front();
+    const auto candidates = driver.last - driver.first;
+    if (candidates <= regime_count && candidates * sparse_ratio <= size()) {
+      const auto &rows = sorted_[driver.column].rows;
+      for (std::size_t i = driver.first; i < driver.last; ++i) {
+        const auto row = rows[i];
+        bool match = !query.regime || regime_[row] == *query.regime;
+        for (const auto &other : active.subspan(1)) {
+          match = match && contains(*ranges[other.column],
+                                    values_[other.column][row]);
+        }
+        if (match) {
+          result.Set(row);
+        }
+      }
+      return result;
+    }
+  }
+
+  // Many candidates: intersect one bitset per predicate
+  if (query.regime) {
+    result = regime_rows_[regime_index];
+  } else if (!active.empty()) {
+    const auto &driver = active.front();
+    const auto &rows = sorted_[driver.column].rows;
+    for (std::size_t i = driver.first; i < driver.last; ++i) {
+      result.Set(rows[i]);
+    }
+  } else {
+    for (std::size_t row = 0; row < size(); ++row) {
+      result.Set(row);
+    }
+    return result;
+  }
+
+  for (const auto &selection : active.subspan(query.regime ? 0 : 1)) {
+    CatalogBitset rows_in_range(size());
+    const auto &rows = sorted_[selection.column].rows;
+    for (std::size_t i = selection.first; i < selection.last; ++i) {
+      rows_in_range.Set(rows[i]);
+    }
+    result &= rows_in_range;
+  }
+  return result;
+}
+}  // namespace eob
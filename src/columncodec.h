@@ -0,0 +1,164 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "earthorbits/earthorbits.h"
+
+/// Little endian, varint and XOR encodings shared by the columnar file
+/// formats, see statefile.h and tlearchive.h.
+
+namespace eob {
+/// control byte of an XOR value of zero, see put_xor
+constexpr std::uint8_t xor_zero = 0x80;
+
+template <typename T>
+void put_le(std::vector<char> &out, T value) {
+  using U = std::make_unsigned_t<
+      std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>>;
+  auto bits = std::bit_cast<U>(value);
+  for (std::size_t i = 0; i < sizeof(U); ++i) {
+    out.push_back(static_cast<char>(bits & 0xff));
+    bits >>= 8;
+  }
+}
+
+inline void put_varint(std::vector<char> &out, std::uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+[[nodiscard]] inline std::uint64_t zigzag(std::int64_t value) noexcept {
+  return (static_cast<std::uint64_t>(value) << 1) ^
+         static_cast<std::uint64_t>(value >> 63);
+}
+
+[[nodiscard]] inline std::int64_t unzigzag(std::uint64_t value) noexcept {
+  return static_cast<std::int64_t>(value >> 1) ^
+         -static_cast<std::int64_t>(value & 1);
+}
+
+/// @brief A value XORed with its prediction, as a control byte holding the
+/// number of leading zero bytes in the high and trailing zero bytes in the
+/// low nibble, followed by the bytes in between
+inline void put_xor(std::vector<char> &out, std::uint64_t bits) {
+  if (bits == 0) {
+    out.push_back(static_cast<char>(xor_zero));
+    return;
+  }
+  const auto leading = std::countl_zero(bits) / 8;
+  const auto trailing = std::countr_zero(bits) / 8;
+  out.push_back(static_cast<char>((leading << 4) | trailing));
+  bits >>= 8 * trailing;
+  for (int b = 0; b < 8 - leading - trailing; ++b) {
+    out.push_back(static_cast<char>(bits & 0xff));
+    bits >>= 8;
+  }
+}
+
+/// @brief Append a column as its byte count followed by what encode wrote
+template <typename F>
+void put_column(std::vector<char> &out, F &&encode) {
+  const auto start = out.size();
+  put_le(out, std::uint32_t{0});
+  encode(out);
+  const auto bytes = static_cast<std::uint32_t>(out.size() - start - 4);
+  for (std::size_t i = 0; i < 4; ++i) {
+    out[start + i] = static_cast<char>((bytes >> (8 * i)) & 0xff);
+  }
+}
+
+/// @brief Bounds checked reads from a mapped file
+///
+/// Reads past the end throw MyException<std::string>(what, path).
+class Cursor {
+ public:
+  Cursor(const char *begin, const char *end, std::string_view what,
+         const std::string &path) noexcept
+      : p_{begin}, end_{end}, what_{what}, path_{&path} {}
+
+  [[nodiscard]] bool done() const noexcept { return p_ == end_; }
+
+  [[nodiscard]] Cursor Take(std::size_t n) {
+    Require(n);
+    Cursor sub{p_, p_ + n, what_, *path_};
+    p_ += n;
+    return sub;
+  }
+
+  [[nodiscard]] std::string_view Bytes(std::size_t n) {
+    Require(n);
+    std::string_view s{p_, n};
+    p_ += n;
+    return s;
+  }
+
+  template <typename T>
+  [[nodiscard]] T Le() {
+    using U = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+    Require(sizeof(U));
+    U bits = 0;
+    for (std::size_t i = sizeof(U); i-- > 0;) {
+      bits = (bits << 8) | static_cast<std::uint8_t>(p_[i]);
+    }
+    p_ += sizeof(U);
+    return std::bit_cast<T>(bits);
+  }
+
+  [[nodiscard]] std::uint64_t Varint() {
+    std::uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      Require(1);
+      const auto byte = static_cast<std::uint8_t>(*p_++);
+      value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    Fail();
+  }
+
+  /// @brief Inverse of put_xor
+  [[nodiscard]] std::uint64_t Xor() {
+    const auto control = static_cast<std::uint8_t>(Bytes(1)[0]);
+    if (control == xor_zero) {
+      return 0;
+    }
+    const int leading = control >> 4;
+    const int trailing = control & 0x0f;
+    if (leading + trailing >= 8) {
+      Fail();
+    }
+    const auto bytes = Bytes(static_cast<std::size_t>(8 - leading - trailing));
+    std::uint64_t bits = 0;
+    for (auto it = bytes.rbegin(); it != bytes.rend(); ++it) {
+      bits = (bits << 8) | static_cast<std::uint8_t>(*it);
+    }
+    return bits << (8 * trailing);
+  }
+
+  [[noreturn]] void Fail() const {
+    throw MyException<std::string>(std::string(what_), *path_);
+  }
+
+ private:
+  void Require(std::size_t n) const {
+    if (static_cast<std::size_t>(end_ - p_) < n) {
+      Fail();
+    }
+  }
+
+  const char *p_;
+  const char *end_;
+  std::string_view what_;
+  const std::string *path_;
+};
+}  // namespace eob
@@ -10,4 +10,14 @@ constexpr double hours_per_day = 24;
 constexpr double seconds_per_hour = 3600;
 constexpr double seconds_per_day = seconds_per_hour * hours_per_day;
 constexpr double ms_per_day = 1000 * seconds_per_day;
+constexpr double minutes_per_day = 60 * hours_per_day;
+
+/// @brief WGS-72 Earth equatorial radius, km. SGP4 and the TLE mean
+/// elements are defined with WGS-72 so it is used throughout.
+/// @see https://celestrak.org/publications/AIAA/2006-6753/
+constexpr double wgs72_earth_radius_km = 6378.135;
+/// @brief WGS-72 flattening of the Earth ellipsoid
+constexpr double wgs72_flattening = 1.0 / 298.26;
+/// @brief WGS-72 Earth gravitational parameter, km^3 / s^2
+constexpr double wgs72_mu_km3_per_s2 = 398600.8;
 }  // namespace eob
@@ -0,0 +1,254 @@
+#include "earthorbits/coverage.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <vector>
+
+#include "constants.h"
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/sgp4.h"
+#include "parallel.h"
+
+namespace eob {
+namespace {
+constexpr double deg_to_rad = std::numbers::pi / 180.0;
+constexpr std::uint32_t never = std::numeric_limits<std::uint32_t>::max();
+
+/// @brief Statistics of a cell over a contiguous range of samples, in
+/// sample indices
+struct Accumulator {
+  std::uint32_t first = never;  ///< first sample in view
+  std::uint32_t last = never;   ///< last sample in view
+  std::uint32_t samples = 0;
+  std::uint32_t passes = 0;
+  std::uint32_t max_gap = 0;
+  std::uint32_t gap_sum = 0;  ///< at most the number of samples
+};
+
+/// @brief Record that the cell is in view at sample, once per sample
+void add_sample(Accumulator &a, std::uint32_t sample) noexcept {
+  if (a.last == sample) {
+    return;  // another satellite already covers the cell
+  }
+  if (a.last == never) {
+    a.first = sample;
+    a.passes = 1;
+  } else if (a.last + 1 != sample) {
+    const auto gap = sample - a.last;
+    a.max_gap = std::max(a.max_gap, gap);
+    a.gap_sum += gap;
+    ++a.passes;
+  }
+  a.last = sample;
+  ++a.samples;
+}
+
+/// @brief Append later, the statistics of the samples after those of a
+void merge(Accumulator &a, const Accumulator &later) noexcept {
+  if (later.last == never) {
+    return;
+  }
+  if (a.last == never) {
+    a = later;
+    return;
+  }
+  a.passes += later.passes;
+  if (a.last + 1 == later.first) {
+    --a.passes;  // one pass across the boundary
+  } else {
+    const auto gap = later.first - a.last;
+    a.max_gap = std::max(a.max_gap, gap);
+    a.gap_sum += gap;
+  }
+  a.max_gap = std::max(a.max_gap, later.max_gap);
+  a.gap_sum += later.gap_sum;
+  a.samples += later.samples;
+  a.last = later.last;
+}
+
+/// @brief Grid geometry used for every footprint
+struct GridTables {
+  double resolution;  ///< radians
+  std::vector<double> sin_latitude;
+  std::vector<double> cos_latitude;
+};
+
+/// @brief add_sample for each cell of grid within radius (Earth central
+/// angle) of the sub-satellite point
+void add_footprint(const CoverageGrid &grid, const GridTables &tables,
+                   double latitude, double longitude, double radius,
+                   std::uint32_t sample, std::span<Accumulator> cells) {
+  const double res = tables.resolution;
+  const auto rows = static_cast<std::ptrdiff_t>(grid.rows());
+  const auto cols = static_cast<std::ptrdiff_t>(grid.cols());
+  const double half_pi = std::numbers::pi / 2.0;
+
+  // rows with centers within radius in latitude
+  const auto row_lo = std::max<std::ptrdiff_t>(
+      0, static_cast<std::ptrdiff_t>(
+             std::ceil((latitude - radius + half_pi) / res - 0.5)));
+  const auto row_hi = std::min<std::ptrdiff_t>(
+      rows - 1, static_cast<std::ptrdiff_t>(
+                    std::floor((latitude + radius + half_pi) / res - 0.5)));
+
+  const double sin_sat = std::sin(latitude);
+  const double cos_sat = std::cos(latitude);
+  const double cos_radius = std::cos(radius);
+  for (auto row = row_lo; row <= row_hi; ++row) {
+    const auto r = static_cast<std::size_t>(row);
+    // spherical law of cosines solved for the longitude difference
+    const double denominator = tables.cos_latitude[r] * cos_sat;
+    const double c = denominator > 1e-12
+                         ? (cos_radius - tables.sin_latitude[r] * sin_sat) /
+                               denominator
+                         : -1.0;
+    if (c > 1.0) {
+      continue;
+    }
+    std::ptrdiff_t col_lo = 0;
+    std::ptrdiff_t col_hi = cols - 1;
+    if (c > -1.0) {
+      const double width = std::acos(c);
+      col_lo = static_cast<std::ptrdiff_t>(std::ceil(
+          (longitude - width + std::numbers::pi) / res - 0.5));
+      col_hi = static_cast<std::ptrdiff_t>(std::floor(
+          (longitude + width + std::numbers::pi) / res - 0.5));
+      if (col_hi - col_lo + 1 >= cols) {
+        col_lo = 0;
+        col_hi = cols - 1;
+      }
+    }
+    if (col_hi < col_lo) {
+      continue;
+    }
+    // at most two contiguous runs once wrapped around the date line
+    auto *row_cells = cells.data() + r * grid.cols();
+    const auto first = (col_lo % cols + cols) % cols;
+    const auto count = col_hi - col_lo + 1;
+    const auto run = std::min(count, cols - first);
+    for (auto col = first; col < first + run; ++col) {
+      add_sample(row_cells[col], sample);
+    }
+    for (std::ptrdiff_t col = 0; col < count - run; ++col) {
+      add_sample(row_cells[col], sample);
+    }
+  }
+}
+
+/// @brief Accumulate samples [begin, end) of options into cells
+void cover_samples(std::span<const Sgp4State> states, const CoverageGrid &grid,
+                   const GridTables &tables, const CoverageOptions &options,
+                   std::size_t begin, std::size_t end,
+                   std::span<Accumulator> cells) {
+  for (std::size_t i = begin; i < end; ++i) {
+    const auto tp = options.start + options.step * static_cast<std::int64_t>(i);
+    const double gmst = calc_gmst(tp).count() * pi2 / seconds_per_day;
+    TemeState teme;
+    for (const auto &state : states) {
+      if (PropagateSgp4(state, MinutesSinceEpoch(state, tp), teme) !=
+          Sgp4Errc::kOk) {
+        continue;
+      }
+      const auto &p = teme.position;
+      const double r = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+      const double radius =
+          FootprintRadius(r - wgs72_earth_radius_km, options.min_elevation);
+      if (radius <= 0.0) {
+        continue;
+      }
+      double longitude = std::atan2(p[1], p[0]) - gmst;
+      if (longitude < -std::numbers::pi) {
+        longitude += pi2;
+      }
+      add_footprint(grid, tables, std::asin(p[2] / r), longitude, radius,
+                    static_cast<std::uint32_t>(i), cells);
+    }
+  }
+}
+}  // namespace
+
+[[nodiscard]] double FootprintRadius(double altitude,
+                                     double min_elevation) noexcept {
+  if (altitude <= 0.0) {
+    return 0.0;
+  }
+  const double c = wgs72_earth_radius_km /
+                   (wgs72_earth_radius_km + altitude) *
+                   std::cos(min_elevation);
+  return std::max(0.0, std::acos(std::min(c, 1.0)) - min_elevation);
+}
+
+CoverageGrid::CoverageGrid(double resolution) : resolution_{resolution} {
+  const double rows = 180.0 / resolution;
+  if (!(resolution > 0.0) || std::abs(rows - std::round(rows)) > 1e-9 * rows) {
+    throw MyException<double>("resolution has to divide 180 degrees",
+                              resolution);
+  }
+  rows_ = static_cast<std::size_t>(std::round(rows));
+}
+
+[[nodiscard]] double CoverageGrid::latitude(std::size_t row) const noexcept {
+  return (-90.0 + (static_cast<double>(row) + 0.5) * resolution_) * deg_to_rad;
+}
+
+[[nodiscard]] double CoverageGrid::longitude(std::size_t col) const noexcept {
+  return (-180.0 + (static_cast<double>(col) + 0.5) * resolution_) *
+         deg_to_rad;
+}
+
+[[nodiscard]] std::vector<CellCoverage> CalcCoverage(
+    std::span<const Sgp4State> states, const CoverageGrid &grid,
+    const CoverageOptions &options) {
+  if (options.samples >= never) {
+    throw MyException<std::size_t>("too many coverage samples",
+                                   options.samples);
+  }
+  GridTables tables{.resolution = grid.resolution() * deg_to_rad,
+                    .sin_latitude = {},
+                    .cos_latitude = {}};
+  for (std::size_t row = 0; row < grid.rows(); ++row) {
+    tables.sin_latitude.push_back(std::sin(grid.latitude(row)));
+    tables.cos_latitude.push_back(std::cos(grid.latitude(row)));
+  }
+
+  // one contiguous range of samples per thread, merged in time order
+  const std::size_t chunks =
+      std::max<std::size_t>(
+          1, std::min(resolve_threads(options.threads), options.samples));
+  std::vector<std::vector<Accumulator>> partial(chunks);
+  parallel_for(chunks, chunks, [&](std::size_t k) {
+    partial[k].resize(grid.size());
+    cover_samples(states, grid, tables, options,
+                  options.samples * k / chunks,
+                  options.samples * (k + 1) / chunks, partial[k]);
+  });
+  auto &total = partial[0];
+  for (std::size_t k = 1; k < chunks; ++k) {
+    for (std::size_t c = 0; c < total.size(); ++c) {
+      merge(total[c], partial[k][c]);
+    }
+    partial[k] = {};
+  }
+
+  std::vector<CellCoverage> cells(grid.size());
+  for (std::size_t c = 0; c < cells.size(); ++c) {
+    const auto &a = total[c];
+    cells[c].samples_in_view = a.samples;
+    cells[c].passes = a.passes;
+    cells[c].max_revisit_gap =
+        options.step * static_cast<std::int64_t>(a.max_gap);
+    if (a.passes > 1) {
+      cells[c].mean_revisit_gap = options.step *
+                                  static_cast<std::int64_t>(a.gap_sum) /
+                                  static_cast<std::int64_t>(a.passes - 1);
+    }
+  }
+  return cells;
+}
+}  // namespace eob
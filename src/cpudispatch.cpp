@@ -0,0 +1,71 @@
+#include "earthorbits/cpudispatch.h"
+
+#include <atomic>
+#include <initializer_list>
+#include <string_view>
+
+#include "dispatch.h"
+
+namespace eob {
+namespace {
+[[nodiscard]] bool cpu_supports(Isa isa) noexcept {
+#if defined(EOB_HAVE_ISA_VARIANTS)
+  // CPUID, and XGETBV for the OS saving the wider registers
+  __builtin_cpu_init();
+  switch (isa) {
+    case Isa::kBaseline:
+      return true;
+    case Isa::kAvx2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case Isa::kAvx512:
+      return cpu_supports(Isa::kAvx2) && __builtin_cpu_supports("avx512f") &&
+             __builtin_cpu_supports("avx512dq") &&
+             __builtin_cpu_supports("avx512vl");
+  }
+  return false;
+#else
+  return isa == Isa::kBaseline;
+#endif
+}
+
+[[nodiscard]] std::atomic<Isa> &active_isa() noexcept {
+  static std::atomic<Isa> isa{DetectIsa()};
+  return isa;
+}
+}  // namespace
+
+[[nodiscard]] std::string_view to_string(Isa isa) noexcept {
+  switch (isa) {
+    case Isa::kBaseline:
+      return "baseline";
+    case Isa::kAvx2:
+      return "avx2";
+    case Isa::kAvx512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+[[nodiscard]] bool IsaSupported(Isa isa) noexcept { return cpu_supports(isa); }
+
+[[nodiscard]] Isa DetectIsa() noexcept {
+  for (const auto isa : {Isa::kAvx512, Isa::kAvx2}) {
+    if (cpu_supports(isa)) {
+      return isa;
+    }
+  }
+  return Isa::kBaseline;
+}
+
+[[nodiscard]] Isa ActiveIsa() noexcept {
+  return active_isa().load(std::memory_order_relaxed);
+}
+
+bool SetIsa(Isa isa) noexcept {
+  if (!IsaSupported(isa)) {
+    return false;
+  }
+  active_isa().store(isa, std::memory_order_relaxed);
+  return true;
+}
+}  // namespace eob
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "earthorbits/cpudispatch.h"
+
+/// Runs a kernel with the variant for ActiveIsa().
+///
+/// The variants are template functions with a target attribute that
+/// flatten, i.e. inline everything they call, so the kernel and the
+/// helpers it calls are compiled for that instruction set. Kernels are
+/// lambdas local to a translation unit, so every instantiation is too and
+/// no inline function compiled for a newer instruction set can be picked
+/// by the linker for a caller compiled for an older one.
+///
+///   void Kernel(std::span<const double> in, std::span<double> out) {
+///     dispatch([&] { kernel_impl(in, out); });
+///   }
+
+#if defined(EOB_ENABLE_ISA_DISPATCH) && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define EOB_HAVE_ISA_VARIANTS 1
+#endif
+
+namespace eob {
+namespace dispatch_detail {
+#if defined(EOB_HAVE_ISA_VARIANTS)
+template <typename F>
+[[gnu::target("avx2,fma"), gnu::flatten]] void run_avx2(F &kernel) {
+  kernel();
+}
+
+template <typename F>
+[[gnu::target("avx512f,avx512dq,avx512vl,avx2,fma"), gnu::flatten]] void
+run_avx512(F &kernel) {
+  kernel();
+}
+#endif
+
+template <typename F>
+[[gnu::flatten]] void run_baseline(F &kernel) {
+  kernel();
+}
+}  // namespace dispatch_detail
+
+template <typename F>
+void dispatch(F &&kernel) {
+#if defined(EOB_HAVE_ISA_VARIANTS)
+  switch (ActiveIsa()) {
+    case Isa::kAvx512:
+      dispatch_detail::run_avx512(kernel);
+      return;
+    case Isa::kAvx2:
+      dispatch_detail::run_avx2(kernel);
+      return;
+    case Isa::kBaseline:
+      break;
+  }
+#endif
+  dispatch_detail::run_baseline(kernel);
+}
+}  // namespace eob
@@ -2,13 +2,15 @@
 
 #include <fmt/core.h>
 
+#include <array>
 #include <chrono>
 #include <ctime>
 #include <string>
 
 #include "constants.h"
 #include "date/date.h"
-#include "eobmath.h"
+#include "earthorbits/eobmath.h"
+#include "earthorbits/instrumentation.h"
 
 namespace eob {
 namespace {
@@ -28,9 +30,9 @@ namespace {
 /// To get current julian date/day:
 /// @see https://aa.usno.navy.mil/data/JulianDate
 ///
-/// Tu variable below is really days since Jan 1, 2000 UT1, however,
-/// I am using UTC time.
-/// TODO Investigate importance of UT1-UTC corrections
+/// Tu variable below is days since Jan 1, 2000 UT1. tp is taken as UT1,
+/// callers that have UT1-UTC pass UT1 through calc_gmst(tp, EopTable) or
+/// calc_gmst(eob_ut1_clock::time_point), plain UTC is off by up to 0.9 s.
 /// @see
 /// https://crf.usno.navy.mil/global-solutions-eop?pageid=vlbi-analysis-center
 /// @see https://celestrak.org/SpaceData/
@@ -39,7 +41,7 @@ namespace {
 /// needed to to Earth's nutation. Precession is accounted for however.
 /// @see https://lweb.cfa.harvard.edu/~jzhao/times.html
 ///
-/// @returns Greenwich mean sidereal angle, seconds, at midnight UT1 (UTC?)
+/// @returns Greenwich mean sidereal angle, seconds, at midnight UT1
 [[nodiscard]] double calc_gmst_0h(
     const std::chrono::time_point<std::chrono::system_clock> &tp) noexcept {
   using namespace date;
@@ -62,6 +64,7 @@ namespace {
 
 [[nodiscard]] std::string to_string(
     const std::chrono::time_point<std::chrono::system_clock> &tp) {
+  EOB_SCOPED_TIMER(Probe::kFormat);
   using namespace std::chrono;
 
   std::array<char, std::size("yyyy-mm-ddTHH:MM:SS")> ymd_hms{};
@@ -80,18 +83,13 @@ namespace {
 
 [[nodiscard]] eob_seconds calc_gmst(
     const std::chrono::time_point<std::chrono::system_clock> &tp) noexcept {
+  EOB_SCOPED_TIMER(Probe::kCalcGmst);
   auto tp_0h = std::chrono::floor<std::chrono::days>(tp);
   auto gmst_0h = calc_gmst_0h(tp_0h);
 
   std::chrono::duration<double, std::chrono::seconds::period> delta_s =
       (tp - tp_0h);
 
-  /// @brief Rotation of Earth, radians per second
-  /// @see https://celestrak.org/columns/v02n01/
-  constexpr double earth_rotation_rad_per_s = 7.29211510e-5;
-  constexpr double earth_rotation =
-      earth_rotation_rad_per_s * seconds_per_day / pi2;
-
-  return eob_seconds{wrap_to_86400(gmst_0h + earth_rotation * delta_s.count())};
+  return eob_seconds{wrap_to_86400(gmst_0h + gmst_rate * delta_s.count())};
 }
 }  // namespace eob
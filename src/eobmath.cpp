@@ -0,0 +1,290 @@
+#include "earthorbits/eobmath.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+
+#include "constants.h"
+#include "dispatch.h"
+
+namespace eob {
+namespace {
+/// 1.5 * 2^52, adding and subtracting it rounds to the nearest integer for
+/// |x| < 2^51 and leaves the integer in the low bits of the sum
+constexpr double round_magic = 6755399441055744.0;
+
+/// pi / 2 split into two 33 bit parts and the rest, n * part is exact for
+/// |n| < 2^20
+constexpr double pio2_1 = 1.57079632673412561417e+00;
+constexpr double pio2_2 = 6.07710050630396597660e-11;
+constexpr double pio2_2t = 2.02226624879595063154e-21;
+constexpr double two_over_pi = 6.36619772367581382433e-01;
+/// |n| < 2^20 for the reduction above
+constexpr double sincos_limit = 1.0e6;
+
+/// Minimax polynomials for sin and cos on [-pi/4, pi/4]
+/// @see fdlibm k_sin.c and k_cos.c
+constexpr double s1 = -1.66666666666666324348e-01;
+constexpr double s2 = 8.33333333332248946124e-03;
+constexpr double s3 = -1.98412698298579493134e-04;
+constexpr double s4 = 2.75573137070700676789e-06;
+constexpr double s5 = -2.50507602534068634195e-08;
+constexpr double s6 = 1.58969099521155010221e-10;
+constexpr double c1 = 4.16666666666666019037e-02;
+constexpr double c2 = -1.38888888888741095749e-03;
+constexpr double c3 = 2.48015872894767294178e-05;
+constexpr double c4 = -2.75573143513906633035e-07;
+constexpr double c5 = 2.08757232129817482790e-09;
+constexpr double c6 = -1.13596475577881948265e-11;
+
+/// Rational approximation of atan on [-0.21, 0.66] and the bits of pi / 2
+/// beyond double precision
+/// @see Cephes atan.c
+constexpr double atan_p0 = -8.750608600031904122785e-01;
+constexpr double atan_p1 = -1.615753718733365076637e+01;
+constexpr double atan_p2 = -7.500855792314704667340e+01;
+constexpr double atan_p3 = -1.228866684490136173410e+02;
+constexpr double atan_p4 = -6.485021904942025371773e+01;
+constexpr double atan_q0 = 2.485846490142306297962e+01;
+constexpr double atan_q1 = 1.650270098316988542046e+02;
+constexpr double atan_q2 = 4.328810604912902668951e+02;
+constexpr double atan_q3 = 4.853903996359136964868e+02;
+constexpr double atan_q4 = 1.945506571482613964425e+02;
+constexpr double pio2_lo = 6.123233995736765886130e-17;
+
+/// Newton iterations of the batched Kepler solver, enough to converge to
+/// double precision for e <= 0.99 from the starter in kepler_start
+constexpr int kepler_iterations = 8;
+constexpr std::size_t kepler_tile = 256;
+
+/// @brief x rounded to the nearest integer for |x| < 2^51 without a libm
+/// call
+[[nodiscard]] inline double round_fast(double x) noexcept {
+  return (x + round_magic) - round_magic;
+}
+
+/// @brief x + y if x is negative, else x
+///
+/// Selects with a mask from the sign bit rather than a comparison, which
+/// compilers don't turn into vector code while floating point exceptions
+/// have to be preserved. Adding 0.0 turns -0.0 into 0.0.
+[[nodiscard]] inline double add_if_negative(double x, double y) noexcept {
+  const auto sign = std::bit_cast<std::uint64_t>(x + 0.0) >> 63;
+  return x +
+         std::bit_cast<double>(std::bit_cast<std::uint64_t>(y) & (0 - sign));
+}
+
+struct SinCos {
+  double sin;
+  double cos;
+};
+
+/// @brief sin and cos for |x| <= sincos_limit, branch free
+[[nodiscard]] inline SinCos sincos_kernel(double x) noexcept {
+  const double shifted = x * two_over_pi + round_magic;
+  const double n = shifted - round_magic;
+  const double r = ((x - n * pio2_1) - n * pio2_2) - n * pio2_2t;
+  const double z = r * r;
+  const double s =
+      r + r * z * (s1 + z * (s2 + z * (s3 + z * (s4 + z * (s5 + z * s6)))));
+  const double c =
+      1.0 - 0.5 * z +
+      z * z * (c1 + z * (c2 + z * (c3 + z * (c4 + z * (c5 + z * c6)))));
+
+  // quadrant from the low bits of n, swap sin and cos in odd quadrants and
+  // flip signs with bit operations so all lanes take the same path
+  const auto q = std::bit_cast<std::uint64_t>(shifted);
+  const std::uint64_t swap = 0 - (q & 1);
+  const auto s_bits = std::bit_cast<std::uint64_t>(s);
+  const auto c_bits = std::bit_cast<std::uint64_t>(c);
+  const std::uint64_t sin_bits = ((s_bits & ~swap) | (c_bits & swap)) ^
+                                 ((q & 2) << 62);
+  const std::uint64_t cos_bits = ((c_bits & ~swap) | (s_bits & swap)) ^
+                                 (((q + 1) & 2) << 62);
+  return {std::bit_cast<double>(sin_bits), std::bit_cast<double>(cos_bits)};
+}
+
+/// @brief All ones if x is negative, including -0.0, else 0
+[[nodiscard]] inline std::uint64_t negative_mask(double x) noexcept {
+  return 0 - (std::bit_cast<std::uint64_t>(x) >> 63);
+}
+
+/// @brief a where mask is set, else b
+[[nodiscard]] inline double select(std::uint64_t mask, double a,
+                                   double b) noexcept {
+  return std::bit_cast<double>((std::bit_cast<std::uint64_t>(a) & mask) |
+                               (std::bit_cast<std::uint64_t>(b) & ~mask));
+}
+
+/// @brief atan2 branch free, selecting with masks like add_if_negative
+[[nodiscard]] inline double atan2_kernel(double y, double x) noexcept {
+  constexpr std::uint64_t sign = std::uint64_t{1} << 63;
+  const double ax = std::bit_cast<double>(std::bit_cast<std::uint64_t>(x) &
+                                          ~sign);
+  const double ay = std::bit_cast<double>(std::bit_cast<std::uint64_t>(y) &
+                                          ~sign);
+  // atan(t) of t = min / max in [0, 1], reduced by atan(t) = pi / 4 +
+  // atan((t - 1) / (t + 1)) above 0.66
+  const auto swap = negative_mask(ax - ay);
+  const double t = select(swap, ax, ay) /
+                   (select(swap, ay, ax) + std::numeric_limits<double>::min());
+  const auto high = negative_mask(0.66 - t);
+  const double u = select(high, (t - 1.0) / (t + 1.0), t);
+  const double z = u * u;
+  const double p =
+      z * ((((atan_p0 * z + atan_p1) * z + atan_p2) * z + atan_p3) * z +
+           atan_p4) /
+      (((((z + atan_q0) * z + atan_q1) * z + atan_q2) * z + atan_q3) * z +
+       atan_q4);
+  double a = select(high, std::numbers::pi / 4.0, 0.0) +
+             ((u * p + u) + select(high, 0.5 * pio2_lo, 0.0));
+  // back to the octant and quadrant of (x, y)
+  a = select(swap, (std::numbers::pi / 2.0 - a) + pio2_lo, a);
+  a = select(negative_mask(x), (std::numbers::pi - a) + 2.0 * pio2_lo, a);
+  return std::bit_cast<double>(std::bit_cast<std::uint64_t>(a) ^
+                               (std::bit_cast<std::uint64_t>(y) & sign));
+}
+
+/// @brief M wrapped to [-pi, pi] and the starting E of Danby
+[[nodiscard]] inline double kepler_start(double mean_anomaly,
+                                         double eccentricity,
+                                         double &wrapped) noexcept {
+  wrapped = mean_anomaly - pi2 * round_fast(mean_anomaly / pi2);
+  return wrapped + std::copysign(0.85 * eccentricity, wrapped);
+}
+
+/// @brief E in [-pi - e, pi + e] moved to [0, 2 pi]
+[[nodiscard]] inline double kepler_wrap(double e_anomaly) noexcept {
+  return add_if_negative(e_anomaly, pi2);
+}
+
+void wrap(std::span<const double> in, std::span<double> out,
+          double period) noexcept {
+  const auto n = std::min(in.size(), out.size());
+  for (std::size_t i = 0; i < n; ++i) {
+    // to [-period / 2, period / 2] and then up
+    out[i] = add_if_negative(in[i] - period * round_fast(in[i] / period),
+                             period);
+  }
+}
+
+void sincos_batch(std::span<const double> angles, std::span<double> sines,
+                  std::span<double> cosines) noexcept {
+  const auto n = std::min({angles.size(), sines.size(), cosines.size()});
+  // the bits of non-negative doubles order like their values, the sign of
+  // limit - |angle| flags larger angles, infinities and NaN
+  constexpr auto limit_bits = std::bit_cast<std::uint64_t>(sincos_limit);
+  std::uint64_t over = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto abs_bits =
+        std::bit_cast<std::uint64_t>(angles[i]) & ~(std::uint64_t{1} << 63);
+    over |= limit_bits - abs_bits;
+  }
+  if ((over >> 63) != 0) {  // rare, keeps the loop below free of branches
+    for (std::size_t i = 0; i < n; ++i) {
+      const double angle = angles[i];
+      if (std::abs(angle) <= sincos_limit) {
+        const auto sc = sincos_kernel(angle);
+        sines[i] = sc.sin;
+        cosines[i] = sc.cos;
+      } else {
+        sines[i] = std::sin(angle);
+        cosines[i] = std::cos(angle);
+      }
+    }
+    return;
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto sc = sincos_kernel(angles[i]);
+    sines[i] = sc.sin;
+    cosines[i] = sc.cos;
+  }
+}
+
+void atan2_batch(std::span<const double> y, std::span<const double> x,
+                 std::span<double> angles) noexcept {
+  const auto n = std::min({y.size(), x.size(), angles.size()});
+  for (std::size_t i = 0; i < n; ++i) {
+    angles[i] = atan2_kernel(y[i], x[i]);
+  }
+}
+
+void solve_kepler_batch(std::span<const double> mean_anomalies,
+                        std::span<const double> eccentricities,
+                        std::span<double> eccentric_anomalies) noexcept {
+  const auto n = std::min({mean_anomalies.size(), eccentricities.size(),
+                           eccentric_anomalies.size()});
+  // iterations in passes over tiles, each pass is a loop the compiler can
+  // vectorize and the tile stays in L1
+  std::array<double, kepler_tile> m{};
+  std::array<double, kepler_tile> e{};
+  std::array<double, kepler_tile> e_anomaly{};
+  for (std::size_t first = 0; first < n; first += kepler_tile) {
+    const auto size = std::min(kepler_tile, n - first);
+    for (std::size_t i = 0; i < size; ++i) {
+      e[i] = eccentricities[first + i];
+      e_anomaly[i] = kepler_start(mean_anomalies[first + i], e[i], m[i]);
+    }
+    for (int k = 0; k < kepler_iterations; ++k) {
+      for (std::size_t i = 0; i < size; ++i) {
+        const auto sc = sincos_kernel(e_anomaly[i]);
+        e_anomaly[i] -=
+            (e_anomaly[i] - e[i] * sc.sin - m[i]) / (1.0 - e[i] * sc.cos);
+      }
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      eccentric_anomalies[first + i] = kepler_wrap(e_anomaly[i]);
+    }
+  }
+}
+}  // namespace
+
+[[nodiscard]] double solve_kepler(double mean_anomaly,
+                                  double eccentricity) noexcept {
+  double m = 0.0;
+  double e_anomaly = kepler_start(mean_anomaly, eccentricity, m);
+  for (int i = 0; i < 50; ++i) {
+    const double delta = (e_anomaly - eccentricity * std::sin(e_anomaly) - m) /
+                         (1.0 - eccentricity * std::cos(e_anomaly));
+    e_anomaly -= delta;
+    if (std::abs(delta) < 1.0e-15) {
+      break;
+    }
+  }
+  return kepler_wrap(e_anomaly);
+}
+
+void wrap_to_2pi(std::span<const double> angles,
+                 std::span<double> wrapped) noexcept {
+  dispatch([&] { wrap(angles, wrapped, pi2); });
+}
+
+void wrap_to_86400(std::span<const double> seconds,
+                   std::span<double> wrapped) noexcept {
+  dispatch([&] { wrap(seconds, wrapped, seconds_per_day); });
+}
+
+void sincos(std::span<const double> angles, std::span<double> sines,
+            std::span<double> cosines) noexcept {
+  dispatch([&] { sincos_batch(angles, sines, cosines); });
+}
+
+void atan2(std::span<const double> y, std::span<const double> x,
+           std::span<double> angles) noexcept {
+  dispatch([&] { atan2_batch(y, x, angles); });
+}
+
+void solve_kepler(std::span<const double> mean_anomalies,
+                  std::span<const double> eccentricities,
+                  std::span<double> eccentric_anomalies) noexcept {
+  dispatch([&] {
+    solve_kepler_batch(mean_anomalies, eccentricities, eccentric_anomalies);
+  });
+}
+}  // namespace eob
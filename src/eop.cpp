@@ -0,0 +1,229 @@
+#include "earthorbits/eop.h"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/timescales.h"
+
+namespace eob {
+namespace {
+/// MJD of 1970-01-01
+constexpr int unix_epoch_mjd = 40587;
+
+[[nodiscard]] std::string_view trim(std::string_view s) noexcept {
+  while (!s.empty() && (s.front() == ' ' || s.front() == '\r')) {
+    s.remove_prefix(1);
+  }
+  while (!s.empty() && (s.back() == ' ' || s.back() == '\r')) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+/// @brief false unless all of s, ignoring surrounding blanks, is a number
+[[nodiscard]] bool parse_number(std::string_view s, double &value) noexcept {
+  s = trim(s);
+  if (!s.empty() && s.front() == '+') {
+    s.remove_prefix(1);
+  }
+  const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+  return ec == std::errc() && ptr == s.data() + s.size() && !s.empty();
+}
+
+/// @brief Call f(line) for each line of text
+template <typename F>
+void for_each_line(std::string_view text, F &&f) {
+  while (!text.empty()) {
+    const auto end = text.find('\n');
+    f(text.substr(0, end));
+    if (end == std::string_view::npos) {
+      break;
+    }
+    text.remove_prefix(end + 1);
+  }
+}
+
+/// @brief Collects parsed days, which have to be consecutive
+class TableBuilder {
+ public:
+  void Add(int mjd, const EopValues &values, std::string_view line) {
+    if (days_.empty()) {
+      first_mjd_ = mjd;
+    } else if (mjd != first_mjd_ + static_cast<int>(days_.size())) {
+      throw MyException<std::string>(
+          fmt::format("EOP days are not consecutive, expected MJD {}",
+                      first_mjd_ + static_cast<int>(days_.size())),
+          std::string(line));
+    }
+    days_.push_back(values);
+  }
+
+  [[nodiscard]] EopTable Build() const { return EopTable(first_mjd_, days_); }
+
+ private:
+  int first_mjd_ = 0;
+  std::vector<EopValues> days_;
+};
+}  // namespace
+
+EopTable::EopTable(int first_mjd, const std::vector<EopValues> &days)
+    : first_mjd_{first_mjd} {
+  days_.reserve(days.size());
+  for (const auto &d : days) {
+    days_.push_back(Day{static_cast<float>(d.ut1_utc),
+                        static_cast<float>(d.x_pole),
+                        static_cast<float>(d.y_pole)});
+  }
+}
+
+[[nodiscard]] EopValues EopTable::Interpolate(
+    const std::chrono::system_clock::time_point &tp) const noexcept {
+  if (days_.empty()) {
+    return {};
+  }
+  const std::chrono::duration<double, std::chrono::days::period> unix_days =
+      tp.time_since_epoch();
+  const double offset =
+      unix_days.count() + static_cast<double>(unix_epoch_mjd - first_mjd_);
+  if (!(offset > 0.0)) {
+    const auto &d = days_.front();
+    return {d.ut1_utc, d.x_pole, d.y_pole};
+  }
+  const auto i = static_cast<std::size_t>(offset);
+  if (i + 1 >= days_.size()) {
+    const auto &d = days_.back();
+    return {d.ut1_utc, d.x_pole, d.y_pole};
+  }
+
+  const auto &a = days_[i];
+  const auto &b = days_[i + 1];
+  const double f = offset - static_cast<double>(i);
+  double ut1_step = static_cast<double>(b.ut1_utc) - a.ut1_utc;
+  if (ut1_step > 0.5) {  // leap second
+    ut1_step -= 1.0;
+  } else if (ut1_step < -0.5) {
+    ut1_step += 1.0;
+  }
+  return {
+      .ut1_utc = a.ut1_utc + f * ut1_step,
+      .x_pole = a.x_pole + f * (static_cast<double>(b.x_pole) - a.x_pole),
+      .y_pole = a.y_pole + f * (static_cast<double>(b.y_pole) - a.y_pole),
+  };
+}
+
+[[nodiscard]] EopTable ParseFinals2000A(std::string_view text) {
+  TableBuilder builder;
+  for_each_line(text, [&builder](std::string_view line) {
+    if (trim(line).empty()) {
+      return;
+    }
+    // 1-based columns: 8-15 MJD, 19-27 PM-x, 38-46 PM-y, 59-68 UT1-UTC
+    if (line.size() < 68 || trim(line.substr(58, 10)).empty()) {
+      return;  // beyond the predictions
+    }
+    double mjd = 0.0;
+    EopValues values;
+    if (!parse_number(line.substr(7, 8), mjd) ||
+        !parse_number(line.substr(18, 9), values.x_pole) ||
+        !parse_number(line.substr(37, 9), values.y_pole) ||
+        !parse_number(line.substr(58, 10), values.ut1_utc)) {
+      throw MyException<std::string>("malformed finals2000A line",
+                                     std::string(line));
+    }
+    builder.Add(static_cast<int>(mjd), values, line);
+  });
+  return builder.Build();
+}
+
+[[nodiscard]] EopTable ParseCelestrakEop(std::string_view text) {
+  TableBuilder builder;
+  std::size_t mjd_column = SIZE_MAX;
+  std::size_t x_column = SIZE_MAX;
+  std::size_t y_column = SIZE_MAX;
+  std::size_t ut1_column = SIZE_MAX;
+  bool header = true;
+
+  for_each_line(text, [&](std::string_view line) {
+    line = trim(line);
+    if (line.empty()) {
+      return;
+    }
+    std::vector<std::string_view> fields;
+    for (std::size_t start = 0;;) {
+      const auto end = line.find(',', start);
+      fields.push_back(trim(line.substr(start, end - start)));
+      if (end == std::string_view::npos) {
+        break;
+      }
+      start = end + 1;
+    }
+
+    if (header) {
+      for (std::size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i] == "MJD") {
+          mjd_column = i;
+        } else if (fields[i] == "X") {
+          x_column = i;
+        } else if (fields[i] == "Y") {
+          y_column = i;
+        } else if (fields[i] == "UT1-UTC") {
+          ut1_column = i;
+        }
+      }
+      if (mjd_column == SIZE_MAX || x_column == SIZE_MAX ||
+          y_column == SIZE_MAX || ut1_column == SIZE_MAX) {
+        throw MyException<std::string>(
+            "EOP CSV header lacks MJD, X, Y or UT1-UTC", std::string(line));
+      }
+      header = false;
+      return;
+    }
+
+    double mjd = 0.0;
+    EopValues values;
+    if (fields.size() <=
+            std::max({mjd_column, x_column, y_column, ut1_column}) ||
+        !parse_number(fields[mjd_column], mjd) ||
+        !parse_number(fields[x_column], values.x_pole) ||
+        !parse_number(fields[y_column], values.y_pole) ||
+        !parse_number(fields[ut1_column], values.ut1_utc)) {
+      throw MyException<std::string>("malformed EOP CSV line",
+                                     std::string(line));
+    }
+    builder.Add(static_cast<int>(mjd), values, line);
+  });
+  return builder.Build();
+}
+
+[[nodiscard]] EopTable LoadEopTable(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw MyException<std::string>("failed to open EOP file", path);
+  }
+  std::stringstream ss;
+  ss << file.rdbuf();
+  const auto text = ss.str();
+  if (text.starts_with("DATE,")) {
+    return ParseCelestrakEop(text);
+  }
+  return ParseFinals2000A(text);
+}
+
+[[nodiscard]] eob_seconds calc_gmst(
+    const std::chrono::time_point<std::chrono::system_clock> &tp,
+    const EopTable &eop) noexcept {
+  return calc_gmst(UtcToUt1(tp, eop));
+}
+}  // namespace eob
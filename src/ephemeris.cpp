@@ -0,0 +1,280 @@
+#include "earthorbits/ephemeris.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <numbers>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "earthorbits/earthorbits.h"
+
+namespace eob {
+namespace {
+constexpr std::size_t components = 6;
+constexpr int max_degree = 64;
+/// beyond this the coefficients take gigabytes, far more than any window
+/// a TLE is good for needs
+constexpr double max_segment_count = 1 << 24;
+constexpr std::string_view ephemeris_magic = "EOBCHEB1";
+
+using Components = std::array<double, components>;
+
+[[nodiscard]] Components to_components(const TemeState &teme) noexcept {
+  return {teme.position[0], teme.position[1], teme.position[2],
+          teme.velocity[0], teme.velocity[1], teme.velocity[2]};
+}
+
+/// @brief Clenshaw recurrence of the 6 component series at x in [-1, 1]
+[[nodiscard]] Components clenshaw(const double *c, int degree,
+                                  double x) noexcept {
+  Components b1{};
+  Components b2{};
+  const double two_x = 2.0 * x;
+  for (int j = degree; j >= 1; --j) {
+    const double *cj = c + static_cast<std::size_t>(j) * components;
+    for (std::size_t i = 0; i < components; ++i) {
+      const double b0 = cj[i] + two_x * b1[i] - b2[i];
+      b2[i] = b1[i];
+      b1[i] = b0;
+    }
+  }
+  Components result{};
+  for (std::size_t i = 0; i < components; ++i) {
+    result[i] = c[i] + x * b1[i] - b2[i];
+  }
+  return result;
+}
+
+struct FitResult {
+  Sgp4Errc errc = Sgp4Errc::kOk;
+  double max_position_error = 0.0;
+  double max_velocity_error = 0.0;
+};
+
+/// @brief Fit count segments of length minutes starting at first
+///
+/// Interpolates at the Chebyshev nodes of each segment, then measures the
+/// error at the extrema of the polynomial, which lie in between the nodes.
+[[nodiscard]] FitResult fit_segments(const Sgp4State &state, double first,
+                                     double minutes, std::size_t count,
+                                     int degree,
+                                     std::vector<double> &coefficients) {
+  const auto n = static_cast<std::size_t>(degree) + 1;
+  const double half = 0.5 * minutes;
+  coefficients.assign(count * n * components, 0.0);
+
+  std::vector<Components> values(n);
+  FitResult result;
+  TemeState teme;
+  for (std::size_t s = 0; s < count; ++s) {
+    const double center = first + (static_cast<double>(s) + 0.5) * minutes;
+    double *c = coefficients.data() + s * n * components;
+
+    for (std::size_t k = 0; k < n; ++k) {
+      const double theta =
+          std::numbers::pi * (static_cast<double>(k) + 0.5) /
+          static_cast<double>(n);
+      result.errc = PropagateSgp4(state, center + half * std::cos(theta), teme);
+      if (result.errc != Sgp4Errc::kOk) {
+        return result;
+      }
+      values[k] = to_components(teme);
+    }
+    for (std::size_t j = 0; j < n; ++j) {
+      const double scale = (j == 0 ? 1.0 : 2.0) / static_cast<double>(n);
+      for (std::size_t k = 0; k < n; ++k) {
+        const double t = std::cos(std::numbers::pi * static_cast<double>(j) *
+                                  (static_cast<double>(k) + 0.5) /
+                                  static_cast<double>(n));
+        for (std::size_t i = 0; i < components; ++i) {
+          c[j * components + i] += scale * t * values[k][i];
+        }
+      }
+    }
+
+    for (std::size_t k = 0; k <= n; ++k) {
+      const double x = std::cos(std::numbers::pi * static_cast<double>(k) /
+                                static_cast<double>(n));
+      result.errc = PropagateSgp4(state, center + half * x, teme);
+      if (result.errc != Sgp4Errc::kOk) {
+        return result;
+      }
+      const auto expected = to_components(teme);
+      const auto fitted = clenshaw(c, degree, x);
+      result.max_position_error = std::max(
+          result.max_position_error,
+          std::hypot(fitted[0] - expected[0], fitted[1] - expected[1],
+                     fitted[2] - expected[2]));
+      result.max_velocity_error = std::max(
+          result.max_velocity_error,
+          std::hypot(fitted[3] - expected[3], fitted[4] - expected[4],
+                     fitted[5] - expected[5]));
+    }
+  }
+  return result;
+}
+
+template <typename T>
+void write_le(std::ostream &os, T value) {
+  using U = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+  auto bits = std::bit_cast<U>(value);
+  std::array<char, sizeof(U)> bytes{};
+  for (auto &byte : bytes) {
+    byte = static_cast<char>(bits & 0xff);
+    bits >>= 8;
+  }
+  os.write(bytes.data(), bytes.size());
+}
+
+template <typename T>
+[[nodiscard]] T read_le(std::istream &is, std::string_view what) {
+  using U = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+  std::array<char, sizeof(U)> bytes{};
+  if (!is.read(bytes.data(), bytes.size())) {
+    throw MyException<std::string>("truncated ephemeris", std::string(what));
+  }
+  U bits = 0;
+  for (auto it = bytes.rbegin(); it != bytes.rend(); ++it) {
+    bits = (bits << 8) | static_cast<std::uint8_t>(*it);
+  }
+  return std::bit_cast<T>(bits);
+}
+}  // namespace
+
+[[nodiscard]] std::size_t ChebyshevEphemeris::segment_count() const noexcept {
+  const auto per_segment = static_cast<std::size_t>(degree_ + 1) * components;
+  return coefficients_.size() / per_segment;
+}
+
+[[nodiscard]] bool ChebyshevEphemeris::Evaluate(
+    double minutes, TemeState &teme) const noexcept {
+  const auto count = segment_count();
+  const double offset = (minutes - first_) / segment_minutes_;
+  if (count == 0 || !(offset >= 0.0) ||
+      offset > static_cast<double>(count)) {
+    return false;
+  }
+  const auto s = std::min(static_cast<std::size_t>(offset), count - 1);
+  const double x = 2.0 * (offset - static_cast<double>(s)) - 1.0;
+  const auto *c = coefficients_.data() +
+                  s * static_cast<std::size_t>(degree_ + 1) * components;
+  const auto value = clenshaw(c, degree_, x);
+  teme.position = {value[0], value[1], value[2]};
+  teme.velocity = {value[3], value[4], value[5]};
+  return true;
+}
+
+[[nodiscard]] Sgp4Errc FitEphemeris(const Sgp4State &state, double first,
+                                    double last,
+                                    const EphemerisOptions &options,
+                                    ChebyshevEphemeris &ephemeris) {
+  if (!(options.segment_minutes > 0.0)) {
+    throw MyException<double>("segment_minutes has to be positive",
+                              options.segment_minutes);
+  }
+  if (!(options.min_segment_minutes > 0.0)) {
+    throw MyException<double>("min_segment_minutes has to be positive",
+                              options.min_segment_minutes);
+  }
+  if (!std::isfinite(last - first)) {
+    throw MyException<double>("first and last have to be finite",
+                              last - first);
+  }
+  const int degree = std::clamp(options.degree, 1, max_degree);
+  const double span = std::max(last - first, 0.0);
+  double minutes = std::min(options.segment_minutes, std::max(span, 1e-3));
+  if (span / minutes > max_segment_count) {
+    throw MyException<double>("too many segments between first and last",
+                              span / minutes);
+  }
+
+  std::vector<double> coefficients;
+  while (true) {
+    const auto count = std::max<std::size_t>(
+        static_cast<std::size_t>(std::ceil(span / minutes - 1e-9)), 1);
+    const auto fit =
+        fit_segments(state, first, minutes, count, degree, coefficients);
+    if (fit.errc != Sgp4Errc::kOk) {
+      return fit.errc;
+    }
+    const bool within_tolerance =
+        fit.max_position_error <= options.position_tolerance &&
+        fit.max_velocity_error <= options.velocity_tolerance;
+    if (within_tolerance || minutes / 2.0 < options.min_segment_minutes ||
+        span / (minutes / 2.0) > max_segment_count) {
+      ephemeris.epoch_ = state.epoch;
+      ephemeris.first_ = first;
+      ephemeris.segment_minutes_ = minutes;
+      ephemeris.degree_ = degree;
+      ephemeris.max_position_error_ = fit.max_position_error;
+      ephemeris.max_velocity_error_ = fit.max_velocity_error;
+      ephemeris.coefficients_ = std::move(coefficients);
+      return Sgp4Errc::kOk;
+    }
+    minutes /= 2.0;
+  }
+}
+
+void WriteEphemeris(std::ostream &os, const ChebyshevEphemeris &ephemeris) {
+  using namespace std::chrono;
+  os.write(ephemeris_magic.data(),
+           static_cast<std::streamsize>(ephemeris_magic.size()));
+  write_le(os, static_cast<std::int64_t>(
+                   duration_cast<microseconds>(
+                       ephemeris.epoch_.time_since_epoch())
+                       .count()));
+  write_le(os, ephemeris.first_);
+  write_le(os, ephemeris.segment_minutes_);
+  write_le(os, static_cast<std::int32_t>(ephemeris.degree_));
+  write_le(os, static_cast<std::uint64_t>(ephemeris.segment_count()));
+  write_le(os, ephemeris.max_position_error_);
+  write_le(os, ephemeris.max_velocity_error_);
+  for (const double c : ephemeris.coefficients_) {
+    write_le(os, c);
+  }
+}
+
+[[nodiscard]] ChebyshevEphemeris ReadEphemeris(std::istream &is) {
+  using namespace std::chrono;
+  std::string magic(ephemeris_magic.size(), '\0');
+  if (!is.read(magic.data(), static_cast<std::streamsize>(magic.size())) ||
+      magic != ephemeris_magic) {
+    throw MyException<std::string>("not an ephemeris", magic);
+  }
+
+  ChebyshevEphemeris ephemeris;
+  ephemeris.epoch_ =
+      system_clock::time_point{duration_cast<system_clock::duration>(
+          microseconds{read_le<std::int64_t>(is, "epoch")})};
+  ephemeris.first_ = read_le<double>(is, "first");
+  ephemeris.segment_minutes_ = read_le<double>(is, "segment_minutes");
+  ephemeris.degree_ = read_le<std::int32_t>(is, "degree");
+  const auto count = read_le<std::uint64_t>(is, "segment_count");
+  ephemeris.max_position_error_ = read_le<double>(is, "max_position_error");
+  ephemeris.max_velocity_error_ = read_le<double>(is, "max_velocity_error");
+
+  if (ephemeris.degree_ < 1 || ephemeris.degree_ > max_degree ||
+      !(ephemeris.segment_minutes_ > 0.0) || count > (std::uint64_t{1} << 32)) {
+    throw MyException<std::string>("invalid ephemeris header", magic);
+  }
+  // segment by segment, a corrupt count runs into the end of the stream
+  // instead of allocating for segments that aren't there
+  const auto per_segment =
+      static_cast<std::size_t>(ephemeris.degree_ + 1) * components;
+  for (std::uint64_t s = 0; s < count; ++s) {
+    for (std::size_t k = 0; k < per_segment; ++k) {
+      ephemeris.coefficients_.push_back(read_le<double>(is, "coefficients"));
+    }
+  }
+  return ephemeris;
+}
+}  // namespace eob
@@ -0,0 +1,317 @@
+#include "earthorbits/formattle.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "earthorbits/instrumentation.h"
+#include "earthorbits/parsetle.h"
+#include "tlefields.h"
+
+namespace eob {
+namespace {
+static_assert(formatted_tle_size == tle_record_size);
+
+/// decimals of the fixed point fields
+constexpr std::size_t epoch_day_decimals = 8;
+constexpr std::size_t angle_decimals = 4;
+constexpr std::size_t mean_motion_decimals = 8;
+/// largest |exponent| of an "exponential" field, it has a single digit
+constexpr int max_tle_exponent = 9;
+
+/// @brief Columns of field within its line
+[[nodiscard]] std::span<char> field_chars(std::span<char, tle_line_size> line,
+                                          TleField field) noexcept {
+  const auto &span = tle_field_span(field);
+  return line.subspan(span.start, span.size);
+}
+
+/// @brief Digits of value right aligned in field, the rest filled with pad
+[[nodiscard]] bool write_uint(std::span<char> field, std::uint64_t value,
+                              char pad) noexcept {
+  auto i = field.size();
+  do {
+    if (i == 0) {
+      return false;
+    }
+    field[--i] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  std::fill_n(field.begin(), i, pad);
+  return true;
+}
+
+[[nodiscard]] bool write_int(std::span<char> field, int value,
+                             char pad) noexcept {
+  return value >= 0 &&
+         write_uint(field, static_cast<std::uint64_t>(value), pad);
+}
+
+/// @brief |value| * 10^decimals rounded to an integer
+///
+/// Values parsed from a field with that many decimals come back exactly,
+/// the product is within a few ulp of the integer they were parsed from.
+[[nodiscard]] bool scale_to_digits(double value, std::size_t decimals,
+                                   std::uint64_t &digits) noexcept {
+  const double scaled = std::abs(value) * tle_pow10[decimals];
+  if (!(scaled < 1e18)) {  // also NaN
+    return false;
+  }
+  digits = static_cast<std::uint64_t>(std::llround(scaled));
+  return true;
+}
+
+/// @brief Non-negative value with decimals digits after the point, e.g.
+/// " 51.6405", the integer part padded with pad
+[[nodiscard]] bool write_fixed(std::span<char> field, double value,
+                               std::size_t decimals, char pad) noexcept {
+  std::uint64_t digits = 0;
+  if (!(value >= 0.0) || !scale_to_digits(value, decimals, digits)) {
+    return false;
+  }
+  const auto point = field.size() - decimals - 1;
+  const auto unit = static_cast<std::uint64_t>(tle_pow10[decimals]);
+  field[point] = '.';
+  return write_uint(field.subspan(point + 1), digits % unit, '0') &&
+         write_uint(field.first(point), digits / unit, pad);
+}
+
+/// @brief Signed value below 1 without the leading zero, e.g. " .00011771"
+/// or "-.00000123"
+[[nodiscard]] bool write_fraction(std::span<char> field,
+                                  double value) noexcept {
+  const auto decimals = field.size() - 2;
+  std::uint64_t digits = 0;
+  if (!scale_to_digits(value, decimals, digits) ||
+      digits >= static_cast<std::uint64_t>(tle_pow10[decimals])) {
+    return false;
+  }
+  field[0] = std::signbit(value) ? '-' : ' ';
+  field[1] = '.';
+  return write_uint(field.subspan(2), digits, '0');
+}
+
+/// @brief mantissa rounded to digits after moving the point by shift
+[[nodiscard]] std::uint64_t shifted_mantissa(double magnitude,
+                                             int shift) noexcept {
+  const double scaled =
+      shift >= 0 ? magnitude * tle_pow10[static_cast<std::size_t>(shift)]
+                 : magnitude / tle_pow10[static_cast<std::size_t>(-shift)];
+  return static_cast<std::uint64_t>(std::llround(scaled));
+}
+
+/// @brief TLE "exponential" field, the inverse of decode_tle_exponent,
+/// e.g. 0.21418e-3 -> " 21418-3"
+///
+/// The mantissa is normalized to a non-zero first digit, values too small
+/// for the smallest exponent lose digits and round to zero like
+/// " 00000-0".
+[[nodiscard]] bool write_exponent(std::span<char> field,
+                                  double value) noexcept {
+  const auto digits = static_cast<int>(field.size()) - 3;
+  const auto limit = static_cast<std::uint64_t>(
+      tle_pow10[static_cast<std::size_t>(digits)]);
+  const double magnitude = std::abs(value);
+  if (!std::isfinite(magnitude)) {
+    return false;
+  }
+
+  std::uint64_t mantissa = 0;
+  int exponent = 0;
+  if (magnitude != 0.0) {
+    // log10 is only a guess near powers of ten and rounding the mantissa
+    // can carry into a new digit, the passes below correct either
+    exponent = static_cast<int>(std::floor(std::log10(magnitude))) + 1;
+    for (int pass = 0; pass < 3; ++pass) {
+      exponent = std::max(exponent, -max_tle_exponent);
+      if (exponent > max_tle_exponent) {
+        return false;
+      }
+      mantissa = shifted_mantissa(magnitude, digits - exponent);
+      if (mantissa >= limit) {
+        ++exponent;
+      } else if (mantissa < limit / 10 && exponent > -max_tle_exponent) {
+        --exponent;
+      } else {
+        break;
+      }
+    }
+    if (mantissa >= limit) {
+      return false;
+    }
+  }
+  if (mantissa == 0) {
+    exponent = 0;
+  }
+
+  field[0] = std::signbit(value) ? '-' : ' ';
+  // zero is written with "-0", like " 00000-0"
+  field[field.size() - 2] = exponent > 0 || (exponent == 0 && mantissa != 0)
+                                ? '+'
+                                : '-';
+  field[field.size() - 1] = static_cast<char>('0' + std::abs(exponent));
+  return write_uint(field.subspan(1, field.size() - 3), mantissa, '0');
+}
+
+[[nodiscard]] bool write_launch_piece(std::span<char> field,
+                                      std::string_view piece) noexcept {
+  if (piece.size() > field.size() ||
+      find_invalid_tle_char(piece) != piece.size() ||
+      piece.find('\n') != std::string_view::npos) {
+    return false;
+  }
+  std::copy(piece.begin(), piece.end(), field.begin());
+  return true;
+}
+
+void write_checksum(std::span<char, tle_line_size> line) noexcept {
+  line.back() = static_cast<char>(
+      '0' + compute_tle_checksum({line.data(), line.size()}));
+}
+
+[[nodiscard]] TleError write_line_1(
+    const TleLine1 &tle, std::span<char, tle_line_size> line) noexcept {
+  auto field = [line](TleField f) { return field_chars(line, f); };
+  line.front() = '1';
+  field(TleField::kClassification).front() = tle.classification;
+
+  struct IntField {
+    TleField field;
+    int value;
+    char pad;
+  };
+  const std::array<IntField, 6> int_fields{{
+      {TleField::kLine1SatelliteNumber, tle.satellite_number, '0'},
+      {TleField::kLaunchYear, tle.launch_year, '0'},
+      {TleField::kLaunchNumber, tle.launch_number, '0'},
+      {TleField::kEpochYear, tle.epoch_year, '0'},
+      {TleField::kEphemerisType, tle.ephemeris_type, '0'},
+      {TleField::kElementNumber, tle.element_number, ' '},
+  }};
+  for (const auto &[f, value, pad] : int_fields) {
+    if (!write_int(field(f), value, pad)) {
+      return make_tle_error(TleErrc::kOutOfDomain, f);
+    }
+  }
+
+  if (!write_launch_piece(field(TleField::kLaunchPiece), tle.launch_piece)) {
+    return make_tle_error(TleErrc::kOutOfDomain, TleField::kLaunchPiece);
+  }
+  if (!write_fixed(field(TleField::kEpochDay), tle.epoch_day,
+                   epoch_day_decimals, '0')) {
+    return make_tle_error(TleErrc::kOutOfDomain, TleField::kEpochDay);
+  }
+  if (!write_fraction(field(TleField::kMeanMotionDot), tle.mean_motion_dot)) {
+    return make_tle_error(TleErrc::kOutOfDomain, TleField::kMeanMotionDot);
+  }
+  if (!write_exponent(field(TleField::kMeanMotionDdot),
+                      tle.mean_motion_ddot)) {
+    return make_tle_error(TleErrc::kOutOfDomain, TleField::kMeanMotionDdot);
+  }
+  if (!write_exponent(field(TleField::kBstarDrag), tle.bstar_drag)) {
+    return make_tle_error(TleErrc::kOutOfDomain, TleField::kBstarDrag);
+  }
+  write_checksum(line);
+  return TleError{};
+}
+
+[[nodiscard]] TleError write_line_2(
+    const TleLine2 &tle, std::span<char, tle_line_size> line) noexcept {
+  auto field = [line](TleField f) { return field_chars(line, f); };
+  line.front() = '2';
+
+  if (!write_int(field(TleField::kLine2SatelliteNumber), tle.satellite_number,
+                 '0')) {
+    return make_tle_error(TleErrc::kOutOfDomain,
+                          TleField::kLine2SatelliteNumber);
+  }
+  if (!write_int(field(TleField::kRevAtEpoch), tle.rev_at_epoch, ' ')) {
+    return make_tle_error(TleErrc::kOutOfDomain, TleField::kRevAtEpoch);
+  }
+
+  struct FixedField {
+    TleField field;
+    double value;
+    std::size_t decimals;
+  };
+  const std::array<FixedField, 5> fixed_fields{{
+      {TleField::kInclination, tle.inclination, angle_decimals},
+      {TleField::kRaan, tle.raan, angle_decimals},
+      {TleField::kArgumentOfPerigree, tle.argument_of_perigree, angle_decimals},
+      {TleField::kMeanAnomaly, tle.mean_anomaly, angle_decimals},
+      {TleField::kMeanMotion, tle.mean_motion, mean_motion_decimals},
+  }};
+  for (const auto &[f, value, decimals] : fixed_fields) {
+    if (!write_fixed(field(f), value, decimals, ' ')) {
+      return make_tle_error(TleErrc::kOutOfDomain, f);
+    }
+  }
+
+  // implied leading decimal point, 0.0004792 -> "0004792"
+  const auto eccentricity = field(TleField::kEccentricity);
+  std::uint64_t digits = 0;
+  if (!scale_to_digits(tle.eccentricity, eccentricity.size(), digits) ||
+      !write_uint(eccentricity, digits, '0')) {
+    return make_tle_error(TleErrc::kOutOfDomain, TleField::kEccentricity);
+  }
+  write_checksum(line);
+  return TleError{};
+}
+}  // namespace
+
+[[nodiscard]] TleError FormatTle(const Tle &tle, std::span<char> out) noexcept {
+  EOB_SCOPED_TIMER(Probe::kFormat);
+  if (out.size() < formatted_tle_size) {
+    return TleError{.code = TleErrc::kInvalidSize};
+  }
+  // same checks ParseTle makes, so whatever is written parses again
+  if (auto err = check_tle_values(tle); !err.ok()) {
+    return err;
+  }
+  if (tle.line_1.classification != 'U') {
+    return make_tle_error(TleErrc::kInvalidClassification,
+                          TleField::kClassification);
+  }
+
+  // assembled on the stack so out is left alone on errors
+  std::array<char, formatted_tle_size> record;
+  record.fill(' ');
+  record[tle_line_size] = '\n';
+  const std::span<char, tle_line_size> line_1(record.data(), tle_line_size);
+  const std::span<char, tle_line_size> line_2(
+      record.data() + tle_line_size + 1, tle_line_size);
+  if (auto err = write_line_1(tle.line_1, line_1); !err.ok()) {
+    return err;
+  }
+  if (auto err = write_line_2(tle.line_2, line_2); !err.ok()) {
+    return err;
+  }
+  std::copy(record.begin(), record.end(), out.begin());
+  return TleError{};
+}
+
+[[nodiscard]] std::size_t FormatTles(std::span<const Tle> tles,
+                                     std::span<char> out,
+                                     TleError &error) noexcept {
+  error = TleError{};
+  std::size_t written = 0;
+  for (const auto &tle : tles) {
+    if (out.size() < formatted_tle_size + 1) {
+      error = TleError{.code = TleErrc::kInvalidSize};
+      break;
+    }
+    error = FormatTle(tle, out);
+    if (!error.ok()) {
+      break;
+    }
+    out[formatted_tle_size] = '\n';
+    out = out.subspan(formatted_tle_size + 1);
+    ++written;
+  }
+  return written;
+}
+}  // namespace eob
@@ -0,0 +1,141 @@
+#include "earthorbits/frames.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <span>
+
+#include "constants.h"
+#include "dispatch.h"
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/timescales.h"
+
+namespace eob {
+namespace {
+constexpr double arcsec_to_rad = std::numbers::pi / (180.0 * 3600.0);
+
+/// @brief Mean rotation rate of the Earth, radians / second
+constexpr double earth_rotation_rad_per_s = 7.292115146706979e-5;
+
+/// @param gmst radians
+/// @param x_pole radians
+/// @param y_pole radians
+[[nodiscard]] EcefState teme_to_ecef(const TemeState &teme, double gmst,
+                                     double x_pole, double y_pole) noexcept {
+  const double st = std::sin(gmst);
+  const double ct = std::cos(gmst);
+  const auto &r = teme.position;
+  const auto &v = teme.velocity;
+
+  // pseudo Earth fixed, rotate about the pole
+  const std::array<double, 3> r_pef{ct * r[0] + st * r[1],
+                                    -st * r[0] + ct * r[1], r[2]};
+  std::array<double, 3> v_pef{ct * v[0] + st * v[1], -st * v[0] + ct * v[1],
+                              v[2]};
+  // minus omega x r, the frame rotates
+  v_pef[0] += earth_rotation_rad_per_s * r_pef[1];
+  v_pef[1] -= earth_rotation_rad_per_s * r_pef[0];
+
+  if (x_pole == 0.0 && y_pole == 0.0) {
+    return {r_pef, v_pef};
+  }
+
+  // transpose of the polar motion matrix W
+  const double sx = std::sin(x_pole);
+  const double cx = std::cos(x_pole);
+  const double sy = std::sin(y_pole);
+  const double cy = std::cos(y_pole);
+  auto polar_motion = [&](const std::array<double, 3> &p) {
+    return std::array<double, 3>{
+        cx * p[0] + sx * sy * p[1] + sx * cy * p[2],
+        cy * p[1] - sy * p[2],
+        -sx * p[0] + cx * sy * p[1] + cx * cy * p[2],
+    };
+  };
+  return {polar_motion(r_pef), polar_motion(v_pef)};
+}
+
+/// @brief The transform as matrices, r' = m r and v' = m v + n r
+struct Transform {
+  std::array<std::array<double, 3>, 3> m;
+  std::array<std::array<double, 3>, 3> n;
+};
+
+[[nodiscard]] Transform make_transform(
+    const std::chrono::system_clock::time_point &tp,
+    const EopTable &eop) noexcept {
+  // the transform is linear in the state, so its columns are the images of
+  // unit positions and velocities
+  Transform transform{};
+  for (std::size_t j = 0; j < 3; ++j) {
+    TemeState unit{};
+    unit.position[j] = 1.0;
+    const auto from_position = TemeToEcef(unit, tp, eop);
+    for (std::size_t i = 0; i < 3; ++i) {
+      transform.m[i][j] = from_position.position[i];
+      transform.n[i][j] = from_position.velocity[i];
+    }
+  }
+  return transform;
+}
+
+template <typename T>
+void teme_to_ecef_batch(std::span<const BasicTemeState<T>> teme,
+                        const std::chrono::system_clock::time_point &tp,
+                        const EopTable &eop,
+                        std::span<BasicEcefState<T>> ecef) noexcept {
+  const auto transform = make_transform(tp, eop);
+  std::array<std::array<T, 3>, 3> m{};
+  std::array<std::array<T, 3>, 3> n{};
+  for (std::size_t i = 0; i < 3; ++i) {
+    for (std::size_t j = 0; j < 3; ++j) {
+      m[i][j] = static_cast<T>(transform.m[i][j]);
+      n[i][j] = static_cast<T>(transform.n[i][j]);
+    }
+  }
+  const auto size = std::min(teme.size(), ecef.size());
+  for (std::size_t k = 0; k < size; ++k) {
+    const auto &r = teme[k].position;
+    const auto &v = teme[k].velocity;
+    auto &out = ecef[k];
+    for (std::size_t i = 0; i < 3; ++i) {
+      out.position[i] = m[i][0] * r[0] + m[i][1] * r[1] + m[i][2] * r[2];
+      out.velocity[i] = m[i][0] * v[0] + m[i][1] * v[1] + m[i][2] * v[2] +
+                        n[i][0] * r[0] + n[i][1] * r[1] + n[i][2] * r[2];
+    }
+  }
+}
+}  // namespace
+
+[[nodiscard]] EcefState TemeToEcef(
+    const TemeState &teme,
+    const std::chrono::system_clock::time_point &tp) noexcept {
+  const double gmst = calc_gmst(tp).count() * pi2 / seconds_per_day;
+  return teme_to_ecef(teme, gmst, 0.0, 0.0);
+}
+
+[[nodiscard]] EcefState TemeToEcef(
+    const TemeState &teme, const std::chrono::system_clock::time_point &tp,
+    const EopTable &eop) noexcept {
+  const auto values = eop.Interpolate(tp);
+  const double gmst =
+      calc_gmst(UtcToUt1(tp, eop)).count() * pi2 / seconds_per_day;
+  return teme_to_ecef(teme, gmst, values.x_pole * arcsec_to_rad,
+                      values.y_pole * arcsec_to_rad);
+}
+
+void TemeToEcef(std::span<const TemeState> teme,
+                const std::chrono::system_clock::time_point &tp,
+                const EopTable &eop, std::span<EcefState> ecef) noexcept {
+  dispatch([&] { teme_to_ecef_batch(teme, tp, eop, ecef); });
+}
+
+void TemeToEcef(std::span<const TemeStateF> teme,
+                const std::chrono::system_clock::time_point &tp,
+                const EopTable &eop, std::span<EcefStateF> ecef) noexcept {
+  dispatch([&] { teme_to_ecef_batch(teme, tp, eop, ecef); });
+}
+}  // namespace eob
@@ -0,0 +1,259 @@
+#include "earthorbits/illumination.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "constants.h"
+#include "earthorbits/earthorbits.h"
+#include "jdate.h"
+
+namespace eob {
+namespace {
+constexpr double deg_to_rad = std::numbers::pi / 180.0;
+constexpr double au_km = 149597870.7;
+constexpr double sun_radius_km = 696000.0;
+
+void check_precision(std::chrono::system_clock::duration precision) {
+  if (precision <= std::chrono::system_clock::duration::zero()) {
+    throw MyException<std::string>("precision must be positive",
+                                   std::to_string(precision.count()));
+  }
+}
+
+[[nodiscard]] double dot(const Vector3 &a, const Vector3 &b) noexcept {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+[[nodiscard]] double norm(const Vector3 &a) noexcept {
+  return std::sqrt(dot(a, a));
+}
+
+/// @brief Julian centuries since J2000, UTC is used for UT1 and TT which
+/// is well within the precision of the models
+[[nodiscard]] double julian_centuries(
+    const std::chrono::system_clock::time_point &tp) noexcept {
+  using namespace std::chrono;
+  constexpr double j2000 = 2451545.0;
+  // double days first, nanoseconds since the Julian epoch would overflow
+  const auto jd = sys_to_jdate(time_point_cast<jdate_clock::duration>(tp));
+  const auto days = duration_cast<jdate_clock::duration>(jd.time_since_epoch());
+  return (days.count() - j2000) / 36525.0;
+}
+
+/// @brief sin of an angle in degrees
+[[nodiscard]] double sind(double degrees) noexcept {
+  return std::sin(degrees * deg_to_rad);
+}
+[[nodiscard]] double cosd(double degrees) noexcept {
+  return std::cos(degrees * deg_to_rad);
+}
+
+[[nodiscard]] bool in_shadow(const Vector3 &satellite, const Vector3 &sun,
+                             ShadowModel model) noexcept {
+  return CalcIllumination(satellite, sun, model) != Illumination::kSunlit;
+}
+}  // namespace
+
+[[nodiscard]] Vector3 SunPosition(
+    const std::chrono::system_clock::time_point &tp) noexcept {
+  const double t = julian_centuries(tp);
+  const double mean_longitude = 280.460 + 36000.771 * t;
+  const double mean_anomaly = 357.5291092 + 35999.05034 * t;
+  const double ecliptic_longitude = mean_longitude +
+                                    1.914666471 * sind(mean_anomaly) +
+                                    0.019994643 * sind(2.0 * mean_anomaly);
+  const double distance = (1.000140612 - 0.016708617 * cosd(mean_anomaly) -
+                           0.000139589 * cosd(2.0 * mean_anomaly)) *
+                          au_km;
+  const double obliquity = 23.439291 - 0.0130042 * t;
+  return {distance * cosd(ecliptic_longitude),
+          distance * cosd(obliquity) * sind(ecliptic_longitude),
+          distance * sind(obliquity) * sind(ecliptic_longitude)};
+}
+
+[[nodiscard]] Vector3 MoonPosition(
+    const std::chrono::system_clock::time_point &tp) noexcept {
+  const double t = julian_centuries(tp);
+  const double longitude = 218.32 + 481267.8813 * t +
+                           6.29 * sind(134.9 + 477198.85 * t) -
+                           1.27 * sind(259.2 - 413335.38 * t) +
+                           0.66 * sind(235.7 + 890534.23 * t) +
+                           0.21 * sind(269.9 + 954397.70 * t) -
+                           0.19 * sind(357.5 + 35999.05 * t) -
+                           0.11 * sind(186.6 + 966404.05 * t);
+  const double latitude = 5.13 * sind(93.3 + 483202.03 * t) +
+                          0.28 * sind(228.2 + 960400.87 * t) -
+                          0.28 * sind(318.3 + 6003.18 * t) -
+                          0.17 * sind(217.6 - 407332.20 * t);
+  const double parallax = 0.9508 + 0.0518 * cosd(134.9 + 477198.85 * t) +
+                          0.0095 * cosd(259.2 - 413335.38 * t) +
+                          0.0078 * cosd(235.7 + 890534.23 * t) +
+                          0.0028 * cosd(269.9 + 954397.70 * t);
+  const double obliquity = 23.439291 - 0.0130042 * t;
+  const double distance = wgs72_earth_radius_km / sind(parallax);
+  return {distance * cosd(latitude) * cosd(longitude),
+          distance * (cosd(obliquity) * cosd(latitude) * sind(longitude) -
+                      sind(obliquity) * sind(latitude)),
+          distance * (sind(obliquity) * cosd(latitude) * sind(longitude) +
+                      cosd(obliquity) * sind(latitude))};
+}
+
+/// Overlap of the apparent disks of the Sun and the Earth
+/// @see Montenbruck and Gill, Satellite Orbits, section 3.4.2
+[[nodiscard]] double SunlitFraction(const Vector3 &satellite,
+                                    const Vector3 &sun) noexcept {
+  // Earth is behind the satellite as seen from the Sun, skips the
+  // trigonometry for half of all samples
+  if (dot(satellite, sun) >= dot(satellite, satellite)) {
+    return 1.0;
+  }
+  const Vector3 to_sun{sun[0] - satellite[0], sun[1] - satellite[1],
+                       sun[2] - satellite[2]};
+  const double r = norm(satellite);
+  const double d = norm(to_sun);
+  const double a = std::asin(sun_radius_km / d);
+  const double b = std::asin(std::min(wgs72_earth_radius_km / r, 1.0));
+  const double c =
+      std::acos(std::clamp(-dot(satellite, to_sun) / (r * d), -1.0, 1.0));
+  if (c >= a + b) {
+    return 1.0;
+  }
+  if (c <= b - a) {
+    return 0.0;
+  }
+  if (c <= a - b) {  // annular, Earth disk inside the Sun's
+    return 1.0 - (b * b) / (a * a);
+  }
+  const double x = (c * c + a * a - b * b) / (2.0 * c);
+  const double y = std::sqrt(std::max(a * a - x * x, 0.0));
+  const double overlap = a * a * std::acos(std::clamp(x / a, -1.0, 1.0)) +
+                         b * b * std::acos(std::clamp((c - x) / b, -1.0, 1.0)) -
+                         c * y;
+  return 1.0 - overlap / (std::numbers::pi * a * a);
+}
+
+[[nodiscard]] Illumination CalcIllumination(const Vector3 &satellite,
+                                            const Vector3 &sun,
+                                            ShadowModel model) noexcept {
+  if (model == ShadowModel::kCylindrical) {
+    const double sun_distance = norm(sun);
+    const double along = dot(satellite, sun) / sun_distance;
+    if (along >= 0.0) {
+      return Illumination::kSunlit;
+    }
+    const double across_sq = dot(satellite, satellite) - along * along;
+    return across_sq < wgs72_earth_radius_km * wgs72_earth_radius_km
+               ? Illumination::kUmbra
+               : Illumination::kSunlit;
+  }
+  const double fraction = SunlitFraction(satellite, sun);
+  if (fraction >= 1.0) {
+    return Illumination::kSunlit;
+  }
+  return fraction <= 0.0 ? Illumination::kUmbra : Illumination::kPenumbra;
+}
+
+void CalcIllumination(std::span<const Vector3> satellites, const Vector3 &sun,
+                      ShadowModel model, std::span<Illumination> out) noexcept {
+  const auto n = std::min(satellites.size(), out.size());
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = CalcIllumination(satellites[i], sun, model);
+  }
+}
+
+SunMoonGrid::SunMoonGrid(std::chrono::system_clock::time_point start,
+                         std::chrono::system_clock::duration step,
+                         std::size_t size)
+    : start_{start}, step_{step} {
+  sun_.reserve(size);
+  moon_.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    sun_.push_back(SunPosition(time(i)));
+    moon_.push_back(MoonPosition(time(i)));
+  }
+}
+
+[[nodiscard]] Sgp4Errc FindEclipses(
+    const Sgp4State &state, const SunMoonGrid &grid, ShadowModel model,
+    std::vector<EclipseInterval> &eclipses,
+    std::chrono::system_clock::duration precision) {
+  using std::chrono::system_clock;
+  check_precision(precision);
+  eclipses.clear();
+  TemeState teme;
+  Sgp4Errc errc = Sgp4Errc::kOk;
+
+  // shadow state at tp, Sun computed directly in between grid times
+  auto shadow_at = [&](system_clock::time_point tp, const Vector3 &sun) {
+    errc = PropagateSgp4(state, MinutesSinceEpoch(state, tp), teme);
+    return in_shadow(teme.position, sun, model);
+  };
+  // time of the first sample in shadow state `after` in (lo, hi]
+  auto refine = [&](system_clock::time_point lo, system_clock::time_point hi,
+                    bool after) {
+    while (hi - lo > precision && errc == Sgp4Errc::kOk) {
+      const auto mid = lo + (hi - lo) / 2;
+      if (shadow_at(mid, SunPosition(mid)) == after) {
+        hi = mid;
+      } else {
+        lo = mid;
+      }
+    }
+    return hi;
+  };
+
+  bool shadow = false;
+  system_clock::time_point entry;
+  for (std::size_t i = 0; i < grid.size(); ++i) {
+    const auto tp = grid.time(i);
+    const bool now = shadow_at(tp, grid.sun(i));
+    if (errc != Sgp4Errc::kOk) {
+      return errc;
+    }
+    if (i == 0) {
+      shadow = now;
+      entry = tp;
+      continue;
+    }
+    if (now != shadow) {
+      const auto change = refine(grid.time(i - 1), tp, now);
+      if (errc != Sgp4Errc::kOk) {
+        return errc;
+      }
+      if (now) {
+        entry = change;
+      } else {
+        eclipses.push_back(EclipseInterval{.entry = entry, .exit = change});
+      }
+      shadow = now;
+    }
+  }
+  if (shadow && grid.size() > 0) {
+    eclipses.push_back(
+        EclipseInterval{.entry = entry, .exit = grid.time(grid.size() - 1)});
+  }
+  return Sgp4Errc::kOk;
+}
+
+void FindEclipses(std::span<const Sgp4State> states, const SunMoonGrid &grid,
+                  ShadowModel model,
+                  std::vector<std::vector<EclipseInterval>> &eclipses,
+                  std::vector<Sgp4Errc> &errors,
+                  std::chrono::system_clock::duration precision) {
+  check_precision(precision);
+  eclipses.resize(states.size());
+  errors.resize(states.size());
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    errors[i] = FindEclipses(states[i], grid, model, eclipses[i], precision);
+    if (errors[i] != Sgp4Errc::kOk) {
+      eclipses[i].clear();
+    }
+  }
+}
+}  // namespace eob
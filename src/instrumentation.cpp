@@ -0,0 +1,174 @@
+#include "earthorbits/instrumentation.h"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#define EOB_HAVE_RDTSC 1
+#endif
+
+namespace eob {
+namespace {
+using instrumentation_detail::ThreadCounters;
+
+/// @brief All live thread counters plus totals of threads that have exited
+struct Registry {
+  std::mutex mutex;
+  std::vector<ThreadCounters *> live;
+  std::array<std::uint64_t, probe_count> retired_calls{};
+  std::array<std::uint64_t, probe_count> retired_ticks{};
+};
+
+[[nodiscard]] Registry &registry() {
+  static Registry r;
+  return r;
+}
+
+/// @brief Tick rate of read_ticks(), measured once for the TSC
+[[nodiscard]] double ticks_per_second() {
+#if defined(EOB_HAVE_RDTSC)
+  static const double rate = [] {
+    using namespace std::chrono;
+    const auto t0 = steady_clock::now();
+    const auto c0 = __rdtsc();
+    std::this_thread::sleep_for(milliseconds(10));
+    const auto c1 = __rdtsc();
+    const duration<double> elapsed = steady_clock::now() - t0;
+    return static_cast<double>(c1 - c0) / elapsed.count();
+  }();
+  return rate;
+#else
+  using period = std::chrono::steady_clock::period;
+  return static_cast<double>(period::den) / static_cast<double>(period::num);
+#endif
+}
+}  // namespace
+
+namespace instrumentation_detail {
+ThreadCounters::ThreadCounters() noexcept {
+  // timers are used in noexcept functions, a thread that can't register
+  // still counts, its counters only show up in snapshots once it exits
+  try {
+    auto &r = registry();
+    const std::lock_guard lock(r.mutex);
+    r.live.push_back(this);
+  } catch (...) {  // NOLINT(bugprone-empty-catch)
+  }
+}
+
+ThreadCounters::~ThreadCounters() {
+  auto &r = registry();
+  const std::lock_guard lock(r.mutex);
+  for (std::size_t i = 0; i < probe_count; ++i) {
+    r.retired_calls[i] += calls[i].load(std::memory_order_relaxed);
+    r.retired_ticks[i] += ticks[i].load(std::memory_order_relaxed);
+  }
+  r.live.erase(std::remove(r.live.begin(), r.live.end(), this), r.live.end());
+}
+
+[[nodiscard]] ThreadCounters &thread_counters() noexcept {
+  thread_local ThreadCounters counters;
+  return counters;
+}
+
+[[nodiscard]] std::uint64_t read_ticks() noexcept {
+#if defined(EOB_HAVE_RDTSC)
+  return __rdtsc();
+#else
+  return static_cast<std::uint64_t>(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+}  // namespace instrumentation_detail
+
+[[nodiscard]] std::string_view to_string(Probe probe) noexcept {
+  switch (probe) {
+    case Probe::kParseTle:
+      return "parse_tle";
+    case Probe::kValidateTle:
+      return "validate_tle";
+    case Probe::kCalcGmst:
+      return "calc_gmst";
+    case Probe::kPropagate:
+      return "propagate";
+    case Probe::kFormat:
+      return "format";
+  }
+  return "unknown";
+}
+
+[[nodiscard]] InstrumentationSnapshot TakeInstrumentationSnapshot() {
+  InstrumentationSnapshot snapshot;
+  if constexpr (!instrumentation_enabled()) {
+    return snapshot;
+  }
+
+  snapshot.ticks_per_second = ticks_per_second();
+  auto &r = registry();
+  const std::lock_guard lock(r.mutex);
+  snapshot.threads = r.live.size();
+  for (std::size_t i = 0; i < probe_count; ++i) {
+    auto &probe = snapshot.probes[i];
+    probe.calls = r.retired_calls[i];
+    probe.ticks = r.retired_ticks[i];
+    for (const auto *counters : r.live) {
+      probe.calls += counters->calls[i].load(std::memory_order_relaxed);
+      probe.ticks += counters->ticks[i].load(std::memory_order_relaxed);
+    }
+    probe.seconds =
+        static_cast<double>(probe.ticks) / snapshot.ticks_per_second;
+  }
+  return snapshot;
+}
+
+/// Threads that are recording while this runs may keep part of their counts
+void ResetInstrumentation() {
+  auto &r = registry();
+  const std::lock_guard lock(r.mutex);
+  r.retired_calls.fill(0);
+  r.retired_ticks.fill(0);
+  for (auto *counters : r.live) {
+    for (std::size_t i = 0; i < probe_count; ++i) {
+      counters->calls[i].store(0, std::memory_order_relaxed);
+      counters->ticks[i].store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+[[nodiscard]] std::string ToText(const InstrumentationSnapshot &snapshot) {
+  std::string text;
+  for (std::size_t i = 0; i < probe_count; ++i) {
+    const auto &probe = snapshot.probes[i];
+    text += fmt::format("{} calls={} seconds={:.9f}\n",
+                        to_string(static_cast<Probe>(i)), probe.calls,
+                        probe.seconds);
+  }
+  return text;
+}
+
+[[nodiscard]] std::string ToJson(const InstrumentationSnapshot &snapshot) {
+  std::string json = fmt::format(
+      R"({{"enabled":{},"threads":{},"ticks_per_second":{},"probes":{{)",
+      instrumentation_enabled(), snapshot.threads, snapshot.ticks_per_second);
+  for (std::size_t i = 0; i < probe_count; ++i) {
+    const auto &probe = snapshot.probes[i];
+    json += fmt::format(R"({}"{}":{{"calls":{},"ticks":{},"seconds":{}}})",
+                        i == 0 ? "" : ",", to_string(static_cast<Probe>(i)),
+                        probe.calls, probe.ticks, probe.seconds);
+  }
+  json += "}}";
+  return json;
+}
+}  // namespace eob
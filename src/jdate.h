@@ -3,6 +3,7 @@
 #include <chrono>
 
 #include "date/date.h"
+#include "earthorbits/timescales.h"
 
 /// @see https://stackoverflow.com/a/33964462
 /// TODO delete this file depending on whether I need it actually or not
@@ -35,16 +36,24 @@ struct jdate_clock {
   }
 };
 
-template <class Duration>
-constexpr auto sys_to_jdate(
-    std::chrono::time_point<std::chrono::system_clock, Duration> tp) noexcept {
+/// @brief Julian date in the time scale of Clock, e.g. JD(TT) of an
+/// eob_tt_clock time point
+template <class Clock, class Duration>
+  requires eob::is_time_scale_clock_v<Clock>
+constexpr auto to_jdate(std::chrono::time_point<Clock, Duration> tp) noexcept {
   using namespace std::chrono;
   static_assert(jdate_clock::duration{jdiff()} < Duration::max(),
-                "Overflow in sys_to_jdate");
+                "Overflow in to_jdate");
   const auto d = tp.time_since_epoch() + jdiff();
   return time_point<jdate_clock, std::remove_cv_t<decltype(d)>>{d};
 }
 
+template <class Duration>
+constexpr auto sys_to_jdate(
+    std::chrono::time_point<std::chrono::system_clock, Duration> tp) noexcept {
+  return to_jdate(tp);
+}
+
 template <class Duration>
 constexpr auto jdate_to_sys(
     std::chrono::time_point<jdate_clock, Duration> tp) noexcept {
@@ -0,0 +1,112 @@
+#include "earthorbits/linkgeometry.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "dispatch.h"
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/eobmath.h"
+#include "earthorbits/frames.h"
+#include "earthorbits/topocentric.h"
+#include "parallel.h"
+
+namespace eob {
+namespace {
+/// Samples per chunk, the chunk's scratch arrays stay in L1
+constexpr std::size_t chunk = 256;
+
+void link_geometry(const GroundStation &station,
+                   std::span<const EcefState> track, LinkGeometry &out) {
+  out.resize(track.size());
+  dispatch([&] {
+    const auto &s = station.ecef();
+    const auto &east = station.east();
+    const auto &north = station.north();
+    const auto &up = station.up();
+    constexpr double inv_c = 1.0 / speed_of_light_km_per_s;
+
+    // relative position and velocity as structure of arrays
+    std::array<double, chunk> x;
+    std::array<double, chunk> y;
+    std::array<double, chunk> z;
+    std::array<double, chunk> vx;
+    std::array<double, chunk> vy;
+    std::array<double, chunk> vz;
+    // east, north, up and horizontal distance
+    std::array<double, chunk> e;
+    std::array<double, chunk> n;
+    std::array<double, chunk> u;
+    std::array<double, chunk> h;
+    for (std::size_t begin = 0; begin < track.size(); begin += chunk) {
+      const auto m = std::min(chunk, track.size() - begin);
+      const auto *sat = track.data() + begin;
+      for (std::size_t i = 0; i < m; ++i) {
+        x[i] = sat[i].position[0] - s[0];
+        y[i] = sat[i].position[1] - s[1];
+        z[i] = sat[i].position[2] - s[2];
+        vx[i] = sat[i].velocity[0];
+        vy[i] = sat[i].velocity[1];
+        vz[i] = sat[i].velocity[2];
+      }
+
+      auto *range = out.range.data() + begin;
+      auto *range_rate = out.range_rate.data() + begin;
+      auto *doppler = out.doppler.data() + begin;
+      for (std::size_t i = 0; i < m; ++i) {
+        const double r = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+        const double rr = (x[i] * vx[i] + y[i] * vy[i] + z[i] * vz[i]) / r;
+        range[i] = r;
+        range_rate[i] = rr;
+        doppler[i] = 1.0 - rr * inv_c;
+        e[i] = x[i] * east[0] + y[i] * east[1] + z[i] * east[2];
+        n[i] = x[i] * north[0] + y[i] * north[1] + z[i] * north[2];
+        u[i] = x[i] * up[0] + y[i] * up[1] + z[i] * up[2];
+        h[i] = std::sqrt(e[i] * e[i] + n[i] * n[i]);
+      }
+
+      const std::span azimuth(out.azimuth.data() + begin, m);
+      atan2(std::span(e).first(m), std::span(n).first(m), azimuth);
+      wrap_to_2pi(azimuth, azimuth);
+      atan2(std::span(u).first(m), std::span(h).first(m),
+            std::span(out.elevation.data() + begin, m));
+    }
+  });
+}
+}  // namespace
+
+void LinkGeometry::resize(std::size_t size) {
+  range.resize(size);
+  range_rate.resize(size);
+  doppler.resize(size);
+  azimuth.resize(size);
+  elevation.resize(size);
+}
+
+void CalcLinkGeometry(const GroundStation &station,
+                      std::span<const EcefState> track, LinkGeometry &out) {
+  link_geometry(station, track, out);
+}
+
+void CalcLinkGeometry(std::span<const GroundStation> stations,
+                      std::span<const Contact> contacts,
+                      std::vector<LinkGeometry> &out, std::size_t threads) {
+  for (std::size_t i = 0; i < contacts.size(); ++i) {
+    if (contacts[i].station >= stations.size()) {
+      throw MyException<std::string>(
+          "contact refers to a station that doesn't exist",
+          std::to_string(i));
+    }
+  }
+  out.resize(contacts.size());
+  parallel_for(contacts.size(), resolve_threads(threads),
+               [&](std::size_t i) {
+                 link_geometry(stations[contacts[i].station],
+                               contacts[i].track, out[i]);
+               });
+}
+}  // namespace eob
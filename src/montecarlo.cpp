@@ -0,0 +1,439 @@
+#include "earthorbits/montecarlo.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "dispatch.h"
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "parallel.h"
+#include "tleelements.h"
+
+namespace eob {
+namespace {
+using Elements = TleElementVector;
+static_assert(tle_element_count == tle_elements);
+
+/// Samples initialized and propagated together, small enough that their
+/// states and deviations stay in L1
+constexpr std::size_t batch = 64;
+/// relative to the diagonal, rounding below this isn't indefiniteness
+constexpr double definite_tolerance = 1e-12;
+
+/// @brief splitmix64 finalizer
+/// @see https://prng.di.unimi.it/splitmix64.c
+[[nodiscard]] constexpr std::uint64_t mix(std::uint64_t z) noexcept {
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+
+/// @brief Uniform in (0, 1], the counter-th number of the stream of key
+[[nodiscard]] double uniform(std::uint64_t key,
+                             std::uint64_t counter) noexcept {
+  constexpr double two_pow_minus_53 = 1.0 / 9007199254740992.0;
+  const auto bits = mix(key + counter * 0x9e3779b97f4a7c15);
+  return static_cast<double>((bits >> 11) + 1) * two_pow_minus_53;
+}
+
+/// @brief Standard normal numbers of sample i, Box-Muller on pairs
+[[nodiscard]] Elements normals(std::uint64_t key, std::uint64_t i) noexcept {
+  constexpr std::uint64_t pairs = (tle_elements + 1) / 2;
+  Elements z{};
+  for (std::uint64_t p = 0; p < pairs; ++p) {
+    const double u1 = uniform(key, (i * pairs + p) * 2);
+    const double u2 = uniform(key, (i * pairs + p) * 2 + 1);
+    const double r = std::sqrt(-2.0 * std::log(u1));
+    const double a = 2.0 * std::numbers::pi * u2;
+    z[2 * p] = r * std::cos(a);
+    if (2 * p + 1 < tle_elements) {
+      z[2 * p + 1] = r * std::sin(a);
+    }
+  }
+  return z;
+}
+
+/// @brief Lower triangular L with L L^T = covariance, zero columns for
+/// elements without variance
+[[nodiscard]] ElementCovariance cholesky(const ElementCovariance &c) {
+  for (std::size_t i = 0; i < tle_elements; ++i) {
+    if (!(c[i][i] >= 0.0) || !std::isfinite(c[i][i])) {
+      throw MyException<std::string>("covariance has an invalid variance",
+                                     std::to_string(i));
+    }
+    for (std::size_t j = 0; j < i; ++j) {
+      const double scale = std::sqrt(c[i][i] * c[j][j]);
+      if (!(std::abs(c[i][j] - c[j][i]) <= definite_tolerance * scale)) {
+        throw MyException<std::string>(
+            "covariance isn't symmetric",
+            std::to_string(i) + ", " + std::to_string(j));
+      }
+    }
+  }
+
+  ElementCovariance l{};
+  for (std::size_t j = 0; j < tle_elements; ++j) {
+    double d = c[j][j];
+    for (std::size_t k = 0; k < j; ++k) {
+      d -= l[j][k] * l[j][k];
+    }
+    const double tolerance = definite_tolerance * c[j][j];
+    if (d < -tolerance) {
+      throw MyException<std::string>(
+          "covariance isn't positive semidefinite", std::to_string(j));
+    }
+    if (d <= tolerance) {
+      continue;  // dependent on the elements before, column stays zero
+    }
+    l[j][j] = std::sqrt(d);
+    for (std::size_t i = j + 1; i < tle_elements; ++i) {
+      double s = c[i][j];
+      for (std::size_t k = 0; k < j; ++k) {
+        s -= l[i][k] * l[j][k];
+      }
+      l[i][j] = s / l[j][j];
+    }
+  }
+  return l;
+}
+
+/// Partial sums kept per lane, the loops adding up a batch are element
+/// wise and vectorize, a single sum would be a serial dependency
+constexpr std::size_t lanes = 8;
+/// upper triangle of the 6 x 6 products
+constexpr std::size_t products = 21;
+
+/// @brief Running sums of one thread at one time, relative to the nominal
+struct Sums {
+  std::size_t samples = 0;
+  std::size_t failed = 0;
+  std::array<std::array<double, lanes>, 6> first{};
+  std::array<std::array<double, lanes>, products> second{};
+  std::array<std::uint64_t, MonteCarloStats::bins> histogram{};
+
+  void Add(const Sums &other) noexcept {
+    samples += other.samples;
+    failed += other.failed;
+    for (std::size_t k = 0; k < first.size(); ++k) {
+      for (std::size_t j = 0; j < lanes; ++j) {
+        first[k][j] += other.first[k][j];
+      }
+    }
+    for (std::size_t p = 0; p < second.size(); ++p) {
+      for (std::size_t j = 0; j < lanes; ++j) {
+        second[p][j] += other.second[p][j];
+      }
+    }
+    for (std::size_t b = 0; b < histogram.size(); ++b) {
+      histogram[b] += other.histogram[b];
+    }
+  }
+};
+
+[[nodiscard]] double lane_sum(const std::array<double, lanes> &a) noexcept {
+  double s = 0.0;
+  for (const double x : a) {
+    s += x;
+  }
+  return s;
+}
+
+/// @brief Histogram bin of a squared distance, the exponent and the top
+/// mantissa bits are the octave and the bin within it
+[[nodiscard]] std::int64_t distance_bin(double km2) noexcept {
+  constexpr int mantissa_bits = 52;
+  constexpr int exponent_bias = 1023;
+  constexpr int bin_bits = std::countr_zero(MonteCarloStats::bins_per_octave);
+  constexpr auto first = static_cast<std::int64_t>(
+      (exponent_bias + MonteCarloStats::min_octave) << bin_bits);
+  constexpr auto last = static_cast<std::int64_t>(MonteCarloStats::bins - 1);
+  const auto bits = std::bit_cast<std::int64_t>(km2);
+  return std::clamp((bits >> (mantissa_bits - bin_bits)) - first,
+                    std::int64_t{0}, last);
+}
+
+/// @brief Deviations of a batch from the nominal, structure of arrays
+struct Deviations {
+  std::array<std::array<double, batch>, 6> d;
+  std::array<std::int64_t, batch> bin;
+};
+
+/// @brief Add the states of a batch at one time to sums
+void accumulate(std::span<const TemeState> teme,
+                std::span<const Sgp4Errc> errors, const TemeState &nominal,
+                bool histogram, Deviations &dev, Sums &sums) noexcept {
+  const auto m = teme.size();
+  // failed samples and the padding to whole lanes deviate by zero and
+  // don't count
+  const auto padded = (m + lanes - 1) / lanes * lanes;
+  for (std::size_t i = 0; i < m; ++i) {
+    const bool ok = errors[i] == Sgp4Errc::kOk;
+    for (std::size_t k = 0; k < 3; ++k) {
+      dev.d[k][i] = ok ? teme[i].position[k] - nominal.position[k] : 0.0;
+      dev.d[k + 3][i] = ok ? teme[i].velocity[k] - nominal.velocity[k] : 0.0;
+    }
+    if (ok) {
+      ++sums.samples;
+    } else {
+      ++sums.failed;
+    }
+  }
+  for (auto &dk : dev.d) {
+    std::fill(dk.begin() + static_cast<std::ptrdiff_t>(m),
+              dk.begin() + static_cast<std::ptrdiff_t>(padded), 0.0);
+  }
+
+  for (std::size_t i = 0; i < padded; i += lanes) {
+    std::size_t p = 0;
+    for (std::size_t k = 0; k < 6; ++k) {
+      const double *dk = dev.d[k].data() + i;
+      for (std::size_t j = 0; j < lanes; ++j) {
+        sums.first[k][j] += dk[j];
+      }
+      for (std::size_t l = k; l < 6; ++l, ++p) {
+        const double *dl = dev.d[l].data() + i;
+        for (std::size_t j = 0; j < lanes; ++j) {
+          sums.second[p][j] += dk[j] * dl[j];
+        }
+      }
+    }
+  }
+
+  if (!histogram) {
+    return;
+  }
+  const auto &x = dev.d[0];
+  const auto &y = dev.d[1];
+  const auto &z = dev.d[2];
+  for (std::size_t i = 0; i < m; ++i) {
+    dev.bin[i] = distance_bin(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+  }
+  for (std::size_t i = 0; i < m; ++i) {
+    if (errors[i] == Sgp4Errc::kOk) {
+      ++sums.histogram[static_cast<std::size_t>(dev.bin[i])];
+    }
+  }
+}
+
+[[nodiscard]] std::size_t resolve_workers(
+    const MonteCarloOptions &options) noexcept {
+  const auto batches = (options.samples + batch - 1) / batch;
+  return std::max<std::size_t>(
+      std::min(resolve_threads(options.threads), batches), 1);
+}
+
+/// @brief Samples of worker's batches, every threads-th batch
+void run_worker(const ElementCloud &cloud,
+                std::span<const std::chrono::system_clock::time_point> times,
+                std::span<const TemeState> nominal,
+                std::span<const Sgp4Errc> nominal_errc, std::size_t samples,
+                std::size_t worker, std::size_t threads,
+                std::vector<Sums> &sums) {
+  sums.assign(times.size(), {});
+  std::array<Tle, batch> tles;
+  std::array<Sgp4State, batch> states;
+  std::array<TemeState, batch> teme;
+  std::array<Sgp4Errc, batch> errors;
+  Deviations dev;
+  std::size_t init_failed = 0;
+  for (auto begin = worker * batch; begin < samples;
+       begin += threads * batch) {
+    const auto n = std::min(batch, samples - begin);
+    cloud.Sample(begin, std::span(tles).first(n));
+    std::size_t m = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      if (InitSgp4(tles[i], states[m]) == Sgp4Errc::kOk) {
+        ++m;
+      }
+    }
+    init_failed += n - m;
+    for (std::size_t t = 0; t < times.size(); ++t) {
+      const auto valid = std::span(states).first(m);
+      PropagateSgp4(valid, times[t], std::span(teme).first(m),
+                    std::span(errors).first(m));
+      dispatch([&] {
+        accumulate(std::span(teme).first(m), std::span(errors).first(m),
+                   nominal[t], nominal_errc[t] == Sgp4Errc::kOk, dev,
+                   sums[t]);
+      });
+    }
+  }
+  for (auto &s : sums) {
+    s.failed += init_failed;
+  }
+}
+}  // namespace
+
+[[nodiscard]] ElementCovariance ToCovariance(
+    const ElementSigmas &sigmas) noexcept {
+  const Elements s{sigmas.inclination,         sigmas.raan,
+                   sigmas.eccentricity,        sigmas.argument_of_perigee,
+                   sigmas.mean_anomaly,        sigmas.mean_motion,
+                   sigmas.bstar};
+  ElementCovariance c{};
+  for (std::size_t i = 0; i < tle_elements; ++i) {
+    c[i][i] = s[i] * s[i];
+  }
+  return c;
+}
+
+ElementCloud::ElementCloud(const Tle &nominal,
+                           const ElementCovariance &covariance,
+                           std::uint64_t seed)
+    : nominal_{nominal}, cholesky_{cholesky(covariance)}, seed_{mix(seed)} {}
+
+[[nodiscard]] Tle ElementCloud::operator[](std::uint64_t i) const noexcept {
+  const auto z = normals(seed_, i);
+  auto x = get_elements(nominal_);
+  for (std::size_t r = 0; r < tle_elements; ++r) {
+    for (std::size_t k = 0; k <= r; ++k) {
+      x[r] += cholesky_[r][k] * z[k];
+    }
+  }
+  Tle tle = nominal_;
+  set_elements(normalize_elements(x), tle);
+  return tle;
+}
+
+void ElementCloud::Sample(std::uint64_t first,
+                          std::span<Tle> out) const noexcept {
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = (*this)[first + i];
+  }
+}
+
+[[nodiscard]] double MonteCarloStats::DistancePercentile(
+    double p) const noexcept {
+  std::uint64_t total = 0;
+  for (const auto count : distance_histogram) {
+    total += count;
+  }
+  if (total == 0 || nominal_errc != Sgp4Errc::kOk) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  const double target = std::clamp(p, 0.0, 1.0) * static_cast<double>(total);
+  // bin b covers squared distances 2^octave * [1 + j / n, 1 + (j + 1) / n)
+  constexpr auto n = static_cast<double>(bins_per_octave);
+  auto squared = [](std::size_t b, double fraction) {
+    const auto octave =
+        min_octave + static_cast<int>(b / bins_per_octave);
+    const auto j = static_cast<double>(b % bins_per_octave);
+    return std::ldexp(1.0 + (j + fraction) / n, octave);
+  };
+  double below = 0.0;
+  for (std::size_t b = 0; b < bins; ++b) {
+    const auto count = static_cast<double>(distance_histogram[b]);
+    if (count > 0.0 && below + count >= target) {
+      return std::sqrt(squared(b, (target - below) / count));
+    }
+    below += count;
+  }
+  return std::sqrt(squared(bins - 1, 1.0));
+}
+
+[[nodiscard]] std::vector<MonteCarloStats> PropagateMonteCarlo(
+    const ElementCloud &cloud,
+    std::span<const std::chrono::system_clock::time_point> times,
+    const MonteCarloOptions &options) {
+  std::vector<MonteCarloStats> stats(times.size());
+  std::vector<TemeState> nominal(times.size());
+  std::vector<Sgp4Errc> nominal_errc(times.size(), Sgp4Errc::kOk);
+  Sgp4State state{};
+  const auto init = InitSgp4(cloud.nominal(), state);
+  if (init == Sgp4Errc::kOk) {
+    for (std::size_t t = 0; t < times.size(); ++t) {
+      nominal_errc[t] = PropagateSgp4(
+          state, MinutesSinceEpoch(state, times[t]), nominal[t]);
+    }
+  } else {
+    std::fill(nominal_errc.begin(), nominal_errc.end(), init);
+  }
+  for (std::size_t t = 0; t < times.size(); ++t) {
+    if (nominal_errc[t] != Sgp4Errc::kOk) {
+      nominal[t] = {};
+    }
+  }
+
+  const auto threads = resolve_workers(options);
+  std::vector<std::vector<Sums>> sums(threads);
+  parallel_for(threads, threads, [&](std::size_t w) {
+    run_worker(cloud, times, nominal, nominal_errc, options.samples, w,
+               threads, sums[w]);
+  });
+
+  for (std::size_t t = 0; t < times.size(); ++t) {
+    Sums total;
+    for (const auto &s : sums) {
+      if (!s.empty()) {
+        total.Add(s[t]);
+      }
+    }
+    auto &out = stats[t];
+    out.time = times[t];
+    out.samples = total.samples;
+    out.failed = total.failed;
+    out.nominal = nominal[t];
+    out.nominal_errc = nominal_errc[t];
+    out.distance_histogram = total.histogram;
+    const std::array<double, 6> reference{
+        nominal[t].position[0], nominal[t].position[1],
+        nominal[t].position[2], nominal[t].velocity[0],
+        nominal[t].velocity[1], nominal[t].velocity[2]};
+    if (total.samples == 0) {
+      out.mean.fill(std::numeric_limits<double>::quiet_NaN());
+      for (auto &row : out.covariance) {
+        row.fill(std::numeric_limits<double>::quiet_NaN());
+      }
+      continue;
+    }
+    const auto n = static_cast<double>(total.samples);
+    std::array<double, 6> first{};
+    for (std::size_t k = 0; k < 6; ++k) {
+      first[k] = lane_sum(total.first[k]);
+      out.mean[k] = reference[k] + first[k] / n;
+    }
+    std::size_t p = 0;
+    for (std::size_t k = 0; k < 6; ++k) {
+      for (std::size_t l = k; l < 6; ++l, ++p) {
+        const double second = lane_sum(total.second[p]);
+        const double c = total.samples > 1
+                             ? (second - first[k] * first[l] / n) / (n - 1.0)
+                             : 0.0;
+        out.covariance[k][l] = c;
+        out.covariance[l][k] = c;
+      }
+    }
+  }
+  return stats;
+}
+
+[[nodiscard]] std::size_t MonteCarloBytes(
+    std::size_t times, const MonteCarloOptions &options) noexcept {
+  constexpr std::size_t worker_buffers =
+      batch * (sizeof(Tle) + sizeof(Sgp4State) + sizeof(TemeState) +
+               sizeof(Sgp4Errc)) +
+      sizeof(Deviations);
+  return resolve_workers(options) * (worker_buffers + times * sizeof(Sums)) +
+         times * (sizeof(MonteCarloStats) + sizeof(TemeState) +
+                  sizeof(Sgp4Errc));
+}
+
+[[nodiscard]] std::vector<MonteCarloStats> PropagateMonteCarlo(
+    const Tle &tle, const ElementCovariance &covariance,
+    std::span<const std::chrono::system_clock::time_point> times,
+    const MonteCarloOptions &options) {
+  return PropagateMonteCarlo(ElementCloud(tle, covariance, options.seed),
+                             times, options);
+}
+}  // namespace eob
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Fork-join helpers for the batch functions, threads are created per call.
+
+namespace eob {
+/// @brief threads, or std::thread::hardware_concurrency() for 0
+[[nodiscard]] inline std::size_t resolve_threads(std::size_t threads) noexcept {
+  return threads > 0 ? threads
+                     : std::max<std::size_t>(
+                           std::thread::hardware_concurrency(), 1);
+}
+
+/// @brief fn(i) for i in [0, count) on up to threads threads, the calling
+/// thread included
+///
+/// Rethrows the first exception fn threw once all threads are done.
+template <typename F>
+void parallel_for(std::size_t count, std::size_t threads, const F &fn) {
+  std::atomic<std::size_t> next{0};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto work = [&] {
+    for (auto i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+      try {
+        fn(i);
+      } catch (...) {
+        const std::lock_guard lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        next = count;
+      }
+    }
+  };
+  {
+    std::vector<std::jthread> helpers;
+    for (std::size_t t = 1; t < std::min(threads, count); ++t) {
+      helpers.emplace_back(work);
+    }
+    work();
+  }  // joined
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+}  // namespace eob
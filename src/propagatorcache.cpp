@@ -0,0 +1,217 @@
+#include "earthorbits/propagatorcache.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace eob {
+namespace {
+struct PropagatorKeyHash {
+  [[nodiscard]] std::size_t operator()(
+      const PropagatorKey &key) const noexcept {
+    // splitmix64 finalizer over the fields, shards use the high bits and
+    // the map the low bits so both need to be well mixed
+    auto mix = [](std::uint64_t z) {
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+      return z ^ (z >> 31);
+    };
+    auto h = mix(static_cast<std::uint64_t>(key.satellite_number) << 32 |
+                 static_cast<std::uint32_t>(key.element_number));
+    h = mix(h ^ static_cast<std::uint64_t>(key.epoch_year));
+    h = mix(h ^ std::bit_cast<std::uint64_t>(key.epoch_day));
+    return static_cast<std::size_t>(h);
+  }
+};
+
+constexpr std::uint32_t npos = UINT32_MAX;
+
+/// smaller caches use fewer shards
+constexpr std::size_t min_shard_capacity = 256;
+
+/// approximate size of an unordered_map node plus its bucket
+constexpr std::size_t map_entry_bytes =
+    sizeof(PropagatorKey) + sizeof(std::uint32_t) + 3 * sizeof(void *);
+}  // namespace
+
+[[nodiscard]] PropagatorKey MakePropagatorKey(const Tle &tle) noexcept {
+  return PropagatorKey{
+      .satellite_number = tle.line_1.satellite_number,
+      .element_number = tle.line_1.element_number,
+      .epoch_year = tle.line_1.epoch_year,
+      .epoch_day = tle.line_1.epoch_day,
+  };
+}
+
+/// @brief Fixed capacity pool with an intrusive LRU list, head is the most
+/// recently used entry
+struct PropagatorCache::Shard {
+  struct Entry {
+    PropagatorKey key;
+    std::uint32_t prev;
+    std::uint32_t next;
+    Sgp4State state;
+  };
+
+  mutable std::mutex mutex;
+  std::vector<Entry> entries;  // reserved to capacity, never reallocates
+  std::unordered_map<PropagatorKey, std::uint32_t, PropagatorKeyHash> slots;
+  std::size_t capacity = 0;
+  std::uint32_t head = npos;
+  std::uint32_t tail = npos;
+  std::uint64_t hits = 0;
+  std::uint64_t misses = 0;
+  std::uint64_t evictions = 0;
+
+  void Unlink(std::uint32_t i) noexcept {
+    auto &e = entries[i];
+    (e.prev == npos ? head : entries[e.prev].next) = e.next;
+    (e.next == npos ? tail : entries[e.next].prev) = e.prev;
+  }
+
+  void PushFront(std::uint32_t i) noexcept {
+    auto &e = entries[i];
+    e.prev = npos;
+    e.next = head;
+    (head == npos ? tail : entries[head].prev) = i;
+    head = i;
+  }
+
+  /// @brief Slot for a new entry, evicting the least recently used if full
+  [[nodiscard]] std::uint32_t Allocate() {
+    if (entries.size() < capacity) {
+      entries.emplace_back();
+      return static_cast<std::uint32_t>(entries.size() - 1);
+    }
+    const auto victim = tail;
+    Unlink(victim);
+    slots.erase(entries[victim].key);
+    ++evictions;
+    return victim;
+  }
+};
+
+PropagatorCache::PropagatorCache(std::size_t capacity, std::size_t shards)
+    : shard_count_{std::clamp<std::size_t>(
+          shards, 1, std::max<std::size_t>(capacity / min_shard_capacity, 1))} {
+  shards_ = std::make_unique<Shard[]>(shard_count_);
+  auto per_shard =
+      std::max<std::size_t>((capacity + shard_count_ - 1) / shard_count_, 1);
+  if (shard_count_ > 1) {
+    // keys don't hash evenly, without headroom busy shards would evict
+    // long before the cache is full
+    per_shard += static_cast<std::size_t>(
+        4.0 * std::sqrt(static_cast<double>(per_shard)));
+  }
+  for (std::size_t i = 0; i < shard_count_; ++i) {
+    shards_[i].capacity = per_shard;
+    shards_[i].entries.reserve(per_shard);
+    shards_[i].slots.reserve(per_shard);
+  }
+}
+
+PropagatorCache::~PropagatorCache() = default;
+PropagatorCache::PropagatorCache(PropagatorCache &&other) noexcept
+    : shards_{std::move(other.shards_)},
+      shard_count_{std::exchange(other.shard_count_, 0)} {}
+
+PropagatorCache &PropagatorCache::operator=(PropagatorCache &&other) noexcept {
+  if (this != &other) {
+    shards_ = std::move(other.shards_);
+    shard_count_ = std::exchange(other.shard_count_, 0);
+  }
+  return *this;
+}
+
+[[nodiscard]] PropagatorCache::Shard &PropagatorCache::shard(
+    std::size_t hash) const noexcept {
+  return shards_[(hash >> 32) % shard_count_];
+}
+
+[[nodiscard]] Sgp4Errc PropagatorCache::Get(const Tle &tle, Sgp4State &state) {
+  const auto key = MakePropagatorKey(tle);
+  const auto hash = PropagatorKeyHash{}(key);
+  auto &s = shard(hash);
+  {
+    const std::lock_guard lock(s.mutex);
+    if (auto it = s.slots.find(key); it != s.slots.end()) {
+      ++s.hits;
+      s.Unlink(it->second);
+      s.PushFront(it->second);
+      state = s.entries[it->second].state;
+      return Sgp4Errc::kOk;
+    }
+    ++s.misses;
+  }
+
+  Sgp4State initialized;
+  if (auto err = InitSgp4(tle, initialized); err != Sgp4Errc::kOk) {
+    return err;
+  }
+
+  const std::lock_guard lock(s.mutex);
+  // another thread may have inserted the key while we initialized
+  if (s.slots.find(key) == s.slots.end()) {
+    const auto slot = s.Allocate();
+    s.entries[slot].key = key;
+    s.entries[slot].state = initialized;
+    s.PushFront(slot);
+    s.slots.emplace(key, slot);
+  }
+  state = initialized;
+  return Sgp4Errc::kOk;
+}
+
+[[nodiscard]] Sgp4Errc PropagatorCache::Propagate(const Tle &tle,
+                                                  double minutes,
+                                                  TemeState &teme) {
+  Sgp4State state;
+  if (auto err = Get(tle, state); err != Sgp4Errc::kOk) {
+    return err;
+  }
+  return PropagateSgp4(state, minutes, teme);
+}
+
+[[nodiscard]] bool PropagatorCache::Contains(const PropagatorKey &key) const {
+  auto &s = shard(PropagatorKeyHash{}(key));
+  const std::lock_guard lock(s.mutex);
+  return s.slots.contains(key);
+}
+
+void PropagatorCache::Clear() {
+  for (std::size_t i = 0; i < shard_count_; ++i) {
+    auto &s = shards_[i];
+    const std::lock_guard lock(s.mutex);
+    s.entries.clear();
+    s.slots.clear();
+    s.head = npos;
+    s.tail = npos;
+  }
+}
+
+[[nodiscard]] PropagatorCacheStats PropagatorCache::Stats() const {
+  PropagatorCacheStats stats;
+  for (std::size_t i = 0; i < shard_count_; ++i) {
+    const auto &s = shards_[i];
+    const std::lock_guard lock(s.mutex);
+    stats.hits += s.hits;
+    stats.misses += s.misses;
+    stats.evictions += s.evictions;
+    stats.size += s.entries.size();
+    stats.capacity += s.capacity;
+  }
+  stats.bytes = stats.size * bytes_per_entry();
+  return stats;
+}
+
+[[nodiscard]] std::size_t PropagatorCache::bytes_per_entry() noexcept {
+  return sizeof(Shard::Entry) + map_entry_bytes;
+}
+}  // namespace eob
@@ -0,0 +1,1156 @@
+#include "earthorbits/sgp4.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include "constants.h"
+#include "dispatch.h"
+#include "date/date.h"
+#include "earthorbits/instrumentation.h"
+#include "earthorbits/timescales.h"
+
+/// SGP4 as in Vallado et al., "Revisiting Spacetrack Report #3", including
+/// the later fixes of the reference implementation. Variable names follow
+/// the reference so the two can be compared line by line.
+/// @see https://celestrak.org/publications/AIAA/2006-6753/
+
+namespace eob {
+namespace {
+constexpr double deg_to_rad = std::numbers::pi / 180.0;
+constexpr double x2o3 = 2.0 / 3.0;
+
+// WGS-72 zonal harmonics
+constexpr double j2 = 0.001082616;
+constexpr double j3 = -0.00000253881;
+constexpr double j4 = -0.00000165597;
+constexpr double j3oj2 = j3 / j2;
+
+/// @brief sqrt(mu) in Earth radii^1.5 / minute
+[[nodiscard]] double xke() noexcept {
+  static const double value =
+      60.0 / std::sqrt(wgs72_earth_radius_km * wgs72_earth_radius_km *
+                       wgs72_earth_radius_km / wgs72_mu_km3_per_s2);
+  return value;
+}
+
+/// orbits with longer periods, minutes, need the deep space terms
+constexpr double deep_space_period = 225.0;
+
+// lunar-solar constants of dscom and dpper, mean motions in radians /
+// minute and eccentricities of the solar and lunar orbits
+constexpr double zns = 1.19459e-5;
+constexpr double zes = 0.01675;
+constexpr double znl = 1.5835218e-4;
+constexpr double zel = 0.05490;
+/// Earth rotation rate, radians / minute
+constexpr double rptim = 4.37526908801129966e-3;
+
+/// @brief Greenwich sidereal angle at the Julian date jdut1, radians
+[[nodiscard]] double gstime(double jdut1) noexcept {
+  const double tut1 = (jdut1 - 2451545.0) / 36525.0;
+  double temp = -6.2e-6 * tut1 * tut1 * tut1 + 0.093104 * tut1 * tut1 +
+                (876600.0 * 3600.0 + 8640184.812866) * tut1 + 67310.54841;
+  temp = std::fmod(temp * deg_to_rad / 240.0, pi2);
+  return temp < 0.0 ? temp + pi2 : temp;
+}
+
+/// @brief Terms of the sun or the moon in dscom
+struct DscomBody {
+  double s1;
+  double s2;
+  double s3;
+  double s4;
+  double s5;
+  double s6;
+  double s7;
+  double z1;
+  double z2;
+  double z3;
+  double z11;
+  double z12;
+  double z13;
+  double z21;
+  double z22;
+  double z23;
+  double z31;
+  double z32;
+  double z33;
+};
+
+/// @brief What dsinit needs of dscom, ss and sz of the reference are the
+/// solar terms, s and z the lunar ones
+struct Dscom {
+  double sinim;
+  double cosim;
+  double emsq;
+  DscomBody solar;
+  DscomBody lunar;
+};
+
+/// @brief Lunar-solar terms at the epoch, the reference's dscom
+///
+/// @param epoch days since 1950 January 0.0
+/// Writes the periodic coefficients to deep.
+[[nodiscard]] Dscom dscom(double epoch, const Sgp4State &s,
+                          BasicDeepSpaceTerms<double> &deep) noexcept {
+  constexpr double c1ss = 2.9864797e-6;
+  constexpr double c1l = 4.7968065e-7;
+  constexpr double zsinis = 0.39785416;
+  constexpr double zcosis = 0.91744867;
+  constexpr double zcosgs = 0.1945905;
+  constexpr double zsings = -0.98088458;
+
+  Dscom c{};
+  const double snodm = std::sin(s.raan);
+  const double cnodm = std::cos(s.raan);
+  const double sinomm = std::sin(s.argument_of_perigee);
+  const double cosomm = std::cos(s.argument_of_perigee);
+  c.sinim = std::sin(s.inclination);
+  c.cosim = std::cos(s.inclination);
+  const double em = s.eccentricity;
+  c.emsq = em * em;
+  const double betasq = 1.0 - c.emsq;
+  const double rtemsq = std::sqrt(betasq);
+
+  // lunar orbit
+  const double day = epoch + 18261.5;
+  const double xnodce = std::fmod(4.5236020 - 9.2422029e-4 * day, pi2);
+  const double stem = std::sin(xnodce);
+  const double ctem = std::cos(xnodce);
+  const double zcosil = 0.91375164 - 0.03568096 * ctem;
+  const double zsinil = std::sqrt(1.0 - zcosil * zcosil);
+  const double zsinhl = 0.089683511 * stem / zsinil;
+  const double zcoshl = std::sqrt(1.0 - zsinhl * zsinhl);
+  const double gam = 5.8351514 + 0.0019443680 * day;
+  double zx = 0.39785416 * stem / zsinil;
+  const double zy = zcoshl * ctem + 0.91744867 * zsinhl * stem;
+  zx = std::atan2(zx, zy);
+  zx = gam + zx - xnodce;
+  const double zcosgl = std::cos(zx);
+  const double zsingl = std::sin(zx);
+
+  const double xnoi = 1.0 / s.mean_motion;
+  const auto body = [&](double zcosg, double zsing, double zcosi,
+                        double zsini, double zcosh, double zsinh,
+                        double cc) noexcept {
+    const double a1 = zcosg * zcosh + zsing * zcosi * zsinh;
+    const double a3 = -zsing * zcosh + zcosg * zcosi * zsinh;
+    const double a7 = -zcosg * zsinh + zsing * zcosi * zcosh;
+    const double a8 = zsing * zsini;
+    const double a9 = zsing * zsinh + zcosg * zcosi * zcosh;
+    const double a10 = zcosg * zsini;
+    const double a2 = c.cosim * a7 + c.sinim * a8;
+    const double a4 = c.cosim * a9 + c.sinim * a10;
+    const double a5 = -c.sinim * a7 + c.cosim * a8;
+    const double a6 = -c.sinim * a9 + c.cosim * a10;
+
+    const double x1 = a1 * cosomm + a2 * sinomm;
+    const double x2 = a3 * cosomm + a4 * sinomm;
+    const double x3 = -a1 * sinomm + a2 * cosomm;
+    const double x4 = -a3 * sinomm + a4 * cosomm;
+    const double x5 = a5 * sinomm;
+    const double x6 = a6 * sinomm;
+    const double x7 = a5 * cosomm;
+    const double x8 = a6 * cosomm;
+
+    DscomBody b{};
+    const double emsq = c.emsq;
+    b.z31 = 12.0 * x1 * x1 - 3.0 * x3 * x3;
+    b.z32 = 24.0 * x1 * x2 - 6.0 * x3 * x4;
+    b.z33 = 12.0 * x2 * x2 - 3.0 * x4 * x4;
+    b.z1 = 3.0 * (a1 * a1 + a2 * a2) + b.z31 * emsq;
+    b.z2 = 6.0 * (a1 * a3 + a2 * a4) + b.z32 * emsq;
+    b.z3 = 3.0 * (a3 * a3 + a4 * a4) + b.z33 * emsq;
+    b.z11 = -6.0 * a1 * a5 + emsq * (-24.0 * x1 * x7 - 6.0 * x3 * x5);
+    b.z12 = -6.0 * (a1 * a6 + a3 * a5) +
+            emsq * (-24.0 * (x2 * x7 + x1 * x8) - 6.0 * (x3 * x6 + x4 * x5));
+    b.z13 = -6.0 * a3 * a6 + emsq * (-24.0 * x2 * x8 - 6.0 * x4 * x6);
+    b.z21 = 6.0 * a2 * a5 + emsq * (24.0 * x1 * x5 - 6.0 * x3 * x7);
+    b.z22 = 6.0 * (a4 * a5 + a2 * a6) +
+            emsq * (24.0 * (x2 * x5 + x1 * x6) - 6.0 * (x4 * x7 + x3 * x8));
+    b.z23 = 6.0 * a4 * a6 + emsq * (24.0 * x2 * x6 - 6.0 * x4 * x8);
+    b.z1 = b.z1 + b.z1 + betasq * b.z31;
+    b.z2 = b.z2 + b.z2 + betasq * b.z32;
+    b.z3 = b.z3 + b.z3 + betasq * b.z33;
+    b.s3 = cc * xnoi;
+    b.s2 = -0.5 * b.s3 / rtemsq;
+    b.s4 = b.s3 * rtemsq;
+    b.s1 = -15.0 * em * b.s4;
+    b.s5 = x1 * x3 + x2 * x4;
+    b.s6 = x2 * x3 + x1 * x4;
+    b.s7 = x2 * x4 - x1 * x3;
+    return b;
+  };
+  c.solar = body(zcosgs, zsings, zcosis, zsinis, cnodm, snodm, c1ss);
+  c.lunar = body(zcosgl, zsingl, zcosil, zsinil,
+                 zcoshl * cnodm + zsinhl * snodm,
+                 snodm * zcoshl - cnodm * zsinhl, c1l);
+
+  deep.zmol = std::fmod(4.7199672 + 0.22997150 * day - gam, pi2);
+  deep.zmos = std::fmod(6.2565837 + 0.017201977 * day, pi2);
+
+  const auto &ss = c.solar;
+  deep.se2 = 2.0 * ss.s1 * ss.s6;
+  deep.se3 = 2.0 * ss.s1 * ss.s7;
+  deep.si2 = 2.0 * ss.s2 * ss.z12;
+  deep.si3 = 2.0 * ss.s2 * (ss.z13 - ss.z11);
+  deep.sl2 = -2.0 * ss.s3 * ss.z2;
+  deep.sl3 = -2.0 * ss.s3 * (ss.z3 - ss.z1);
+  deep.sl4 = -2.0 * ss.s3 * (-21.0 - 9.0 * c.emsq) * zes;
+  deep.sgh2 = 2.0 * ss.s4 * ss.z32;
+  deep.sgh3 = 2.0 * ss.s4 * (ss.z33 - ss.z31);
+  deep.sgh4 = -18.0 * ss.s4 * zes;
+  deep.sh2 = -2.0 * ss.s2 * ss.z22;
+  deep.sh3 = -2.0 * ss.s2 * (ss.z23 - ss.z21);
+
+  const auto &l = c.lunar;
+  deep.ee2 = 2.0 * l.s1 * l.s6;
+  deep.e3 = 2.0 * l.s1 * l.s7;
+  deep.xi2 = 2.0 * l.s2 * l.z12;
+  deep.xi3 = 2.0 * l.s2 * (l.z13 - l.z11);
+  deep.xl2 = -2.0 * l.s3 * l.z2;
+  deep.xl3 = -2.0 * l.s3 * (l.z3 - l.z1);
+  deep.xl4 = -2.0 * l.s3 * (-21.0 - 9.0 * c.emsq) * zel;
+  deep.xgh2 = 2.0 * l.s4 * l.z32;
+  deep.xgh3 = 2.0 * l.s4 * (l.z33 - l.z31);
+  deep.xgh4 = -18.0 * l.s4 * zel;
+  deep.xh2 = -2.0 * l.s2 * l.z22;
+  deep.xh3 = -2.0 * l.s2 * (l.z23 - l.z21);
+  return c;
+}
+
+/// @brief Lunar-solar secular rates and resonance terms, the reference's
+/// dsinit at the epoch
+void dsinit(const Sgp4State &s, const Dscom &c,
+            BasicDeepSpaceTerms<double> &deep) noexcept {
+  constexpr double q22 = 1.7891679e-6;
+  constexpr double q31 = 2.1460748e-6;
+  constexpr double q33 = 2.2123015e-7;
+  constexpr double root22 = 1.7891679e-6;
+  constexpr double root44 = 7.3636953e-9;
+  constexpr double root54 = 2.1765803e-9;
+  constexpr double root32 = 3.7393792e-7;
+  constexpr double root52 = 1.1428639e-7;
+  /// within 3 degrees of equatorial the node is undefined
+  constexpr double min_inclination = 5.2359877e-2;
+
+  const double nm = s.mean_motion;
+  const double em = s.eccentricity;
+  const double emsq = c.emsq;
+  const double sinim = c.sinim;
+  const double cosim = c.cosim;
+  deep.irez = 0;
+  if (nm < 0.0052359877 && nm > 0.0034906585) {
+    deep.irez = 1;
+  }
+  if (nm >= 8.26e-3 && nm <= 9.24e-3 && em >= 0.5) {
+    deep.irez = 2;
+  }
+  const bool equatorial = s.inclination < min_inclination ||
+                          s.inclination > std::numbers::pi - min_inclination;
+
+  // solar terms
+  const auto &ss = c.solar;
+  const double ses = ss.s1 * zns * ss.s5;
+  const double sis = ss.s2 * zns * (ss.z11 + ss.z13);
+  const double sls = -zns * ss.s3 * (ss.z1 + ss.z3 - 14.0 - 6.0 * emsq);
+  const double sghs = ss.s4 * zns * (ss.z31 + ss.z33 - 6.0);
+  double shs = equatorial ? 0.0 : -zns * ss.s2 * (ss.z21 + ss.z23);
+  if (sinim != 0.0) {
+    shs = shs / sinim;
+  }
+  const double sgs = sghs - cosim * shs;
+
+  // lunar terms
+  const auto &l = c.lunar;
+  deep.dedt = ses + l.s1 * znl * l.s5;
+  deep.didt = sis + l.s2 * znl * (l.z11 + l.z13);
+  deep.dmdt = sls - znl * l.s3 * (l.z1 + l.z3 - 14.0 - 6.0 * emsq);
+  const double sghl = l.s4 * znl * (l.z31 + l.z33 - 6.0);
+  const double shll = equatorial ? 0.0 : -znl * l.s2 * (l.z21 + l.z23);
+  deep.domdt = sgs + sghl;
+  deep.dnodt = shs;
+  if (sinim != 0.0) {
+    deep.domdt = deep.domdt - cosim / sinim * shll;
+    deep.dnodt = deep.dnodt + shll / sinim;
+  }
+
+  if (deep.irez == 0) {
+    return;
+  }
+  const double theta = std::fmod(deep.gsto, pi2);
+  const double aonv = std::pow(nm / xke(), x2o3);
+
+  // geopotential resonance for 12 hour orbits
+  if (deep.irez == 2) {
+    const double cosisq = cosim * cosim;
+    const double eoc = em * emsq;
+    const double g201 = -0.306 - (em - 0.64) * 0.440;
+    double g211 = 0.0;
+    double g310 = 0.0;
+    double g322 = 0.0;
+    double g410 = 0.0;
+    double g422 = 0.0;
+    double g520 = 0.0;
+    if (em <= 0.65) {
+      g211 = 3.616 - 13.2470 * em + 16.2900 * emsq;
+      g310 = -19.302 + 117.3900 * em - 228.4190 * emsq + 156.5910 * eoc;
+      g322 = -18.9068 + 109.7927 * em - 214.6334 * emsq + 146.5816 * eoc;
+      g410 = -41.122 + 242.6940 * em - 471.0940 * emsq + 313.9530 * eoc;
+      g422 = -146.407 + 841.8800 * em - 1629.014 * emsq + 1083.4350 * eoc;
+      g520 = -532.114 + 3017.977 * em - 5740.032 * emsq + 3708.2760 * eoc;
+    } else {
+      g211 = -72.099 + 331.819 * em - 508.738 * emsq + 266.724 * eoc;
+      g310 = -346.844 + 1582.851 * em - 2415.925 * emsq + 1246.113 * eoc;
+      g322 = -342.585 + 1554.908 * em - 2366.899 * emsq + 1215.972 * eoc;
+      g410 = -1052.797 + 4758.686 * em - 7193.992 * emsq + 3651.957 * eoc;
+      g422 = -3581.690 + 16178.110 * em - 24462.770 * emsq + 12422.520 * eoc;
+      if (em > 0.715) {
+        g520 = -5149.66 + 29936.92 * em - 54087.36 * emsq + 31324.56 * eoc;
+      } else {
+        g520 = 1464.74 - 4664.75 * em + 3763.64 * emsq;
+      }
+    }
+    double g533 = 0.0;
+    double g521 = 0.0;
+    double g532 = 0.0;
+    if (em < 0.7) {
+      g533 = -919.22770 + 4988.6100 * em - 9064.7700 * emsq + 5542.21 * eoc;
+      g521 = -822.71072 + 4568.6173 * em - 8491.4146 * emsq + 5337.524 * eoc;
+      g532 = -853.66600 + 4690.2500 * em - 8624.7700 * emsq + 5341.4 * eoc;
+    } else {
+      g533 = -37995.780 + 161616.52 * em - 229838.20 * emsq + 109377.94 * eoc;
+      g521 = -51752.104 + 218913.95 * em - 309468.16 * emsq + 146349.42 * eoc;
+      g532 = -40023.880 + 170470.89 * em - 242699.48 * emsq + 115605.82 * eoc;
+    }
+
+    const double sini2 = sinim * sinim;
+    const double f220 = 0.75 * (1.0 + 2.0 * cosim + cosisq);
+    const double f221 = 1.5 * sini2;
+    const double f321 = 1.875 * sinim * (1.0 - 2.0 * cosim - 3.0 * cosisq);
+    const double f322 = -1.875 * sinim * (1.0 + 2.0 * cosim - 3.0 * cosisq);
+    const double f441 = 35.0 * sini2 * f220;
+    const double f442 = 39.3750 * sini2 * sini2;
+    const double f522 =
+        9.84375 * sinim *
+        (sini2 * (1.0 - 2.0 * cosim - 5.0 * cosisq) +
+         0.33333333 * (-2.0 + 4.0 * cosim + 6.0 * cosisq));
+    const double f523 =
+        sinim * (4.92187512 * sini2 * (-2.0 - 4.0 * cosim + 10.0 * cosisq) +
+                 6.56250012 * (1.0 + 2.0 * cosim - 3.0 * cosisq));
+    const double f542 =
+        29.53125 * sinim *
+        (2.0 - 8.0 * cosim + cosisq * (-12.0 + 8.0 * cosim + 10.0 * cosisq));
+    const double f543 =
+        29.53125 * sinim *
+        (-2.0 - 8.0 * cosim + cosisq * (12.0 + 8.0 * cosim - 10.0 * cosisq));
+    const double xno2 = nm * nm;
+    const double ainv2 = aonv * aonv;
+    double temp1 = 3.0 * xno2 * ainv2;
+    double temp = temp1 * root22;
+    deep.d2201 = temp * f220 * g201;
+    deep.d2211 = temp * f221 * g211;
+    temp1 = temp1 * aonv;
+    temp = temp1 * root32;
+    deep.d3210 = temp * f321 * g310;
+    deep.d3222 = temp * f322 * g322;
+    temp1 = temp1 * aonv;
+    temp = 2.0 * temp1 * root44;
+    deep.d4410 = temp * f441 * g410;
+    deep.d4422 = temp * f442 * g422;
+    temp1 = temp1 * aonv;
+    temp = temp1 * root52;
+    deep.d5220 = temp * f522 * g520;
+    deep.d5232 = temp * f523 * g532;
+    temp = 2.0 * temp1 * root54;
+    deep.d5421 = temp * f542 * g521;
+    deep.d5433 = temp * f543 * g533;
+    deep.xlamo =
+        std::fmod(s.mean_anomaly + s.raan + s.raan - theta - theta, pi2);
+    deep.xfact = s.mdot + deep.dmdt + 2.0 * (s.nodedot + deep.dnodt - rptim) -
+                 s.mean_motion;
+  }
+
+  // synchronous resonance terms
+  if (deep.irez == 1) {
+    const double g200 = 1.0 + emsq * (-2.5 + 0.8125 * emsq);
+    const double g310 = 1.0 + 2.0 * emsq;
+    const double g300 = 1.0 + emsq * (-6.0 + 6.60937 * emsq);
+    const double f220 = 0.75 * (1.0 + cosim) * (1.0 + cosim);
+    const double f311 =
+        0.9375 * sinim * sinim * (1.0 + 3.0 * cosim) - 0.75 * (1.0 + cosim);
+    double f330 = 1.0 + cosim;
+    f330 = 1.875 * f330 * f330 * f330;
+    deep.del1 = 3.0 * nm * nm * aonv * aonv;
+    deep.del2 = 2.0 * deep.del1 * f220 * g200 * q22;
+    deep.del3 = 3.0 * deep.del1 * f330 * g300 * q33 * aonv;
+    deep.del1 = deep.del1 * f311 * g310 * q31 * aonv;
+    deep.xlamo = std::fmod(
+        s.mean_anomaly + s.raan + s.argument_of_perigee - theta, pi2);
+    const double xpidot = s.argpdot + s.nodedot;
+    deep.xfact = s.mdot + xpidot - rptim + deep.dmdt + deep.domdt +
+                 deep.dnodt - s.mean_motion;
+  }
+}
+
+/// @brief Mean elements at t with the lunar-solar secular rates and the
+/// resonances, the reference's dspace
+///
+/// The resonances are integrated from the epoch in steps of 720 minutes.
+/// The reference keeps the integrator between calls, here the state is
+/// const, restarting gives the same result.
+/// @param argpo argument of perigee at the epoch
+/// @param argpdot its secular rate
+/// @param no un-Kozai'd mean motion
+void dspace(const BasicDeepSpaceTerms<double> &deep, double argpo,
+            double argpdot, double no, double t, double &em, double &argpm,
+            double &inclm, double &mm, double &nodem, double &nm) noexcept {
+  constexpr double fasx2 = 0.13130908;
+  constexpr double fasx4 = 2.8843198;
+  constexpr double fasx6 = 0.37448087;
+  constexpr double g22 = 5.7686396;
+  constexpr double g32 = 0.95240898;
+  constexpr double g44 = 1.8014998;
+  constexpr double g52 = 1.0508330;
+  constexpr double g54 = 4.4108898;
+  constexpr double stepp = 720.0;
+  constexpr double stepn = -720.0;
+  constexpr double step2 = 259200.0;
+
+  const double theta = std::fmod(deep.gsto + t * rptim, pi2);
+  em = em + deep.dedt * t;
+  inclm = inclm + deep.didt * t;
+  argpm = argpm + deep.domdt * t;
+  nodem = nodem + deep.dnodt * t;
+  mm = mm + deep.dmdt * t;
+  if (deep.irez == 0) {
+    return;
+  }
+
+  double atime = 0.0;
+  double xni = no;
+  double xli = deep.xlamo;
+  const double delt = t > 0.0 ? stepp : stepn;
+  double xndt = 0.0;
+  double xldot = 0.0;
+  double xnddt = 0.0;
+  double ft = 0.0;
+  while (true) {
+    if (deep.irez != 2) {
+      // near synchronous resonance terms
+      xndt = deep.del1 * std::sin(xli - fasx2) +
+             deep.del2 * std::sin(2.0 * (xli - fasx4)) +
+             deep.del3 * std::sin(3.0 * (xli - fasx6));
+      xldot = xni + deep.xfact;
+      xnddt = deep.del1 * std::cos(xli - fasx2) +
+              2.0 * deep.del2 * std::cos(2.0 * (xli - fasx4)) +
+              3.0 * deep.del3 * std::cos(3.0 * (xli - fasx6));
+      xnddt = xnddt * xldot;
+    } else {
+      // near half day resonance terms
+      const double xomi = argpo + argpdot * atime;
+      const double x2omi = xomi + xomi;
+      const double x2li = xli + xli;
+      xndt = deep.d2201 * std::sin(x2omi + xli - g22) +
+             deep.d2211 * std::sin(xli - g22) +
+             deep.d3210 * std::sin(xomi + xli - g32) +
+             deep.d3222 * std::sin(-xomi + xli - g32) +
+             deep.d4410 * std::sin(x2omi + x2li - g44) +
+             deep.d4422 * std::sin(x2li - g44) +
+             deep.d5220 * std::sin(xomi + xli - g52) +
+             deep.d5232 * std::sin(-xomi + xli - g52) +
+             deep.d5421 * std::sin(xomi + x2li - g54) +
+             deep.d5433 * std::sin(-xomi + x2li - g54);
+      xldot = xni + deep.xfact;
+      xnddt = deep.d2201 * std::cos(x2omi + xli - g22) +
+              deep.d2211 * std::cos(xli - g22) +
+              deep.d3210 * std::cos(xomi + xli - g32) +
+              deep.d3222 * std::cos(-xomi + xli - g32) +
+              deep.d5220 * std::cos(xomi + xli - g52) +
+              deep.d5232 * std::cos(-xomi + xli - g52) +
+              2.0 * (deep.d4410 * std::cos(x2omi + x2li - g44) +
+                     deep.d4422 * std::cos(x2li - g44) +
+                     deep.d5421 * std::cos(xomi + x2li - g54) +
+                     deep.d5433 * std::cos(-xomi + x2li - g54));
+      xnddt = xnddt * xldot;
+    }
+
+    // Euler-Maclaurin integrator
+    if (std::abs(t - atime) < stepp) {
+      ft = t - atime;
+      break;
+    }
+    xli = xli + xldot * delt + xndt * step2;
+    xni = xni + xndt * delt + xnddt * step2;
+    atime = atime + delt;
+  }
+
+  nm = xni + xndt * ft + xnddt * ft * ft * 0.5;
+  const double xl = xli + xldot * ft + xndt * ft * ft * 0.5;
+  if (deep.irez != 1) {
+    mm = xl - 2.0 * nodem + 2.0 * theta;
+  } else {
+    mm = xl - nodem - argpm + theta;
+  }
+  const double dndt = nm - no;
+  nm = no + dndt;
+}
+
+/// @brief Apply the lunar-solar periodics at t, the reference's dpper
+/// after initialization
+void dpper(const BasicDeepSpaceTerms<double> &deep, double t, double &ep,
+           double &inclp, double &nodep, double &argpp, double &mp) noexcept {
+  // solar
+  double zm = deep.zmos + zns * t;
+  double zf = zm + 2.0 * zes * std::sin(zm);
+  double sinzf = std::sin(zf);
+  double f2 = 0.5 * sinzf * sinzf - 0.25;
+  double f3 = -0.5 * sinzf * std::cos(zf);
+  const double ses = deep.se2 * f2 + deep.se3 * f3;
+  const double sis = deep.si2 * f2 + deep.si3 * f3;
+  const double sls = deep.sl2 * f2 + deep.sl3 * f3 + deep.sl4 * sinzf;
+  const double sghs = deep.sgh2 * f2 + deep.sgh3 * f3 + deep.sgh4 * sinzf;
+  const double shs = deep.sh2 * f2 + deep.sh3 * f3;
+
+  // lunar
+  zm = deep.zmol + znl * t;
+  zf = zm + 2.0 * zel * std::sin(zm);
+  sinzf = std::sin(zf);
+  f2 = 0.5 * sinzf * sinzf - 0.25;
+  f3 = -0.5 * sinzf * std::cos(zf);
+  const double sel = deep.ee2 * f2 + deep.e3 * f3;
+  const double sil = deep.xi2 * f2 + deep.xi3 * f3;
+  const double sll = deep.xl2 * f2 + deep.xl3 * f3 + deep.xl4 * sinzf;
+  const double sghl = deep.xgh2 * f2 + deep.xgh3 * f3 + deep.xgh4 * sinzf;
+  const double shll = deep.xh2 * f2 + deep.xh3 * f3;
+
+  // the periodics at the epoch, peo and the like of the reference, are 0
+  const double pe = ses + sel;
+  const double pinc = sis + sil;
+  const double pl = sls + sll;
+  double pgh = sghs + sghl;
+  double ph = shs + shll;
+  inclp = inclp + pinc;
+  ep = ep + pe;
+  const double sinip = std::sin(inclp);
+  const double cosip = std::cos(inclp);
+
+  // with the perturbed inclination, as GSFC does
+  if (inclp >= 0.2) {
+    ph = ph / sinip;
+    pgh = pgh - cosip * ph;
+    argpp = argpp + pgh;
+    nodep = nodep + ph;
+    mp = mp + pl;
+    return;
+  }
+
+  // Lyddane's modification for low inclinations
+  const double sinop = std::sin(nodep);
+  const double cosop = std::cos(nodep);
+  double alfdp = sinip * sinop;
+  double betdp = sinip * cosop;
+  const double dalf = ph * cosop + pinc * cosip * sinop;
+  const double dbet = -ph * sinop + pinc * cosip * cosop;
+  alfdp = alfdp + dalf;
+  betdp = betdp + dbet;
+  nodep = std::fmod(nodep, pi2);
+  double xls = mp + argpp + cosip * nodep;
+  const double dls = pl + pgh - pinc * nodep * sinip;
+  xls = xls + dls;
+  xls = std::fmod(xls, pi2);
+  const double xnoh = nodep;
+  nodep = std::atan2(alfdp, betdp);
+  if (std::abs(xnoh - nodep) > std::numbers::pi) {
+    nodep = nodep < xnoh ? nodep + pi2 : nodep - pi2;
+  }
+  mp = mp + pl;
+  argpp = xls - mp - cosip * nodep;
+}
+
+template <typename To, typename From>
+[[nodiscard]] BasicDeepSpaceTerms<To> convert(
+    const BasicDeepSpaceTerms<From> &d) noexcept {
+  auto f = [](From value) { return static_cast<To>(value); };
+  return BasicDeepSpaceTerms<To>{
+      .irez = d.irez,
+      .gsto = f(d.gsto),
+      .e3 = f(d.e3),
+      .ee2 = f(d.ee2),
+      .se2 = f(d.se2),
+      .se3 = f(d.se3),
+      .sgh2 = f(d.sgh2),
+      .sgh3 = f(d.sgh3),
+      .sgh4 = f(d.sgh4),
+      .sh2 = f(d.sh2),
+      .sh3 = f(d.sh3),
+      .si2 = f(d.si2),
+      .si3 = f(d.si3),
+      .sl2 = f(d.sl2),
+      .sl3 = f(d.sl3),
+      .sl4 = f(d.sl4),
+      .xgh2 = f(d.xgh2),
+      .xgh3 = f(d.xgh3),
+      .xgh4 = f(d.xgh4),
+      .xh2 = f(d.xh2),
+      .xh3 = f(d.xh3),
+      .xi2 = f(d.xi2),
+      .xi3 = f(d.xi3),
+      .xl2 = f(d.xl2),
+      .xl3 = f(d.xl3),
+      .xl4 = f(d.xl4),
+      .zmol = f(d.zmol),
+      .zmos = f(d.zmos),
+      .dedt = f(d.dedt),
+      .didt = f(d.didt),
+      .dmdt = f(d.dmdt),
+      .dnodt = f(d.dnodt),
+      .domdt = f(d.domdt),
+      .d2201 = f(d.d2201),
+      .d2211 = f(d.d2211),
+      .d3210 = f(d.d3210),
+      .d3222 = f(d.d3222),
+      .d4410 = f(d.d4410),
+      .d4422 = f(d.d4422),
+      .d5220 = f(d.d5220),
+      .d5232 = f(d.d5232),
+      .d5421 = f(d.d5421),
+      .d5433 = f(d.d5433),
+      .del1 = f(d.del1),
+      .del2 = f(d.del2),
+      .del3 = f(d.del3),
+      .xfact = f(d.xfact),
+      .xlamo = f(d.xlamo),
+  };
+}
+
+/// @brief The deep space terms of s in double, without a copy for double
+template <typename T>
+[[nodiscard]] decltype(auto) deep_terms(const BasicSgp4State<T> &s) noexcept {
+  if constexpr (std::is_same_v<T, double>) {
+    return (s.deep);
+  } else {
+    return convert<double>(s.deep);
+  }
+}
+
+/// @brief Secular angle at t, accumulated in double
+///
+/// Rates times a week of minutes are hundreds of radians, in float that
+/// alone would be off by ~1e-4 radians. The angle is reduced to a period
+/// before rounding to T, which doesn't matter to SGP4 as every angle only
+/// enters through sin, cos and fmod.
+template <typename T>
+[[nodiscard]] T secular_angle(T at_epoch, T rate, double t) noexcept {
+  const double angle =
+      static_cast<double>(at_epoch) + static_cast<double>(rate) * t;
+  if constexpr (std::is_same_v<T, double>) {
+    return angle;
+  } else {
+    return static_cast<T>(std::fmod(angle, pi2));
+  }
+}
+
+/// @brief T of a deep space angle, reduced to a period for float as in
+/// secular_angle
+template <typename T>
+[[nodiscard]] T deep_angle(double angle) noexcept {
+  if constexpr (std::is_same_v<T, double>) {
+    return angle;
+  } else {
+    return static_cast<T>(std::fmod(angle, pi2));
+  }
+}
+
+/// @brief Lunar-solar secular terms and resonances at minutes, in double
+template <typename T>
+void deep_secular(const BasicSgp4State<T> &s, double minutes, T &em,
+                  T &argpm, T &inclm, T &mm, T &nodem, T &nm) noexcept {
+  const auto &deep = deep_terms(s);
+  const double argpo = s.argument_of_perigee;
+  const double argpdot = s.argpdot;
+  double em_d = em;
+  double argpm_d = argpo + argpdot * minutes;
+  double inclm_d = inclm;
+  double mm_d = static_cast<double>(s.mean_anomaly) +
+                static_cast<double>(s.mdot) * minutes;
+  double nodem_d = static_cast<double>(s.raan) +
+                   static_cast<double>(s.nodedot) * minutes +
+                   static_cast<double>(s.nodecf) * minutes * minutes;
+  double nm_d = nm;
+  dspace(deep, argpo, argpdot, s.mean_motion, minutes, em_d, argpm_d,
+         inclm_d, mm_d, nodem_d, nm_d);
+  em = static_cast<T>(em_d);
+  argpm = deep_angle<T>(argpm_d);
+  inclm = static_cast<T>(inclm_d);
+  mm = deep_angle<T>(mm_d);
+  nodem = deep_angle<T>(nodem_d);
+  nm = static_cast<T>(nm_d);
+}
+
+/// @brief Lunar-solar periodics at minutes, in double
+template <typename T>
+[[nodiscard]] Sgp4Errc deep_periodics(const BasicSgp4State<T> &s,
+                                      double minutes, T &em, T &inclm,
+                                      T &nodem, T &argpm, T &mm) noexcept {
+  double ep = em;
+  double xincp = inclm;
+  double nodep = nodem;
+  double argpp = argpm;
+  double mp = mm;
+  dpper(deep_terms(s), minutes, ep, xincp, nodep, argpp, mp);
+  if (xincp < 0.0) {
+    xincp = -xincp;
+    nodep = nodep + std::numbers::pi;
+    argpp = argpp - std::numbers::pi;
+  }
+  if (ep < 0.0 || ep > 1.0) {
+    return Sgp4Errc::kPerturbedEccentricityOutOfRange;
+  }
+  em = static_cast<T>(ep);
+  inclm = static_cast<T>(xincp);
+  nodem = deep_angle<T>(nodep);
+  argpm = deep_angle<T>(argpp);
+  mm = deep_angle<T>(mp);
+  return Sgp4Errc::kOk;
+}
+
+/// @brief Propagation in T, the reference implementation's sgp4()
+template <typename T>
+[[nodiscard]] Sgp4Errc propagate(const BasicSgp4State<T> &s, double minutes,
+                                 BasicTemeState<T> &teme) noexcept {
+  const T t = static_cast<T>(minutes);
+  const T xke_t = static_cast<T>(xke());
+  const T pi2_t = static_cast<T>(pi2);
+  // Kepler's equation converges to the precision of T
+  const T kepler_tolerance = std::is_same_v<T, double>
+                                ? static_cast<T>(1.0e-12)
+                                : static_cast<T>(1.0e-6);
+
+  // secular gravity and atmospheric drag
+  const T xmdf = secular_angle(s.mean_anomaly, s.mdot, minutes);
+  const T argpdf = secular_angle(s.argument_of_perigee, s.argpdot, minutes);
+  const T nodedf = secular_angle(s.raan, s.nodedot, minutes);
+  T argpm = argpdf;
+  T mm = xmdf;
+  const T t2 = t * t;
+  T nodem = nodedf + s.nodecf * t2;
+  T tempa = static_cast<T>(1.0) - s.cc1 * t;
+  T tempe = s.bstar * s.cc4 * t;
+  T templ = s.t2cof * t2;
+
+  if (!s.simplified) {
+    const T delomg = s.omgcof * t;
+    const T delmtemp = static_cast<T>(1.0) + s.eta * std::cos(xmdf);
+    const T delm = s.xmcof * (delmtemp * delmtemp * delmtemp - s.delmo);
+    const T temp = delomg + delm;
+    mm = xmdf + temp;
+    argpm = argpdf - temp;
+    const T t3 = t2 * t;
+    const T t4 = t3 * t;
+    tempa = tempa - s.d2 * t2 - s.d3 * t3 - s.d4 * t4;
+    tempe = tempe + s.bstar * s.cc5 * (std::sin(mm) - s.sinmao);
+    templ = templ + s.t3cof * t3 + t4 * (s.t4cof + t * s.t5cof);
+  }
+
+  T nm = s.mean_motion;
+  T em = s.eccentricity;
+  T inclm = s.inclination;
+  if (s.deep_space) {
+    deep_secular(s, minutes, em, argpm, inclm, mm, nodem, nm);
+  }
+  if (nm <= static_cast<T>(0.0)) {
+    return Sgp4Errc::kMeanMotionNegative;
+  }
+  const T am = std::pow(xke_t / nm, static_cast<T>(x2o3)) * tempa * tempa;
+  nm = xke_t / std::pow(am, static_cast<T>(1.5));
+  em = em - tempe;
+  if (em >= static_cast<T>(1.0) || em < static_cast<T>(-0.001)) {
+    return Sgp4Errc::kEccentricityOutOfRange;
+  }
+  if (em < static_cast<T>(1.0e-6)) {
+    em = static_cast<T>(1.0e-6);
+  }
+  mm = mm + s.mean_motion * templ;
+  T xlm = mm + argpm + nodem;
+  nodem = std::fmod(nodem, pi2_t);
+  argpm = std::fmod(argpm, pi2_t);
+  xlm = std::fmod(xlm, pi2_t);
+  mm = std::fmod(xlm - argpm - nodem, pi2_t);
+
+  if (s.deep_space) {
+    const auto errc = deep_periodics(s, minutes, em, inclm, nodem, argpm, mm);
+    if (errc != Sgp4Errc::kOk) {
+      return errc;
+    }
+  }
+  const T sinip = std::sin(inclm);
+  const T cosip = std::cos(inclm);
+  T aycof = s.aycof;
+  T xlcof = s.xlcof;
+  T con41 = s.con41;
+  T x1mth2 = s.x1mth2;
+  T x7thm1 = s.x7thm1;
+  if (s.deep_space) {
+    // with the perturbed inclination
+    const T one = static_cast<T>(1.0);
+    const T cosip_plus_1 = std::abs(cosip + one) > static_cast<T>(1.5e-12)
+                               ? one + cosip
+                               : static_cast<T>(1.5e-12);
+    aycof = static_cast<T>(-0.5 * j3oj2) * sinip;
+    xlcof = static_cast<T>(-0.25 * j3oj2) * sinip *
+            (static_cast<T>(3.0) + static_cast<T>(5.0) * cosip) /
+            cosip_plus_1;
+    const T cosisq = cosip * cosip;
+    con41 = static_cast<T>(3.0) * cosisq - one;
+    x1mth2 = one - cosisq;
+    x7thm1 = static_cast<T>(7.0) * cosisq - one;
+  }
+
+  // long period periodics
+  const T axnl = em * std::cos(argpm);
+  T temp = static_cast<T>(1.0) / (am * (static_cast<T>(1.0) - em * em));
+  const T aynl = em * std::sin(argpm) + temp * aycof;
+  const T xl = mm + argpm + nodem + temp * xlcof * axnl;
+
+  // solve Kepler's equation
+  const T u = std::fmod(xl - nodem, pi2_t);
+  T eo1 = u;
+  T tem5 = static_cast<T>(9999.9);
+  T sineo1 = static_cast<T>(0.0);
+  T coseo1 = static_cast<T>(0.0);
+  for (int ktr = 1; std::abs(tem5) >= kepler_tolerance && ktr <= 10; ++ktr) {
+    sineo1 = std::sin(eo1);
+    coseo1 = std::cos(eo1);
+    tem5 = static_cast<T>(1.0) - coseo1 * axnl - sineo1 * aynl;
+    tem5 = (u - aynl * coseo1 + axnl * sineo1 - eo1) / tem5;
+    if (std::abs(tem5) >= static_cast<T>(0.95)) {
+      tem5 = tem5 > static_cast<T>(0.0) ? static_cast<T>(0.95)
+                                        : static_cast<T>(-0.95);
+    }
+    eo1 = eo1 + tem5;
+  }
+
+  // short period preliminary quantities
+  const T ecose = axnl * coseo1 + aynl * sineo1;
+  const T esine = axnl * sineo1 - aynl * coseo1;
+  const T el2 = axnl * axnl + aynl * aynl;
+  const T pl = am * (static_cast<T>(1.0) - el2);
+  if (pl < static_cast<T>(0.0)) {
+    return Sgp4Errc::kSemiLatusRectumNegative;
+  }
+  const T rl = am * (static_cast<T>(1.0) - ecose);
+  const T rdotl = std::sqrt(am) * esine / rl;
+  const T rvdotl = std::sqrt(pl) / rl;
+  const T betal = std::sqrt(static_cast<T>(1.0) - el2);
+  temp = esine / (static_cast<T>(1.0) + betal);
+  const T sinu = am / rl * (sineo1 - aynl - axnl * temp);
+  const T cosu = am / rl * (coseo1 - axnl + aynl * temp);
+  T su = std::atan2(sinu, cosu);
+  const T sin2u = (cosu + cosu) * sinu;
+  const T cos2u = static_cast<T>(1.0) - static_cast<T>(2.0) * sinu * sinu;
+  temp = static_cast<T>(1.0) / pl;
+  const T temp1 = static_cast<T>(0.5 * j2) * temp;
+  const T temp2 = temp1 * temp;
+
+  // update for short period periodics
+  const T mrt =
+      rl * (static_cast<T>(1.0) - static_cast<T>(1.5) * temp2 * betal * con41) +
+      static_cast<T>(0.5) * temp1 * x1mth2 * cos2u;
+  su = su - static_cast<T>(0.25) * temp2 * x7thm1 * sin2u;
+  const T xnode = nodem + static_cast<T>(1.5) * temp2 * cosip * sin2u;
+  const T xinc =
+      inclm + static_cast<T>(1.5) * temp2 * cosip * sinip * cos2u;
+  const T mvt = rdotl - nm * temp1 * x1mth2 * sin2u / xke_t;
+  const T rvdot =
+      rvdotl +
+      nm * temp1 * (x1mth2 * cos2u + static_cast<T>(1.5) * con41) / xke_t;
+
+  // orientation vectors
+  const T sinsu = std::sin(su);
+  const T cossu = std::cos(su);
+  const T snod = std::sin(xnode);
+  const T cnod = std::cos(xnode);
+  const T sini = std::sin(xinc);
+  const T cosi = std::cos(xinc);
+  const T xmx = -snod * cosi;
+  const T xmy = cnod * cosi;
+  const std::array<T, 3> uv{xmx * sinsu + cnod * cossu,
+                            xmy * sinsu + snod * cossu, sini * sinsu};
+  const std::array<T, 3> vv{xmx * cossu - cnod * sinsu,
+                            xmy * cossu - snod * sinsu, sini * cossu};
+
+  const T radius_km = static_cast<T>(wgs72_earth_radius_km);
+  const T km_per_s = static_cast<T>(wgs72_earth_radius_km * xke() / 60.0);
+  for (std::size_t i = 0; i < 3; ++i) {
+    teme.position[i] = mrt * uv[i] * radius_km;
+    teme.velocity[i] = (mvt * uv[i] + rvdot * vv[i]) * km_per_s;
+  }
+
+  if (mrt < static_cast<T>(1.0)) {
+    return Sgp4Errc::kDecayed;
+  }
+  return Sgp4Errc::kOk;
+}
+
+template <typename T>
+void propagate_batch(std::span<const BasicSgp4State<T>> states,
+                     const std::chrono::system_clock::time_point &tp,
+                     std::span<BasicTemeState<T>> teme,
+                     std::span<Sgp4Errc> errors) noexcept {
+  EOB_SCOPED_TIMER(Probe::kPropagate);
+  const auto n = std::min({states.size(), teme.size(), errors.size()});
+  for (std::size_t i = 0; i < n; ++i) {
+    errors[i] = propagate(states[i], MinutesSinceEpoch(states[i], tp), teme[i]);
+  }
+}
+}  // namespace
+
+[[nodiscard]] std::string_view to_string(Sgp4Errc errc) noexcept {
+  switch (errc) {
+    case Sgp4Errc::kOk:
+      return "ok";
+    case Sgp4Errc::kInvalidElements:
+      return "invalid elements";
+    case Sgp4Errc::kEccentricityOutOfRange:
+      return "eccentricity out of range";
+    case Sgp4Errc::kMeanMotionNegative:
+      return "mean motion negative";
+    case Sgp4Errc::kPerturbedEccentricityOutOfRange:
+      return "perturbed eccentricity out of range";
+    case Sgp4Errc::kSemiLatusRectumNegative:
+      return "semi-latus rectum negative";
+    case Sgp4Errc::kDecayed:
+      return "satellite decayed";
+  }
+  return "unknown";
+}
+
+[[nodiscard]] std::chrono::system_clock::time_point TleEpoch(
+    const TleLine1 &line_1) noexcept {
+  using namespace std::chrono;
+  const int year = line_1.epoch_year < 57 ? 2000 + line_1.epoch_year
+                                          : 1900 + line_1.epoch_year;
+  const auto jan_1 = date::sys_days{date::year{year} / date::jan / 1};
+  const duration<double, days::period> day_of_year{line_1.epoch_day - 1.0};
+  return time_point_cast<system_clock::duration>(
+      jan_1 + duration_cast<microseconds>(day_of_year));
+}
+
+[[nodiscard]] Sgp4Errc InitSgp4(const Tle &tle, Sgp4State &state) noexcept {
+  const auto &l1 = tle.line_1;
+  const auto &l2 = tle.line_2;
+  if (!(l2.mean_motion > 0.0) || !(l2.eccentricity >= 0.0) ||
+      !(l2.eccentricity < 1.0)) {
+    return Sgp4Errc::kInvalidElements;
+  }
+
+  Sgp4State s{};
+  s.epoch = TleEpoch(l1);
+  s.bstar = l1.bstar_drag;
+  s.eccentricity = l2.eccentricity;
+  s.inclination = l2.inclination * deg_to_rad;
+  s.raan = l2.raan * deg_to_rad;
+  s.argument_of_perigee = l2.argument_of_perigree * deg_to_rad;
+  s.mean_anomaly = l2.mean_anomaly * deg_to_rad;
+  const double no_kozai = l2.mean_motion * pi2 / minutes_per_day;
+
+  // initl, un-Kozai the mean motion
+  const double ecco = s.eccentricity;
+  const double eccsq = ecco * ecco;
+  const double omeosq = 1.0 - eccsq;
+  const double rteosq = std::sqrt(omeosq);
+  const double cosio = std::cos(s.inclination);
+  const double cosio2 = cosio * cosio;
+
+  const double ak = std::pow(xke() / no_kozai, x2o3);
+  const double d1 = 0.75 * j2 * (3.0 * cosio2 - 1.0) / (rteosq * omeosq);
+  double del = d1 / (ak * ak);
+  const double adel =
+      ak * (1.0 - del * del - del * (1.0 / 3.0 + 134.0 * del * del / 81.0));
+  del = d1 / (adel * adel);
+  s.mean_motion = no_kozai / (1.0 + del);
+
+  const double ao = std::pow(xke() / s.mean_motion, x2o3);
+  const double sinio = std::sin(s.inclination);
+  const double po = ao * omeosq;
+  const double con42 = 1.0 - 5.0 * cosio2;
+  s.con41 = -con42 - cosio2 - cosio2;
+  const double posq = po * po;
+  const double rp = ao * (1.0 - ecco);
+
+  // sgp4init
+  s.deep_space = pi2 / s.mean_motion >= deep_space_period;
+  s.simplified =
+      s.deep_space || rp < (220.0 / wgs72_earth_radius_km + 1.0);
+
+  // atmospheric density parameters, adjusted for low perigees
+  double sfour = 78.0 / wgs72_earth_radius_km + 1.0;
+  double qzms24 = std::pow((120.0 - 78.0) / wgs72_earth_radius_km, 4.0);
+  const double perige = (rp - 1.0) * wgs72_earth_radius_km;
+  if (perige < 156.0) {
+    sfour = perige < 98.0 ? 20.0 : perige - 78.0;
+    qzms24 = std::pow((120.0 - sfour) / wgs72_earth_radius_km, 4.0);
+    sfour = sfour / wgs72_earth_radius_km + 1.0;
+  }
+
+  const double pinvsq = 1.0 / posq;
+  const double tsi = 1.0 / (ao - sfour);
+  s.eta = ao * ecco * tsi;
+  const double etasq = s.eta * s.eta;
+  const double eeta = ecco * s.eta;
+  const double psisq = std::abs(1.0 - etasq);
+  const double coef = qzms24 * std::pow(tsi, 4.0);
+  const double coef1 = coef / std::pow(psisq, 3.5);
+  const double cc2 =
+      coef1 * s.mean_motion *
+      (ao * (1.0 + 1.5 * etasq + eeta * (4.0 + etasq)) +
+       0.375 * j2 * tsi / psisq * s.con41 *
+           (8.0 + 3.0 * etasq * (8.0 + etasq)));
+  s.cc1 = s.bstar * cc2;
+  double cc3 = 0.0;
+  if (ecco > 1.0e-4) {
+    cc3 = -2.0 * coef * tsi * j3oj2 * s.mean_motion * sinio / ecco;
+  }
+  s.x1mth2 = 1.0 - cosio2;
+  s.cc4 = 2.0 * s.mean_motion * coef1 * ao * omeosq *
+          (s.eta * (2.0 + 0.5 * etasq) + ecco * (0.5 + 2.0 * etasq) -
+           j2 * tsi / (ao * psisq) *
+               (-3.0 * s.con41 *
+                    (1.0 - 2.0 * eeta + etasq * (1.5 - 0.5 * eeta)) +
+                0.75 * s.x1mth2 * (2.0 * etasq - eeta * (1.0 + etasq)) *
+                    std::cos(2.0 * s.argument_of_perigee)));
+  s.cc5 = 2.0 * coef1 * ao * omeosq *
+          (1.0 + 2.75 * (etasq + eeta) + eeta * etasq);
+
+  // secular rates
+  const double cosio4 = cosio2 * cosio2;
+  const double temp1 = 1.5 * j2 * pinvsq * s.mean_motion;
+  const double temp2 = 0.5 * temp1 * j2 * pinvsq;
+  const double temp3 = -0.46875 * j4 * pinvsq * pinvsq * s.mean_motion;
+  s.mdot = s.mean_motion + 0.5 * temp1 * rteosq * s.con41 +
+           0.0625 * temp2 * rteosq * (13.0 - 78.0 * cosio2 + 137.0 * cosio4);
+  s.argpdot = -0.5 * temp1 * con42 +
+              0.0625 * temp2 * (7.0 - 114.0 * cosio2 + 395.0 * cosio4) +
+              temp3 * (3.0 - 36.0 * cosio2 + 49.0 * cosio4);
+  const double xhdot1 = -temp1 * cosio;
+  s.nodedot = xhdot1 + (0.5 * temp2 * (4.0 - 19.0 * cosio2) +
+                        2.0 * temp3 * (3.0 - 7.0 * cosio2)) *
+                           cosio;
+  s.omgcof = s.bstar * cc3 * std::cos(s.argument_of_perigee);
+  s.xmcof = 0.0;
+  if (ecco > 1.0e-4) {
+    s.xmcof = -x2o3 * coef * s.bstar / eeta;
+  }
+  s.nodecf = 3.5 * omeosq * xhdot1 * s.cc1;
+  s.t2cof = 1.5 * s.cc1;
+  // avoid dividing by zero for 180 degree inclinations
+  const double cosio_plus_1 =
+      std::abs(cosio + 1.0) > 1.5e-12 ? 1.0 + cosio : 1.5e-12;
+  s.xlcof = -0.25 * j3oj2 * sinio * (3.0 + 5.0 * cosio) / cosio_plus_1;
+  s.aycof = -0.5 * j3oj2 * sinio;
+  const double delmotemp = 1.0 + s.eta * std::cos(s.mean_anomaly);
+  s.delmo = delmotemp * delmotemp * delmotemp;
+  s.sinmao = std::sin(s.mean_anomaly);
+  s.x7thm1 = 7.0 * cosio2 - 1.0;
+
+  if (s.deep_space) {
+    using Days = std::chrono::duration<double, std::chrono::days::period>;
+    const double jd =
+        unix_epoch_julian_date + Days(s.epoch.time_since_epoch()).count();
+    s.deep.gsto = gstime(jd);
+    // days since 1950 January 0.0
+    const Dscom c = dscom(jd - 2433281.5, s, s.deep);
+    dsinit(s, c, s.deep);
+  }
+
+  if (!s.simplified) {
+    const double cc1sq = s.cc1 * s.cc1;
+    s.d2 = 4.0 * ao * tsi * cc1sq;
+    const double temp = s.d2 * tsi * s.cc1 / 3.0;
+    s.d3 = (17.0 * ao + sfour) * temp;
+    s.d4 = 0.5 * temp * ao * tsi * (221.0 * ao + 31.0 * sfour) * s.cc1;
+    s.t3cof = s.d2 + 2.0 * cc1sq;
+    s.t4cof = 0.25 * (3.0 * s.d3 + s.cc1 * (12.0 * s.d2 + 10.0 * cc1sq));
+    s.t5cof = 0.2 * (3.0 * s.d4 + 12.0 * s.cc1 * s.d3 + 6.0 * s.d2 * s.d2 +
+                     15.0 * cc1sq * (2.0 * s.d2 + cc1sq));
+  }
+
+  state = s;
+  return Sgp4Errc::kOk;
+}
+
+[[nodiscard]] Sgp4StateF ToSinglePrecision(const Sgp4State &s) noexcept {
+  auto f = [](double value) { return static_cast<float>(value); };
+  return Sgp4StateF{
+      .epoch = s.epoch,
+      .simplified = s.simplified,
+      .deep_space = s.deep_space,
+      .bstar = f(s.bstar),
+      .eccentricity = f(s.eccentricity),
+      .inclination = f(s.inclination),
+      .raan = f(s.raan),
+      .argument_of_perigee = f(s.argument_of_perigee),
+      .mean_anomaly = f(s.mean_anomaly),
+      .mean_motion = f(s.mean_motion),
+      .aycof = f(s.aycof),
+      .con41 = f(s.con41),
+      .cc1 = f(s.cc1),
+      .cc4 = f(s.cc4),
+      .cc5 = f(s.cc5),
+      .d2 = f(s.d2),
+      .d3 = f(s.d3),
+      .d4 = f(s.d4),
+      .delmo = f(s.delmo),
+      .eta = f(s.eta),
+      .argpdot = f(s.argpdot),
+      .omgcof = f(s.omgcof),
+      .sinmao = f(s.sinmao),
+      .t2cof = f(s.t2cof),
+      .t3cof = f(s.t3cof),
+      .t4cof = f(s.t4cof),
+      .t5cof = f(s.t5cof),
+      .x1mth2 = f(s.x1mth2),
+      .x7thm1 = f(s.x7thm1),
+      .mdot = f(s.mdot),
+      .nodedot = f(s.nodedot),
+      .xlcof = f(s.xlcof),
+      .xmcof = f(s.xmcof),
+      .nodecf = f(s.nodecf),
+      .deep = convert<float>(s.deep),
+  };
+}
+
+[[nodiscard]] Sgp4Errc PropagateSgp4(const Sgp4State &state, double minutes,
+                                     TemeState &teme) noexcept {
+  EOB_SCOPED_TIMER(Probe::kPropagate);
+  return propagate(state, minutes, teme);
+}
+
+[[nodiscard]] Sgp4Errc PropagateSgp4(const Sgp4StateF &state, double minutes,
+                                     TemeStateF &teme) noexcept {
+  EOB_SCOPED_TIMER(Probe::kPropagate);
+  return propagate(state, minutes, teme);
+}
+
+void PropagateSgp4(std::span<const Sgp4State> states,
+                   const std::chrono::system_clock::time_point &tp,
+                   std::span<TemeState> teme,
+                   std::span<Sgp4Errc> errors) noexcept {
+  dispatch([&] { propagate_batch(states, tp, teme, errors); });
+}
+
+void PropagateSgp4(std::span<const Sgp4StateF> states,
+                   const std::chrono::system_clock::time_point &tp,
+                   std::span<TemeStateF> teme,
+                   std::span<Sgp4Errc> errors) noexcept {
+  dispatch([&] { propagate_batch(states, tp, teme, errors); });
+}
+}  // namespace eob
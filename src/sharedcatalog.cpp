@@ -0,0 +1,414 @@
+#include "earthorbits/sharedcatalog.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/formattle.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+
+namespace eob {
+namespace {
+constexpr std::string_view control_magic = "EOBSHMG1";
+constexpr std::string_view catalog_magic = "EOBSHMC1";
+/// arrays start at multiples of a cache line
+constexpr std::size_t alignment = 64;
+/// attempts to map the latest generation while publications replace it
+constexpr int map_attempts = 8;
+
+/// @brief The object "<name>", the latest generation
+struct Control {
+  std::array<char, 8> magic;
+  std::atomic<std::uint64_t> generation;
+};
+
+/// @brief Start of the object "<name>.<generation>", offsets are from the
+/// start of the object
+struct CatalogHeader {
+  std::array<char, 8> magic;
+  std::uint64_t generation;
+  std::uint64_t objects;
+  std::uint64_t satellite_numbers_offset;
+  std::uint64_t states_offset;
+  std::uint64_t text_offset;
+  std::uint64_t bytes;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "the generation is shared between processes");
+static_assert(std::is_trivially_copyable_v<Sgp4State>,
+              "states are used in place in shared memory");
+
+[[nodiscard]] std::size_t align(std::size_t offset) noexcept {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+[[nodiscard]] std::string generation_name(const std::string &name,
+                                          std::uint64_t generation) {
+  return name + "." + std::to_string(generation);
+}
+
+void check_name(const std::string &name) {
+  if (name.size() < 2 || name.front() != '/' ||
+      name.find('/', 1) != std::string::npos) {
+    throw MyException<std::string>("invalid shared catalog name", name);
+  }
+}
+
+/// @brief Map the shared memory object fd, closing it
+/// @returns nullptr on failure
+[[nodiscard]] void *map_fd(int fd, std::size_t bytes, bool writable) noexcept {
+  void *data = ::mmap(nullptr, bytes,
+                      writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                      MAP_SHARED, fd, 0);
+  ::close(fd);
+  return data == MAP_FAILED  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+             ? nullptr
+             : data;
+}
+
+/// @brief Size of the shared memory object fd, -1 on failure
+[[nodiscard]] off_t object_size(int fd) noexcept {
+  struct stat st {};
+  return ::fstat(fd, &st) == 0 ? st.st_size : -1;
+}
+}  // namespace
+
+SharedCatalogPublisher::SharedCatalogPublisher(const std::string &name)
+    : name_{name} {
+  check_name(name_);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+  const int fd = ::shm_open(name_.c_str(), O_CREAT | O_RDWR, 0644);
+  if (fd < 0) {
+    throw MyException<std::string>("failed to open shared catalog", name_);
+  }
+  const auto size = object_size(fd);
+  const bool created = size == 0;
+  if ((created && ::ftruncate(fd, sizeof(Control)) != 0) ||
+      (!created && size != static_cast<off_t>(sizeof(Control)))) {
+    ::close(fd);
+    throw MyException<std::string>("malformed shared catalog", name_);
+  }
+  void *data = map_fd(fd, sizeof(Control), true);
+  if (data == nullptr) {
+    throw MyException<std::string>("failed to map shared catalog", name_);
+  }
+  auto *control = static_cast<Control *>(data);
+  if (created) {
+    std::memcpy(control->magic.data(), control_magic.data(),
+                control_magic.size());
+  } else if (std::string_view(control->magic.data(), control->magic.size()) !=
+             control_magic) {
+    ::munmap(data, sizeof(Control));
+    throw MyException<std::string>("malformed shared catalog", name_);
+  }
+  control_ = data;
+  generation_ = &control->generation;
+}
+
+SharedCatalogPublisher::~SharedCatalogPublisher() {
+  ::munmap(control_, sizeof(Control));
+}
+
+[[nodiscard]] std::uint64_t SharedCatalogPublisher::generation()
+    const noexcept {
+  return generation_->load(std::memory_order_acquire);
+}
+
+std::size_t SharedCatalogPublisher::Publish(std::span<const Tle> catalog) {
+  // latest element set of each satellite
+  struct Entry {
+    std::uint32_t satellite_number;
+    std::chrono::system_clock::time_point epoch;
+    std::size_t row;
+  };
+  std::vector<Entry> entries;
+  entries.reserve(catalog.size());
+  for (std::size_t i = 0; i < catalog.size(); ++i) {
+    const auto number = catalog[i].line_1.satellite_number;
+    if (number >= 0) {
+      entries.push_back(Entry{.satellite_number =
+                                  static_cast<std::uint32_t>(number),
+                              .epoch = TleEpoch(catalog[i].line_1),
+                              .row = i});
+    }
+  }
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const Entry &a, const Entry &b) {
+                     return a.satellite_number != b.satellite_number
+                                ? a.satellite_number < b.satellite_number
+                                : a.epoch > b.epoch;
+                   });
+
+  std::vector<std::uint32_t> numbers;
+  std::vector<Sgp4State> states;
+  std::vector<char> text;
+  std::array<char, formatted_tle_size> record{};
+  for (const auto &entry : entries) {
+    if (!numbers.empty() && numbers.back() == entry.satellite_number) {
+      continue;
+    }
+    Sgp4State state;
+    const auto &tle = catalog[entry.row];
+    if (InitSgp4(tle, state) != Sgp4Errc::kOk ||
+        !FormatTle(tle, record).ok()) {
+      // an older element set of the satellite may still do
+      continue;
+    }
+    numbers.push_back(entry.satellite_number);
+    states.push_back(state);
+    text.insert(text.end(), record.begin(), record.end());
+  }
+
+  const auto objects = numbers.size();
+  CatalogHeader header{};
+  std::memcpy(header.magic.data(), catalog_magic.data(),
+              catalog_magic.size());
+  header.generation = generation() + 1;
+  header.objects = objects;
+  header.satellite_numbers_offset = align(sizeof(CatalogHeader));
+  header.states_offset = align(header.satellite_numbers_offset +
+                               objects * sizeof(std::uint32_t));
+  header.text_offset =
+      align(header.states_offset + objects * sizeof(Sgp4State));
+  header.bytes = header.text_offset + text.size();
+
+  const auto object_name = generation_name(name_, header.generation);
+  // left over by a publisher that died while publishing
+  ::shm_unlink(object_name.c_str());
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+  const int fd = ::shm_open(object_name.c_str(), O_CREAT | O_EXCL | O_RDWR,
+                            0644);
+  if (fd < 0) {
+    throw MyException<std::string>("failed to create shared catalog",
+                                   object_name);
+  }
+  if (::ftruncate(fd, static_cast<off_t>(header.bytes)) != 0) {
+    ::close(fd);
+    ::shm_unlink(object_name.c_str());
+    throw MyException<std::string>("failed to size shared catalog",
+                                   object_name);
+  }
+  void *mapped = map_fd(fd, header.bytes, true);
+  if (mapped == nullptr) {
+    ::shm_unlink(object_name.c_str());
+    throw MyException<std::string>("failed to map shared catalog",
+                                   object_name);
+  }
+  auto *data = static_cast<char *>(mapped);
+  std::memcpy(data, &header, sizeof(header));
+  std::memcpy(data + header.satellite_numbers_offset, numbers.data(),
+              objects * sizeof(std::uint32_t));
+  std::memcpy(data + header.states_offset, states.data(),
+              objects * sizeof(Sgp4State));
+  std::memcpy(data + header.text_offset, text.data(), text.size());
+  ::munmap(mapped, header.bytes);
+
+  // workers see the new generation complete, then the old one goes away
+  generation_->store(header.generation, std::memory_order_release);
+  if (header.generation > 1) {
+    ::shm_unlink(generation_name(name_, header.generation - 1).c_str());
+  }
+  return objects;
+}
+
+void RemoveSharedCatalog(const std::string &name) noexcept {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+  const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return;
+  }
+  if (object_size(fd) == static_cast<off_t>(sizeof(Control))) {
+    if (void *data = map_fd(fd, sizeof(Control), false); data != nullptr) {
+      const auto *control = static_cast<const Control *>(data);
+      const auto generation =
+          control->generation.load(std::memory_order_acquire);
+      ::munmap(data, sizeof(Control));
+      try {
+        ::shm_unlink(generation_name(name, generation).c_str());
+      } catch (...) {  // NOLINT(bugprone-empty-catch)
+      }
+    }
+  } else {
+    ::close(fd);
+  }
+  ::shm_unlink(name.c_str());
+}
+
+SharedCatalog::SharedCatalog(const std::string &name) : name_{name} {
+  check_name(name_);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+  const int fd = ::shm_open(name_.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    throw MyException<std::string>("no shared catalog published", name_);
+  }
+  if (object_size(fd) != static_cast<off_t>(sizeof(Control))) {
+    ::close(fd);
+    throw MyException<std::string>("no shared catalog published", name_);
+  }
+  const void *control = map_fd(fd, sizeof(Control), false);
+  if (control == nullptr) {
+    throw MyException<std::string>("failed to map shared catalog", name_);
+  }
+  control_ = control;
+  latest_ = &static_cast<const Control *>(control)->generation;
+  try {
+    if (std::string_view(static_cast<const Control *>(control)->magic.data(),
+                         control_magic.size()) != control_magic) {
+      throw MyException<std::string>("malformed shared catalog", name_);
+    }
+    Map();
+  } catch (...) {
+    Unmap();
+    throw;
+  }
+}
+
+void SharedCatalog::Map() {
+  for (int attempt = 0; attempt < map_attempts; ++attempt) {
+    const auto generation = latest_->load(std::memory_order_acquire);
+    if (generation == 0) {
+      break;
+    }
+    const auto object_name = generation_name(name_, generation);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    const int fd = ::shm_open(object_name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+      if (errno == ENOENT) {
+        continue;  // replaced by a newer generation meanwhile
+      }
+      throw MyException<std::string>("failed to open shared catalog",
+                                     object_name);
+    }
+    const auto size = object_size(fd);
+    if (size < static_cast<off_t>(sizeof(CatalogHeader))) {
+      ::close(fd);
+      throw MyException<std::string>("malformed shared catalog", object_name);
+    }
+    const void *mapped = map_fd(fd, static_cast<std::size_t>(size), false);
+    if (mapped == nullptr) {
+      throw MyException<std::string>("failed to map shared catalog",
+                                     object_name);
+    }
+    data_ = static_cast<const char *>(mapped);
+    bytes_ = static_cast<std::size_t>(size);
+
+    CatalogHeader header{};
+    std::memcpy(&header, data_, sizeof(header));
+    const auto n = header.objects;
+    if (std::string_view(header.magic.data(), header.magic.size()) !=
+            catalog_magic ||
+        header.generation != generation || header.bytes != bytes_ ||
+        n > bytes_ / formatted_tle_size ||
+        header.satellite_numbers_offset % alignment != 0 ||
+        header.states_offset % alignment != 0 ||
+        header.satellite_numbers_offset + n * sizeof(std::uint32_t) >
+            header.states_offset ||
+        header.states_offset + n * sizeof(Sgp4State) > header.text_offset ||
+        header.text_offset + n * formatted_tle_size != bytes_) {
+      throw MyException<std::string>("malformed shared catalog", object_name);
+    }
+    generation_ = generation;
+    size_ = static_cast<std::size_t>(n);
+    satellite_numbers_ = reinterpret_cast<const std::uint32_t *>(
+        data_ + header.satellite_numbers_offset);
+    states_ =
+        reinterpret_cast<const Sgp4State *>(data_ + header.states_offset);
+    text_ = data_ + header.text_offset;
+    return;
+  }
+  throw MyException<std::string>("no shared catalog published", name_);
+}
+
+SharedCatalog::~SharedCatalog() { Unmap(); }
+
+SharedCatalog::SharedCatalog(SharedCatalog &&other) noexcept
+    : name_{std::move(other.name_)},
+      control_{std::exchange(other.control_, nullptr)},
+      latest_{std::exchange(other.latest_, nullptr)},
+      data_{std::exchange(other.data_, nullptr)},
+      bytes_{std::exchange(other.bytes_, 0)},
+      generation_{std::exchange(other.generation_, 0)},
+      size_{std::exchange(other.size_, 0)},
+      satellite_numbers_{std::exchange(other.satellite_numbers_, nullptr)},
+      states_{std::exchange(other.states_, nullptr)},
+      text_{std::exchange(other.text_, nullptr)} {}
+
+SharedCatalog &SharedCatalog::operator=(SharedCatalog &&other) noexcept {
+  if (this != &other) {
+    Unmap();
+    name_ = std::move(other.name_);
+    control_ = std::exchange(other.control_, nullptr);
+    latest_ = std::exchange(other.latest_, nullptr);
+    data_ = std::exchange(other.data_, nullptr);
+    bytes_ = std::exchange(other.bytes_, 0);
+    generation_ = std::exchange(other.generation_, 0);
+    size_ = std::exchange(other.size_, 0);
+    satellite_numbers_ = std::exchange(other.satellite_numbers_, nullptr);
+    states_ = std::exchange(other.states_, nullptr);
+    text_ = std::exchange(other.text_, nullptr);
+  }
+  return *this;
+}
+
+void SharedCatalog::Unmap() noexcept {
+  if (data_ != nullptr) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    ::munmap(const_cast<char *>(data_), bytes_);
+    data_ = nullptr;
+  }
+  if (control_ != nullptr) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    ::munmap(const_cast<void *>(control_), sizeof(Control));
+    control_ = nullptr;
+    latest_ = nullptr;
+  }
+}
+
+[[nodiscard]] std::string_view SharedCatalog::tle(
+    std::size_t i) const noexcept {
+  return {text_ + i * formatted_tle_size, formatted_tle_size};
+}
+
+[[nodiscard]] std::optional<std::size_t> SharedCatalog::Find(
+    std::uint32_t satellite_number) const noexcept {
+  const auto numbers = satellite_numbers();
+  const auto it = std::lower_bound(numbers.begin(), numbers.end(),
+                                   satellite_number);
+  if (it == numbers.end() || *it != satellite_number) {
+    return std::nullopt;
+  }
+  return static_cast<std::size_t>(it - numbers.begin());
+}
+
+[[nodiscard]] bool SharedCatalog::Stale() const noexcept {
+  return latest_->load(std::memory_order_acquire) != generation_;
+}
+
+bool SharedCatalog::Refresh() {
+  if (!Stale()) {
+    return false;
+  }
+  *this = SharedCatalog(name_);
+  return true;
+}
+}  // namespace eob
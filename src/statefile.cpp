@@ -0,0 +1,441 @@
+#include "earthorbits/statefile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "columncodec.h"
+#include "earthorbits/earthorbits.h"
+
+namespace eob {
+namespace {
+constexpr std::string_view header_magic = "EOBSTAT1";
+constexpr std::string_view trailer_magic = "EOBSTEND";
+constexpr std::size_t header_bytes = 32;
+constexpr std::size_t index_entry_bytes = 40;
+constexpr std::size_t trailer_bytes = 24;
+constexpr std::string_view malformed = "malformed state file";
+
+using Duration = std::chrono::nanoseconds;
+
+[[nodiscard]] std::int64_t to_ns(
+    const std::chrono::system_clock::time_point &tp) noexcept {
+  return std::chrono::duration_cast<Duration>(tp.time_since_epoch()).count();
+}
+
+[[nodiscard]] std::chrono::system_clock::time_point from_ns(
+    std::int64_t ns) noexcept {
+  return std::chrono::system_clock::time_point{
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          Duration{ns})};
+}
+
+/// @brief Quadratic extrapolation of a column from its last three values
+///
+/// Works on the bit patterns as integers, which within a binade are linear
+/// in the value, so the prediction is exact integer arithmetic and doesn't
+/// depend on how the compiler rounds or contracts floating point.
+class Predictor {
+ public:
+  [[nodiscard]] std::uint64_t Next() const noexcept {
+    return 3 * (p1_ - p2_) + p3_;
+  }
+
+  void Push(std::uint64_t bits) noexcept {
+    p3_ = p2_;
+    p2_ = p1_;
+    p1_ = bits;
+  }
+
+ private:
+  std::uint64_t p1_ = 0;
+  std::uint64_t p2_ = 0;
+  std::uint64_t p3_ = 0;
+};
+
+void encode_times(std::span<const StateRecord> block, StateCodec codec,
+                  std::vector<char> &out) {
+  if (codec == StateCodec::kRaw) {
+    for (const auto &r : block) {
+      put_le(out, to_ns(r.time));
+    }
+    return;
+  }
+  // wrapping arithmetic, any pair of times round trips
+  std::uint64_t prev = 0;
+  std::uint64_t prev_delta = 0;
+  for (std::size_t i = 0; i < block.size(); ++i) {
+    const auto t = static_cast<std::uint64_t>(to_ns(block[i].time));
+    const auto delta = t - prev;
+    put_varint(out, zigzag(static_cast<std::int64_t>(delta - prev_delta)));
+    prev = t;
+    prev_delta = i == 0 ? 0 : delta;
+  }
+}
+
+void decode_times(Cursor &column, StateCodec codec,
+                  std::span<StateRecord> records) {
+  if (codec == StateCodec::kRaw) {
+    for (auto &r : records) {
+      r.time = from_ns(column.Le<std::int64_t>());
+    }
+    return;
+  }
+  std::uint64_t prev = 0;
+  std::uint64_t prev_delta = 0;
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    const auto delta =
+        prev_delta + static_cast<std::uint64_t>(unzigzag(column.Varint()));
+    const auto t = prev + delta;
+    records[i].time = from_ns(static_cast<std::int64_t>(t));
+    prev = t;
+    prev_delta = i == 0 ? 0 : delta;
+  }
+}
+
+void encode_objects(std::span<const StateRecord> block, StateCodec codec,
+                    std::vector<char> &out) {
+  if (codec == StateCodec::kRaw) {
+    for (const auto &r : block) {
+      put_le(out, r.object);
+    }
+    return;
+  }
+  std::int64_t prev = 0;
+  for (const auto &r : block) {
+    put_varint(out, zigzag(static_cast<std::int64_t>(r.object) - prev));
+    prev = r.object;
+  }
+}
+
+void decode_objects(Cursor &column, StateCodec codec,
+                    std::span<StateRecord> records) {
+  if (codec == StateCodec::kRaw) {
+    for (auto &r : records) {
+      r.object = column.Le<std::uint32_t>();
+    }
+    return;
+  }
+  std::int64_t prev = 0;
+  for (auto &r : records) {
+    const auto object = prev + unzigzag(column.Varint());
+    if (object < 0 || object > UINT32_MAX) {
+      column.Fail();
+    }
+    r.object = static_cast<std::uint32_t>(object);
+    prev = object;
+  }
+}
+
+/// @brief Component `c` of a state, position then velocity
+[[nodiscard]] double &component(TemeState &teme, std::size_t c) noexcept {
+  return c < 3 ? teme.position[c] : teme.velocity[c - 3];
+}
+[[nodiscard]] double component(const TemeState &teme, std::size_t c) noexcept {
+  return c < 3 ? teme.position[c] : teme.velocity[c - 3];
+}
+
+/// XOR with the prediction, see put_xor
+void encode_doubles(std::span<const StateRecord> block, std::size_t c,
+                    StateCodec codec, std::vector<char> &out) {
+  if (codec == StateCodec::kRaw) {
+    for (const auto &r : block) {
+      put_le(out, component(r.state, c));
+    }
+    return;
+  }
+  Predictor predictor;
+  for (const auto &r : block) {
+    const auto value = std::bit_cast<std::uint64_t>(component(r.state, c));
+    put_xor(out, value ^ predictor.Next());
+    predictor.Push(value);
+  }
+}
+
+void decode_doubles(Cursor &column, std::size_t c, StateCodec codec,
+                    std::span<StateRecord> records) {
+  if (codec == StateCodec::kRaw) {
+    for (auto &r : records) {
+      component(r.state, c) = column.Le<double>();
+    }
+    return;
+  }
+  Predictor predictor;
+  for (auto &r : records) {
+    const auto value = column.Xor() ^ predictor.Next();
+    component(r.state, c) = std::bit_cast<double>(value);
+    predictor.Push(value);
+  }
+}
+
+}  // namespace
+
+StateFileWriter::StateFileWriter(const std::string &path,
+                                 const StateFileOptions &options)
+    : path_{path}, options_{options} {
+  if (options_.block_size == 0) {
+    throw MyException<std::string>("state file block size is 0", path_);
+  }
+  if (options_.codec != StateCodec::kRaw &&
+      options_.codec != StateCodec::kDeltaXor) {
+    throw MyException<std::string>("unknown state file codec", path_);
+  }
+  file_.open(path_, std::ios::binary | std::ios::trunc);
+  if (!file_) {
+    throw MyException<std::string>("failed to open state file", path_);
+  }
+  block_.reserve(options_.block_size);
+  buffer_.reserve(options_.buffer_bytes + options_.block_size * 64);
+  buffer_.insert(buffer_.end(), header_magic.begin(), header_magic.end());
+  put_le(buffer_, static_cast<std::uint32_t>(options_.codec));
+  put_le(buffer_, std::uint32_t{0});
+  put_le(buffer_, static_cast<std::uint64_t>(options_.block_size));
+  put_le(buffer_, std::uint64_t{0});
+}
+
+StateFileWriter::~StateFileWriter() {
+  try {
+    Close();
+  } catch (...) {  // NOLINT(bugprone-empty-catch)
+  }
+}
+
+void StateFileWriter::Append(const StateRecord &record) {
+  if (closed_) {
+    throw MyException<std::string>("state file is closed", path_);
+  }
+  block_.push_back(record);
+  ++states_;
+  if (block_.size() == options_.block_size) {
+    FlushBlock();
+  }
+}
+
+void StateFileWriter::Append(std::span<const StateRecord> records) {
+  for (const auto &r : records) {
+    Append(r);
+  }
+}
+
+void StateFileWriter::Close() {
+  if (closed_) {
+    return;
+  }
+  closed_ = true;
+  if (!block_.empty()) {
+    FlushBlock();
+  }
+  const auto index_offset = bytes_ + buffer_.size();
+  for (const auto &info : index_) {
+    put_le(buffer_, info.offset);
+    put_le(buffer_, info.bytes);
+    put_le(buffer_, info.states);
+    put_le(buffer_, to_ns(info.first_time));
+    put_le(buffer_, to_ns(info.last_time));
+  }
+  put_le(buffer_, static_cast<std::uint64_t>(index_offset));
+  put_le(buffer_, static_cast<std::uint64_t>(index_.size()));
+  buffer_.insert(buffer_.end(), trailer_magic.begin(), trailer_magic.end());
+  FlushBuffer();
+  file_.close();
+  if (file_.fail()) {
+    throw MyException<std::string>("failed to write state file", path_);
+  }
+}
+
+void StateFileWriter::FlushBlock() {
+  const std::span<const StateRecord> block{block_};
+  const auto codec = options_.codec;
+  const auto offset = bytes_ + buffer_.size();
+  put_column(buffer_, [&](std::vector<char> &out) {
+    encode_times(block, codec, out);
+  });
+  put_column(buffer_, [&](std::vector<char> &out) {
+    encode_objects(block, codec, out);
+  });
+  for (std::size_t c = 0; c < 6; ++c) {
+    put_column(buffer_, [&](std::vector<char> &out) {
+      encode_doubles(block, c, codec, out);
+    });
+  }
+  const auto [first, last] = std::minmax_element(
+      block_.begin(), block_.end(),
+      [](const auto &a, const auto &b) { return a.time < b.time; });
+  index_.push_back(StateBlockInfo{
+      .offset = offset,
+      .bytes = bytes_ + buffer_.size() - offset,
+      .states = block_.size(),
+      .first_time = first->time,
+      .last_time = last->time,
+  });
+  block_.clear();
+  if (buffer_.size() >= options_.buffer_bytes) {
+    FlushBuffer();
+  }
+}
+
+void StateFileWriter::FlushBuffer() {
+  file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  if (!file_) {
+    throw MyException<std::string>("failed to write state file", path_);
+  }
+  bytes_ += buffer_.size();
+  buffer_.clear();
+}
+
+StateFileReader::StateFileReader(const std::string &path) : path_{path} {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+  const int fd = ::open(path_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw MyException<std::string>("failed to open state file", path_);
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw MyException<std::string>("failed to stat state file", path_);
+  }
+  size_ = static_cast<std::size_t>(st.st_size);
+  if (size_ < header_bytes + trailer_bytes) {
+    ::close(fd);
+    throw MyException<std::string>(std::string(malformed), path_);
+  }
+  void *data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    throw MyException<std::string>("failed to map state file", path_);
+  }
+  data_ = static_cast<const char *>(data);
+
+  try {
+    Cursor header{data_, data_ + header_bytes, malformed, path_};
+    if (header.Bytes(header_magic.size()) != header_magic) {
+      header.Fail();
+    }
+    const auto codec = header.Le<std::uint32_t>();
+    if (codec > static_cast<std::uint32_t>(StateCodec::kDeltaXor)) {
+      header.Fail();
+    }
+    codec_ = static_cast<StateCodec>(codec);
+
+    Cursor trailer{data_ + size_ - trailer_bytes, data_ + size_, malformed,
+                   path_};
+    const auto index_offset = trailer.Le<std::uint64_t>();
+    const auto blocks = trailer.Le<std::uint64_t>();
+    if (trailer.Bytes(trailer_magic.size()) != trailer_magic ||
+        index_offset < header_bytes ||
+        index_offset > size_ - trailer_bytes ||
+        (size_ - trailer_bytes - index_offset) / index_entry_bytes != blocks ||
+        (size_ - trailer_bytes - index_offset) % index_entry_bytes != 0) {
+      trailer.Fail();
+    }
+
+    Cursor index{data_ + index_offset, data_ + size_ - trailer_bytes,
+                 malformed, path_};
+    index_.reserve(blocks);
+    while (!index.done()) {
+      StateBlockInfo info{};
+      info.offset = index.Le<std::uint64_t>();
+      info.bytes = index.Le<std::uint64_t>();
+      info.states = index.Le<std::uint64_t>();
+      info.first_time = from_ns(index.Le<std::int64_t>());
+      info.last_time = from_ns(index.Le<std::int64_t>());
+      if (info.offset < header_bytes || info.offset > index_offset ||
+          info.bytes > index_offset - info.offset) {
+        index.Fail();
+      }
+      index_.push_back(info);
+    }
+  } catch (...) {
+    Unmap();
+    throw;
+  }
+}
+
+StateFileReader::~StateFileReader() { Unmap(); }
+
+StateFileReader::StateFileReader(StateFileReader &&other) noexcept
+    : path_{std::move(other.path_)},
+      data_{std::exchange(other.data_, nullptr)},
+      size_{std::exchange(other.size_, 0)},
+      codec_{other.codec_},
+      index_{std::move(other.index_)} {}
+
+StateFileReader &StateFileReader::operator=(StateFileReader &&other) noexcept {
+  if (this != &other) {
+    Unmap();
+    path_ = std::move(other.path_);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    codec_ = other.codec_;
+    index_ = std::move(other.index_);
+  }
+  return *this;
+}
+
+void StateFileReader::Unmap() noexcept {
+  if (data_ != nullptr) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    ::munmap(const_cast<char *>(data_), size_);
+    data_ = nullptr;
+  }
+}
+
+[[nodiscard]] std::uint64_t StateFileReader::state_count() const noexcept {
+  std::uint64_t count = 0;
+  for (const auto &info : index_) {
+    count += info.states;
+  }
+  return count;
+}
+
+void StateFileReader::ReadBlock(std::size_t i,
+                                std::vector<StateRecord> &records) const {
+  if (i >= index_.size()) {
+    throw MyException<std::string>(
+        "state file block " + std::to_string(i) + " out of range", path_);
+  }
+  const auto &info = index_[i];
+  Cursor block{data_ + info.offset, data_ + info.offset + info.bytes,
+               malformed, path_};
+  // every encoding takes at least a byte per value
+  if (info.states > info.bytes) {
+    block.Fail();
+  }
+  records.resize(info.states);
+  const std::span<StateRecord> out{records};
+  auto column = [&block]() {
+    return block.Take(block.Le<std::uint32_t>());
+  };
+  auto finish = [](const Cursor &c) {
+    if (!c.done()) {
+      c.Fail();
+    }
+  };
+
+  auto times = column();
+  decode_times(times, codec_, out);
+  finish(times);
+  auto objects = column();
+  decode_objects(objects, codec_, out);
+  finish(objects);
+  for (std::size_t c = 0; c < 6; ++c) {
+    auto values = column();
+    decode_doubles(values, c, codec_, out);
+    finish(values);
+  }
+  finish(block);
+}
+}  // namespace eob
@@ -0,0 +1,292 @@
+#include "earthorbits/timescales.h"
+
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "date/date.h"
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/eop.h"
+
+namespace eob {
+namespace {
+/// Seconds from the NTP epoch 1900-01-01 to 1970-01-01
+constexpr std::int64_t ntp_unix_offset = 2208988800;
+
+std::vector<LeapSecond> embedded_leaps() {
+  using namespace date;
+  using std::chrono::seconds;
+  const auto leap = [](const year_month_day &ymd, int tai_minus_utc) {
+    return LeapSecond{.day = sys_days{ymd},
+                      .tai_minus_utc = seconds{tai_minus_utc}};
+  };
+  return {
+      leap(January / 1 / 1972, 10), leap(July / 1 / 1972, 11),
+      leap(January / 1 / 1973, 12), leap(January / 1 / 1974, 13),
+      leap(January / 1 / 1975, 14), leap(January / 1 / 1976, 15),
+      leap(January / 1 / 1977, 16), leap(January / 1 / 1978, 17),
+      leap(January / 1 / 1979, 18), leap(January / 1 / 1980, 19),
+      leap(July / 1 / 1981, 20),    leap(July / 1 / 1982, 21),
+      leap(July / 1 / 1983, 22),    leap(July / 1 / 1985, 23),
+      leap(January / 1 / 1988, 24), leap(January / 1 / 1990, 25),
+      leap(January / 1 / 1991, 26), leap(July / 1 / 1992, 27),
+      leap(July / 1 / 1993, 28),    leap(July / 1 / 1994, 29),
+      leap(January / 1 / 1996, 30), leap(July / 1 / 1997, 31),
+      leap(January / 1 / 1999, 32), leap(January / 1 / 2006, 33),
+      leap(January / 1 / 2009, 34), leap(July / 1 / 2012, 35),
+      leap(July / 1 / 2015, 36),    leap(January / 1 / 2017, 37),
+  };
+}
+
+[[nodiscard]] std::string_view trim(std::string_view s) noexcept {
+  while (!s.empty() && (s.front() == ' ' || s.front() == '\t' ||
+                        s.front() == '\r')) {
+    s.remove_prefix(1);
+  }
+  while (!s.empty() &&
+         (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+/// @brief Parse the integer at the start of s and drop it and the blanks
+/// after it from s
+[[nodiscard]] bool take_integer(std::string_view &s,
+                                std::int64_t &value) noexcept {
+  s = trim(s);
+  const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+  if (ec != std::errc() || ptr == s.data()) {
+    return false;
+  }
+  s.remove_prefix(static_cast<std::size_t>(ptr - s.data()));
+  s = trim(s);
+  return true;
+}
+
+/// @brief The UTC day starting at NTP seconds, nullopt if not at 0h
+[[nodiscard]] std::optional<std::chrono::sys_days> ntp_day(
+    std::int64_t ntp) noexcept {
+  using namespace std::chrono;
+  const sys_seconds tp{seconds{ntp - ntp_unix_offset}};
+  const auto day = floor<days>(tp);
+  if (day != tp) {
+    return std::nullopt;
+  }
+  return day;
+}
+}  // namespace
+
+eob_tai_clock::time_point eob_tai_clock::now() noexcept {
+  return UtcToTai(std::chrono::system_clock::now());
+}
+
+eob_tt_clock::time_point eob_tt_clock::now() noexcept {
+  return UtcToTt(std::chrono::system_clock::now());
+}
+
+LeapSecondTable::LeapSecondTable() : LeapSecondTable(embedded_leaps()) {}
+
+LeapSecondTable::LeapSecondTable(std::vector<LeapSecond> leaps,
+                                 std::optional<std::chrono::sys_days> expires)
+    : leaps_{std::move(leaps)}, expires_{expires} {
+  using namespace std::chrono;
+  if (leaps_.empty()) {
+    throw MyException<std::string>("no leap seconds", "");
+  }
+  for (std::size_t i = 0; i < leaps_.size(); ++i) {
+    const auto offset = leaps_[i].tai_minus_utc.count();
+    if (offset < -1000 || offset > 1000) {
+      throw MyException<std::string>(
+          "TAI - UTC out of range",
+          to_string(leaps_[i].day) + " " + std::to_string(offset));
+    }
+    if (i == 0) {
+      continue;
+    }
+    const auto &prev = leaps_[i - 1];
+    const auto step = offset - prev.tai_minus_utc.count();
+    if (leaps_[i].day - prev.day < days{bucket_days} || step < -127 ||
+        step > 127) {
+      throw MyException<std::string>(
+          "leap seconds not increasing in day by at least 28 days or "
+          "stepping by more than 127 s",
+          to_string(leaps_[i].day));
+    }
+  }
+
+  first_day_ = leaps_.front().day;
+  first_ = static_cast<std::int16_t>(leaps_.front().tai_minus_utc.count());
+  last_ = static_cast<std::int16_t>(leaps_.back().tai_minus_utc.count());
+  const auto span_days =
+      static_cast<std::uint64_t>((leaps_.back().day - first_day_).count());
+  buckets_.resize(span_days / bucket_days + 1);
+  std::size_t next = 1;
+  std::int16_t value = first_;
+  for (std::size_t b = 0; b < buckets_.size(); ++b) {
+    const auto start = first_day_ + days{b * bucket_days};
+    while (next < leaps_.size() && leaps_[next].day <= start) {
+      value = static_cast<std::int16_t>(leaps_[next].tai_minus_utc.count());
+      ++next;
+    }
+    auto &bucket = buckets_[b];
+    bucket = {.before = value,
+              .step = 0,
+              .day = static_cast<std::uint8_t>(bucket_days)};
+    if (next < leaps_.size() &&
+        leaps_[next].day < start + days{bucket_days}) {
+      bucket.step = static_cast<std::int8_t>(
+          leaps_[next].tai_minus_utc.count() - value);
+      bucket.day =
+          static_cast<std::uint8_t>((leaps_[next].day - start).count());
+    }
+  }
+}
+
+const LeapSecondTable &LeapSecondTable::Embedded() {
+  static const LeapSecondTable table;
+  return table;
+}
+
+[[nodiscard]] LeapSecondTable ParseLeapSecondsList(std::string_view text) {
+  std::vector<LeapSecond> leaps;
+  std::optional<std::chrono::sys_days> expires;
+  while (!text.empty()) {
+    const auto end = text.find('\n');
+    const auto line = text.substr(0, end);
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+    auto rest = trim(line);
+    if (rest.starts_with("#@")) {
+      rest.remove_prefix(2);
+      std::int64_t ntp = 0;
+      if (!take_integer(rest, ntp)) {
+        throw MyException<std::string>("malformed expiry line",
+                                       std::string(line));
+      }
+      // the expiry is a day but not necessarily at 0h
+      expires = std::chrono::floor<std::chrono::days>(std::chrono::sys_seconds{
+          std::chrono::seconds{ntp - ntp_unix_offset}});
+      continue;
+    }
+    if (rest.empty() || rest.front() == '#') {
+      continue;
+    }
+    std::int64_t ntp = 0;
+    std::int64_t offset = 0;
+    if (!take_integer(rest, ntp) || !take_integer(rest, offset) ||
+        !(rest.empty() || rest.front() == '#')) {
+      throw MyException<std::string>("malformed leap second line",
+                                     std::string(line));
+    }
+    const auto day = ntp_day(ntp);
+    if (!day) {
+      throw MyException<std::string>("leap second not at 0h UTC",
+                                     std::string(line));
+    }
+    leaps.push_back(
+        {.day = *day, .tai_minus_utc = std::chrono::seconds{offset}});
+  }
+  return LeapSecondTable(std::move(leaps), expires);
+}
+
+[[nodiscard]] LeapSecondTable LoadLeapSecondTable(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw MyException<std::string>("failed to open leap second file", path);
+  }
+  std::stringstream ss;
+  ss << file.rdbuf();
+  return ParseLeapSecondsList(ss.str());
+}
+
+[[nodiscard]] std::chrono::system_clock::time_point TaiToUtc(
+    const eob_tai_clock::time_point &tai,
+    const LeapSecondTable &table) noexcept {
+  using namespace std::chrono;
+  const auto t = tai.time_since_epoch();
+  // TAI - UTC at the TAI time read as UTC is the one at the UTC time unless
+  // a leap second is less than TAI - UTC away, then the one before is
+  const system_clock::time_point guess{t};
+  const auto first = guess - table.TaiMinusUtc(guess);
+  if (first + table.TaiMinusUtc(first) == guess) {
+    return first;
+  }
+  const auto second = guess - table.TaiMinusUtc(first);
+  if (second + table.TaiMinusUtc(second) == guess) {
+    return second;
+  }
+  // in the leap second 23:59:60 before the day of second
+  return floor<days>(second) - system_clock::duration{1};
+}
+
+[[nodiscard]] eob_ut1_clock::time_point UtcToUt1(
+    const std::chrono::system_clock::time_point &utc,
+    const EopTable &eop) noexcept {
+  using namespace std::chrono;
+  const duration<double> ut1_utc{eop.Interpolate(utc).ut1_utc};
+  return eob_ut1_clock::time_point{
+      utc.time_since_epoch() +
+      duration_cast<system_clock::duration>(ut1_utc)};
+}
+
+[[nodiscard]] std::chrono::system_clock::time_point Ut1ToUtc(
+    const eob_ut1_clock::time_point &ut1, const EopTable &eop) noexcept {
+  using namespace std::chrono;
+  const system_clock::time_point guess{ut1.time_since_epoch()};
+  const auto first =
+      guess - (UtcToUt1(guess, eop).time_since_epoch() -
+               guess.time_since_epoch());
+  return guess -
+         (UtcToUt1(first, eop).time_since_epoch() - first.time_since_epoch());
+}
+
+void UtcToTai(std::span<const std::chrono::system_clock::time_point> utc,
+              std::span<eob_tai_clock::time_point> tai,
+              const LeapSecondTable &table) {
+  for (std::size_t i = 0; i < utc.size(); ++i) {
+    tai[i] = UtcToTai(utc[i], table);
+  }
+}
+
+void TaiToUtc(std::span<const eob_tai_clock::time_point> tai,
+              std::span<std::chrono::system_clock::time_point> utc,
+              const LeapSecondTable &table) {
+  for (std::size_t i = 0; i < tai.size(); ++i) {
+    utc[i] = TaiToUtc(tai[i], table);
+  }
+}
+
+void UtcToTt(std::span<const std::chrono::system_clock::time_point> utc,
+             std::span<eob_tt_clock::time_point> tt,
+             const LeapSecondTable &table) {
+  for (std::size_t i = 0; i < utc.size(); ++i) {
+    tt[i] = UtcToTt(utc[i], table);
+  }
+}
+
+void TtToUtc(std::span<const eob_tt_clock::time_point> tt,
+             std::span<std::chrono::system_clock::time_point> utc,
+             const LeapSecondTable &table) {
+  for (std::size_t i = 0; i < tt.size(); ++i) {
+    utc[i] = TtToUtc(tt[i], table);
+  }
+}
+
+[[nodiscard]] eob_seconds calc_gmst(
+    const eob_ut1_clock::time_point &ut1) noexcept {
+  // calc_gmst takes UTC as an approximation of UT1, here it is UT1
+  return calc_gmst(
+      std::chrono::system_clock::time_point{ut1.time_since_epoch()});
+}
+}  // namespace eob
@@ -0,0 +1,737 @@
+#include "earthorbits/tlearchive.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "columncodec.h"
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "parallel.h"
+#include "tlefields.h"
+
+namespace eob {
+namespace {
+constexpr std::string_view header_magic = "EOBTLEA1";
+constexpr std::string_view trailer_magic = "EOBTLEND";
+constexpr std::size_t header_bytes = 32;
+constexpr std::size_t index_entry_bytes = 40;
+constexpr std::size_t trailer_bytes = 24;
+constexpr std::string_view malformed = "malformed TLE archive";
+
+/// exponent of the exponent columns marking a value stored XORed
+constexpr std::uint64_t exponent_escape = 31;
+
+[[nodiscard]] std::int64_t to_ns(
+    const std::chrono::system_clock::time_point &tp) noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             tp.time_since_epoch())
+      .count();
+}
+
+[[nodiscard]] std::chrono::system_clock::time_point from_ns(
+    std::int64_t ns) noexcept {
+  return std::chrono::system_clock::time_point{
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::nanoseconds{ns})};
+}
+
+/// @brief A double field of either line, and its decimals in TLE text
+struct DoubleColumn {
+  double TleLine1::*line_1;
+  double TleLine2::*line_2;
+  int decimals;
+};
+
+[[nodiscard]] double value(const Tle &tle, const DoubleColumn &c) noexcept {
+  return c.line_1 != nullptr ? tle.line_1.*c.line_1 : tle.line_2.*c.line_2;
+}
+[[nodiscard]] double &value(Tle &tle, const DoubleColumn &c) noexcept {
+  return c.line_1 != nullptr ? tle.line_1.*c.line_1 : tle.line_2.*c.line_2;
+}
+
+constexpr std::array<DoubleColumn, 8> decimal_columns{{
+    {&TleLine1::epoch_day, nullptr, 8},
+    {&TleLine1::mean_motion_dot, nullptr, 8},
+    {nullptr, &TleLine2::inclination, 4},
+    {nullptr, &TleLine2::raan, 4},
+    {nullptr, &TleLine2::eccentricity, 7},
+    {nullptr, &TleLine2::argument_of_perigree, 4},
+    {nullptr, &TleLine2::mean_anomaly, 4},
+    {nullptr, &TleLine2::mean_motion, 8},
+}};
+
+/// decimals unused, the exponent is stored per value
+constexpr std::array<DoubleColumn, 2> exponent_columns{{
+    {&TleLine1::mean_motion_ddot, nullptr, 0},
+    {&TleLine1::bstar_drag, nullptr, 0},
+}};
+
+struct IntColumn {
+  int TleLine1::*line_1;
+  int TleLine2::*line_2;
+};
+
+[[nodiscard]] int value(const Tle &tle, const IntColumn &c) noexcept {
+  return c.line_1 != nullptr ? tle.line_1.*c.line_1 : tle.line_2.*c.line_2;
+}
+[[nodiscard]] int &value(Tle &tle, const IntColumn &c) noexcept {
+  return c.line_1 != nullptr ? tle.line_1.*c.line_1 : tle.line_2.*c.line_2;
+}
+
+constexpr std::array<IntColumn, 2> int_columns{{
+    {&TleLine1::element_number, nullptr},
+    {nullptr, &TleLine2::rev_at_epoch},
+}};
+
+/// @brief Fields that rarely change packed into 60 bits, from the low
+/// bits: classification 8, ephemeris type 4, launch year 7, launch number
+/// 10, launch piece 3 x 8 (0 past its end) and epoch year 7
+/// @returns false if a field doesn't fit
+[[nodiscard]] bool pack_designator(const Tle &tle,
+                                   std::uint64_t &packed) noexcept {
+  const auto &l1 = tle.line_1;
+  if (l1.ephemeris_type < 0 || l1.ephemeris_type > 15 ||
+      l1.launch_year < 0 || l1.launch_year > 127 || l1.launch_number < 0 ||
+      l1.launch_number > 1023 || l1.launch_piece.size() > 3 ||
+      l1.epoch_year < 0 || l1.epoch_year > 127) {
+    return false;
+  }
+  std::uint64_t piece = 0;
+  for (std::size_t i = 0; i < l1.launch_piece.size(); ++i) {
+    const auto c = static_cast<std::uint8_t>(l1.launch_piece[i]);
+    if (c == 0) {
+      return false;
+    }
+    piece |= std::uint64_t{c} << (8 * i);
+  }
+  packed = static_cast<std::uint64_t>(
+               static_cast<std::uint8_t>(l1.classification)) |
+           static_cast<std::uint64_t>(l1.ephemeris_type) << 8 |
+           static_cast<std::uint64_t>(l1.launch_year) << 12 |
+           static_cast<std::uint64_t>(l1.launch_number) << 19 |
+           piece << 29 | static_cast<std::uint64_t>(l1.epoch_year) << 53;
+  return true;
+}
+
+/// @returns false if packed has bits above 60 or a launch piece with a
+/// character after its end
+[[nodiscard]] bool unpack_designator(std::uint64_t packed,
+                                     Tle &tle) noexcept {
+  if (packed >> 60 != 0) {
+    return false;
+  }
+  auto &l1 = tle.line_1;
+  l1.classification = static_cast<char>(packed & 0xff);
+  l1.ephemeris_type = static_cast<int>((packed >> 8) & 0xf);
+  l1.launch_year = static_cast<int>((packed >> 12) & 0x7f);
+  l1.launch_number = static_cast<int>((packed >> 19) & 0x3ff);
+  l1.launch_piece.clear();
+  for (auto piece = (packed >> 29) & 0xffffff; piece != 0; piece >>= 8) {
+    const auto c = static_cast<char>(piece & 0xff);
+    if (c == 0) {
+      return false;
+    }
+    l1.launch_piece.push_back(c);
+  }
+  l1.epoch_year = static_cast<int>((packed >> 53) & 0x7f);
+  return true;
+}
+
+/// @brief value * 10^decimals if it is an integer below 2^52 that gives
+/// back value when divided by 10^decimals, as parsing TLE text does
+[[nodiscard]] bool scaled_decimal(double value, int decimals,
+                                  std::int64_t &scaled) noexcept {
+  const double pow10 = tle_pow10[static_cast<std::size_t>(decimals)];
+  const double x = value * pow10;
+  if (!(std::abs(x) < 0x1p52)) {
+    return false;
+  }
+  scaled = std::llround(x);
+  return std::bit_cast<std::uint64_t>(static_cast<double>(scaled) / pow10) ==
+         std::bit_cast<std::uint64_t>(value);
+}
+
+/// @brief Varint of the zigzag delta of the scaled value shifted left by
+/// one, or 1 followed by the XOR with the previous value
+void encode_decimals(std::span<const Tle> block, const DoubleColumn &c,
+                     std::vector<char> &out) {
+  std::int64_t prev = 0;
+  std::uint64_t prev_bits = 0;
+  for (const auto &tle : block) {
+    const double v = value(tle, c);
+    const auto bits = std::bit_cast<std::uint64_t>(v);
+    std::int64_t scaled = 0;
+    if (scaled_decimal(v, c.decimals, scaled)) {
+      put_varint(out, zigzag(scaled - prev) << 1);
+      prev = scaled;
+    } else {
+      put_varint(out, 1);
+      put_xor(out, bits ^ prev_bits);
+    }
+    prev_bits = bits;
+  }
+}
+
+void decode_decimals(Cursor &column, const DoubleColumn &c,
+                     std::span<Tle> tles) {
+  const double pow10 = tle_pow10[static_cast<std::size_t>(c.decimals)];
+  std::uint64_t prev = 0;
+  std::uint64_t prev_bits = 0;
+  for (auto &tle : tles) {
+    const auto tag = column.Varint();
+    double v = 0.0;
+    if ((tag & 1) == 0) {
+      // wrapping, malformed deltas don't overflow
+      prev += static_cast<std::uint64_t>(unzigzag(tag >> 1));
+      v = static_cast<double>(static_cast<std::int64_t>(prev)) / pow10;
+    } else if (tag == 1) {
+      v = std::bit_cast<double>(column.Xor() ^ prev_bits);
+    } else {
+      column.Fail();
+    }
+    value(tle, c) = v;
+    prev_bits = std::bit_cast<std::uint64_t>(v);
+  }
+}
+
+/// @brief Smallest exponent for which value is a mantissa below 2^31
+/// divided by 10^exponent, as TLE text like " 12345-3" is
+[[nodiscard]] bool decimal_exponent(double value, std::uint64_t &exponent,
+                                    std::int64_t &mantissa) noexcept {
+  for (std::size_t k = 0; k < tle_pow10.size(); ++k) {
+    const double x = value * tle_pow10[k];
+    if (!(std::abs(x) < 0x1p31)) {
+      return false;
+    }
+    mantissa = std::llround(x);
+    if (std::bit_cast<std::uint64_t>(static_cast<double>(mantissa) /
+                                     tle_pow10[k]) ==
+        std::bit_cast<std::uint64_t>(value)) {
+      exponent = k;
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @brief Varint of the zigzag mantissa shifted left by 5 or'ed with the
+/// exponent, or exponent_escape followed by the XOR with the previous
+/// value
+void encode_exponents(std::span<const Tle> block, const DoubleColumn &c,
+                      std::vector<char> &out) {
+  std::uint64_t prev_bits = 0;
+  for (const auto &tle : block) {
+    const double v = value(tle, c);
+    const auto bits = std::bit_cast<std::uint64_t>(v);
+    std::uint64_t exponent = 0;
+    std::int64_t mantissa = 0;
+    if (decimal_exponent(v, exponent, mantissa)) {
+      put_varint(out, zigzag(mantissa) << 5 | exponent);
+    } else {
+      put_varint(out, exponent_escape);
+      put_xor(out, bits ^ prev_bits);
+    }
+    prev_bits = bits;
+  }
+}
+
+void decode_exponents(Cursor &column, const DoubleColumn &c,
+                      std::span<Tle> tles) {
+  std::uint64_t prev_bits = 0;
+  for (auto &tle : tles) {
+    const auto tag = column.Varint();
+    const auto exponent = tag & 31;
+    double v = 0.0;
+    if (exponent < tle_pow10.size()) {
+      v = static_cast<double>(unzigzag(tag >> 5)) / tle_pow10[exponent];
+    } else if (tag == exponent_escape) {
+      v = std::bit_cast<double>(column.Xor() ^ prev_bits);
+    } else {
+      column.Fail();
+    }
+    value(tle, c) = v;
+    prev_bits = std::bit_cast<std::uint64_t>(v);
+  }
+}
+
+void encode_ints(std::span<const Tle> block, const IntColumn &c,
+                 std::vector<char> &out) {
+  std::int64_t prev = 0;
+  for (const auto &tle : block) {
+    const std::int64_t v = value(tle, c);
+    put_varint(out, zigzag(v - prev));
+    prev = v;
+  }
+}
+
+void decode_ints(Cursor &column, const IntColumn &c, std::span<Tle> tles) {
+  std::int64_t prev = 0;
+  for (auto &tle : tles) {
+    const auto delta = unzigzag(column.Varint());
+    if (delta < -(std::int64_t{1} << 32) || delta > std::int64_t{1} << 32) {
+      column.Fail();
+    }
+    const auto v = prev + delta;
+    if (v < std::numeric_limits<int>::min() ||
+        v > std::numeric_limits<int>::max()) {
+      column.Fail();
+    }
+    value(tle, c) = static_cast<int>(v);
+    prev = v;
+  }
+}
+
+/// @brief Epochs of tles in nanoseconds since 1970
+[[nodiscard]] std::vector<std::int64_t> epochs_ns(std::span<const Tle> tles) {
+  std::vector<std::int64_t> epochs;
+  epochs.reserve(tles.size());
+  for (const auto &tle : tles) {
+    epochs.push_back(to_ns(TleEpoch(tle.line_1)));
+  }
+  return epochs;
+}
+
+/// @brief Stable sort of tles and their epochs by epoch
+void sort_by_epoch(std::vector<Tle> &tles, std::vector<std::int64_t> &epochs) {
+  if (std::is_sorted(epochs.begin(), epochs.end())) {
+    return;
+  }
+  std::vector<std::size_t> order(tles.size());
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::stable_sort(order.begin(), order.end(),
+                   [&](std::size_t a, std::size_t b) {
+                     return epochs[a] < epochs[b];
+                   });
+  std::vector<Tle> sorted_tles;
+  std::vector<std::int64_t> sorted_epochs;
+  sorted_tles.reserve(tles.size());
+  sorted_epochs.reserve(tles.size());
+  for (const auto i : order) {
+    sorted_tles.push_back(std::move(tles[i]));
+    sorted_epochs.push_back(epochs[i]);
+  }
+  tles = std::move(sorted_tles);
+  epochs = std::move(sorted_epochs);
+}
+}  // namespace
+
+TleArchiveWriter::TleArchiveWriter(const std::string &path,
+                                   const TleArchiveOptions &options)
+    : path_{path}, options_{options} {
+  if (options_.block_size == 0 ||
+      options_.block_size > std::numeric_limits<std::uint32_t>::max()) {
+    throw MyException<std::string>("TLE archive block size out of range",
+                                   path_);
+  }
+  file_.open(path_, std::ios::binary | std::ios::trunc);
+  if (!file_) {
+    throw MyException<std::string>("failed to open TLE archive", path_);
+  }
+  buffer_.reserve(options_.buffer_bytes);
+  buffer_.insert(buffer_.end(), header_magic.begin(), header_magic.end());
+  put_le(buffer_, std::uint32_t{0});
+  put_le(buffer_, std::uint32_t{0});
+  put_le(buffer_, static_cast<std::uint64_t>(options_.block_size));
+  put_le(buffer_, std::uint64_t{0});
+}
+
+TleArchiveWriter::~TleArchiveWriter() {
+  try {
+    Close();
+  } catch (...) {  // NOLINT(bugprone-empty-catch)
+  }
+}
+
+void TleArchiveWriter::Append(const Tle &tle) {
+  if (closed_) {
+    throw MyException<std::string>("TLE archive is closed", path_);
+  }
+  std::uint64_t packed = 0;
+  if (tle.line_1.line_number != 1 || tle.line_2.line_number != 2 ||
+      tle.line_1.satellite_number < 0 ||
+      tle.line_1.satellite_number != tle.line_2.satellite_number ||
+      tle.line_1.checksum < 0 || tle.line_1.checksum > 15 ||
+      tle.line_2.checksum < 0 || tle.line_2.checksum > 15 ||
+      !pack_designator(tle, packed)) {
+    throw MyException<int>("TLE can't be archived",
+                           tle.line_1.satellite_number);
+  }
+  const auto satellite_number =
+      static_cast<std::uint32_t>(tle.line_1.satellite_number);
+  auto &tles = pending_[satellite_number];
+  tles.push_back(tle);
+  ++buffered_;
+  ++records_;
+  if (tles.size() == options_.block_size) {
+    FlushBlock(satellite_number, tles);
+  }
+  if (buffered_ > options_.max_buffered) {
+    for (auto &[number, object_tles] : pending_) {
+      FlushBlock(number, object_tles);
+    }
+  }
+}
+
+void TleArchiveWriter::Append(std::span<const Tle> tles) {
+  for (const auto &tle : tles) {
+    Append(tle);
+  }
+}
+
+void TleArchiveWriter::Close() {
+  if (closed_) {
+    return;
+  }
+  closed_ = true;
+  for (auto &[number, tles] : pending_) {
+    FlushBlock(number, tles);
+  }
+  pending_.clear();
+  std::stable_sort(index_.begin(), index_.end(),
+                   [](const TleBlockInfo &a, const TleBlockInfo &b) {
+                     return std::tie(a.satellite_number, a.first_epoch) <
+                            std::tie(b.satellite_number, b.first_epoch);
+                   });
+  const auto index_offset = bytes_ + buffer_.size();
+  for (const auto &info : index_) {
+    put_le(buffer_, info.satellite_number);
+    put_le(buffer_, info.records);
+    put_le(buffer_, to_ns(info.first_epoch));
+    put_le(buffer_, to_ns(info.last_epoch));
+    put_le(buffer_, info.offset);
+    put_le(buffer_, info.bytes);
+  }
+  put_le(buffer_, static_cast<std::uint64_t>(index_offset));
+  put_le(buffer_, static_cast<std::uint64_t>(index_.size()));
+  buffer_.insert(buffer_.end(), trailer_magic.begin(), trailer_magic.end());
+  FlushBuffer();
+  file_.close();
+  if (file_.fail()) {
+    throw MyException<std::string>("failed to write TLE archive", path_);
+  }
+}
+
+void TleArchiveWriter::FlushBlock(std::uint32_t satellite_number,
+                                  std::vector<Tle> &tles) {
+  if (tles.empty()) {
+    return;
+  }
+  auto epochs = epochs_ns(tles);
+  sort_by_epoch(tles, epochs);
+  const std::span<const Tle> block{tles};
+  const auto offset = bytes_ + buffer_.size();
+  put_column(buffer_, [&](std::vector<char> &out) {
+    std::uint64_t prev = 0;
+    for (const auto &tle : block) {
+      std::uint64_t packed = 0;
+      (void)pack_designator(tle, packed);  // checked by Append
+      put_varint(out, packed ^ prev);
+      prev = packed;
+    }
+  });
+  put_column(buffer_, [&](std::vector<char> &out) {
+    for (const auto &tle : block) {
+      out.push_back(static_cast<char>(tle.line_1.checksum |
+                                      tle.line_2.checksum << 4));
+    }
+  });
+  for (const auto &c : decimal_columns) {
+    put_column(buffer_, [&](std::vector<char> &out) {
+      encode_decimals(block, c, out);
+    });
+  }
+  for (const auto &c : exponent_columns) {
+    put_column(buffer_, [&](std::vector<char> &out) {
+      encode_exponents(block, c, out);
+    });
+  }
+  for (const auto &c : int_columns) {
+    put_column(buffer_, [&](std::vector<char> &out) {
+      encode_ints(block, c, out);
+    });
+  }
+  index_.push_back(TleBlockInfo{
+      .satellite_number = satellite_number,
+      .records = static_cast<std::uint32_t>(tles.size()),
+      .first_epoch = from_ns(epochs.front()),
+      .last_epoch = from_ns(epochs.back()),
+      .offset = offset,
+      .bytes = bytes_ + buffer_.size() - offset,
+  });
+  buffered_ -= tles.size();
+  tles.clear();
+  if (buffer_.size() >= options_.buffer_bytes) {
+    FlushBuffer();
+  }
+}
+
+void TleArchiveWriter::FlushBuffer() {
+  file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  if (!file_) {
+    throw MyException<std::string>("failed to write TLE archive", path_);
+  }
+  bytes_ += buffer_.size();
+  buffer_.clear();
+}
+
+TleArchiveReader::TleArchiveReader(const std::string &path) : path_{path} {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+  const int fd = ::open(path_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw MyException<std::string>("failed to open TLE archive", path_);
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw MyException<std::string>("failed to stat TLE archive", path_);
+  }
+  size_ = static_cast<std::size_t>(st.st_size);
+  if (size_ < header_bytes + trailer_bytes) {
+    ::close(fd);
+    throw MyException<std::string>(std::string(malformed), path_);
+  }
+  void *data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    throw MyException<std::string>("failed to map TLE archive", path_);
+  }
+  data_ = static_cast<const char *>(data);
+
+  try {
+    Cursor header{data_, data_ + header_bytes, malformed, path_};
+    if (header.Bytes(header_magic.size()) != header_magic) {
+      header.Fail();
+    }
+
+    Cursor trailer{data_ + size_ - trailer_bytes, data_ + size_, malformed,
+                   path_};
+    const auto index_offset = trailer.Le<std::uint64_t>();
+    const auto blocks = trailer.Le<std::uint64_t>();
+    if (trailer.Bytes(trailer_magic.size()) != trailer_magic ||
+        index_offset < header_bytes ||
+        index_offset > size_ - trailer_bytes ||
+        (size_ - trailer_bytes - index_offset) / index_entry_bytes != blocks ||
+        (size_ - trailer_bytes - index_offset) % index_entry_bytes != 0) {
+      trailer.Fail();
+    }
+
+    Cursor index{data_ + index_offset, data_ + size_ - trailer_bytes,
+                 malformed, path_};
+    index_.reserve(blocks);
+    while (!index.done()) {
+      TleBlockInfo info{};
+      info.satellite_number = index.Le<std::uint32_t>();
+      info.records = index.Le<std::uint32_t>();
+      info.first_epoch = from_ns(index.Le<std::int64_t>());
+      info.last_epoch = from_ns(index.Le<std::int64_t>());
+      info.offset = index.Le<std::uint64_t>();
+      info.bytes = index.Le<std::uint64_t>();
+      if (info.offset < header_bytes || info.offset > index_offset ||
+          info.bytes > index_offset - info.offset ||
+          info.first_epoch > info.last_epoch ||
+          (!index_.empty() &&
+           std::tie(info.satellite_number, info.first_epoch) <
+               std::tie(index_.back().satellite_number,
+                        index_.back().first_epoch))) {
+        index.Fail();
+      }
+      index_.push_back(info);
+    }
+  } catch (...) {
+    Unmap();
+    throw;
+  }
+}
+
+TleArchiveReader::~TleArchiveReader() { Unmap(); }
+
+TleArchiveReader::TleArchiveReader(TleArchiveReader &&other) noexcept
+    : path_{std::move(other.path_)},
+      data_{std::exchange(other.data_, nullptr)},
+      size_{std::exchange(other.size_, 0)},
+      index_{std::move(other.index_)} {}
+
+TleArchiveReader &TleArchiveReader::operator=(
+    TleArchiveReader &&other) noexcept {
+  if (this != &other) {
+    Unmap();
+    path_ = std::move(other.path_);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    index_ = std::move(other.index_);
+  }
+  return *this;
+}
+
+void TleArchiveReader::Unmap() noexcept {
+  if (data_ != nullptr) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    ::munmap(const_cast<char *>(data_), size_);
+    data_ = nullptr;
+  }
+}
+
+[[nodiscard]] std::uint64_t TleArchiveReader::record_count() const noexcept {
+  std::uint64_t count = 0;
+  for (const auto &info : index_) {
+    count += info.records;
+  }
+  return count;
+}
+
+[[nodiscard]] std::vector<std::uint32_t> TleArchiveReader::Objects() const {
+  std::vector<std::uint32_t> objects;
+  for (const auto &info : index_) {
+    if (objects.empty() || objects.back() != info.satellite_number) {
+      objects.push_back(info.satellite_number);
+    }
+  }
+  return objects;
+}
+
+void TleArchiveReader::ReadBlock(std::size_t i, std::vector<Tle> &tles) const {
+  const auto &info = index_.at(i);
+  Cursor block{data_ + info.offset, data_ + info.offset + info.bytes,
+               malformed, path_};
+  // every column takes at least a byte per record
+  if (info.records > info.bytes) {
+    block.Fail();
+  }
+  tles.resize(info.records);
+  const std::span<Tle> out{tles};
+  auto column = [&block]() {
+    return block.Take(block.Le<std::uint32_t>());
+  };
+  auto finish = [](const Cursor &c) {
+    if (!c.done()) {
+      c.Fail();
+    }
+  };
+
+  const auto number = static_cast<int>(info.satellite_number);
+  auto designators = column();
+  std::uint64_t packed = 0;
+  for (auto &tle : out) {
+    packed ^= designators.Varint();
+    if (!unpack_designator(packed, tle)) {
+      designators.Fail();
+    }
+    tle.line_1.line_number = 1;
+    tle.line_1.satellite_number = number;
+    tle.line_2.line_number = 2;
+    tle.line_2.satellite_number = number;
+  }
+  finish(designators);
+  auto checksums = column();
+  const auto bytes = checksums.Bytes(out.size());
+  for (std::size_t k = 0; k < out.size(); ++k) {
+    const auto byte = static_cast<std::uint8_t>(bytes[k]);
+    out[k].line_1.checksum = byte & 0xf;
+    out[k].line_2.checksum = byte >> 4;
+  }
+  finish(checksums);
+  for (const auto &c : decimal_columns) {
+    auto values = column();
+    decode_decimals(values, c, out);
+    finish(values);
+  }
+  for (const auto &c : exponent_columns) {
+    auto values = column();
+    decode_exponents(values, c, out);
+    finish(values);
+  }
+  for (const auto &c : int_columns) {
+    auto values = column();
+    decode_ints(values, c, out);
+    finish(values);
+  }
+  finish(block);
+}
+
+void TleArchiveReader::ReadObject(std::size_t first, std::size_t last,
+                                  std::vector<Tle> &tles) const {
+  // blocks are time ordered unless the writer flushed an object whose
+  // element sets weren't appended in epoch order
+  bool ordered = true;
+  std::vector<Tle> block;
+  for (std::size_t i = first; i < last; ++i) {
+    ordered = ordered &&
+              (i == first || index_[i - 1].last_epoch <= index_[i].first_epoch);
+    ReadBlock(i, block);
+    std::move(block.begin(), block.end(), std::back_inserter(tles));
+  }
+  if (!ordered) {
+    auto epochs = epochs_ns(tles);
+    sort_by_epoch(tles, epochs);
+  }
+}
+
+void TleArchiveReader::History(std::uint32_t satellite_number,
+                               std::chrono::system_clock::time_point from,
+                               std::chrono::system_clock::time_point to,
+                               std::vector<Tle> &tles) const {
+  tles.clear();
+  const auto [first, last] = std::ranges::equal_range(
+      index_, satellite_number, {}, &TleBlockInfo::satellite_number);
+  // only the blocks overlapping [from, to), first epochs are increasing
+  auto begin = first;
+  while (begin != last && begin->last_epoch < from) {
+    ++begin;
+  }
+  const auto end =
+      std::ranges::lower_bound(begin, last, to, {}, &TleBlockInfo::first_epoch);
+  if (begin >= end) {
+    return;
+  }
+  ReadObject(static_cast<std::size_t>(begin - index_.begin()),
+             static_cast<std::size_t>(end - index_.begin()), tles);
+  const auto lo = to_ns(from);
+  const auto hi = to_ns(to);
+  std::erase_if(tles, [&](const Tle &tle) {
+    const auto epoch = to_ns(TleEpoch(tle.line_1));
+    return epoch < lo || epoch >= hi;
+  });
+}
+
+void TleArchiveReader::ScanObjects(
+    const std::function<void(std::span<const Tle>)> &fn,
+    std::size_t threads) const {
+  // [starts[k], starts[k + 1]) are the blocks of an object
+  std::vector<std::size_t> starts;
+  for (std::size_t i = 0; i < index_.size(); ++i) {
+    if (i == 0 ||
+        index_[i].satellite_number != index_[i - 1].satellite_number) {
+      starts.push_back(i);
+    }
+  }
+  starts.push_back(index_.size());
+  parallel_for(starts.size() - 1, resolve_threads(threads),
+               [&](std::size_t k) {
+                 std::vector<Tle> tles;
+                 ReadObject(starts[k], starts[k + 1], tles);
+                 fn(tles);
+               });
+}
+}  // namespace eob
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include "earthorbits/eobmath.h"
+#include "earthorbits/parsetle.h"
+
+/// The mean elements of a TLE as a vector, for the fits and samplers that
+/// perturb them.
+
+namespace eob {
+/// inclination, RAAN, eccentricity, argument of perigee, mean anomaly,
+/// mean motion and B*, in the units of the TLE
+constexpr std::size_t tle_element_count = 7;
+using TleElementVector = std::array<double, tle_element_count>;
+
+/// eccentricities above this are clamped, near 1 SGP4 fails anyway
+constexpr double max_element_eccentricity = 0.999;
+
+[[nodiscard]] inline TleElementVector get_elements(const Tle &tle) noexcept {
+  return {tle.line_2.inclination,
+          tle.line_2.raan,
+          tle.line_2.eccentricity,
+          tle.line_2.argument_of_perigree,
+          tle.line_2.mean_anomaly,
+          tle.line_2.mean_motion,
+          tle.line_1.bstar_drag};
+}
+
+inline void set_elements(const TleElementVector &x, Tle &tle) noexcept {
+  tle.line_2.inclination = x[0];
+  tle.line_2.raan = x[1];
+  tle.line_2.eccentricity = x[2];
+  tle.line_2.argument_of_perigree = x[3];
+  tle.line_2.mean_anomaly = x[4];
+  tle.line_2.mean_motion = x[5];
+  tle.line_1.bstar_drag = x[6];
+}
+
+/// @brief x moved back into the domain of each element after a step
+[[nodiscard]] inline TleElementVector normalize_elements(
+    TleElementVector x) noexcept {
+  x[0] = std::clamp(x[0], 0.0, 180.0);
+  x[1] = wrap_to_360(x[1]);
+  x[2] = std::clamp(x[2], 0.0, max_element_eccentricity);
+  x[3] = wrap_to_360(x[3]);
+  x[4] = wrap_to_360(x[4]);
+  return x;
+}
+}  // namespace eob
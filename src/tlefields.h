@@ -0,0 +1,335 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+
+#include "earthorbits/parsetle.h"
+
+/// Field layout and allocation free decoders shared by the TLE parsers.
+/// All decoders are noexcept and report failure by returning false so that
+/// rejecting a malformed record is cheap.
+
+namespace eob {
+constexpr std::size_t tle_line_size = 69;
+/// two lines of 69 characters and a line break
+constexpr std::size_t tle_record_size = 2 * tle_line_size + 1;
+
+/// @brief Location of a field within its TLE line
+struct TleFieldSpan {
+  TleField field;
+  std::uint8_t line;   ///< 1 or 2
+  std::uint8_t start;  ///< 0-based offset into the line
+  std::uint8_t size;
+};
+
+/// @see ParseTle for the layout, columns there are 1-based
+constexpr std::array<TleFieldSpan, 24> tle_field_spans{{
+    {TleField::kLine1Number, 1, 0, 1},
+    {TleField::kLine1SatelliteNumber, 1, 2, 5},
+    {TleField::kClassification, 1, 7, 1},
+    {TleField::kLaunchYear, 1, 9, 2},
+    {TleField::kLaunchNumber, 1, 11, 3},
+    {TleField::kLaunchPiece, 1, 14, 3},
+    {TleField::kEpochYear, 1, 18, 2},
+    {TleField::kEpochDay, 1, 20, 12},
+    {TleField::kMeanMotionDot, 1, 33, 10},
+    {TleField::kMeanMotionDdot, 1, 44, 8},
+    {TleField::kBstarDrag, 1, 53, 8},
+    {TleField::kEphemerisType, 1, 62, 1},
+    {TleField::kElementNumber, 1, 64, 4},
+    {TleField::kLine1Checksum, 1, 68, 1},
+    {TleField::kLine2Number, 2, 0, 1},
+    {TleField::kLine2SatelliteNumber, 2, 2, 5},
+    {TleField::kInclination, 2, 8, 8},
+    {TleField::kRaan, 2, 17, 8},
+    {TleField::kEccentricity, 2, 26, 7},
+    {TleField::kArgumentOfPerigree, 2, 34, 8},
+    {TleField::kMeanAnomaly, 2, 43, 8},
+    {TleField::kMeanMotion, 2, 52, 11},
+    {TleField::kRevAtEpoch, 2, 63, 5},
+    {TleField::kLine2Checksum, 2, 68, 1},
+}};
+
+[[nodiscard]] constexpr const TleFieldSpan &tle_field_span(
+    TleField field) noexcept {
+  // enumerators are in record order starting at 1
+  return tle_field_spans[static_cast<std::size_t>(field) - 1];
+}
+
+static_assert(tle_field_span(TleField::kLine2Checksum).start == 68);
+static_assert(tle_field_span(TleField::kMeanMotion).field ==
+              TleField::kMeanMotion);
+
+/// @brief Slice a field out of a full (already size checked) TLE record
+[[nodiscard]] constexpr std::string_view tle_field_str(
+    std::string_view record, TleField field) noexcept {
+  const auto &span = tle_field_span(field);
+  const std::size_t offset = span.line == 1 ? 0 : tle_line_size + 1;
+  return record.substr(offset + span.start, span.size);
+}
+
+[[nodiscard]] constexpr TleError make_tle_error(TleErrc code,
+                                                TleField field) noexcept {
+  const auto &span = tle_field_span(field);
+  return TleError{.code = code,
+                  .field = field,
+                  .line = span.line,
+                  .column = static_cast<std::uint8_t>(span.start + 1)};
+}
+
+[[nodiscard]] constexpr bool is_tle_digit(char c) noexcept {
+  return '0' <= c && c <= '9';
+}
+
+/// @brief Remove leading blanks and a single leading '+', which
+/// std::from_chars doesn't accept but TLE fields contain
+[[nodiscard]] constexpr std::string_view trim_tle_number(
+    std::string_view str) noexcept {
+  while (!str.empty() && str.front() == ' ') {
+    str.remove_prefix(1);
+  }
+  if (!str.empty() && str.front() == '+') {
+    str.remove_prefix(1);
+  }
+  return str;
+}
+
+/// @brief Decode a (blank padded) integer field, all characters must be used
+[[nodiscard]] inline bool decode_tle_int(std::string_view str,
+                                         int &value) noexcept {
+  str = trim_tle_number(str);
+  const char *end = str.data() + str.size();
+  auto [ptr, ec] = std::from_chars(str.data(), end, value);
+  return ec == std::errc{} && ptr == end;
+}
+
+/// @brief Decode a (blank padded) decimal field, all characters must be used
+[[nodiscard]] inline bool decode_tle_double(std::string_view str,
+                                            double &value) noexcept {
+  str = trim_tle_number(str);
+  const char *end = str.data() + str.size();
+  auto [ptr, ec] =
+      std::from_chars(str.data(), end, value, std::chars_format::fixed);
+  return ec == std::errc{} && ptr == end;
+}
+
+/// @brief Exact powers of ten, every entry is representable by a double
+constexpr std::array<double, 23> tle_pow10{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/// @brief Decode a field with an assumed leading decimal point, e.g. the
+/// eccentricity "0004792" -> 0.0004792
+[[nodiscard]] constexpr bool decode_tle_implied_decimal(
+    std::string_view digits, double &value) noexcept {
+  if (digits.empty() || digits.size() >= tle_pow10.size()) {
+    return false;
+  }
+  std::int64_t mantissa = 0;
+  for (char c : digits) {
+    if (!is_tle_digit(c)) {
+      return false;
+    }
+    mantissa = 10 * mantissa + (c - '0');
+  }
+  // a single division of exact values is correctly rounded
+  value = static_cast<double>(mantissa) / tle_pow10[digits.size()];
+  return true;
+}
+
+/// @brief Decode TLE "exponential" field, e.g. " 21418-3" -> 0.21418e-3
+///
+/// Format is [sign][digits with assumed leading decimal point][sign][digit]
+/// where the leading sign may be '+', '-' or ' '.
+[[nodiscard]] constexpr bool decode_tle_exponent(std::string_view str,
+                                                 double &value) noexcept {
+  if (str.size() < 4) {
+    return false;
+  }
+
+  double prefix_sign = 1.0;
+  switch (str.front()) {
+    case '-':
+      prefix_sign = -1.0;
+      break;
+    case '+':
+    case ' ':
+      break;
+    default:
+      return false;
+  }
+
+  int exponent = 0;
+  const char exp_digit = str.back();
+  if (!is_tle_digit(exp_digit)) {
+    return false;
+  }
+  switch (str[str.size() - 2]) {
+    case '-':
+      exponent = -(exp_digit - '0');
+      break;
+    case '+':
+      exponent = exp_digit - '0';
+      break;
+    default:
+      return false;
+  }
+
+  const auto digits = str.substr(1, str.size() - 3);
+  if (digits.size() >= tle_pow10.size() - 9) {
+    return false;
+  }
+  std::int64_t mantissa = 0;
+  for (char c : digits) {
+    if (!is_tle_digit(c)) {
+      return false;
+    }
+    mantissa = 10 * mantissa + (c - '0');
+  }
+
+  // value = 0.mantissa * 10^exponent = mantissa * 10^(exponent - digits)
+  const int scale = exponent - static_cast<int>(digits.size());
+  const auto m = static_cast<double>(mantissa);
+  value = prefix_sign *
+          (scale < 0 ? m / tle_pow10[static_cast<std::size_t>(-scale)]
+                     : m * tle_pow10[static_cast<std::size_t>(scale)]);
+  return true;
+}
+
+/// The checksum is (Modulo 10) (Letters, blanks, periods, plus signs = 0; minus
+/// signs = 1), computed over all but the last character of the line
+[[nodiscard]] constexpr int compute_tle_checksum(
+    std::string_view line) noexcept {
+  int sum = 0;
+  for (char c : line.substr(0, line.size() - 1)) {
+    if (is_tle_digit(c)) {
+      sum += c - '0';
+    } else if (c == '-') {
+      sum += 1;
+    }
+  }
+  return sum % 10;
+}
+
+/// @brief Position of first character not allowed in a TLE
+///
+/// @return index into str, or str.size() if all characters are valid
+[[nodiscard]] constexpr std::size_t find_invalid_tle_char(
+    std::string_view str) noexcept {
+  constexpr auto mask = [] {
+    constexpr std::string_view valid_chars =
+        "ABCDEFGHIJKLMNOPQRSTUV+- 0123456789.\n";
+    std::array<bool, 256> m{};  // initialize all to false
+    for (char c : valid_chars) {
+      m[static_cast<unsigned char>(c)] = true;
+    }
+    return m;
+  }();
+
+  for (std::size_t i = 0; i < str.size(); ++i) {
+    if (!mask[static_cast<unsigned char>(str[i])]) {
+      return i;
+    }
+  }
+  return str.size();
+}
+
+/// @brief Validation shared by the eager and lazy parsers that doesn't
+/// require decoding any numeric fields: size, line break, character set,
+/// line numbers, classification and both checksums.
+[[nodiscard]] constexpr TleError check_tle_record(
+    std::string_view record) noexcept {
+  if (record.size() != tle_record_size) {
+    return TleError{.code = TleErrc::kInvalidSize};
+  }
+
+  if (record[tle_line_size] != '\n') {
+    return TleError{.code = TleErrc::kMissingLineBreak,
+                    .line = 1,
+                    .column = static_cast<std::uint8_t>(tle_line_size + 1)};
+  }
+
+  if (auto pos = find_invalid_tle_char(record); pos != record.size()) {
+    const bool on_line_2 = pos > tle_line_size;
+    const std::size_t column = on_line_2 ? pos - tle_line_size : pos + 1;
+    return TleError{.code = TleErrc::kInvalidCharacter,
+                    .line = static_cast<std::uint8_t>(on_line_2 ? 2 : 1),
+                    .column = static_cast<std::uint8_t>(column)};
+  }
+
+  const auto line_1 = record.substr(0, tle_line_size);
+  const auto line_2 = record.substr(tle_line_size + 1, tle_line_size);
+
+  if (line_1.front() != '1') {
+    return make_tle_error(TleErrc::kInvalidLineNumber, TleField::kLine1Number);
+  }
+  // only unclassified TLEs are in the public domain (that's all we have)
+  // access to, so any other character is assumed to be an error
+  if (tle_field_str(record, TleField::kClassification).front() != 'U') {
+    return make_tle_error(TleErrc::kInvalidClassification,
+                          TleField::kClassification);
+  }
+  if (!is_tle_digit(line_1.back())) {
+    return make_tle_error(TleErrc::kInvalidField, TleField::kLine1Checksum);
+  }
+  if (line_1.back() - '0' != compute_tle_checksum(line_1)) {
+    return make_tle_error(TleErrc::kChecksumMismatch,
+                          TleField::kLine1Checksum);
+  }
+
+  if (line_2.front() != '2') {
+    return make_tle_error(TleErrc::kInvalidLineNumber, TleField::kLine2Number);
+  }
+  if (!is_tle_digit(line_2.back())) {
+    return make_tle_error(TleErrc::kInvalidField, TleField::kLine2Checksum);
+  }
+  if (line_2.back() - '0' != compute_tle_checksum(line_2)) {
+    return make_tle_error(TleErrc::kChecksumMismatch,
+                          TleField::kLine2Checksum);
+  }
+
+  return TleError{};
+}
+
+/// @brief Check domain of parameter inclusive [lower_bound, upper_bound]
+[[nodiscard]] constexpr bool is_within_inclusive_domain(
+    double value, double lower_bound, double upper_bound) noexcept {
+  return lower_bound <= value && value <= upper_bound;
+}
+
+/// @brief Domain and consistency checks on decoded values, a Tle passing
+/// them can be formatted and parsed back
+[[nodiscard]] inline TleError check_tle_values(const Tle &tle) noexcept {
+  struct Domain {
+    TleField field;
+    double value;
+    double lower_bound;
+    double upper_bound;
+  };
+  const std::array<Domain, 5> domains{{
+      {TleField::kInclination, tle.line_2.inclination, 0.0, 180.0},
+      {TleField::kRaan, tle.line_2.raan, 0.0, 360.0},
+      {TleField::kEccentricity, tle.line_2.eccentricity, 0.0, 1.0},
+      {TleField::kArgumentOfPerigree, tle.line_2.argument_of_perigree, 0.0,
+       360.0},
+      {TleField::kMeanAnomaly, tle.line_2.mean_anomaly, 0.0, 360.0},
+  }};
+  for (const auto &[field, value, lower_bound, upper_bound] : domains) {
+    if (!is_within_inclusive_domain(value, lower_bound, upper_bound)) {
+      return make_tle_error(TleErrc::kOutOfDomain, field);
+    }
+  }
+
+  // consistency checks between the two lines
+  if (tle.line_1.satellite_number != tle.line_2.satellite_number) {
+    return make_tle_error(TleErrc::kSatelliteNumberMismatch,
+                          TleField::kLine2SatelliteNumber);
+  }
+
+  return TleError{};
+}
+}  // namespace eob
@@ -0,0 +1,328 @@
+#include "earthorbits/tlefit.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "parallel.h"
+#include "tleelements.h"
+
+namespace eob {
+namespace {
+/// elements in the order of TleElementVector, the order of the Jacobian
+/// columns
+constexpr std::size_t max_elements = tle_element_count;
+using Elements = TleElementVector;
+
+/// Forward difference steps, large enough that the change of the states
+/// is well above rounding and small enough to stay linear
+constexpr Elements difference_steps{
+    1e-5,  // degrees
+    1e-5,  // degrees
+    1e-7,
+    1e-5,  // degrees
+    1e-5,  // degrees
+    1e-8,  // revolutions / day
+    1e-6,  // 1 / Earth radii
+};
+
+/// Levenberg-Marquardt damping, relative to the diagonal of J^T J
+constexpr double initial_damping = 1e-3;
+constexpr double min_damping = 1e-9;
+constexpr double max_damping = 1e12;
+/// km, residuals this small are exact for any tracking data, iterating
+/// further only chases rounding in the finite differences
+constexpr double residual_floor = 1e-8;
+
+/// @brief Observations and the minutes since the epoch they are at
+struct Problem {
+  std::span<const TleObservation> observations;
+  std::vector<double> minutes;
+  double velocity_weight;
+};
+
+/// @brief SGP4 of tle minus the observations, 6 per observation, false if
+/// SGP4 fails for any of them
+[[nodiscard]] bool calc_residuals(const Problem &problem, const Tle &tle,
+                                  std::span<double> residuals) noexcept {
+  Sgp4State state;
+  if (InitSgp4(tle, state) != Sgp4Errc::kOk) {
+    return false;
+  }
+  for (std::size_t i = 0; i < problem.minutes.size(); ++i) {
+    TemeState teme;
+    if (PropagateSgp4(state, problem.minutes[i], teme) != Sgp4Errc::kOk) {
+      return false;
+    }
+    const auto &observed = problem.observations[i].state;
+    for (std::size_t k = 0; k < 3; ++k) {
+      residuals[6 * i + k] = teme.position[k] - observed.position[k];
+      residuals[6 * i + 3 + k] =
+          problem.velocity_weight * (teme.velocity[k] - observed.velocity[k]);
+    }
+  }
+  return true;
+}
+
+[[nodiscard]] double sum_of_squares(std::span<const double> v) noexcept {
+  double sum = 0.0;
+  for (const double x : v) {
+    sum += x * x;
+  }
+  return sum;
+}
+
+[[nodiscard]] double position_rms(std::span<const double> residuals) noexcept {
+  const std::size_t count = residuals.size() / 6;
+  double sum = 0.0;
+  for (std::size_t i = 0; i < count; ++i) {
+    for (std::size_t k = 0; k < 3; ++k) {
+      sum += residuals[6 * i + k] * residuals[6 * i + k];
+    }
+  }
+  return count > 0 ? std::sqrt(sum / static_cast<double>(count)) : 0.0;
+}
+
+using Matrix = std::array<Elements, max_elements>;
+
+/// @brief Decrease of the sum of squared residuals by step if they were
+/// linear in the elements, jtr is -J^T r
+[[nodiscard]] double predicted_decrease(const Matrix &jtj, const Elements &jtr,
+                                        const Elements &step,
+                                        std::size_t n) noexcept {
+  double decrease = 0.0;
+  for (std::size_t a = 0; a < n; ++a) {
+    double jtj_step = 0.0;
+    for (std::size_t b = 0; b < n; ++b) {
+      jtj_step += jtj[a][b] * step[b];
+    }
+    decrease += step[a] * (2.0 * jtr[a] - jtj_step);
+  }
+  return decrease;
+}
+
+/// @brief Solve a x = b for the leading n x n block of the symmetric
+/// positive definite a with a Cholesky decomposition
+///
+/// @returns false if a isn't positive definite
+[[nodiscard]] bool solve_cholesky(Matrix a, const Elements &b, std::size_t n,
+                                  Elements &x) noexcept {
+  for (std::size_t j = 0; j < n; ++j) {
+    double d = a[j][j];
+    for (std::size_t k = 0; k < j; ++k) {
+      d -= a[j][k] * a[j][k];
+    }
+    if (!(d > 0.0)) {
+      return false;
+    }
+    a[j][j] = std::sqrt(d);
+    for (std::size_t i = j + 1; i < n; ++i) {
+      double s = a[i][j];
+      for (std::size_t k = 0; k < j; ++k) {
+        s -= a[i][k] * a[j][k];
+      }
+      a[i][j] = s / a[j][j];
+    }
+  }
+  // L y = b, then L^T x = y
+  for (std::size_t i = 0; i < n; ++i) {
+    double s = b[i];
+    for (std::size_t k = 0; k < i; ++k) {
+      s -= a[i][k] * x[k];
+    }
+    x[i] = s / a[i][i];
+  }
+  for (std::size_t i = n; i-- > 0;) {
+    double s = x[i];
+    for (std::size_t k = i + 1; k < n; ++k) {
+      s -= a[k][i] * x[k];
+    }
+    x[i] = s / a[i][i];
+  }
+  return true;
+}
+}  // namespace
+
+[[nodiscard]] std::string_view to_string(TleFitErrc errc) noexcept {
+  switch (errc) {
+    case TleFitErrc::kOk:
+      return "ok";
+    case TleFitErrc::kTooFewObservations:
+      return "too few observations";
+    case TleFitErrc::kInitialTleInvalid:
+      return "initial TLE invalid";
+    case TleFitErrc::kPropagationFailed:
+      return "propagation failed";
+    case TleFitErrc::kSingular:
+      return "elements not determined by the observations";
+    case TleFitErrc::kNotConverged:
+      return "not converged";
+  }
+  return "unknown error";
+}
+
+[[nodiscard]] TleFitResult FitTle(std::span<const TleObservation> observations,
+                                  const Tle &initial,
+                                  const TleFitOptions &options) {
+  TleFitResult result{.tle = initial};
+  const std::size_t n = options.fit_bstar ? max_elements : max_elements - 1;
+  const std::size_t rows_per_observation =
+      options.velocity_weight != 0.0 ? 6 : 3;
+  if (observations.size() * rows_per_observation < n) {
+    result.code = TleFitErrc::kTooFewObservations;
+    return result;
+  }
+
+  Sgp4State state;
+  if (InitSgp4(initial, state) != Sgp4Errc::kOk) {
+    result.code = TleFitErrc::kInitialTleInvalid;
+    return result;
+  }
+  // the epoch isn't fitted, so these stay the same for every trial
+  Problem problem{.observations = observations,
+                  .minutes = {},
+                  .velocity_weight = options.velocity_weight};
+  problem.minutes.reserve(observations.size());
+  for (const auto &observation : observations) {
+    problem.minutes.push_back(MinutesSinceEpoch(state, observation.time));
+  }
+
+  const std::size_t rows = 6 * observations.size();
+  std::vector<double> residuals(rows);
+  std::vector<double> trial_residuals(rows);
+  std::vector<std::vector<double>> jacobian(n, std::vector<double>(rows));
+  if (!calc_residuals(problem, initial, residuals)) {
+    result.code = TleFitErrc::kPropagationFailed;
+    return result;
+  }
+  double cost = sum_of_squares(residuals);
+  Elements x = get_elements(initial);
+  double damping = initial_damping;
+  const std::size_t threads = resolve_threads(options.threads);
+
+  result.code = TleFitErrc::kNotConverged;
+  while (result.iterations < options.max_iterations) {
+    ++result.iterations;
+
+    std::array<bool, max_elements> column_ok{};
+    parallel_for(n, threads, [&](std::size_t k) {
+      Elements perturbed = x;
+      perturbed[k] += difference_steps[k];
+      Tle tle = result.tle;
+      set_elements(perturbed, tle);
+      auto &column = jacobian[k];
+      column_ok[k] = calc_residuals(problem, tle, column);
+      for (std::size_t i = 0; i < rows; ++i) {
+        column[i] = (column[i] - residuals[i]) / difference_steps[k];
+      }
+    });
+    if (!std::all_of(column_ok.begin(),
+                     column_ok.begin() + static_cast<std::ptrdiff_t>(n),
+                     [](bool ok) { return ok; })) {
+      result.code = TleFitErrc::kPropagationFailed;
+      break;
+    }
+
+    // normal equations J^T J dx = -J^T r
+    Matrix jtj{};
+    Elements jtr{};
+    for (std::size_t a = 0; a < n; ++a) {
+      for (std::size_t b = 0; b <= a; ++b) {
+        double s = 0.0;
+        for (std::size_t i = 0; i < rows; ++i) {
+          s += jacobian[a][i] * jacobian[b][i];
+        }
+        jtj[a][b] = s;
+        jtj[b][a] = s;
+      }
+      double s = 0.0;
+      for (std::size_t i = 0; i < rows; ++i) {
+        s += jacobian[a][i] * residuals[i];
+      }
+      jtr[a] = -s;
+      if (!(jtj[a][a] > 0.0)) {
+        result.code = TleFitErrc::kSingular;
+        break;
+      }
+    }
+    if (result.code == TleFitErrc::kSingular) {
+      break;
+    }
+
+    // the undamped step of the linear model gains nothing worth another
+    // iteration, e.g. the residuals are down to rounding
+    Elements full_step{};
+    if (solve_cholesky(jtj, jtr, n, full_step) &&
+        predicted_decrease(jtj, jtr, full_step, n) <=
+            options.tolerance * cost) {
+      result.code = TleFitErrc::kOk;
+      break;
+    }
+
+    // raise the damping until a step lowers the residuals
+    bool improved = false;
+    double trial_cost = cost;
+    Tle trial = result.tle;
+    while (!improved && damping <= max_damping) {
+      Matrix damped = jtj;
+      for (std::size_t k = 0; k < n; ++k) {
+        damped[k][k] *= 1.0 + damping;
+      }
+      Elements step{};
+      if (solve_cholesky(damped, jtr, n, step)) {
+        Elements next = x;
+        for (std::size_t k = 0; k < n; ++k) {
+          next[k] += step[k];
+        }
+        next = normalize_elements(next);
+        set_elements(next, trial);
+        if (calc_residuals(problem, trial, trial_residuals)) {
+          trial_cost = sum_of_squares(trial_residuals);
+          improved = trial_cost < cost;
+          if (improved) {
+            x = next;
+          }
+        }
+      }
+      damping = improved ? std::max(damping / 10.0, min_damping)
+                         : damping * 10.0;
+    }
+    if (!improved) {
+      // no step lowers the residuals, x is the minimum
+      result.code = TleFitErrc::kOk;
+      break;
+    }
+
+    const double decrease = (cost - trial_cost) / cost;
+    result.tle = trial;
+    residuals.swap(trial_residuals);
+    cost = trial_cost;
+    if (decrease < options.tolerance ||
+        cost <= static_cast<double>(rows) * residual_floor * residual_floor) {
+      result.code = TleFitErrc::kOk;
+      break;
+    }
+  }
+  result.position_rms = position_rms(residuals);
+  return result;
+}
+
+[[nodiscard]] std::vector<TleFitResult> FitTles(
+    std::span<const TleFitProblem> problems, const TleFitOptions &options) {
+  std::vector<TleFitResult> results(problems.size());
+  TleFitOptions single = options;
+  single.threads = 1;
+  parallel_for(problems.size(), resolve_threads(options.threads),
+               [&](std::size_t i) {
+                 results[i] = FitTle(problems[i].observations,
+                                     problems[i].initial, single);
+               });
+  return results;
+}
+}  // namespace eob
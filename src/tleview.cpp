@@ -0,0 +1,154 @@
+#include "earthorbits/tleview.h"
+
+#include <string>
+#include <string_view>
+
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/instrumentation.h"
+#include "tlefields.h"
+
+namespace eob {
+namespace {
+/// @brief Decode a single numeric field and check its domain
+[[nodiscard]] TleError decode_tle_field(std::string_view str, TleField field,
+                                        double &value) noexcept {
+  const auto field_str = tle_field_str(str, field);
+  bool ok = false;
+  switch (field) {
+    case TleField::kMeanMotionDdot:
+    case TleField::kBstarDrag:
+      ok = decode_tle_exponent(field_str, value);
+      break;
+    case TleField::kEccentricity:
+      ok = decode_tle_implied_decimal(field_str, value);
+      break;
+    case TleField::kEpochDay:
+    case TleField::kMeanMotionDot:
+    case TleField::kInclination:
+    case TleField::kRaan:
+    case TleField::kArgumentOfPerigree:
+    case TleField::kMeanAnomaly:
+    case TleField::kMeanMotion:
+      ok = decode_tle_double(field_str, value);
+      break;
+    default: {
+      int int_value = 0;
+      ok = decode_tle_int(field_str, int_value);
+      value = int_value;
+      break;
+    }
+  }
+  if (!ok) {
+    return make_tle_error(TleErrc::kInvalidField, field);
+  }
+
+  double upper_bound = 360.0;
+  switch (field) {
+    case TleField::kInclination:
+      upper_bound = 180.0;
+      break;
+    case TleField::kEccentricity:
+      upper_bound = 1.0;
+      break;
+    case TleField::kRaan:
+    case TleField::kArgumentOfPerigree:
+    case TleField::kMeanAnomaly:
+      break;
+    default:
+      return TleError{};
+  }
+  if (value < 0.0 || upper_bound < value) {
+    return make_tle_error(TleErrc::kOutOfDomain, field);
+  }
+  return TleError{};
+}
+}  // namespace
+
+TleView::TleView(std::string_view str) {
+  if (auto err = TryMakeTleView(str, *this); !err.ok()) {
+    throw MyException<std::string>(to_string(err), std::string(str));
+  }
+}
+
+[[nodiscard]] char TleView::classification() const noexcept {
+  return tle_field_str(str_, TleField::kClassification).front();
+}
+
+[[nodiscard]] std::string_view TleView::launch_piece() const noexcept {
+  return tle_field_str(str_, TleField::kLaunchPiece);
+}
+
+void TleView::decode(TleField field) const {
+  const auto index = static_cast<std::size_t>(field);
+  if (auto err = decode_tle_field(str_, field, values_[index]); !err.ok()) {
+    throw MyException<std::string>(to_string(err), std::string(str_));
+  }
+  decoded_ |= std::uint32_t{1} << index;
+}
+
+[[nodiscard]] Tle TleView::ToTle() const {
+  Tle tle;
+  tle.line_1 = TleLine1{
+      .line_number = 1,
+      .satellite_number = satellite_number(),
+      .classification = classification(),
+      .launch_year = launch_year(),
+      .launch_number = launch_number(),
+      .launch_piece = std::string(launch_piece()),
+      .epoch_year = epoch_year(),
+      .epoch_day = epoch_day(),
+      .mean_motion_dot = mean_motion_dot(),
+      .mean_motion_ddot = mean_motion_ddot(),
+      .bstar_drag = bstar_drag(),
+      .ephemeris_type = ephemeris_type(),
+      .element_number = element_number(),
+      .checksum = tle_field_str(str_, TleField::kLine1Checksum).front() - '0',
+  };
+  tle.line_2 = TleLine2{
+      .line_number = 2,
+      .satellite_number = satellite_number(),
+      .inclination = inclination(),
+      .raan = raan(),
+      .eccentricity = eccentricity(),
+      .argument_of_perigree = argument_of_perigree(),
+      .mean_anomaly = mean_anomaly(),
+      .mean_motion = mean_motion(),
+      .rev_at_epoch = rev_at_epoch(),
+      .checksum = tle_field_str(str_, TleField::kLine2Checksum).front() - '0',
+  };
+  return tle;
+}
+
+[[nodiscard]] TleError TryMakeTleView(std::string_view str,
+                                      TleView &view) noexcept {
+  EOB_SCOPED_TIMER(Probe::kValidateTle);
+  if (auto err = check_tle_record(str); !err.ok()) {
+    return err;
+  }
+
+  // compare as text first so that normally neither number is decoded, only
+  // differently padded fields need decoding to be compared
+  const auto sat_1 = tle_field_str(str, TleField::kLine1SatelliteNumber);
+  const auto sat_2 = tle_field_str(str, TleField::kLine2SatelliteNumber);
+  if (sat_1 != sat_2) {
+    int sat_1_value = 0;
+    int sat_2_value = 0;
+    if (!decode_tle_int(sat_1, sat_1_value)) {
+      return make_tle_error(TleErrc::kInvalidField,
+                            TleField::kLine1SatelliteNumber);
+    }
+    if (!decode_tle_int(sat_2, sat_2_value)) {
+      return make_tle_error(TleErrc::kInvalidField,
+                            TleField::kLine2SatelliteNumber);
+    }
+    if (sat_1_value != sat_2_value) {
+      return make_tle_error(TleErrc::kSatelliteNumberMismatch,
+                            TleField::kLine2SatelliteNumber);
+    }
+  }
+
+  view.str_ = str;
+  view.decoded_ = 0;
+  return TleError{};
+}
+}  // namespace eob
@@ -0,0 +1,105 @@
+#include "earthorbits/topocentric.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+#include "constants.h"
+#include "dispatch.h"
+
+namespace eob {
+namespace {
+/// @brief ECEF position of a geodetic position and its east, north and up
+/// unit vectors
+struct Horizon {
+  std::array<double, 3> ecef;
+  std::array<double, 3> east;
+  std::array<double, 3> north;
+  std::array<double, 3> up;
+};
+
+[[nodiscard]] Horizon make_horizon(const Geodetic &geodetic) noexcept {
+  const double sin_lat = std::sin(geodetic.latitude);
+  const double cos_lat = std::cos(geodetic.latitude);
+  const double sin_lon = std::sin(geodetic.longitude);
+  const double cos_lon = std::cos(geodetic.longitude);
+
+  // radius of curvature in the prime vertical
+  constexpr double e2 = wgs72_flattening * (2.0 - wgs72_flattening);
+  const double n =
+      wgs72_earth_radius_km / std::sqrt(1.0 - e2 * sin_lat * sin_lat);
+  const double r = (n + geodetic.altitude) * cos_lat;
+
+  return {
+      .ecef = {r * cos_lon, r * sin_lon,
+               (n * (1.0 - e2) + geodetic.altitude) * sin_lat},
+      .east = {-sin_lon, cos_lon, 0.0},
+      .north = {-sin_lat * cos_lon, -sin_lat * sin_lon, cos_lat},
+      .up = {cos_lat * cos_lon, cos_lat * sin_lon, sin_lat},
+  };
+}
+
+[[nodiscard]] double dot(const std::array<double, 3> &a,
+                         const std::array<double, 3> &b) noexcept {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+[[nodiscard]] LookAngles look(const std::array<double, 3> &ecef,
+                              const std::array<double, 3> &east,
+                              const std::array<double, 3> &north,
+                              const std::array<double, 3> &up,
+                              const EcefState &satellite) noexcept {
+  const std::array<double, 3> rho{satellite.position[0] - ecef[0],
+                                  satellite.position[1] - ecef[1],
+                                  satellite.position[2] - ecef[2]};
+  const double range = std::sqrt(dot(rho, rho));
+  double azimuth = std::atan2(dot(rho, east), dot(rho, north));
+  if (azimuth < 0.0) {
+    azimuth += pi2;
+  }
+  return {
+      .azimuth = azimuth,
+      .elevation = std::asin(std::clamp(dot(rho, up) / range, -1.0, 1.0)),
+      .range = range,
+      .range_rate = dot(rho, satellite.velocity) / range,
+  };
+}
+}  // namespace
+
+[[nodiscard]] std::array<double, 3> GeodeticToEcef(
+    const Geodetic &geodetic) noexcept {
+  return make_horizon(geodetic).ecef;
+}
+
+[[nodiscard]] LookAngles CalcLookAngles(const Geodetic &station,
+                                        const EcefState &satellite) noexcept {
+  const auto h = make_horizon(station);
+  return look(h.ecef, h.east, h.north, h.up, satellite);
+}
+
+GroundStation::GroundStation(const Geodetic &geodetic) noexcept
+    : geodetic_{geodetic} {
+  const auto h = make_horizon(geodetic);
+  ecef_ = h.ecef;
+  east_ = h.east;
+  north_ = h.north;
+  up_ = h.up;
+}
+
+[[nodiscard]] LookAngles GroundStation::Look(
+    const EcefState &satellite) const noexcept {
+  return look(ecef_, east_, north_, up_, satellite);
+}
+
+void GroundStation::Look(std::span<const EcefState> satellites,
+                         std::span<LookAngles> out) const noexcept {
+  dispatch([&] {
+    const auto n = std::min(satellites.size(), out.size());
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = look(ecef_, east_, north_, up_, satellites[i]);
+    }
+  });
+}
+}  // namespace eob
@@ -0,0 +1,186 @@
+#include "earthorbits/visibility.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "constants.h"
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/eop.h"
+#include "earthorbits/frames.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/topocentric.h"
+#include "parallel.h"
+
+namespace eob {
+namespace {
+constexpr double earth_rotation_rad_per_s = 7.292115146706979e-5;
+
+/// @brief Bound of the speed of state in the Earth fixed frame, km/s
+///
+/// Perigee speed of the mean orbit plus the speed the rotating frame adds
+/// at apogee, with a margin for the short periodic terms of SGP4 and the
+/// mean motion growing from drag.
+[[nodiscard]] double max_speed(const Sgp4State &state) noexcept {
+  const double n = state.mean_motion / 60.0;  // radians / s
+  const double a = std::cbrt(wgs72_mu_km3_per_s2 / (n * n));
+  const double e = std::min(state.eccentricity, 0.999);
+  const double perigee_speed =
+      std::sqrt(wgs72_mu_km3_per_s2 * (1.0 + e) / (a * (1.0 - e)));
+  return 1.05 * (perigee_speed + earth_rotation_rad_per_s * a * (1.0 + e)) +
+         0.1;
+}
+}  // namespace
+
+VisibilityIndex::VisibilityIndex(std::vector<Sgp4State> states,
+                                 std::vector<GroundStation> stations,
+                                 std::chrono::system_clock::time_point start,
+                                 const VisibilityIndexOptions &options)
+    : states_{std::move(states)},
+      stations_{std::move(stations)},
+      start_{start},
+      options_{options} {
+  if (options_.bucket <= std::chrono::system_clock::duration::zero()) {
+    throw MyException<std::string>("bucket must be positive",
+                                   std::to_string(options_.bucket.count()));
+  }
+  if (states_.size() > std::numeric_limits<std::uint32_t>::max()) {
+    throw MyException<std::size_t>("catalog too large to index",
+                                   states_.size());
+  }
+  max_speeds_.reserve(states_.size());
+  for (const auto &state : states_) {
+    max_speeds_.push_back(max_speed(state));
+  }
+}
+
+[[nodiscard]] std::size_t VisibilityIndex::MemoryBytes() const noexcept {
+  std::size_t bytes = max_speeds_.capacity() * sizeof(double) +
+                      buckets_.size() * sizeof(Bucket);
+  for (const auto &bucket : buckets_) {
+    bytes += (bucket.offsets.capacity() + bucket.satellites.capacity()) *
+             sizeof(std::uint32_t);
+  }
+  return bytes;
+}
+
+[[nodiscard]] VisibilityIndex::Bucket VisibilityIndex::MakeBucket(
+    std::chrono::system_clock::time_point begin) const {
+  using namespace std::chrono;
+  const auto middle = begin + options_.bucket / 2;
+  const double half_bucket =
+      duration<double>(options_.bucket).count() / 2.0;  // seconds
+
+  // Earth fixed positions at the middle of the bucket, satellites that
+  // fail to propagate aren't candidates
+  std::vector<TemeState> teme(states_.size());
+  std::vector<Sgp4Errc> errors(states_.size());
+  PropagateSgp4(states_, middle, teme, errors);
+  std::vector<EcefState> ecef(states_.size());
+  TemeToEcef(teme, middle, EopTable{}, ecef);
+
+  Bucket bucket;
+  bucket.offsets.reserve(stations_.size() + 1);
+  bucket.offsets.push_back(0);
+  for (const auto &station : stations_) {
+    for (std::size_t i = 0; i < states_.size(); ++i) {
+      if (errors[i] != Sgp4Errc::kOk) {
+        continue;
+      }
+      // the satellite stays in a ball of radius slack around its position,
+      // which reaches min_elevation if the ball's angular radius makes up
+      // for the elevation missing at the middle
+      const double slack = max_speeds_[i] * half_bucket;
+      const auto look = station.Look(ecef[i]);
+      if (look.range <= slack ||
+          look.elevation + std::asin(slack / look.range) >=
+              options_.min_elevation) {
+        bucket.satellites.push_back(static_cast<std::uint32_t>(i));
+      }
+    }
+    bucket.offsets.push_back(
+        static_cast<std::uint32_t>(bucket.satellites.size()));
+  }
+  bucket.satellites.shrink_to_fit();
+  return bucket;
+}
+
+void VisibilityIndex::Extend(std::chrono::system_clock::time_point end) {
+  const auto current = this->end();
+  if (end <= current) {
+    return;
+  }
+  const auto &bucket = options_.bucket;
+  // buckets until end, rounded up
+  const auto count = static_cast<std::size_t>(
+      (end - current + bucket - std::chrono::system_clock::duration(1)) /
+      bucket);
+  std::vector<Bucket> added(count);
+  parallel_for(count, resolve_threads(options_.threads), [&](std::size_t k) {
+    added[k] = MakeBucket(current + bucket * static_cast<std::int64_t>(k));
+  });
+  for (auto &b : added) {
+    buckets_.push_back(std::move(b));
+  }
+}
+
+void VisibilityIndex::DropBefore(std::chrono::system_clock::time_point tp) {
+  while (!buckets_.empty() && start_ + options_.bucket <= tp) {
+    buckets_.pop_front();
+    start_ += options_.bucket;
+  }
+}
+
+[[nodiscard]] std::span<const std::uint32_t> VisibilityIndex::Candidates(
+    std::size_t station,
+    std::chrono::system_clock::time_point tp) const noexcept {
+  if (tp < start_ || tp >= end() || station >= stations_.size()) {
+    return {};
+  }
+  const auto &bucket =
+      buckets_[static_cast<std::size_t>((tp - start_) / options_.bucket)];
+  return std::span<const std::uint32_t>(bucket.satellites)
+      .subspan(bucket.offsets[station],
+               bucket.offsets[station + 1] - bucket.offsets[station]);
+}
+
+[[nodiscard]] bool VisibilityIndex::Visible(
+    std::size_t station, std::chrono::system_clock::time_point tp,
+    std::vector<VisibleSatellite> &out) const {
+  out.clear();
+  if (tp < start_ || tp >= end() || station >= stations_.size()) {
+    return false;
+  }
+  const auto candidates = Candidates(station, tp);
+  std::vector<std::uint32_t> propagated;
+  std::vector<TemeState> teme;
+  propagated.reserve(candidates.size());
+  teme.reserve(candidates.size());
+  TemeState state;
+  for (const auto i : candidates) {
+    if (PropagateSgp4(states_[i], MinutesSinceEpoch(states_[i], tp), state) ==
+        Sgp4Errc::kOk) {
+      propagated.push_back(i);
+      teme.push_back(state);
+    }
+  }
+  // one rotation for all candidates
+  std::vector<EcefState> ecef(teme.size());
+  TemeToEcef(teme, tp, EopTable{}, ecef);
+  for (std::size_t k = 0; k < ecef.size(); ++k) {
+    const auto look = stations_[station].Look(ecef[k]);
+    if (look.elevation >= options_.min_elevation) {
+      out.push_back(
+          VisibleSatellite{.satellite = propagated[k], .look = look});
+    }
+  }
+  return true;
+}
+}  // namespace eob
@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "earthorbits/archiveanalytics.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/tlearchive.h"
+#include "synthcatalog.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+constexpr std::size_t objects = 250;
+constexpr std::size_t days = 4 * 365;
+
+/// @brief Four years of element sets twice a day, by object, each with a
+/// maneuver
+const std::map<std::uint32_t, std::vector<Tle>> &Histories() {
+  static const auto histories = [] {
+    std::map<std::uint32_t, std::vector<Tle>> by_object;
+    for (const auto &tle :
+         MakeSynthHistory({.objects = objects, .days = days})) {
+      by_object[static_cast<std::uint32_t>(tle.line_1.satellite_number)]
+          .push_back(tle);
+    }
+    std::size_t k = 0;
+    for (auto &[number, history] : by_object) {
+      InjectMeanMotion(history, 100 + (k++ * 37) % (history.size() - 200),
+                       0.001);
+    }
+    return by_object;
+  }();
+  return histories;
+}
+
+/// @brief The histories as an archive, written once
+const TleArchiveReader &Archive() {
+  static const auto reader = [] {
+    const auto path = TempPath("eobarchiveanalyticsbench.bin");
+    {
+      TleArchiveWriter writer(path);
+      for (const auto &[number, history] : Histories()) {
+        writer.Append(history);
+      }
+    }
+    TleArchiveReader mapped(path);
+    std::filesystem::remove(path);  // stays mapped
+    return mapped;
+  }();
+  return reader;
+}
+}  // namespace
+
+/// Objects per second, decoding the archive included
+static void BM_AnalyzeArchive(benchmark::State &state) {
+  const auto &archive = Archive();
+  std::size_t events = 0;
+  for (auto _ : state) {
+    events = AnalyzeArchive(
+                 archive,
+                 {.threads = static_cast<std::size_t>(state.range(0))})
+                 .size();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(objects));
+  state.counters["element_sets"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) *
+          static_cast<double>(archive.record_count()),
+      benchmark::Counter::kIsRate);
+  state.counters["events"] = static_cast<double>(events);
+}
+BENCHMARK(BM_AnalyzeArchive)
+    ->Arg(1)
+    ->Arg(0)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/// Decoding alone, what the analysis adds to a scan
+static void BM_ScanArchive(benchmark::State &state) {
+  const auto &archive = Archive();
+  for (auto _ : state) {
+    archive.ScanObjects(
+        [](std::span<const Tle> history) {
+          benchmark::DoNotOptimize(history.data());
+        },
+        1);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(objects));
+}
+BENCHMARK(BM_ScanArchive)->Unit(benchmark::kMillisecond);
+
+/// The analysis alone, histories in memory
+static void BM_AnalyzeHistory(benchmark::State &state) {
+  const auto &histories = Histories();
+  std::size_t element_sets = 0;
+  for (const auto &[number, history] : histories) {
+    element_sets += history.size();
+  }
+  for (auto _ : state) {
+    for (const auto &[number, history] : histories) {
+      auto events = AnalyzeHistory(history);
+      benchmark::DoNotOptimize(events.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(objects));
+  state.counters["element_sets"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) *
+          static_cast<double>(element_sets),
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_AnalyzeHistory)->Unit(benchmark::kMillisecond);
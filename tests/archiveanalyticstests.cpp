@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <numbers>
+#include <string>
+#include <vector>
+
+#include "earthorbits/archiveanalytics.h"
+#include "earthorbits/eobmath.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/tlearchive.h"
+#include "synthcatalog.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+/// @brief A year of element sets of 100 objects, by object
+std::map<std::uint32_t, std::vector<Tle>> Histories() {
+  std::map<std::uint32_t, std::vector<Tle>> histories;
+  for (const auto &tle : MakeSynthHistory({.objects = 100, .days = 365})) {
+    histories[static_cast<std::uint32_t>(tle.line_1.satellite_number)]
+        .push_back(tle);
+  }
+  return histories;
+}
+
+/// @brief The history of a low Earth orbit
+std::vector<Tle> Leo(const std::map<std::uint32_t, std::vector<Tle>> &all,
+                     std::size_t skip = 0) {
+  for (const auto &[number, history] : all) {
+    if (history.front().line_2.mean_motion > 14.0 && skip-- == 0) {
+      return history;
+    }
+  }
+  ADD_FAILURE() << "no LEO";
+  return {};
+}
+
+/// @brief Mean motion derivative rising from first on, SGP4 doesn't use
+/// it so the other elements are left alone
+void InjectDecay(std::vector<Tle> &history, std::size_t first,
+                 std::size_t count) {
+  for (std::size_t k = first; k < first + count; ++k) {
+    history[k].line_1.mean_motion_dot =
+        1e-3 * (1.0 + 0.05 * static_cast<double>(k - first));
+  }
+}
+
+/// @brief B* rising from first on, with mean motions and mean anomalies
+/// that follow the drag of SGP4 to first order
+void InjectDrag(std::vector<Tle> &history, std::size_t first) {
+  double extra_n = 0.0;  // revolutions / day
+  double extra_m = 0.0;  // degrees
+  for (std::size_t k = first; k < history.size(); ++k) {
+    const auto &previous = history[k - 1];
+    auto &tle = history[k];
+    if (k > first) {
+      // n goes with (1 - cc1 t)^-3, the mean anomaly gains n t2cof t^2
+      const auto state = InitState(previous);
+      const double minutes =
+          std::chrono::duration<double, std::chrono::minutes::period>(
+              TleEpoch(tle.line_1) - TleEpoch(previous.line_1))
+              .count();
+      extra_m += extra_n * minutes / 1440.0 * 360.0 +
+                 1.5 * state.cc1 * state.mean_motion * minutes * minutes *
+                     180.0 / std::numbers::pi;
+      extra_n += 3.0 * state.cc1 * minutes * previous.line_2.mean_motion;
+    }
+    tle.line_1.bstar_drag =
+        6e-3 * (1.0 + 0.02 * static_cast<double>(k - first));
+    tle.line_2.mean_motion += extra_n;
+    tle.line_2.mean_anomaly = wrap_to_360(tle.line_2.mean_anomaly + extra_m);
+  }
+}
+}  // namespace
+
+TEST(ArchiveAnalyticsTest, Quiet) {
+  // drift alone is no event
+  for (const auto &[number, history] : Histories()) {
+    const auto events = AnalyzeHistory(history);
+    EXPECT_TRUE(events.empty()) << number << " " << events.size();
+  }
+  EXPECT_TRUE(AnalyzeHistory({}).empty());
+  const auto leo = Leo(Histories());
+  EXPECT_TRUE(AnalyzeHistory(std::span(leo).first(1)).empty());
+}
+
+TEST(ArchiveAnalyticsTest, Maneuvers) {
+  auto history = Leo(Histories());
+  ASSERT_GT(history.size(), 500U);
+  InjectMeanMotion(history, 200, 0.005);
+  for (std::size_t k = 300; k < history.size(); ++k) {
+    history[k].line_2.inclination += 0.05;
+  }
+  for (std::size_t k = 400; k < history.size(); ++k) {
+    history[k].line_2.raan += 0.1;
+  }
+  // re-published, skipped
+  history.insert(history.begin() + 100, history[99]);
+
+  const auto events = AnalyzeHistory(history);
+  ASSERT_EQ(events.size(), 3U);
+  for (const auto &e : events) {
+    EXPECT_EQ(e.kind, ArchiveEventKind::kManeuver);
+    EXPECT_EQ(e.satellite_number,
+              static_cast<std::uint32_t>(history[0].line_1.satellite_number));
+    EXPECT_GT(e.significance, 8.0);
+  }
+  // residuals are osculating, the short period terms of the orbits before
+  // and after a maneuver differ a little
+  EXPECT_EQ(events[0].epoch, TleEpoch(history[201].line_1));
+  EXPECT_EQ(events[0].previous_epoch, TleEpoch(history[200].line_1));
+  EXPECT_TRUE(events[0].mean_motion_jump);
+  EXPECT_FALSE(events[0].inclination_jump);
+  EXPECT_NEAR(events[0].mean_motion_residual, 0.005, 1e-4);
+
+  EXPECT_EQ(events[1].epoch, TleEpoch(history[301].line_1));
+  EXPECT_TRUE(events[1].inclination_jump);
+  EXPECT_FALSE(events[1].mean_motion_jump);
+  EXPECT_NEAR(events[1].inclination_residual, 0.05, 1e-4);
+
+  EXPECT_EQ(events[2].epoch, TleEpoch(history[401].line_1));
+  EXPECT_TRUE(events[2].raan_jump);
+  // the synthetic RAAN keeps drifting at the rate of the orbit before the
+  // maneuvers, the predictions are from the orbit after them
+  EXPECT_NEAR(events[2].raan_residual, 0.1, 1e-2);
+}
+
+TEST(ArchiveAnalyticsTest, Decay) {
+  const auto all = Histories();
+  auto history = Leo(all);
+  InjectDecay(history, 500, 40);
+  history.resize(540);
+  auto events = AnalyzeHistory(history);
+  ASSERT_EQ(events.size(), 1U);
+  EXPECT_EQ(events[0].kind, ArchiveEventKind::kDecay);
+  EXPECT_GE(events[0].epoch, TleEpoch(history[500].line_1));
+  EXPECT_LT(events[0].epoch, TleEpoch(history[520].line_1));
+  EXPECT_GT(events[0].mean_motion_dot, 1e-3);
+
+  // rising drag term
+  history = Leo(all, 1);
+  InjectDrag(history, 600);
+  events = AnalyzeHistory(history);
+  ASSERT_EQ(events.size(), 1U);
+  EXPECT_EQ(events[0].kind, ArchiveEventKind::kDecay);
+  EXPECT_GE(events[0].epoch, TleEpoch(history[600].line_1));
+  EXPECT_GT(events[0].bstar, 6e-3);
+}
+
+TEST(ArchiveAnalyticsTest, Archive) {
+  auto histories = Histories();
+  auto &leo = histories.begin()->second;
+  for (std::size_t k = 123; k < leo.size(); ++k) {
+    leo[k].line_2.inclination += 0.1;
+  }
+  std::vector<ArchiveEvent> expected;
+  const auto path = TempPath("eobarchiveanalyticstest.bin");
+  {
+    TleArchiveWriter writer(path, {.block_size = 100});
+    for (const auto &[number, history] : histories) {
+      writer.Append(history);
+      const auto events = AnalyzeHistory(history);
+      expected.insert(expected.end(), events.begin(), events.end());
+    }
+  }
+  ASSERT_FALSE(expected.empty());
+
+  const TleArchiveReader archive(path);
+  for (const std::size_t threads : {1U, 3U}) {
+    const auto events = AnalyzeArchive(archive, {.threads = threads});
+    ASSERT_EQ(events.size(), expected.size());
+    for (std::size_t i = 0; i < events.size(); ++i) {
+      EXPECT_EQ(events[i].satellite_number, expected[i].satellite_number);
+      EXPECT_EQ(events[i].epoch, expected[i].epoch);
+      EXPECT_EQ(events[i].kind, expected[i].kind);
+      EXPECT_EQ(events[i].inclination_residual,
+                expected[i].inclination_residual);
+    }
+  }
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,110 @@
+#include "asyncdriver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eob {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+[[nodiscard]] double ms_since(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+struct ClientResult {
+  std::vector<double> latency_ms;
+  std::vector<double> first_chunk_ms;
+  std::size_t chunks = 0;
+  std::size_t results = 0;
+};
+
+/// @brief One client, resumed on the propagator's workers between chunks
+Task RunClient(AsyncPropagator &propagator,
+               const std::vector<Sgp4State> &catalog,
+               const AsyncDriverOptions &options, std::uint64_t seed,
+               ClientResult &result) {
+  // xorshift, the driver only needs different slices per client
+  std::uint64_t x = seed * 0x9e3779b97f4a7c15 + 1;
+  for (std::size_t r = 0; r < options.requests_per_client; ++r) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    const auto size = std::min(options.states_per_request, catalog.size());
+    const auto first = static_cast<std::size_t>(
+        x % static_cast<std::uint64_t>(catalog.size() - size + 1));
+
+    PropagationRequest request;
+    request.states.assign(
+        catalog.begin() + static_cast<std::ptrdiff_t>(first),
+        catalog.begin() + static_cast<std::ptrdiff_t>(first + size));
+    request.start = catalog[first].epoch;
+    request.steps = options.steps;
+    request.chunk_size = options.chunk_size;
+
+    const auto start = Clock::now();
+    auto stream = propagator.Submit(std::move(request));
+    bool first_chunk = true;
+    while (auto chunk = co_await stream.Next()) {
+      if (first_chunk) {
+        result.first_chunk_ms.push_back(ms_since(start));
+        first_chunk = false;
+      }
+      ++result.chunks;
+      result.results += chunk->teme.size();
+    }
+    result.latency_ms.push_back(ms_since(start));
+  }
+}
+}  // namespace
+
+[[nodiscard]] AsyncDriverResult RunAsyncDriver(
+    AsyncPropagator &propagator, const std::vector<Sgp4State> &catalog,
+    const AsyncDriverOptions &options) {
+  AsyncDriverResult result;
+  if (catalog.empty()) {
+    return result;
+  }
+  std::vector<ClientResult> clients(options.clients);
+  std::vector<Task> tasks;
+  tasks.reserve(options.clients);
+  const auto start = Clock::now();
+  for (std::size_t i = 0; i < options.clients; ++i) {
+    tasks.push_back(
+        RunClient(propagator, catalog, options, options.seed + i, clients[i]));
+  }
+  for (const auto &task : tasks) {
+    task.Wait();
+  }
+  result.seconds = ms_since(start) / 1000.0;
+
+  for (const auto &client : clients) {
+    result.latency_ms.insert(result.latency_ms.end(),
+                             client.latency_ms.begin(),
+                             client.latency_ms.end());
+    result.first_chunk_ms.insert(result.first_chunk_ms.end(),
+                                 client.first_chunk_ms.begin(),
+                                 client.first_chunk_ms.end());
+    result.chunks += client.chunks;
+    result.results += client.results;
+  }
+  return result;
+}
+
+[[nodiscard]] double Percentile(std::vector<double> values, double p) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  const auto rank = static_cast<std::size_t>(
+      std::ceil(p / 100.0 * static_cast<double>(values.size())));
+  const auto i = std::clamp<std::size_t>(rank, 1, values.size()) - 1;
+  std::nth_element(values.begin(),
+                   values.begin() + static_cast<std::ptrdiff_t>(i),
+                   values.end());
+  return values[i];
+}
+}  // namespace eob
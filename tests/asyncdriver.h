@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "earthorbits/asyncpropagator.h"
+#include "earthorbits/sgp4.h"
+
+/// Stand-in for a propagation service front end: many clients submitting
+/// requests concurrently and consuming the streamed results, for tests and
+/// latency benchmarks of AsyncPropagator.
+
+namespace eob {
+struct AsyncDriverOptions {
+  std::size_t clients = 64;
+  std::size_t requests_per_client = 4;
+  std::size_t states_per_request = 500;
+  std::size_t steps = 60;
+  std::size_t chunk_size = 256;
+  std::uint64_t seed = 1;
+};
+
+struct AsyncDriverResult {
+  std::vector<double> latency_ms;      ///< submit to last chunk, per request
+  std::vector<double> first_chunk_ms;  ///< submit to first chunk
+  std::size_t chunks = 0;
+  std::size_t results = 0;  ///< propagated states, summed over chunks
+  double seconds = 0.0;     ///< wall time of the whole run
+};
+
+/// @brief Run the clients to completion, each request propagates a random
+/// contiguous slice of catalog
+[[nodiscard]] AsyncDriverResult RunAsyncDriver(
+    AsyncPropagator &propagator, const std::vector<Sgp4State> &catalog,
+    const AsyncDriverOptions &options);
+
+/// @brief Nearest rank percentile, p in [0, 100]
+[[nodiscard]] double Percentile(std::vector<double> values, double p);
+}  // namespace eob
@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "asyncdriver.h"
+#include "earthorbits/asyncpropagator.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+namespace {
+/// @brief SGP4 states of the near Earth part of the synthetic catalog
+std::vector<Sgp4State> NearEarthStates(std::size_t size) {
+  std::vector<Sgp4State> states;
+  Sgp4State state;
+  for (const auto &str : CachedSynthTles(size)) {
+    if (InitSgp4(ParseTle(str), state) == Sgp4Errc::kOk) {
+      states.push_back(state);
+    }
+  }
+  return states;
+}
+}  // namespace
+
+/// Request latency under load, range(0) concurrent clients each sending 4
+/// requests of 500 objects over 60 steps
+static void BM_AsyncPropagateLatency(benchmark::State &state) {
+  const auto catalog = NearEarthStates(30000);
+  AsyncPropagator propagator;
+  const AsyncDriverOptions options{
+      .clients = static_cast<std::size_t>(state.range(0))};
+
+  std::vector<double> latency_ms;
+  std::vector<double> first_chunk_ms;
+  std::size_t results = 0;
+  for (auto _ : state) {
+    const auto result = RunAsyncDriver(propagator, catalog, options);
+    latency_ms.insert(latency_ms.end(), result.latency_ms.begin(),
+                      result.latency_ms.end());
+    first_chunk_ms.insert(first_chunk_ms.end(), result.first_chunk_ms.begin(),
+                          result.first_chunk_ms.end());
+    results += result.results;
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(results));
+  state.counters["p50_ms"] = Percentile(latency_ms, 50);
+  state.counters["p99_ms"] = Percentile(latency_ms, 99);
+  state.counters["first_chunk_p50_ms"] = Percentile(first_chunk_ms, 50);
+  state.counters["first_chunk_p99_ms"] = Percentile(first_chunk_ms, 99);
+  state.counters["threads"] = static_cast<double>(propagator.threads());
+}
+BENCHMARK(BM_AsyncPropagateLatency)
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
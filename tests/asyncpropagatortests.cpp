@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "asyncdriver.h"
+#include "earthorbits/asyncpropagator.h"
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+namespace {
+std::vector<Sgp4State> NearEarthStates(std::size_t size) {
+  std::vector<Sgp4State> states;
+  Sgp4State state;
+  for (const auto &str : MakeSynthTles({.size = size})) {
+    if (InitSgp4(ParseTle(str), state) == Sgp4Errc::kOk) {
+      states.push_back(state);
+    }
+  }
+  return states;
+}
+
+/// @brief Collect every chunk of stream into results[step][state]
+Task Collect(PropagationStream &stream,
+             std::vector<std::vector<TemeState>> &results,
+             std::size_t &chunks) {
+  while (auto chunk = co_await stream.Next()) {
+    ++chunks;
+    for (std::size_t i = 0; i < chunk->teme.size(); ++i) {
+      results[chunk->step][chunk->first_state + i] = chunk->teme[i];
+    }
+  }
+}
+}  // namespace
+
+TEST(AsyncPropagatorTest, StreamsAllResults) {
+  const auto states = NearEarthStates(200);
+  const auto start = states.front().epoch;
+  AsyncPropagator propagator(4);
+
+  PropagationRequest request;
+  request.states = states;
+  request.start = start;
+  request.step = std::chrono::minutes(10);
+  request.steps = 6;
+  request.chunk_size = 50;
+  auto stream = propagator.Submit(request);
+  EXPECT_EQ(stream.chunk_count(), 6 * ((states.size() + 49) / 50));
+
+  std::vector<std::vector<TemeState>> results(
+      6, std::vector<TemeState>(states.size()));
+  std::size_t chunks = 0;
+  Collect(stream, results, chunks).Wait();
+  EXPECT_EQ(chunks, stream.chunk_count());
+
+  for (std::size_t step = 0; step < 6; ++step) {
+    const auto tp = start + std::chrono::minutes(10 * step);
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      TemeState expected;
+      static_cast<void>(
+          PropagateSgp4(states[i], MinutesSinceEpoch(states[i], tp), expected));
+      EXPECT_EQ(results[step][i].position, expected.position);
+    }
+  }
+}
+
+TEST(AsyncPropagatorTest, Cancel) {
+  const auto states = NearEarthStates(200);
+  AsyncPropagator propagator(2);
+  PropagationRequest request;
+  request.states = states;
+  request.start = states.front().epoch;
+  request.steps = 10000;
+  request.chunk_size = 16;
+  auto stream = propagator.Submit(std::move(request));
+
+  auto consume = [](PropagationStream &s, std::size_t &chunks) -> Task {
+    while (auto chunk = co_await s.Next()) {
+      if (++chunks == 10) {
+        s.Cancel();
+      }
+    }
+  };
+  std::size_t chunks = 0;
+  consume(stream, chunks).Wait();
+  EXPECT_TRUE(stream.cancelled());
+  EXPECT_EQ(chunks, 10U);
+  EXPECT_LT(chunks, stream.chunk_count());
+}
+
+TEST(AsyncPropagatorTest, Errors) {
+  AsyncPropagator propagator(1);
+  EXPECT_EQ(propagator.threads(), 1U);
+
+  PropagationRequest request;
+  request.chunk_size = 0;
+  EXPECT_THROW(static_cast<void>(propagator.Submit(request)),
+               MyException<std::string>);
+  request.chunk_size = 1;
+  request.steps = 2;
+  request.step = std::chrono::seconds(0);
+  EXPECT_THROW(static_cast<void>(propagator.Submit(request)),
+               MyException<std::string>);
+
+  // nothing to propagate finishes right away
+  request.steps = 1;
+  auto stream = propagator.Submit(request);
+  std::vector<std::vector<TemeState>> results;
+  std::size_t chunks = 0;
+  Collect(stream, results, chunks).Wait();
+  EXPECT_EQ(chunks, 0U);
+
+  // a moved-from stream has nothing more to deliver
+  request.states = NearEarthStates(10);
+  request.start = request.states.front().epoch;
+  request.chunk_size = 16;
+  auto from = propagator.Submit(request);
+  auto to = std::move(from);
+  results.assign(1, std::vector<TemeState>(request.states.size()));
+  // NOLINTNEXTLINE(bugprone-use-after-move)
+  Collect(from, results, chunks).Wait();
+  EXPECT_EQ(chunks, 0U);
+  Collect(to, results, chunks).Wait();
+  EXPECT_EQ(chunks, 1U);
+}
+
+TEST(AsyncPropagatorTest, MoveAssignCancels) {
+  const auto states = NearEarthStates(200);
+  std::vector<std::vector<TemeState>> results(
+      1, std::vector<TemeState>(states.size()));
+  std::size_t chunks = 0;
+  {
+    AsyncPropagator propagator(1);
+    PropagationRequest request;
+    request.states = states;
+    request.start = states.front().epoch;
+    request.chunk_size = 16;
+    request.steps = 1;
+    auto next = propagator.Submit(request);
+    // practically never finishes, so ~AsyncPropagator only returns if
+    // the assignment below cancelled it
+    request.step = std::chrono::milliseconds(1);
+    request.steps = std::size_t{1} << 32U;
+    auto stream = propagator.Submit(request);
+    EXPECT_FALSE(stream.cancelled());
+
+    stream = std::move(next);
+    EXPECT_FALSE(stream.cancelled());
+    EXPECT_EQ(stream.chunk_count(), (states.size() + 15) / 16);
+    Collect(stream, results, chunks).Wait();
+    EXPECT_EQ(chunks, stream.chunk_count());
+  }
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    TemeState expected;
+    static_cast<void>(PropagateSgp4(
+        states[i], MinutesSinceEpoch(states[i], states.front().epoch),
+        expected));
+    EXPECT_EQ(results[0][i].position, expected.position);
+  }
+}
+
+TEST(AsyncPropagatorTest, Driver) {
+  const auto states = NearEarthStates(300);
+  AsyncPropagator propagator(4);
+  const AsyncDriverOptions options{.clients = 16,
+                                   .requests_per_client = 2,
+                                   .states_per_request = 100,
+                                   .steps = 5,
+                                   .chunk_size = 32};
+  const auto result = RunAsyncDriver(propagator, states, options);
+  EXPECT_EQ(result.latency_ms.size(), 32U);
+  EXPECT_EQ(result.results, 32U * 100 * 5);
+  EXPECT_EQ(result.chunks, 32U * 4 * 5);
+  EXPECT_LE(Percentile(result.latency_ms, 50),
+            Percentile(result.latency_ms, 99));
+}
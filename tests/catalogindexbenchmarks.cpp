@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "earthorbits/catalogindex.h"
+#include "earthorbits/parsetle.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+namespace {
+/// @brief Parsed synthetic catalog, cached per size
+const std::vector<Tle> &CachedCatalog(size_t size) {
+  static std::mutex mutex;
+  static std::map<size_t, std::unique_ptr<std::vector<Tle>>> cache;
+  const std::lock_guard lock(mutex);
+  auto &catalog = cache[size];
+  if (!catalog) {
+    catalog = std::make_unique<std::vector<Tle>>();
+    catalog->reserve(size);
+    for (const auto &str : CachedSynthTles(size)) {
+      catalog->push_back(ParseTle(str));
+    }
+  }
+  return *catalog;
+}
+
+/// Sun-synchronous LEO band
+const CatalogQuery sso_query{
+    .perigee_altitude = ValueRange{500.0, 800.0},
+    .inclination = ValueRange{96.0, 99.0},
+    .regime = OrbitRegime::kLeo,
+};
+}  // namespace
+
+static void BM_CatalogIndexBuild(benchmark::State &state) {
+  const auto &catalog = CachedCatalog(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    CatalogIndex index(catalog);
+    benchmark::DoNotOptimize(index);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CatalogIndexBuild)->Arg(30000)->Arg(1000000);
+
+static void BM_CatalogIndexQuery(benchmark::State &state) {
+  const auto &catalog = CachedCatalog(static_cast<size_t>(state.range(0)));
+  const CatalogIndex index(catalog);
+  size_t matches = 0;
+  for (auto _ : state) {
+    auto result = index.Query(sso_query);
+    matches = result.Count();
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["matches"] = static_cast<double>(matches);
+}
+BENCHMARK(BM_CatalogIndexQuery)->Arg(30000)->Arg(1000000);
+
+static void BM_CatalogLinearScan(benchmark::State &state) {
+  const auto &catalog = CachedCatalog(static_cast<size_t>(state.range(0)));
+  size_t matches = 0;
+  for (auto _ : state) {
+    std::vector<size_t> rows;
+    for (size_t row = 0; row < catalog.size(); ++row) {
+      const auto summary = SummarizeOrbit(catalog[row].line_2);
+      if (summary.regime == *sso_query.regime &&
+          sso_query.inclination->min <= summary.inclination &&
+          summary.inclination <= sso_query.inclination->max &&
+          sso_query.perigee_altitude->min <= summary.perigee_altitude &&
+          summary.perigee_altitude <= sso_query.perigee_altitude->max) {
+        rows.push_back(row);
+      }
+    }
+    matches = rows.size();
+    benchmark::DoNotOptimize(rows);
+  }
+  state.counters["matches"] = static_cast<double>(matches);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CatalogLinearScan)->Arg(30000)->Arg(1000000);
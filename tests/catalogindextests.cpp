@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "earthorbits/catalogindex.h"
+#include "earthorbits/parsetle.h"
+
+using namespace eob;
+
+namespace {
+[[nodiscard]] Tle MakeTle(double mean_motion, double eccentricity,
+                          double inclination) {
+  Tle tle{};
+  tle.line_2.mean_motion = mean_motion;
+  tle.line_2.eccentricity = eccentricity;
+  tle.line_2.inclination = inclination;
+  return tle;
+}
+
+[[nodiscard]] bool Matches(const CatalogQuery &query,
+                           const OrbitSummary &summary) {
+  auto in = [](const std::optional<ValueRange> &range, double value) {
+    return !range || (range->min <= value && value <= range->max);
+  };
+  return in(query.semi_major_axis, summary.semi_major_axis) &&
+         in(query.perigee_altitude, summary.perigee_altitude) &&
+         in(query.apogee_altitude, summary.apogee_altitude) &&
+         in(query.inclination, summary.inclination) &&
+         (!query.regime || *query.regime == summary.regime);
+}
+}  // namespace
+
+TEST(CatalogIndexTest, SummarizeOrbit) {
+  // ISS, ~420 km circular orbit
+  auto iss = SummarizeOrbit(MakeTle(15.49960977, 0.0004792, 51.6405).line_2);
+  EXPECT_NEAR(iss.semi_major_axis, 6797.0, 5.0);
+  EXPECT_NEAR(iss.perigee_altitude, 416.0, 5.0);
+  EXPECT_NEAR(iss.apogee_altitude, 422.0, 5.0);
+  EXPECT_EQ(iss.regime, OrbitRegime::kLeo);
+
+  auto geo = SummarizeOrbit(MakeTle(1.0027, 0.0002, 0.05).line_2);
+  EXPECT_NEAR(geo.semi_major_axis, 42164.0, 5.0);
+  EXPECT_EQ(geo.regime, OrbitRegime::kGeo);
+
+  auto gps = SummarizeOrbit(MakeTle(2.00563, 0.004, 55.5).line_2);
+  EXPECT_EQ(gps.regime, OrbitRegime::kMeo);
+
+  auto molniya = SummarizeOrbit(MakeTle(2.006, 0.74, 63.4).line_2);
+  EXPECT_EQ(molniya.regime, OrbitRegime::kHeo);
+}
+
+TEST(CatalogIndexTest, QueryMatchesLinearScan) {
+  std::mt19937 gen(42);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+  std::uniform_real_distribution<double> mean_motion(0.9, 16.0);
+  std::uniform_real_distribution<double> eccentricity(0.0, 0.3);
+  std::uniform_real_distribution<double> inclination(0.0, 180.0);
+
+  std::vector<Tle> catalog;
+  for (int i = 0; i < 5000; ++i) {
+    catalog.push_back(
+        MakeTle(mean_motion(gen), eccentricity(gen), inclination(gen)));
+  }
+  const CatalogIndex index(catalog);
+  ASSERT_EQ(index.size(), catalog.size());
+
+  const std::vector<CatalogQuery> queries{
+      {},
+      {.regime = OrbitRegime::kLeo},
+      {.inclination = ValueRange{96.0, 99.0}},
+      {.perigee_altitude = ValueRange{300.0, 800.0},
+       .inclination = ValueRange{50.0, 60.0}},
+      {.semi_major_axis = ValueRange{7000.0, 30000.0},
+       .apogee_altitude = ValueRange{0.0, 20000.0},
+       .regime = OrbitRegime::kMeo},
+      {.inclination = ValueRange{0.0, 170.0}, .regime = OrbitRegime::kHeo},
+      {.inclination = ValueRange{10.0, 5.0}},  // empty range
+  };
+
+  for (const auto &query : queries) {
+    auto result = index.Query(query);
+    ASSERT_EQ(result.size(), catalog.size());
+    std::size_t expected_count = 0;
+    for (std::size_t row = 0; row < catalog.size(); ++row) {
+      const bool expected = Matches(query, index.summary(row));
+      expected_count += expected ? 1 : 0;
+      EXPECT_EQ(result.Test(row), expected) << "row=" << row;
+    }
+    EXPECT_EQ(result.Count(), expected_count);
+    EXPECT_EQ(result.Rows().size(), expected_count);
+  }
+}
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+#include "earthorbits/coverage.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+constexpr double deg_to_rad = std::numbers::pi / 180.0;
+
+/// @brief Walker constellation of 1000 satellites at 550 km and 53 degrees,
+/// 40 planes of 25
+const std::vector<Sgp4State> &Constellation() {
+  static const auto states = [] {
+    Tle tle = iss_2024;
+    tle.line_2.inclination = 53.0;
+    tle.line_2.eccentricity = 0.0001;
+    tle.line_2.mean_motion = 15.06;
+    tle.line_1.bstar_drag = 1e-5;
+    constexpr std::size_t planes = 40;
+    constexpr std::size_t per_plane = 25;
+    std::vector<Sgp4State> all;
+    for (std::size_t p = 0; p < planes; ++p) {
+      for (std::size_t s = 0; s < per_plane; ++s) {
+        tle.line_2.raan = 360.0 * static_cast<double>(p) / planes;
+        tle.line_2.mean_anomaly =
+            360.0 * (static_cast<double>(s) + static_cast<double>(p) / planes) /
+            per_plane;
+        Sgp4State state;
+        if (InitSgp4(tle, state) == Sgp4Errc::kOk) {
+          all.push_back(state);
+        }
+      }
+    }
+    return all;
+  }();
+  return states;
+}
+}  // namespace
+
+/// Revisit statistics of a 24 h day with 1 minute samples, the argument is
+/// the cell size in hundredths of a degree
+static void BM_CalcCoverageConstellationDay(benchmark::State &state) {
+  const auto &states = Constellation();
+  const CoverageGrid grid(static_cast<double>(state.range(0)) / 100.0);
+  const CoverageOptions options{
+      .start = std::chrono::time_point_cast<std::chrono::seconds>(
+          states.front().epoch),
+      .step = std::chrono::minutes(1),
+      .samples = 1441,
+      .min_elevation = 25.0 * deg_to_rad};
+  std::vector<CellCoverage> cells;
+  for (auto _ : state) {
+    cells = CalcCoverage(states, grid, options);
+    benchmark::DoNotOptimize(cells.data());
+  }
+  std::size_t covered = 0;
+  for (const auto &cell : cells) {
+    covered += cell.samples_in_view > 0 ? 1 : 0;
+  }
+  state.counters["cells"] = static_cast<double>(grid.size());
+  state.counters["covered"] =
+      static_cast<double>(covered) / static_cast<double>(grid.size());
+  // satellite samples
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(states.size()) *
+                          static_cast<std::int64_t>(options.samples));
+}
+BENCHMARK(BM_CalcCoverageConstellationDay)
+    ->ArgName("centidegrees")
+    ->Arg(100)
+    ->Arg(25)
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <vector>
+
+#include "earthorbits/coverage.h"
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/frames.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/topocentric.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+constexpr double deg_to_rad = std::numbers::pi / 180.0;
+}  // namespace
+
+TEST(CoverageTest, FootprintRadius) {
+  EXPECT_EQ(FootprintRadius(0.0, 0.0), 0.0);
+  EXPECT_EQ(FootprintRadius(-10.0, 0.0), 0.0);
+  // GEO sees 81.3 degrees of the Earth's surface down to the horizon
+  EXPECT_NEAR(FootprintRadius(35786.0, 0.0) / deg_to_rad, 81.3, 0.05);
+  EXPECT_LT(FootprintRadius(550.0, 10.0 * deg_to_rad),
+            FootprintRadius(550.0, 0.0));
+  EXPECT_EQ(FootprintRadius(550.0, 90.0 * deg_to_rad), 0.0);
+}
+
+TEST(CoverageTest, Grid) {
+  const CoverageGrid grid(1.0);
+  EXPECT_EQ(grid.rows(), 180U);
+  EXPECT_EQ(grid.cols(), 360U);
+  EXPECT_EQ(grid.size(), 180U * 360U);
+  EXPECT_NEAR(grid.latitude(0), -89.5 * deg_to_rad, 1e-12);
+  EXPECT_NEAR(grid.longitude(359), 179.5 * deg_to_rad, 1e-12);
+  EXPECT_EQ(grid.index(1, 2), 362U);
+  EXPECT_EQ(CoverageGrid(0.25).rows(), 720U);
+  EXPECT_THROW(CoverageGrid(0.7), MyException<double>);
+  EXPECT_THROW(CoverageGrid(0.0), MyException<double>);
+}
+
+/// One sample, cells are in view exactly where CalcLookAngles says the
+/// satellite is above the minimum elevation, up to the spherical Earth
+TEST(CoverageTest, SnapshotMatchesLookAngles) {
+  using namespace std::chrono;
+  const auto state = InitState(iss_2024);
+  const CoverageGrid grid(2.0);
+  const double min_elevation = 10.0 * deg_to_rad;
+  const auto tp = time_point_cast<seconds>(state.epoch) + minutes(17);
+  const std::vector<Sgp4State> states{state};
+  const auto cells = CalcCoverage(
+      states, grid,
+      {.start = tp, .samples = 1, .min_elevation = min_elevation});
+
+  TemeState teme;
+  ASSERT_EQ(PropagateSgp4(state, MinutesSinceEpoch(state, tp), teme),
+            Sgp4Errc::kOk);
+  const auto ecef = TemeToEcef(teme, tp);
+  std::size_t in_view = 0;
+  for (std::size_t row = 0; row < grid.rows(); ++row) {
+    for (std::size_t col = 0; col < grid.cols(); ++col) {
+      const auto look = CalcLookAngles(
+          {.latitude = grid.latitude(row),
+           .longitude = grid.longitude(col),
+           .altitude = 0.0},
+          ecef);
+      const auto &cell = cells[grid.index(row, col)];
+      in_view += cell.samples_in_view;
+      if (look.elevation > min_elevation + 2.0 * deg_to_rad) {
+        EXPECT_EQ(cell.samples_in_view, 1U) << row << ", " << col;
+      } else if (look.elevation < min_elevation - 2.0 * deg_to_rad) {
+        EXPECT_EQ(cell.samples_in_view, 0U) << row << ", " << col;
+      }
+    }
+  }
+  EXPECT_GT(in_view, 20U);
+}
+
+TEST(CoverageTest, RevisitStatistics) {
+  using namespace std::chrono;
+  const auto state = InitState(iss_2024);
+  const CoverageGrid grid(5.0);
+  const std::vector<Sgp4State> states{state};
+  CoverageOptions options{.start = time_point_cast<seconds>(state.epoch),
+                          .step = minutes(1),
+                          .samples = 1441,
+                          .min_elevation = 10.0 * deg_to_rad,
+                          .threads = 1};
+  const auto serial = CalcCoverage(states, grid, options);
+
+  for (std::size_t row = 0; row < grid.rows(); ++row) {
+    const double latitude = std::abs(grid.latitude(row)) / deg_to_rad;
+    for (std::size_t col = 0; col < grid.cols(); ++col) {
+      const auto &cell = serial[grid.index(row, col)];
+      // out of reach of a 51.6 degree orbit
+      if (latitude > 75.0) {
+        EXPECT_EQ(cell.samples_in_view, 0U);
+      }
+      EXPECT_LE(cell.passes, cell.samples_in_view);
+      EXPECT_LE(cell.mean_revisit_gap, cell.max_revisit_gap);
+      EXPECT_EQ(cell.passes < 2, cell.max_revisit_gap == minutes(0));
+    }
+  }
+  // the equator is seen every day, a pass lasts at most a few minutes
+  const auto &equator = serial[grid.index(18, 10)];
+  EXPECT_GE(equator.passes, 1U);
+  EXPECT_LE(equator.samples_in_view, 10U * equator.passes);
+
+  // splitting the samples across threads merges to the same statistics
+  for (std::size_t threads : {2U, 3U, 7U}) {
+    options.threads = threads;
+    const auto parallel = CalcCoverage(states, grid, options);
+    ASSERT_EQ(parallel.size(), serial.size());
+    for (std::size_t c = 0; c < serial.size(); ++c) {
+      EXPECT_EQ(parallel[c].samples_in_view, serial[c].samples_in_view);
+      EXPECT_EQ(parallel[c].passes, serial[c].passes);
+      EXPECT_EQ(parallel[c].max_revisit_gap, serial[c].max_revisit_gap);
+      EXPECT_EQ(parallel[c].mean_revisit_gap, serial[c].mean_revisit_gap);
+    }
+  }
+}
+
+/// Two satellites over the same cells count each sample once
+TEST(CoverageTest, OverlappingSatellites) {
+  using namespace std::chrono;
+  const auto state = InitState(iss_2024);
+  const CoverageGrid grid(5.0);
+  const CoverageOptions options{.start = time_point_cast<seconds>(state.epoch),
+                                .samples = 181,
+                                .threads = 1};
+  const std::vector<Sgp4State> one{state};
+  const std::vector<Sgp4State> two{state, state};
+  const auto a = CalcCoverage(one, grid, options);
+  const auto b = CalcCoverage(two, grid, options);
+  for (std::size_t c = 0; c < a.size(); ++c) {
+    EXPECT_EQ(a[c].samples_in_view, b[c].samples_in_view);
+    EXPECT_EQ(a[c].passes, b[c].passes);
+  }
+}
@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "date/date.h"
+#include "earthorbits/cpudispatch.h"
+#include "earthorbits/eobmath.h"
+#include "earthorbits/eop.h"
+#include "earthorbits/frames.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+namespace {
+constexpr std::size_t batch = 4096;
+
+std::vector<double> Spread(double lo, double hi) {
+  std::vector<double> values(batch);
+  for (std::size_t i = 0; i < batch; ++i) {
+    const double f =
+        std::fmod(static_cast<double>(i) * 0.6180339887498949, 1.0);
+    values[i] = lo + (hi - lo) * f;
+  }
+  return values;
+}
+
+const std::vector<Sgp4State> &States() {
+  static const auto states = [] {
+    std::vector<Sgp4State> all;
+    for (const auto &tle : CachedSynthTles(10000)) {
+      Sgp4State state;
+      if (InitSgp4(ParseTle(tle), state) == Sgp4Errc::kOk) {
+        all.push_back(state);
+      }
+    }
+    return all;
+  }();
+  return states;
+}
+
+const auto some_time =
+    date::sys_days{date::year{2024} / date::March / 1} + std::chrono::hours(6);
+
+/// @brief Switch to the Isa in range(0) for the benchmark, false and the
+/// benchmark skipped if the CPU doesn't support it
+bool UseIsa(benchmark::State &state) {
+  const auto isa = static_cast<Isa>(state.range(0));
+  state.SetLabel(std::string(to_string(isa)));
+  if (!SetIsa(isa)) {
+    state.SkipWithError("not supported by this CPU or build");
+    return false;
+  }
+  return true;
+}
+
+/// Restores the detected Isa after the benchmark
+struct IsaGuard {
+  ~IsaGuard() { SetIsa(DetectIsa()); }
+};
+
+void IsaArgs(benchmark::internal::Benchmark *b) {
+  for (const auto isa : {Isa::kBaseline, Isa::kAvx2, Isa::kAvx512}) {
+    b->Arg(static_cast<int>(isa));
+  }
+}
+}  // namespace
+
+/// The batch kernels once per variant, run on one machine the ratios are
+/// what dispatch buys over a baseline build
+
+static void BM_DispatchSinCos(benchmark::State &state) {
+  const IsaGuard guard;
+  if (!UseIsa(state)) {
+    return;
+  }
+  const auto angles = Spread(-100.0, 100.0);
+  std::vector<double> sines(batch);
+  std::vector<double> cosines(batch);
+  for (auto _ : state) {
+    sincos(angles, sines, cosines);
+    benchmark::DoNotOptimize(sines.data());
+    benchmark::DoNotOptimize(cosines.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK(BM_DispatchSinCos)->Apply(IsaArgs);
+
+static void BM_DispatchSolveKepler(benchmark::State &state) {
+  const IsaGuard guard;
+  if (!UseIsa(state)) {
+    return;
+  }
+  const auto mean_anomalies = Spread(-10.0, 10.0);
+  const auto eccentricities = Spread(0.0, 0.9);
+  std::vector<double> eccentric_anomalies(batch);
+  for (auto _ : state) {
+    solve_kepler(mean_anomalies, eccentricities, eccentric_anomalies);
+    benchmark::DoNotOptimize(eccentric_anomalies.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK(BM_DispatchSolveKepler)->Apply(IsaArgs);
+
+static void BM_DispatchPropagateSgp4(benchmark::State &state) {
+  const IsaGuard guard;
+  if (!UseIsa(state)) {
+    return;
+  }
+  const auto &states = States();
+  std::vector<TemeState> teme(states.size());
+  std::vector<Sgp4Errc> errors(states.size());
+  for (auto _ : state) {
+    PropagateSgp4(states, some_time, teme, errors);
+    benchmark::DoNotOptimize(teme.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(states.size()));
+}
+BENCHMARK(BM_DispatchPropagateSgp4)
+    ->Apply(IsaArgs)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_DispatchTemeToEcef(benchmark::State &state) {
+  const IsaGuard guard;
+  if (!UseIsa(state)) {
+    return;
+  }
+  const auto &states = States();
+  std::vector<TemeState> teme(states.size());
+  std::vector<Sgp4Errc> errors(states.size());
+  PropagateSgp4(states, some_time, teme, errors);
+  const EopTable eop;
+  std::vector<EcefState> ecef(teme.size());
+  for (auto _ : state) {
+    TemeToEcef(teme, some_time, eop, ecef);
+    benchmark::DoNotOptimize(ecef.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(teme.size()));
+}
+BENCHMARK(BM_DispatchTemeToEcef)->Apply(IsaArgs)->Unit(benchmark::kMicrosecond);
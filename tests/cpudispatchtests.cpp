@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "date/date.h"
+#include "earthorbits/cpudispatch.h"
+#include "earthorbits/eobmath.h"
+#include "earthorbits/eop.h"
+#include "earthorbits/frames.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/topocentric.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+namespace {
+constexpr Isa all_isas[] = {Isa::kBaseline, Isa::kAvx2, Isa::kAvx512};
+
+/// @brief Bitwise, so NaN and -0.0 count too
+template <typename T>
+bool SameBits(const std::vector<T> &a, const std::vector<T> &b) {
+  return a.size() == b.size() &&
+         std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+/// Every batch kernel on the same input, once per run
+struct KernelOutputs {
+  std::vector<double> wrapped;
+  std::vector<double> sines;
+  std::vector<double> cosines;
+  std::vector<double> eccentric_anomalies;
+  std::vector<TemeState> teme;
+  std::vector<TemeStateF> teme_f;
+  std::vector<Sgp4Errc> errors;
+  std::vector<EcefState> ecef;
+  std::vector<EcefStateF> ecef_f;
+  std::vector<LookAngles> looks;
+};
+
+KernelOutputs RunKernels() {
+  using namespace std::chrono;
+  constexpr std::size_t size = 1000;
+  std::vector<double> angles(size);
+  std::vector<double> eccentricities(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    angles[i] =
+        std::fmod(static_cast<double>(i) * 0.618034, 1.0) * 2000.0 - 1000.0;
+    eccentricities[i] = std::fmod(static_cast<double>(i) * 0.414214, 0.99);
+  }
+  std::vector<Sgp4State> states;
+  for (const auto &tle : CachedSynthTles(size)) {
+    Sgp4State state;
+    if (InitSgp4(ParseTle(tle), state) == Sgp4Errc::kOk) {
+      states.push_back(state);
+    }
+  }
+  std::vector<Sgp4StateF> states_f;
+  for (const auto &state : states) {
+    states_f.push_back(ToSinglePrecision(state));
+  }
+  const auto tp = date::sys_days{date::year{2024} / date::March / 1} + 6h;
+  const EopTable eop(60370, std::vector<EopValues>(2, {.ut1_utc = -0.01,
+                                                       .x_pole = 0.1,
+                                                       .y_pole = 0.3}));
+  const GroundStation station(
+      {.latitude = 0.68, .longitude = -1.83, .altitude = 2.2});
+
+  KernelOutputs out{.wrapped = std::vector<double>(size),
+                    .sines = std::vector<double>(size),
+                    .cosines = std::vector<double>(size),
+                    .eccentric_anomalies = std::vector<double>(size),
+                    .teme = std::vector<TemeState>(states.size()),
+                    .teme_f = std::vector<TemeStateF>(states.size()),
+                    .errors = std::vector<Sgp4Errc>(states.size()),
+                    .ecef = std::vector<EcefState>(states.size()),
+                    .ecef_f = std::vector<EcefStateF>(states.size()),
+                    .looks = std::vector<LookAngles>(states.size())};
+  wrap_to_2pi(angles, out.wrapped);
+  sincos(angles, out.sines, out.cosines);
+  solve_kepler(angles, eccentricities, out.eccentric_anomalies);
+  PropagateSgp4(states, tp, out.teme, out.errors);
+  PropagateSgp4(states_f, tp, out.teme_f, out.errors);
+  TemeToEcef(out.teme, tp, eop, out.ecef);
+  TemeToEcef(out.teme_f, tp, eop, out.ecef_f);
+  station.Look(out.ecef, out.looks);
+  return out;
+}
+
+class CpuDispatchTest : public testing::Test {
+ protected:
+  void TearDown() override { SetIsa(DetectIsa()); }
+};
+}  // namespace
+
+TEST_F(CpuDispatchTest, Detect) {
+  EXPECT_TRUE(IsaSupported(Isa::kBaseline));
+  EXPECT_TRUE(IsaSupported(DetectIsa()));
+  EXPECT_EQ(ActiveIsa(), DetectIsa());
+  if (!isa_dispatch_enabled()) {
+    EXPECT_EQ(DetectIsa(), Isa::kBaseline);
+  }
+  // the levels build on each other
+  if (IsaSupported(Isa::kAvx512)) {
+    EXPECT_TRUE(IsaSupported(Isa::kAvx2));
+  }
+  for (const auto isa : all_isas) {
+    EXPECT_EQ(SetIsa(isa), IsaSupported(isa)) << to_string(isa);
+    if (IsaSupported(isa)) {
+      EXPECT_EQ(ActiveIsa(), isa);
+    } else {
+      EXPECT_NE(ActiveIsa(), isa);
+    }
+  }
+  EXPECT_EQ(to_string(Isa::kAvx2), "avx2");
+}
+
+TEST_F(CpuDispatchTest, VariantsAgree) {
+  ASSERT_TRUE(SetIsa(Isa::kBaseline));
+  const auto baseline = RunKernels();
+  ASSERT_GT(baseline.teme.size(), 500);
+  for (const auto isa : all_isas) {
+    if (!SetIsa(isa)) {
+      continue;
+    }
+    const auto out = RunKernels();
+    EXPECT_TRUE(SameBits(out.wrapped, baseline.wrapped)) << to_string(isa);
+    EXPECT_TRUE(SameBits(out.sines, baseline.sines)) << to_string(isa);
+    EXPECT_TRUE(SameBits(out.cosines, baseline.cosines)) << to_string(isa);
+    EXPECT_TRUE(SameBits(out.eccentric_anomalies, baseline.eccentric_anomalies))
+        << to_string(isa);
+    EXPECT_TRUE(SameBits(out.teme, baseline.teme)) << to_string(isa);
+    EXPECT_TRUE(SameBits(out.teme_f, baseline.teme_f)) << to_string(isa);
+    EXPECT_TRUE(SameBits(out.errors, baseline.errors)) << to_string(isa);
+    EXPECT_TRUE(SameBits(out.ecef, baseline.ecef)) << to_string(isa);
+    EXPECT_TRUE(SameBits(out.ecef_f, baseline.ecef_f)) << to_string(isa);
+    EXPECT_TRUE(SameBits(out.looks, baseline.looks)) << to_string(isa);
+  }
+}
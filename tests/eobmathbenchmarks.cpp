@@ -0,0 +1,160 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "earthorbits/eobmath.h"
+
+using namespace eob;
+
+namespace {
+constexpr std::size_t batch = 4096;
+
+/// @brief Deterministic values spread over [lo, hi)
+std::vector<double> Spread(double lo, double hi) {
+  std::vector<double> values(batch);
+  for (std::size_t i = 0; i < batch; ++i) {
+    // golden ratio sequence, no two neighbours are close
+    const double f =
+        std::fmod(static_cast<double>(i) * 0.6180339887498949, 1.0);
+    values[i] = lo + (hi - lo) * f;
+  }
+  return values;
+}
+}  // namespace
+
+/// Each kernel once per element with the scalar version and once over the
+/// batch with the span version
+
+static void BM_WrapTo2PiScalar(benchmark::State &state) {
+  const auto angles = Spread(-100.0, 100.0);
+  std::vector<double> wrapped(batch);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < batch; ++i) {
+      wrapped[i] = wrap_to_2pi(angles[i]);
+    }
+    benchmark::DoNotOptimize(wrapped.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK(BM_WrapTo2PiScalar);
+
+static void BM_WrapTo2Pi(benchmark::State &state) {
+  const auto angles = Spread(-100.0, 100.0);
+  std::vector<double> wrapped(batch);
+  for (auto _ : state) {
+    wrap_to_2pi(angles, wrapped);
+    benchmark::DoNotOptimize(wrapped.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK(BM_WrapTo2Pi);
+
+static void BM_WrapTo86400Scalar(benchmark::State &state) {
+  const auto seconds = Spread(0.0, 1.0e6);
+  std::vector<double> wrapped(batch);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < batch; ++i) {
+      wrapped[i] = wrap_to_86400(seconds[i]);
+    }
+    benchmark::DoNotOptimize(wrapped.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK(BM_WrapTo86400Scalar);
+
+static void BM_WrapTo86400(benchmark::State &state) {
+  const auto seconds = Spread(0.0, 1.0e6);
+  std::vector<double> wrapped(batch);
+  for (auto _ : state) {
+    wrap_to_86400(seconds, wrapped);
+    benchmark::DoNotOptimize(wrapped.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK(BM_WrapTo86400);
+
+static void BM_SinCosScalar(benchmark::State &state) {
+  const auto angles = Spread(-10.0, 10.0);
+  std::vector<double> sines(batch);
+  std::vector<double> cosines(batch);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < batch; ++i) {
+      sines[i] = std::sin(angles[i]);
+      cosines[i] = std::cos(angles[i]);
+    }
+    benchmark::DoNotOptimize(sines.data());
+    benchmark::DoNotOptimize(cosines.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK(BM_SinCosScalar);
+
+static void BM_SinCos(benchmark::State &state) {
+  const auto angles = Spread(-10.0, 10.0);
+  std::vector<double> sines(batch);
+  std::vector<double> cosines(batch);
+  for (auto _ : state) {
+    sincos(angles, sines, cosines);
+    benchmark::DoNotOptimize(sines.data());
+    benchmark::DoNotOptimize(cosines.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK(BM_SinCos);
+
+static void BM_Atan2Scalar(benchmark::State &state) {
+  const auto y = Spread(-1.0, 1.0);
+  const auto x = Spread(-2.0, 1.5);
+  std::vector<double> angles(batch);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < batch; ++i) {
+      angles[i] = std::atan2(y[i], x[batch - 1 - i]);
+    }
+    benchmark::DoNotOptimize(angles.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK(BM_Atan2Scalar);
+
+static void BM_Atan2(benchmark::State &state) {
+  const auto y = Spread(-1.0, 1.0);
+  auto x = Spread(-2.0, 1.5);
+  std::reverse(x.begin(), x.end());
+  std::vector<double> angles(batch);
+  for (auto _ : state) {
+    atan2(y, x, angles);
+    benchmark::DoNotOptimize(angles.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK(BM_Atan2);
+
+static void BM_SolveKeplerScalar(benchmark::State &state) {
+  const auto mean_anomalies = Spread(-10.0, 10.0);
+  const auto eccentricities = Spread(0.0, 0.75);
+  std::vector<double> e_anomalies(batch);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < batch; ++i) {
+      e_anomalies[i] = solve_kepler(mean_anomalies[i], eccentricities[i]);
+    }
+    benchmark::DoNotOptimize(e_anomalies.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK(BM_SolveKeplerScalar);
+
+static void BM_SolveKepler(benchmark::State &state) {
+  const auto mean_anomalies = Spread(-10.0, 10.0);
+  const auto eccentricities = Spread(0.0, 0.75);
+  std::vector<double> e_anomalies(batch);
+  for (auto _ : state) {
+    solve_kepler(mean_anomalies, eccentricities, e_anomalies);
+    benchmark::DoNotOptimize(e_anomalies.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK(BM_SolveKepler);
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "earthorbits/eobmath.h"
+
+using namespace eob;
+
+namespace {
+constexpr double pi2 = 2.0 * std::numbers::pi;
+
+/// @brief Rounding error of wrapping value, a few ulp of it
+double WrapTolerance(double value) {
+  return 4.0 * std::numeric_limits<double>::epsilon() *
+         std::max(std::abs(value), 1.0);
+}
+
+std::vector<double> Uniform(double lo, double hi, std::size_t n) {
+  std::mt19937 gen(7);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+  std::uniform_real_distribution<double> dist(lo, hi);
+  std::vector<double> values(n);
+  for (auto &v : values) {
+    v = dist(gen);
+  }
+  return values;
+}
+}  // namespace
+
+TEST(EobMathTest, WrapTo2Pi) {
+  auto angles = Uniform(-1.0e4, 1.0e4, 10000);
+  angles.insert(angles.end(), {0.0, -0.0, pi2, -pi2, 3.0 * pi2, 1.0e-300,
+                               -std::numbers::pi, 1.0e12});
+  std::vector<double> wrapped(angles.size());
+  wrap_to_2pi(angles, wrapped);
+  for (std::size_t i = 0; i < angles.size(); ++i) {
+    EXPECT_NEAR(wrapped[i], wrap_to_2pi(angles[i]), WrapTolerance(angles[i]))
+        << angles[i];
+    EXPECT_GE(wrapped[i], 0.0) << angles[i];
+    EXPECT_LE(wrapped[i], pi2) << angles[i];
+  }
+
+  // in place
+  auto in_place = angles;
+  wrap_to_2pi(in_place, in_place);
+  EXPECT_EQ(in_place, wrapped);
+}
+
+TEST(EobMathTest, WrapTo86400) {
+  auto seconds = Uniform(-1.0e8, 1.0e8, 10000);
+  seconds.insert(seconds.end(), {0.0, 86400.0, -86400.0, 86399.999, -0.001});
+  std::vector<double> wrapped(seconds.size());
+  wrap_to_86400(seconds, wrapped);
+  for (std::size_t i = 0; i < seconds.size(); ++i) {
+    EXPECT_NEAR(wrapped[i], wrap_to_86400(seconds[i]),
+                WrapTolerance(seconds[i]))
+        << seconds[i];
+    EXPECT_GE(wrapped[i], 0.0) << seconds[i];
+    EXPECT_LT(wrapped[i], 86400.0) << seconds[i];
+  }
+  EXPECT_NEAR(wrapped[seconds.size() - 1], 86399.999, 1.0e-9);
+}
+
+TEST(EobMathTest, WrapTo360) {
+  EXPECT_EQ(wrap_to_360(0.0), 0.0);
+  EXPECT_EQ(wrap_to_360(360.0), 0.0);
+  EXPECT_EQ(wrap_to_360(-90.0), 270.0);
+  EXPECT_EQ(wrap_to_360(725.5), 5.5);
+  EXPECT_EQ(wrap_to_360(63.53), 63.53);
+}
+
+TEST(EobMathTest, SinCos) {
+  for (const double range : {10.0, 1.0e6}) {
+    auto angles = Uniform(-range, range, 100000);
+    angles.insert(angles.end(),
+                  {0.0, -0.0, std::numbers::pi / 4.0, std::numbers::pi / 2.0,
+                   std::numbers::pi, -3.0 * std::numbers::pi / 2.0, 1.0e-300});
+    std::vector<double> sines(angles.size());
+    std::vector<double> cosines(angles.size());
+    sincos(angles, sines, cosines);
+    for (std::size_t i = 0; i < angles.size(); ++i) {
+      EXPECT_NEAR(sines[i], std::sin(angles[i]), 3.0e-16) << angles[i];
+      EXPECT_NEAR(cosines[i], std::cos(angles[i]), 3.0e-16) << angles[i];
+    }
+  }
+
+  // large angles and NaN take the fallback, the others are unaffected
+  const std::vector<double> angles{1.0, 1.0e7, -1.0e300,
+                                   std::numeric_limits<double>::quiet_NaN()};
+  std::vector<double> sines(angles.size());
+  std::vector<double> cosines(angles.size());
+  sincos(angles, sines, cosines);
+  for (std::size_t i = 0; i < 3; ++i) {
+    EXPECT_NEAR(sines[i], std::sin(angles[i]), 3.0e-16) << angles[i];
+    EXPECT_NEAR(cosines[i], std::cos(angles[i]), 3.0e-16) << angles[i];
+  }
+  EXPECT_TRUE(std::isnan(sines[3]));
+  EXPECT_TRUE(std::isnan(cosines[3]));
+}
+
+TEST(EobMathTest, Atan2) {
+  auto y = Uniform(-1.0, 1.0, 100000);
+  // the same generator, reversed so x and y don't correlate
+  auto x = Uniform(-1.0, 1.0, 100000);
+  std::reverse(x.begin(), x.end());
+  for (std::size_t i = 0; i < y.size(); i += 7) {
+    y[i] *= 1.0e-6;  // close to the axes
+    x[i + 3] *= 1.0e-6;
+  }
+  // signed zeros and the axes
+  y.insert(y.end(), {0.0, 0.0, -0.0, -0.0, 1.0, -1.0, 0.0, 2.0, 1.0e-300});
+  x.insert(x.end(), {0.0, -0.0, 0.0, -0.0, 0.0, 0.0, -3.0, 2.0, 1.0});
+  std::vector<double> angles(y.size());
+  atan2(y, x, angles);
+  for (std::size_t i = 0; i < y.size(); ++i) {
+    const double expected = std::atan2(y[i], x[i]);
+    EXPECT_NEAR(angles[i], expected, 4.5e-16) << y[i] << " " << x[i];
+    EXPECT_EQ(std::signbit(angles[i]), std::signbit(expected))
+        << y[i] << " " << x[i];
+  }
+}
+
+TEST(EobMathTest, SolveKepler) {
+  // circular, E = M
+  EXPECT_NEAR(solve_kepler(1.0, 0.0), 1.0, 1.0e-15);
+  EXPECT_NEAR(solve_kepler(-1.0, 0.0), pi2 - 1.0, 1.0e-15);
+  // Vallado example 2-1, M = 235.4 deg, e = 0.4, E = 220.512074767522 deg
+  EXPECT_NEAR(solve_kepler(235.4 * std::numbers::pi / 180.0, 0.4),
+              220.512074767522 * std::numbers::pi / 180.0, 1.0e-12);
+
+  const auto mean_anomalies = Uniform(-20.0, 20.0, 20000);
+  auto eccentricities = Uniform(0.0, 0.99, 20000);
+  eccentricities[0] = 0.99;
+  eccentricities[1] = 0.0;
+  std::vector<double> e_anomalies(mean_anomalies.size());
+  solve_kepler(mean_anomalies, eccentricities, e_anomalies);
+  for (std::size_t i = 0; i < mean_anomalies.size(); ++i) {
+    const double m = mean_anomalies[i];
+    const double e = eccentricities[i];
+    const double scalar = solve_kepler(m, e);
+    EXPECT_GE(scalar, 0.0);
+    EXPECT_LE(scalar, pi2);
+    EXPECT_NEAR(wrap_to_2pi(scalar - e * std::sin(scalar)), wrap_to_2pi(m),
+                1.0e-12)
+        << m << " " << e;
+    // the same angle, unless both are next to 0 and 2 pi
+    const double diff = std::abs(e_anomalies[i] - scalar);
+    EXPECT_LT(std::min(diff, pi2 - diff), 1.0e-12) << m << " " << e;
+  }
+}
@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "date/date.h"
+#include "earthorbits/eop.h"
+#include "earthorbits/frames.h"
+#include "earthorbits/sgp4.h"
+
+using namespace eob;
+
+namespace {
+/// @brief ~50 years of daily values, about the size of finals2000A.all
+EopTable MakeEopTable() {
+  std::vector<EopValues> days;
+  for (std::size_t i = 0; i < 50 * 366; ++i) {
+    const auto d = static_cast<double>(i);
+    days.push_back(
+        EopValues{.ut1_utc = -0.5 + 1e-3 * static_cast<double>(i % 500),
+                  .x_pole = 0.1 + 1e-5 * d,
+                  .y_pole = 0.3 - 1e-5 * d});
+  }
+  return EopTable(44000, days);
+}
+
+std::chrono::system_clock::time_point SomeTime() {
+  using namespace std::chrono;
+  return date::sys_days{date::year{2004} / date::April / 6} + 7h + 51min;
+}
+
+const TemeState some_teme{{5094.18016210, 6127.64465950, 6380.34453270},
+                          {-4.746131487, 0.785818041, 5.531931288}};
+}  // namespace
+
+static void BM_EopInterpolate(benchmark::State &state) {
+  const auto eop = MakeEopTable();
+  auto tp = SomeTime();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(eop.Interpolate(tp));
+    tp += std::chrono::minutes(7);
+  }
+  state.counters["bytes"] = static_cast<double>(eop.size() * 3 * sizeof(float));
+}
+BENCHMARK(BM_EopInterpolate);
+
+static void BM_CalcGMSTUtc(benchmark::State &state) {
+  const auto tp = SomeTime();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(calc_gmst(tp));
+  }
+}
+BENCHMARK(BM_CalcGMSTUtc);
+
+static void BM_CalcGMSTUt1(benchmark::State &state) {
+  const auto eop = MakeEopTable();
+  const auto tp = SomeTime();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(calc_gmst(tp, eop));
+  }
+}
+BENCHMARK(BM_CalcGMSTUt1);
+
+static void BM_TemeToEcef(benchmark::State &state) {
+  const auto tp = SomeTime();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(TemeToEcef(some_teme, tp));
+  }
+}
+BENCHMARK(BM_TemeToEcef);
+
+static void BM_TemeToEcefEop(benchmark::State &state) {
+  const auto eop = MakeEopTable();
+  const auto tp = SomeTime();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(TemeToEcef(some_teme, tp, eop));
+  }
+}
+BENCHMARK(BM_TemeToEcefEop);
+
+/// Whole catalog at one time, in double and in single precision
+template <typename T>
+static void BM_TemeToEcefBatch(benchmark::State &state) {
+  const auto eop = MakeEopTable();
+  const auto tp = SomeTime();
+  const auto size = static_cast<std::size_t>(state.range(0));
+  std::vector<BasicTemeState<T>> teme(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    for (std::size_t j = 0; j < 3; ++j) {
+      teme[i].position[j] = static_cast<T>(some_teme.position[j]);
+      teme[i].velocity[j] = static_cast<T>(some_teme.velocity[j]);
+    }
+  }
+  std::vector<BasicEcefState<T>> ecef(size);
+  for (auto _ : state) {
+    TemeToEcef(teme, tp, eop, ecef);
+    benchmark::DoNotOptimize(ecef.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(size));
+}
+BENCHMARK_TEMPLATE(BM_TemeToEcefBatch, double)->Arg(30000);
+BENCHMARK_TEMPLATE(BM_TemeToEcefBatch, float)->Arg(30000);
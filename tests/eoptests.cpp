@@ -0,0 +1,111 @@
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+#include "date/date.h"
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/eop.h"
+
+using namespace eob;
+
+namespace {
+/// @brief One finals2000A line with Bulletin A values
+std::string FinalsLine(int year, int month, int day, int mjd, double x,
+                       double y, double ut1_utc) {
+  return fmt::format(
+      "{:2d}{:2d}{:2d} {:8.2f} I {:9.6f}{:9.6f} {:9.6f}{:9.6f}  "
+      "I{:10.7f}{:10.7f}  0.0000 0.0000\n",
+      year % 100, month, day, static_cast<double>(mjd), x, 0.000091, y,
+      0.000075, ut1_utc, 0.0000101);
+}
+}  // namespace
+
+TEST(EopTest, ParseFinals2000A) {
+  // first line of finals2000A.all, the following day made up
+  const std::string text =
+      "92 1 1 48622.00 I  0.182987 0.000672  0.168775 0.000345  I-0.1251659 "
+      "0.0000207  1.8335 0.0201  I   -16.2420    0.3645    -2.7500    0.4200  "
+      " .182000   .167000  -.1253000   -16.6000    -2.5000  \n" +
+      FinalsLine(92, 1, 2, 48623, 0.182013, 0.168101, -0.1269659) +
+      // predictions without UT1-UTC at the end of the file are skipped
+      "92 1 3 48624.00                                                     \n";
+
+  const auto eop = ParseFinals2000A(text);
+  ASSERT_EQ(eop.size(), 2U);
+  EXPECT_EQ(eop.first_mjd(), 48622);
+  EXPECT_EQ(eop.last_mjd(), 48623);
+
+  using namespace date;
+  using namespace std::chrono;
+  const auto day = date::sys_days{1992_y / date::January / 1};
+  auto values = eop.Interpolate(day);
+  EXPECT_NEAR(values.ut1_utc, -0.1251659, 1e-7);
+  EXPECT_NEAR(values.x_pole, 0.182987, 1e-7);
+  EXPECT_NEAR(values.y_pole, 0.168775, 1e-7);
+
+  values = eop.Interpolate(day + 12h);
+  EXPECT_NEAR(values.ut1_utc, -0.1260659, 1e-7);
+  EXPECT_NEAR(values.x_pole, 0.182500, 1e-7);
+
+  // held constant outside the table
+  EXPECT_NEAR(eop.Interpolate(day - days(10)).ut1_utc, -0.1251659, 1e-7);
+  EXPECT_NEAR(eop.Interpolate(day + days(10)).ut1_utc, -0.1269659, 1e-7);
+
+  EXPECT_THROW(static_cast<void>(ParseFinals2000A(
+                   FinalsLine(92, 1, 1, 48622, 0.1, 0.1, -0.1) +
+                   FinalsLine(92, 1, 3, 48624, 0.1, 0.1, -0.1))),
+               MyException<std::string>);
+  std::string malformed = FinalsLine(92, 1, 1, 48622, 0.1, 0.1, -0.1);
+  malformed[20] = 'x';
+  EXPECT_THROW(static_cast<void>(ParseFinals2000A(malformed)),
+               MyException<std::string>);
+}
+
+TEST(EopTest, LeapSecond) {
+  using namespace date;
+  using namespace std::chrono;
+  // a leap second was inserted at the end of 2016-12-31, MJD 57753
+  const EopTable eop(57753, {{.ut1_utc = -0.4, .x_pole = 0.0, .y_pole = 0.0},
+                             {.ut1_utc = 0.598, .x_pole = 0.0, .y_pole = 0.0}});
+  const auto day = date::sys_days{2016_y / date::December / 31};
+  EXPECT_NEAR(eop.Interpolate(day + 12h).ut1_utc, -0.401, 1e-6);
+  EXPECT_NEAR(eop.Interpolate(day + 24h).ut1_utc, 0.598, 1e-6);
+}
+
+TEST(EopTest, ParseCelestrakEop) {
+  const std::string text =
+      "DATE,MJD,X,Y,UT1-UTC,LOD,DPSI,DEPS,DX,DY,DAT,DATA_TYPE\r\n"
+      "2024-04-06,60406,0.023410,0.384102,-0.0086370,0.0001233,-0.117154,"
+      "-0.007908,0.000231,-0.000100,37,O\r\n"
+      "2024-04-07,60407,0.025069,0.383740,-0.0087458,0.0000870,-0.117245,"
+      "-0.007896,0.000226,-0.000094,37,O\r\n";
+  const auto eop = ParseCelestrakEop(text);
+  ASSERT_EQ(eop.size(), 2U);
+  EXPECT_EQ(eop.first_mjd(), 60406);
+
+  using namespace date;
+  const auto values =
+      eop.Interpolate(date::sys_days{2024_y / date::April / 7});
+  EXPECT_NEAR(values.ut1_utc, -0.0087458, 1e-7);
+  EXPECT_NEAR(values.x_pole, 0.025069, 1e-7);
+  EXPECT_NEAR(values.y_pole, 0.383740, 1e-7);
+
+  EXPECT_THROW(static_cast<void>(ParseCelestrakEop("DATE,MJD,X\n")),
+               MyException<std::string>);
+  EXPECT_THROW(static_cast<void>(LoadEopTable("/nonexistent/eop.csv")),
+               MyException<std::string>);
+}
+
+TEST(EopTest, CalcGmstUt1) {
+  using namespace date;
+  using namespace std::chrono;
+  const auto tp = date::sys_days{2024_y / date::May / 12} + 20h + 33min;
+  EXPECT_EQ(calc_gmst(tp, EopTable{}).count(), calc_gmst(tp).count());
+
+  const EopTable eop(60400, std::vector<EopValues>(30, {.ut1_utc = -0.5}));
+  // sidereal time runs ~1.0027 times faster than solar time
+  EXPECT_NEAR(calc_gmst(tp, eop).count() - calc_gmst(tp).count(),
+              -0.5 * 1.0027379, 1e-6);
+}
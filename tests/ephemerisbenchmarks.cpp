@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "earthorbits/ephemeris.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+/// @brief Query times spread over a day, not in order
+std::vector<double> QueryTimes() {
+  std::vector<double> times(4096);
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    times[i] = static_cast<double>((i * 2654435761U) % 1440000) / 1000.0;
+  }
+  return times;
+}
+}  // namespace
+
+/// range(0) is the position tolerance in mm
+static void BM_EphemerisFitDay(benchmark::State &state) {
+  const auto sgp4 = InitState(iss_2024);
+  EphemerisOptions options;
+  options.position_tolerance = static_cast<double>(state.range(0)) * 1e-6;
+  ChebyshevEphemeris ephemeris;
+  for (auto _ : state) {
+    auto err = FitEphemeris(sgp4, 0.0, 1440.0, options, ephemeris);
+    benchmark::DoNotOptimize(err);
+  }
+  state.counters["bytes_per_satellite_day"] =
+      static_cast<double>(ephemeris.bytes());
+  state.counters["segments"] = static_cast<double>(ephemeris.segment_count());
+  state.counters["max_error_mm"] = ephemeris.max_position_error() * 1e6;
+}
+BENCHMARK(BM_EphemerisFitDay)->Arg(1)->Arg(1000)->Arg(1000000);
+
+static void BM_EphemerisEvaluate(benchmark::State &state) {
+  const auto sgp4 = InitState(iss_2024);
+  ChebyshevEphemeris ephemeris;
+  static_cast<void>(
+      FitEphemeris(sgp4, 0.0, 1440.0, EphemerisOptions{}, ephemeris));
+  const auto times = QueryTimes();
+  TemeState teme;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto ok = ephemeris.Evaluate(times[i++ % times.size()], teme);
+    benchmark::DoNotOptimize(ok);
+    benchmark::DoNotOptimize(teme);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EphemerisEvaluate);
+
+static void BM_EphemerisPropagateDirect(benchmark::State &state) {
+  const auto sgp4 = InitState(iss_2024);
+  const auto times = QueryTimes();
+  TemeState teme;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto err = PropagateSgp4(sgp4, times[i++ % times.size()], teme);
+    benchmark::DoNotOptimize(err);
+    benchmark::DoNotOptimize(teme);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EphemerisPropagateDirect);
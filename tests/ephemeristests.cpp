@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/ephemeris.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+double Distance(const std::array<double, 3> &a,
+                const std::array<double, 3> &b) {
+  return std::hypot(a[0] - b[0], a[1] - b[1], a[2] - b[2]);
+}
+}  // namespace
+
+TEST(EphemerisTest, MatchesPropagation) {
+  const auto state = InitState(iss_2008);
+  const EphemerisOptions options;
+  ChebyshevEphemeris ephemeris;
+  ASSERT_EQ(FitEphemeris(state, 0.0, 1440.0, options, ephemeris),
+            Sgp4Errc::kOk);
+  EXPECT_LE(ephemeris.max_position_error(), options.position_tolerance);
+  EXPECT_LE(ephemeris.max_velocity_error(), options.velocity_tolerance);
+  EXPECT_GE(ephemeris.last(), 1440.0);
+  EXPECT_EQ(ephemeris.epoch(), state.epoch);
+
+  // the fit is only checked at a few points per segment, allow some slack
+  // at the points in between
+  for (int i = 0; i <= 10000; ++i) {
+    const double minutes = 0.144 * i;
+    TemeState fitted;
+    TemeState direct;
+    ASSERT_TRUE(ephemeris.Evaluate(minutes, fitted)) << minutes;
+    ASSERT_EQ(PropagateSgp4(state, minutes, direct), Sgp4Errc::kOk);
+    EXPECT_LT(Distance(fitted.position, direct.position),
+              2.0 * options.position_tolerance)
+        << minutes;
+    EXPECT_LT(Distance(fitted.velocity, direct.velocity),
+              2.0 * options.velocity_tolerance)
+        << minutes;
+  }
+
+  TemeState teme;
+  EXPECT_FALSE(ephemeris.Evaluate(-1.0, teme));
+  EXPECT_FALSE(ephemeris.Evaluate(ephemeris.last() + 1.0, teme));
+}
+
+TEST(EphemerisTest, ToleranceControlsSegments) {
+  const auto state = InitState(iss_2008);
+  EphemerisOptions coarse;
+  coarse.position_tolerance = 1.0;
+  coarse.velocity_tolerance = 1e-3;
+  EphemerisOptions fine;
+  fine.position_tolerance = 1e-5;
+  fine.velocity_tolerance = 1e-8;
+
+  ChebyshevEphemeris a;
+  ChebyshevEphemeris b;
+  ASSERT_EQ(FitEphemeris(state, 0.0, 720.0, coarse, a), Sgp4Errc::kOk);
+  ASSERT_EQ(FitEphemeris(state, 0.0, 720.0, fine, b), Sgp4Errc::kOk);
+  EXPECT_LT(a.segment_count(), b.segment_count());
+  EXPECT_LT(a.bytes(), b.bytes());
+  EXPECT_LE(b.max_position_error(), fine.position_tolerance);
+}
+
+TEST(EphemerisTest, BinaryRoundTrip) {
+  const auto state = InitState(iss_2008);
+  ChebyshevEphemeris ephemeris;
+  ASSERT_EQ(FitEphemeris(state, -60.0, 300.0, EphemerisOptions{}, ephemeris),
+            Sgp4Errc::kOk);
+
+  std::stringstream ss;
+  WriteEphemeris(ss, ephemeris);
+  const auto bytes = ss.str();
+  const auto read = ReadEphemeris(ss);
+  EXPECT_EQ(read.epoch(), ephemeris.epoch());
+  EXPECT_EQ(read.first(), ephemeris.first());
+  EXPECT_EQ(read.segment_count(), ephemeris.segment_count());
+  EXPECT_EQ(read.degree(), ephemeris.degree());
+  EXPECT_EQ(read.max_position_error(), ephemeris.max_position_error());
+
+  for (double minutes : {-60.0, 0.0, 123.4, 300.0}) {
+    TemeState a;
+    TemeState b;
+    ASSERT_TRUE(ephemeris.Evaluate(minutes, a));
+    ASSERT_TRUE(read.Evaluate(minutes, b));
+    EXPECT_EQ(a.position, b.position);
+    EXPECT_EQ(a.velocity, b.velocity);
+  }
+
+  std::stringstream truncated(bytes.substr(0, bytes.size() - 3));
+  EXPECT_THROW(static_cast<void>(ReadEphemeris(truncated)),
+               MyException<std::string>);
+  std::stringstream garbage("not an ephemeris at all");
+  EXPECT_THROW(static_cast<void>(ReadEphemeris(garbage)),
+               MyException<std::string>);
+
+  // a segment count far beyond the coefficients that follow
+  auto corrupt = bytes;
+  const auto coefficients = ephemeris.segment_count() *
+                            static_cast<std::size_t>(ephemeris.degree() + 1) *
+                            6;
+  const auto count_offset = bytes.size() - 8 * coefficients - 3 * 8;
+  corrupt[count_offset + 3] = 1;  // 2^24 more segments
+  std::stringstream huge(corrupt);
+  EXPECT_THROW(static_cast<void>(ReadEphemeris(huge)),
+               MyException<std::string>);
+}
+
+TEST(EphemerisTest, RejectsNonPositiveSegments) {
+  const auto state = InitState(iss_2008);
+  ChebyshevEphemeris ephemeris;
+  for (const double minutes : {0.0, -1.0, std::nan("")}) {
+    EphemerisOptions options;
+    options.segment_minutes = minutes;
+    EXPECT_THROW(
+        static_cast<void>(FitEphemeris(state, 0.0, 60.0, options, ephemeris)),
+        MyException<double>);
+    options = {};
+    options.min_segment_minutes = minutes;
+    EXPECT_THROW(
+        static_cast<void>(FitEphemeris(state, 0.0, 60.0, options, ephemeris)),
+        MyException<double>);
+  }
+}
+
+TEST(EphemerisTest, RejectsUnboundedWindows) {
+  const auto state = InitState(iss_2008);
+  ChebyshevEphemeris ephemeris;
+  const EphemerisOptions options;
+  const double inf = std::numeric_limits<double>::infinity();
+  for (const auto &[first, last] :
+       {std::pair{std::nan(""), 60.0}, std::pair{0.0, std::nan("")},
+        std::pair{-inf, 60.0}, std::pair{0.0, inf},
+        std::pair{0.0, 1e300}}) {
+    EXPECT_THROW(
+        static_cast<void>(FitEphemeris(state, first, last, options, ephemeris)),
+        MyException<double>);
+  }
+}
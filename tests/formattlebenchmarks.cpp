@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+#include <fmt/core.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "earthorbits/formattle.h"
+#include "earthorbits/parsetle.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+namespace {
+const std::vector<Tle> &Catalog() {
+  static const auto tles = [] {
+    std::vector<Tle> parsed;
+    for (const auto &text : CachedSynthTles(10000)) {
+      parsed.push_back(ParseTle(text));
+    }
+    return parsed;
+  }();
+  return tles;
+}
+
+void SetCatalogCounters(benchmark::State &state, std::size_t records) {
+  const auto items = state.iterations() * static_cast<int64_t>(records);
+  state.SetItemsProcessed(items);
+  state.SetBytesProcessed(items * static_cast<int64_t>(formatted_tle_size + 1));
+}
+
+/// @brief e.g. 0.21418e-3 -> " 21418-3", no rounding carry handling
+std::string ExponentField(double value) {
+  if (value == 0.0) {
+    return " 00000-0";
+  }
+  const int exponent =
+      static_cast<int>(std::floor(std::log10(std::abs(value)))) + 1;
+  const long mantissa =
+      std::lround(std::abs(value) / std::pow(10.0, exponent) * 1e5);
+  return fmt::format("{}{:05d}{}{}", value < 0.0 ? '-' : ' ', mantissa,
+                     exponent < 0 ? '-' : '+', std::abs(exponent));
+}
+
+int Checksum(const std::string &line) {
+  int sum = 0;
+  for (const char c : line) {
+    sum += c == '-' ? 1 : ('0' <= c && c <= '9' ? c - '0' : 0);
+  }
+  return sum % 10;
+}
+
+/// @brief The fmt::format version an application would write without
+/// FormatTle
+std::string FormatWithFmt(const Tle &tle) {
+  const auto &l1 = tle.line_1;
+  const auto &l2 = tle.line_2;
+  auto line_1 = fmt::format(
+      "1 {:05d}{} {:02d}{:03d}{:<3} {:02d}{:012.8f} {}.{:08d} {} {} {} {:4d}",
+      l1.satellite_number, l1.classification, l1.launch_year,
+      l1.launch_number, l1.launch_piece, l1.epoch_year, l1.epoch_day,
+      l1.mean_motion_dot < 0.0 ? '-' : ' ',
+      std::lround(std::abs(l1.mean_motion_dot) * 1e8),
+      ExponentField(l1.mean_motion_ddot), ExponentField(l1.bstar_drag),
+      l1.ephemeris_type, l1.element_number);
+  auto line_2 = fmt::format(
+      "2 {:05d} {:8.4f} {:8.4f} {:07d} {:8.4f} {:8.4f} {:11.8f}{:5d}",
+      l2.satellite_number, l2.inclination, l2.raan,
+      std::lround(l2.eccentricity * 1e7), l2.argument_of_perigree,
+      l2.mean_anomaly, l2.mean_motion, l2.rev_at_epoch);
+  return fmt::format("{}{}\n{}{}\n", line_1, Checksum(line_1), line_2,
+                     Checksum(line_2));
+}
+}  // namespace
+
+static void BM_FormatTleFmt(benchmark::State &state) {
+  const auto &tles = Catalog();
+  for (auto _ : state) {
+    for (const auto &tle : tles) {
+      auto text = FormatWithFmt(tle);
+      benchmark::DoNotOptimize(text.data());
+    }
+  }
+  SetCatalogCounters(state, tles.size());
+}
+BENCHMARK(BM_FormatTleFmt)->Unit(benchmark::kMillisecond);
+
+static void BM_FormatTle(benchmark::State &state) {
+  const auto &tles = Catalog();
+  std::array<char, formatted_tle_size> out{};
+  for (auto _ : state) {
+    for (const auto &tle : tles) {
+      auto err = FormatTle(tle, out);
+      benchmark::DoNotOptimize(err);
+      benchmark::DoNotOptimize(out.data());
+    }
+  }
+  SetCatalogCounters(state, tles.size());
+}
+BENCHMARK(BM_FormatTle)->Unit(benchmark::kMillisecond);
+
+/// Whole catalog into one buffer, ready to be written out in one call
+static void BM_FormatTles(benchmark::State &state) {
+  const auto &tles = Catalog();
+  std::string out(tles.size() * (formatted_tle_size + 1), '\0');
+  for (auto _ : state) {
+    TleError err;
+    auto written = FormatTles(tles, out, err);
+    benchmark::DoNotOptimize(written);
+    benchmark::DoNotOptimize(out.data());
+  }
+  SetCatalogCounters(state, tles.size());
+}
+BENCHMARK(BM_FormatTles)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "earthorbits/formattle.h"
+#include "earthorbits/parsetle.h"
+#include "synthcatalog.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+std::string Format(const Tle &tle) {
+  std::array<char, formatted_tle_size> out{};
+  const auto err = FormatTle(tle, out);
+  EXPECT_TRUE(err.ok()) << to_string(err);
+  return {out.data(), out.size()};
+}
+
+/// @brief Every field, doubles compared exactly
+void ExpectSameTle(const Tle &a, const Tle &b) {
+  EXPECT_EQ(a.line_1.satellite_number, b.line_1.satellite_number);
+  EXPECT_EQ(a.line_1.classification, b.line_1.classification);
+  EXPECT_EQ(a.line_1.launch_year, b.line_1.launch_year);
+  EXPECT_EQ(a.line_1.launch_number, b.line_1.launch_number);
+  EXPECT_EQ(a.line_1.launch_piece, b.line_1.launch_piece);
+  EXPECT_EQ(a.line_1.epoch_year, b.line_1.epoch_year);
+  EXPECT_EQ(a.line_1.epoch_day, b.line_1.epoch_day);
+  EXPECT_EQ(a.line_1.mean_motion_dot, b.line_1.mean_motion_dot);
+  EXPECT_EQ(a.line_1.mean_motion_ddot, b.line_1.mean_motion_ddot);
+  EXPECT_EQ(a.line_1.bstar_drag, b.line_1.bstar_drag);
+  EXPECT_EQ(a.line_1.ephemeris_type, b.line_1.ephemeris_type);
+  EXPECT_EQ(a.line_1.element_number, b.line_1.element_number);
+  EXPECT_EQ(a.line_2.satellite_number, b.line_2.satellite_number);
+  EXPECT_EQ(a.line_2.inclination, b.line_2.inclination);
+  EXPECT_EQ(a.line_2.raan, b.line_2.raan);
+  EXPECT_EQ(a.line_2.eccentricity, b.line_2.eccentricity);
+  EXPECT_EQ(a.line_2.argument_of_perigree, b.line_2.argument_of_perigree);
+  EXPECT_EQ(a.line_2.mean_anomaly, b.line_2.mean_anomaly);
+  EXPECT_EQ(a.line_2.mean_motion, b.line_2.mean_motion);
+  EXPECT_EQ(a.line_2.rev_at_epoch, b.line_2.rev_at_epoch);
+}
+}  // namespace
+
+TEST(FormatTleTest, RoundTrip) {
+  EXPECT_EQ(Format(iss_2008), iss_2008_text);
+
+  // canonical text comes back byte for byte, all regimes and signs
+  for (const auto &text : MakeSynthTles({.size = 2000})) {
+    const auto tle = ParseTle(text);
+    const auto formatted = Format(tle);
+    ASSERT_EQ(formatted, text);
+    ExpectSameTle(ParseTle(formatted), tle);
+  }
+}
+
+TEST(FormatTleTest, Canonical) {
+  auto tle = iss_2008;
+  // stale checksums and line numbers are replaced
+  tle.line_1.checksum = 0;
+  tle.line_2.line_number = 7;
+  // values with more digits than the field are rounded, values below
+  // the smallest exponent lose digits
+  tle.line_2.inclination = 51.64163;
+  tle.line_2.eccentricity = 0.00067026;
+  tle.line_1.bstar_drag = 0.000999996;
+  tle.line_1.mean_motion_ddot = 1.0e-12;
+  tle.line_1.launch_piece = "BC";
+  tle.line_2.rev_at_epoch = 7;
+  const auto text = Format(tle);
+  EXPECT_EQ(
+      text,
+      R"(1 25544U 98067BC  08264.51782528 -.00002182  00100-9  10000-2 0  2921
+2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391    72)");
+  EXPECT_TRUE(ValidateTle(text).ok());
+
+  // exponent zero and negative zeros
+  tle.line_1.bstar_drag = 0.5;
+  tle.line_1.mean_motion_ddot = -0.0;
+  tle.line_1.mean_motion_dot = -0.0;
+  const auto zeros = Format(tle);
+  EXPECT_EQ(zeros.substr(33, 10), "-.00000000");
+  EXPECT_EQ(zeros.substr(44, 8), "-00000-0");
+  EXPECT_EQ(zeros.substr(53, 8), " 50000+0");
+  const auto parsed = ParseTle(zeros);
+  EXPECT_EQ(parsed.line_1.bstar_drag, 0.5);
+  EXPECT_TRUE(std::signbit(parsed.line_1.mean_motion_ddot));
+  EXPECT_TRUE(std::signbit(parsed.line_1.mean_motion_dot));
+}
+
+TEST(FormatTleTest, Errors) {
+  const auto &good = iss_2008;
+  std::array<char, formatted_tle_size> out{};
+  out.fill('x');
+
+  std::array<char, formatted_tle_size - 1> small{};
+  EXPECT_EQ(FormatTle(good, small).code, TleErrc::kInvalidSize);
+
+  struct Case {
+    void (*modify)(Tle &);
+    TleErrc code;
+    TleField field;
+  };
+  const std::vector<Case> cases{
+      {[](Tle &t) {
+         t.line_1.satellite_number = 100000;
+         t.line_2.satellite_number = 100000;
+       },
+       TleErrc::kOutOfDomain, TleField::kLine1SatelliteNumber},
+      {[](Tle &t) { t.line_2.satellite_number = 1; },
+       TleErrc::kSatelliteNumberMismatch, TleField::kLine2SatelliteNumber},
+      {[](Tle &t) { t.line_1.classification = 'S'; },
+       TleErrc::kInvalidClassification, TleField::kClassification},
+      {[](Tle &t) { t.line_1.launch_piece = "ABCD"; }, TleErrc::kOutOfDomain,
+       TleField::kLaunchPiece},
+      {[](Tle &t) { t.line_1.epoch_day = -1.0; }, TleErrc::kOutOfDomain,
+       TleField::kEpochDay},
+      {[](Tle &t) { t.line_1.mean_motion_dot = 1.0; }, TleErrc::kOutOfDomain,
+       TleField::kMeanMotionDot},
+      {[](Tle &t) { t.line_1.bstar_drag = 1.0e10; }, TleErrc::kOutOfDomain,
+       TleField::kBstarDrag},
+      {[](Tle &t) {
+         t.line_1.mean_motion_ddot = std::numeric_limits<double>::quiet_NaN();
+       },
+       TleErrc::kOutOfDomain, TleField::kMeanMotionDdot},
+      {[](Tle &t) { t.line_1.element_number = -1; }, TleErrc::kOutOfDomain,
+       TleField::kElementNumber},
+      {[](Tle &t) { t.line_2.inclination = 181.0; }, TleErrc::kOutOfDomain,
+       TleField::kInclination},
+      {[](Tle &t) { t.line_2.eccentricity = 0.99999999; },
+       TleErrc::kOutOfDomain, TleField::kEccentricity},
+      {[](Tle &t) { t.line_2.mean_motion = 100.0; }, TleErrc::kOutOfDomain,
+       TleField::kMeanMotion},
+      {[](Tle &t) { t.line_2.rev_at_epoch = 100000; }, TleErrc::kOutOfDomain,
+       TleField::kRevAtEpoch},
+  };
+  for (const auto &c : cases) {
+    auto tle = good;
+    c.modify(tle);
+    const auto err = FormatTle(tle, out);
+    EXPECT_EQ(err.code, c.code) << to_string(err);
+    EXPECT_EQ(err.field, c.field) << to_string(err);
+    // out is only written on success
+    EXPECT_EQ(out[0], 'x');
+  }
+}
+
+TEST(FormatTleTest, Batch) {
+  const auto &texts = CachedSynthTles(100);
+  std::vector<Tle> tles;
+  std::string expected;
+  for (const auto &text : texts) {
+    tles.push_back(ParseTle(text));
+    expected += text + '\n';
+  }
+
+  std::string out(tles.size() * (formatted_tle_size + 1), '\0');
+  TleError err;
+  EXPECT_EQ(FormatTles(tles, out, err), tles.size());
+  EXPECT_TRUE(err.ok());
+  EXPECT_EQ(out, expected);
+
+  // a bad record stops the batch, what came before it is written
+  tles[60].line_2.mean_motion = -1.0;
+  EXPECT_EQ(FormatTles(tles, out, err), 60);
+  EXPECT_EQ(err.field, TleField::kMeanMotion);
+
+  // as does running out of room
+  const auto room = 10 * (formatted_tle_size + 1) + 5;
+  EXPECT_EQ(FormatTles(tles, std::span(out).first(room), err), 10);
+  EXPECT_EQ(err.code, TleErrc::kInvalidSize);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "date/date.h"
+#include "earthorbits/eop.h"
+#include "earthorbits/frames.h"
+#include "earthorbits/sgp4.h"
+
+using namespace eob;
+
+/// Vallado, example 3-15 and the teme2ecef test of the SGP4 reference code
+TEST(FramesTest, TemeToEcef) {
+  using namespace date;
+  using namespace std::chrono;
+  const auto tp = date::sys_days{2004_y / date::April / 6} + 7h + 51min +
+                  28s + 386009us;
+  const TemeState teme{{5094.18016210, 6127.64465950, 6380.34453270},
+                       {-4.746131487, 0.785818041, 5.531931288}};
+  const EopTable eop(53100, std::vector<EopValues>(2, {
+                                                          .ut1_utc = -0.4399619,
+                                                          .x_pole = -0.140682,
+                                                          .y_pole = 0.333309,
+                                                      }));
+
+  // calc_gmst's rotation rate is rounded to 9 digits, ~1 m at the surface
+  const auto ecef = TemeToEcef(teme, tp, eop);
+  EXPECT_NEAR(ecef.position[0], -1033.4793830, 5e-3);
+  EXPECT_NEAR(ecef.position[1], 7901.2952754, 5e-3);
+  EXPECT_NEAR(ecef.position[2], 6380.3565958, 5e-3);
+  EXPECT_NEAR(ecef.velocity[0], -3.225636520, 1e-5);
+  EXPECT_NEAR(ecef.velocity[1], -2.872451450, 1e-5);
+  EXPECT_NEAR(ecef.velocity[2], 5.531924446, 1e-5);
+
+  // without EOP, UT1-UTC of -0.44 s is ~3 km along track at this radius
+  const auto uncorrected = TemeToEcef(teme, tp);
+  const double dx = uncorrected.position[0] - ecef.position[0];
+  const double dy = uncorrected.position[1] - ecef.position[1];
+  EXPECT_NEAR(std::hypot(dx, dy), 0.4399619 * 7.292115e-5 * 7968.6, 0.02);
+  EXPECT_EQ(TemeToEcef(teme, tp, EopTable{}).position, uncorrected.position);
+}
+
+TEST(FramesTest, TemeToEcefBatch) {
+  using namespace date;
+  using namespace std::chrono;
+  const auto tp = date::sys_days{2004_y / date::April / 6} + 7h + 51min;
+  const EopTable eop(53100, std::vector<EopValues>(2, {
+                                                          .ut1_utc = -0.44,
+                                                          .x_pole = -0.14,
+                                                          .y_pole = 0.33,
+                                                      }));
+  std::vector<TemeState> teme;
+  std::vector<TemeStateF> teme_f;
+  for (int i = 0; i < 16; ++i) {
+    const double a = 0.4 * i;
+    teme.push_back({{7000.0 * std::cos(a), 7000.0 * std::sin(a), 100.0 * i},
+                    {-7.5 * std::sin(a), 7.5 * std::cos(a), 0.1 * i}});
+    teme_f.push_back(
+        {{static_cast<float>(teme.back().position[0]),
+          static_cast<float>(teme.back().position[1]),
+          static_cast<float>(teme.back().position[2])},
+         {static_cast<float>(teme.back().velocity[0]),
+          static_cast<float>(teme.back().velocity[1]),
+          static_cast<float>(teme.back().velocity[2])}});
+  }
+  std::vector<EcefState> ecef(teme.size());
+  TemeToEcef(teme, tp, eop, ecef);
+  std::vector<EcefStateF> ecef_f(teme.size());
+  TemeToEcef(teme_f, tp, eop, ecef_f);
+
+  for (std::size_t i = 0; i < teme.size(); ++i) {
+    const auto expected = TemeToEcef(teme[i], tp, eop);
+    for (std::size_t j = 0; j < 3; ++j) {
+      EXPECT_NEAR(ecef[i].position[j], expected.position[j], 1e-9);
+      EXPECT_NEAR(ecef[i].velocity[j], expected.velocity[j], 1e-12);
+      // float has ~7 significant digits
+      EXPECT_NEAR(ecef_f[i].position[j], expected.position[j], 2e-3);
+      EXPECT_NEAR(ecef_f[i].velocity[j], expected.velocity[j], 2e-6);
+    }
+  }
+}
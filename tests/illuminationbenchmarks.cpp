@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "earthorbits/illumination.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+namespace {
+/// @brief SGP4 states of the near Earth part of the synthetic catalog
+std::vector<Sgp4State> NearEarthStates(std::size_t size) {
+  std::vector<Sgp4State> states;
+  Sgp4State state;
+  for (const auto &str : CachedSynthTles(size)) {
+    if (InitSgp4(ParseTle(str), state) == Sgp4Errc::kOk) {
+      states.push_back(state);
+    }
+  }
+  return states;
+}
+
+/// all synthetic TLEs have epochs in 2024
+const auto grid_start = std::chrono::sys_days{std::chrono::year{2024} /
+                                              std::chrono::June / 1};
+}  // namespace
+
+static void BM_SunPosition(benchmark::State &state) {
+  auto tp = std::chrono::system_clock::time_point{grid_start};
+  for (auto _ : state) {
+    auto sun = SunPosition(tp);
+    benchmark::DoNotOptimize(sun);
+    tp += std::chrono::minutes(1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SunPosition);
+
+static void BM_MoonPosition(benchmark::State &state) {
+  auto tp = std::chrono::system_clock::time_point{grid_start};
+  for (auto _ : state) {
+    auto moon = MoonPosition(tp);
+    benchmark::DoNotOptimize(moon);
+    tp += std::chrono::minutes(1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MoonPosition);
+
+/// One time step of a catalog, the Sun is shared by all satellites
+static void BM_CalcIlluminationCatalog(benchmark::State &state) {
+  const auto model = static_cast<ShadowModel>(state.range(0));
+  const auto states = NearEarthStates(30000);
+  const auto sun = SunPosition(grid_start);
+  std::vector<Vector3> positions;
+  TemeState teme;
+  for (const auto &s : states) {
+    if (PropagateSgp4(s, MinutesSinceEpoch(s, grid_start), teme) ==
+        Sgp4Errc::kOk) {
+      positions.push_back(teme.position);
+    }
+  }
+  std::vector<Illumination> out(positions.size());
+  for (auto _ : state) {
+    CalcIllumination(positions, sun, model, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(positions.size()));
+}
+BENCHMARK(BM_CalcIlluminationCatalog)
+    ->ArgName("conical")
+    ->Arg(static_cast<int>(ShadowModel::kCylindrical))
+    ->Arg(static_cast<int>(ShadowModel::kConical));
+
+/// Eclipse entry and exit times of a catalog over 24 h on a 1 minute grid
+static void BM_FindEclipsesCatalogDay(benchmark::State &state) {
+  const auto states = NearEarthStates(static_cast<std::size_t>(state.range(0)));
+  std::vector<std::vector<EclipseInterval>> eclipses;
+  std::vector<Sgp4Errc> errors;
+  for (auto _ : state) {
+    const SunMoonGrid grid(grid_start, std::chrono::minutes(1), 1441);
+    FindEclipses(states, grid, ShadowModel::kConical, eclipses, errors);
+    benchmark::DoNotOptimize(eclipses.data());
+  }
+  std::size_t found = 0;
+  for (const auto &e : eclipses) {
+    found += e.size();
+  }
+  state.counters["satellites"] = static_cast<double>(states.size());
+  state.counters["eclipses"] = static_cast<double>(found);
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(states.size()));
+}
+BENCHMARK(BM_FindEclipsesCatalogDay)
+    ->ArgName("catalog")
+    ->Arg(1000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FindEclipsesCatalogDay)
+    ->ArgName("catalog")
+    ->Arg(30000)
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "date/date.h"
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/illumination.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+constexpr double au_km = 149597870.7;
+}  // namespace
+
+/// Vallado, example 5-1, which uses TDB instead of UTC for the time
+TEST(IlluminationTest, SunPosition) {
+  using namespace date;
+  const auto sun = SunPosition(date::sys_days{2006_y / date::April / 2});
+  EXPECT_NEAR(sun[0] / au_km, 0.9771945, 1e-5);
+  EXPECT_NEAR(sun[1] / au_km, 0.1924424, 1e-5);
+  EXPECT_NEAR(sun[2] / au_km, 0.0834308, 1e-5);
+}
+
+/// Vallado, example 5-3
+TEST(IlluminationTest, MoonPosition) {
+  using namespace date;
+  const auto moon = MoonPosition(date::sys_days{1994_y / date::April / 28});
+  EXPECT_NEAR(moon[0], -134240.626, 1.0);
+  EXPECT_NEAR(moon[1], -311571.590, 1.0);
+  EXPECT_NEAR(moon[2], -126693.785, 1.0);
+}
+
+TEST(IlluminationTest, ShadowModels) {
+  const Vector3 sun{au_km, 0.0, 0.0};
+  const Vector3 day_side{7000.0, 0.0, 0.0};
+  const Vector3 night_side{-7000.0, 0.0, 0.0};
+  const Vector3 terminator{0.0, 7000.0, 0.0};
+  // just inside the cylinder, but the Sun's disk is partly visible
+  const Vector3 edge{-7000.0, 6370.0, 0.0};
+
+  for (auto model : {ShadowModel::kCylindrical, ShadowModel::kConical}) {
+    EXPECT_EQ(CalcIllumination(day_side, sun, model), Illumination::kSunlit);
+    EXPECT_EQ(CalcIllumination(night_side, sun, model), Illumination::kUmbra);
+    EXPECT_EQ(CalcIllumination(terminator, sun, model), Illumination::kSunlit);
+  }
+  EXPECT_EQ(CalcIllumination(edge, sun, ShadowModel::kCylindrical),
+            Illumination::kUmbra);
+  EXPECT_EQ(CalcIllumination(edge, sun, ShadowModel::kConical),
+            Illumination::kPenumbra);
+  const double fraction = SunlitFraction(edge, sun);
+  EXPECT_GT(fraction, 0.0);
+  EXPECT_LT(fraction, 1.0);
+
+  const std::vector<Vector3> satellites{day_side, night_side, edge};
+  std::vector<Illumination> out(satellites.size());
+  CalcIllumination(satellites, sun, ShadowModel::kConical, out);
+  EXPECT_EQ(out, (std::vector<Illumination>{Illumination::kSunlit,
+                                            Illumination::kUmbra,
+                                            Illumination::kPenumbra}));
+}
+
+TEST(IlluminationTest, FindEclipses) {
+  using namespace std::chrono;
+  Sgp4State state;
+  ASSERT_EQ(InitSgp4(iss_2024, state), Sgp4Errc::kOk);
+  const SunMoonGrid grid(time_point_cast<seconds>(state.epoch), minutes(1),
+                         1441);
+  EXPECT_EQ(grid.time(60) - grid.time(0), hours(1));
+
+  std::vector<EclipseInterval> cylindrical;
+  std::vector<EclipseInterval> conical;
+  ASSERT_EQ(FindEclipses(state, grid, ShadowModel::kCylindrical, cylindrical),
+            Sgp4Errc::kOk);
+  ASSERT_EQ(FindEclipses(state, grid, ShadowModel::kConical, conical),
+            Sgp4Errc::kOk);
+
+  // about 15.5 orbits a day, in shadow for at most ~37 minutes of each
+  ASSERT_GE(cylindrical.size(), 14U);
+  ASSERT_LE(cylindrical.size(), 17U);
+  for (const auto &e : cylindrical) {
+    EXPECT_LT(e.entry, e.exit);
+    EXPECT_LE(e.exit - e.entry, minutes(40));
+    const auto mid = e.entry + (e.exit - e.entry) / 2;
+    TemeState teme;
+    ASSERT_EQ(PropagateSgp4(state, MinutesSinceEpoch(state, mid), teme),
+              Sgp4Errc::kOk);
+    EXPECT_EQ(CalcIllumination(teme.position, SunPosition(mid),
+                               ShadowModel::kCylindrical),
+              Illumination::kUmbra);
+  }
+  // penumbra makes conical eclipses a little longer
+  ASSERT_EQ(conical.size(), cylindrical.size());
+  EXPECT_GE(conical[1].exit - conical[1].entry,
+            cylindrical[1].exit - cylindrical[1].entry);
+
+  const std::vector<Sgp4State> states{state, state};
+  std::vector<std::vector<EclipseInterval>> batch;
+  std::vector<Sgp4Errc> errors;
+  FindEclipses(states, grid, ShadowModel::kCylindrical, batch, errors);
+  ASSERT_EQ(batch.size(), 2U);
+  EXPECT_EQ(errors[1], Sgp4Errc::kOk);
+  ASSERT_EQ(batch[1].size(), cylindrical.size());
+  EXPECT_EQ(batch[1][0].entry, cylindrical[0].entry);
+
+  // bisection would never get within these
+  EXPECT_THROW(static_cast<void>(FindEclipses(
+                   state, grid, ShadowModel::kCylindrical, cylindrical,
+                   seconds(0))),
+               MyException<std::string>);
+  EXPECT_THROW(FindEclipses(states, grid, ShadowModel::kCylindrical, batch,
+                            errors, seconds(-1)),
+               MyException<std::string>);
+}
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+
+#include "earthorbits/instrumentation.h"
+
+using namespace eob;
+
+/// Compare these to see the cost of a scoped timer or counter, with
+/// EOB_ENABLE_INSTRUMENTATION off they compile to the same loop
+static void BM_InstrumentationBaseline(benchmark::State &state) {
+  double x = 0.0;
+  for (auto _ : state) {
+    x += 1.0;
+    benchmark::DoNotOptimize(x);
+  }
+  state.counters["enabled"] = instrumentation_enabled() ? 1 : 0;
+}
+BENCHMARK(BM_InstrumentationBaseline);
+
+static void BM_InstrumentationScopedTimer(benchmark::State &state) {
+  double x = 0.0;
+  for (auto _ : state) {
+    EOB_SCOPED_TIMER(Probe::kFormat);
+    x += 1.0;
+    benchmark::DoNotOptimize(x);
+  }
+  state.counters["enabled"] = instrumentation_enabled() ? 1 : 0;
+}
+BENCHMARK(BM_InstrumentationScopedTimer);
+
+static void BM_InstrumentationCount(benchmark::State &state) {
+  double x = 0.0;
+  for (auto _ : state) {
+    EOB_COUNT(Probe::kFormat);
+    x += 1.0;
+    benchmark::DoNotOptimize(x);
+  }
+  state.counters["enabled"] = instrumentation_enabled() ? 1 : 0;
+}
+BENCHMARK(BM_InstrumentationCount);
+
+static void BM_InstrumentationSnapshot(benchmark::State &state) {
+  for (auto _ : state) {
+    auto snapshot = TakeInstrumentationSnapshot();
+    benchmark::DoNotOptimize(snapshot);
+  }
+}
+BENCHMARK(BM_InstrumentationSnapshot);
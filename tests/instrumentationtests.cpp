@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/instrumentation.h"
+#include "earthorbits/parsetle.h"
+#include "testutil.h"
+
+using namespace eob;
+
+TEST(InstrumentationTest, CountsProbes) {
+  ResetInstrumentation();
+
+  const std::string s(iss_2024_text);
+  auto tle = ParseTle(s);
+  auto gmst = calc_gmst(std::chrono::system_clock::now());
+
+  // counters of exited threads are kept
+  std::thread worker([&s] {
+    for (int i = 0; i < 3; ++i) {
+      auto t = ParseTle(s);
+    }
+  });
+  worker.join();
+
+  const auto snapshot = TakeInstrumentationSnapshot();
+  if constexpr (instrumentation_enabled()) {
+    EXPECT_EQ(snapshot[Probe::kParseTle].calls, 4);
+    EXPECT_EQ(snapshot[Probe::kValidateTle].calls, 4);
+    EXPECT_EQ(snapshot[Probe::kCalcGmst].calls, 1);
+    EXPECT_EQ(snapshot[Probe::kPropagate].calls, 0);
+    EXPECT_GT(snapshot[Probe::kParseTle].ticks, 0);
+    EXPECT_GT(snapshot[Probe::kParseTle].seconds, 0.0);
+    EXPECT_GE(snapshot[Probe::kParseTle].ticks,
+              snapshot[Probe::kValidateTle].ticks);
+    EXPECT_GT(snapshot.ticks_per_second, 0.0);
+    EXPECT_GE(snapshot.threads, 1);
+  } else {
+    for (const auto &probe : snapshot.probes) {
+      EXPECT_EQ(probe.calls, 0);
+      EXPECT_EQ(probe.ticks, 0);
+    }
+  }
+
+  ResetInstrumentation();
+  EXPECT_EQ(TakeInstrumentationSnapshot()[Probe::kParseTle].calls, 0);
+}
+
+TEST(InstrumentationTest, Dumps) {
+  ResetInstrumentation();
+  auto gmst = calc_gmst(std::chrono::system_clock::now());
+  const auto snapshot = TakeInstrumentationSnapshot();
+
+  const auto text = ToText(snapshot);
+  EXPECT_NE(text.find("calc_gmst calls="), std::string::npos);
+
+  const auto json = ToJson(snapshot);
+  EXPECT_EQ(json.front(), '{');
+  EXPECT_EQ(json.back(), '}');
+  EXPECT_NE(json.find(R"("propagate":{"calls":0)"), std::string::npos);
+  if constexpr (instrumentation_enabled()) {
+    EXPECT_NE(json.find(R"("calc_gmst":{"calls":1,)"), std::string::npos);
+  }
+}
@@ -0,0 +1,168 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <vector>
+
+#include "earthorbits/frames.h"
+#include "earthorbits/linkgeometry.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/topocentric.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+namespace {
+constexpr double deg_to_rad = std::numbers::pi / 180.0;
+constexpr std::size_t satellites = 10;
+constexpr std::size_t stations = 100;
+constexpr std::size_t day = 86400;
+constexpr std::size_t contact_seconds = 600;
+
+/// @brief Earth fixed tracks of a few satellites, a day at 1 Hz each
+struct Tracks {
+  Tracks() {
+    const std::chrono::system_clock::time_point start{
+        std::chrono::sys_days{std::chrono::year{2024} / std::chrono::June / 1}};
+    Sgp4State state;
+    TemeState teme;
+    for (const auto &str : CachedSynthTles(100)) {
+      if (states.size() == satellites) {
+        break;
+      }
+      if (InitSgp4(ParseTle(str), state) == Sgp4Errc::kOk) {
+        states.push_back(state);
+      }
+    }
+    for (const auto &s : states) {
+      auto &track = ecef.emplace_back(day);
+      for (std::size_t i = 0; i < day; ++i) {
+        const auto tp = start + std::chrono::seconds(i);
+        if (PropagateSgp4(s, MinutesSinceEpoch(s, tp), teme) !=
+            Sgp4Errc::kOk) {
+          teme = {};
+        }
+        track[i] = TemeToEcef(teme, tp);
+      }
+    }
+  }
+
+  std::vector<Sgp4State> states;
+  std::vector<std::vector<EcefState>> ecef;
+};
+
+const Tracks &CachedTracks() {
+  static const Tracks tracks;
+  return tracks;
+}
+
+/// @brief Stations spread over the globe
+std::vector<GroundStation> Stations() {
+  std::vector<GroundStation> result;
+  for (std::size_t i = 0; i < stations; ++i) {
+    const double k = static_cast<double>(i);
+    result.emplace_back(
+        Geodetic{.latitude = (-70.0 + 1.4 * k) * deg_to_rad,
+                 .longitude = (-180.0 + 137.5 * k) * deg_to_rad,
+                 .altitude = 0.0});
+  }
+  return result;
+}
+
+/// @brief Every station in contact all day, 10 minute contacts taking
+/// turns among the satellites
+std::vector<Contact> Contacts(const Tracks &tracks) {
+  std::vector<Contact> contacts;
+  for (std::size_t s = 0; s < stations; ++s) {
+    for (std::size_t begin = 0; begin < day; begin += contact_seconds) {
+      const auto &track = tracks.ecef[(s + begin) % tracks.ecef.size()];
+      contacts.push_back(
+          {.station = s,
+           .track = std::span(track).subspan(begin, contact_seconds)});
+    }
+  }
+  return contacts;
+}
+}  // namespace
+
+/// 100 stations, a day of contacts at 1 Hz
+static void BM_CalcLinkGeometry(benchmark::State &state) {
+  const auto &tracks = CachedTracks();
+  const auto ground = Stations();
+  const auto contacts = Contacts(tracks);
+  std::vector<LinkGeometry> links;
+  for (auto _ : state) {
+    CalcLinkGeometry(ground, contacts, links,
+                     static_cast<std::size_t>(state.range(0)));
+    benchmark::DoNotOptimize(links.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(stations * day));
+}
+BENCHMARK(BM_CalcLinkGeometry)
+    ->Arg(1)
+    ->Arg(0)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/// The same with a GroundStation::Look per sample and the Doppler factor
+/// from its range rate
+static void BM_LinkGeometryLookPerSample(benchmark::State &state) {
+  const auto &tracks = CachedTracks();
+  const auto ground = Stations();
+  const auto contacts = Contacts(tracks);
+  std::vector<std::vector<LookAngles>> looks(contacts.size());
+  std::vector<std::vector<double>> doppler(contacts.size());
+  for (auto _ : state) {
+    for (std::size_t c = 0; c < contacts.size(); ++c) {
+      const auto &contact = contacts[c];
+      looks[c].resize(contact.track.size());
+      doppler[c].resize(contact.track.size());
+      for (std::size_t i = 0; i < contact.track.size(); ++i) {
+        looks[c][i] = ground[contact.station].Look(contact.track[i]);
+        doppler[c][i] =
+            1.0 - looks[c][i].range_rate / speed_of_light_km_per_s;
+      }
+    }
+    benchmark::DoNotOptimize(looks.data());
+    benchmark::DoNotOptimize(doppler.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(stations * day));
+}
+BENCHMARK(BM_LinkGeometryLookPerSample)->Unit(benchmark::kMillisecond);
+
+/// One contact over and over, in cache, the cost of the arithmetic alone
+static void BM_CalcLinkGeometryInCache(benchmark::State &state) {
+  const auto &tracks = CachedTracks();
+  const auto ground = Stations();
+  const auto track = std::span(tracks.ecef[0]).first(contact_seconds);
+  LinkGeometry link;
+  for (auto _ : state) {
+    CalcLinkGeometry(ground[0], track, link);
+    benchmark::DoNotOptimize(link.range.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(track.size()));
+}
+BENCHMARK(BM_CalcLinkGeometryInCache);
+
+static void BM_LookPerSampleInCache(benchmark::State &state) {
+  const auto &tracks = CachedTracks();
+  const auto ground = Stations();
+  const auto track = std::span(tracks.ecef[0]).first(contact_seconds);
+  std::vector<LookAngles> looks(track.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < track.size(); ++i) {
+      looks[i] = ground[0].Look(track[i]);
+    }
+    benchmark::DoNotOptimize(looks.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(track.size()));
+}
+BENCHMARK(BM_LookPerSampleInCache);
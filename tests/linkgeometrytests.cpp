@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/linkgeometry.h"
+#include "earthorbits/topocentric.h"
+
+using namespace eob;
+
+namespace {
+constexpr double deg_to_rad = std::numbers::pi / 180.0;
+
+/// @brief A circular orbit sampled at 1 Hz, in all directions from a
+/// station on the equator at longitude 0 over time
+std::vector<EcefState> Track(std::size_t samples, double phase) {
+  constexpr double radius = 7000.0;
+  const double rate = std::sqrt(398600.8 / (radius * radius * radius));
+  std::vector<EcefState> track;
+  for (std::size_t i = 0; i < samples; ++i) {
+    const double a = phase + rate * static_cast<double>(i);
+    const double tilt = 0.9;
+    track.push_back(
+        {{radius * std::cos(a), radius * std::sin(a) * std::cos(tilt),
+          radius * std::sin(a) * std::sin(tilt)},
+         {-radius * rate * std::sin(a),
+          radius * rate * std::cos(a) * std::cos(tilt),
+          radius * rate * std::cos(a) * std::sin(tilt)}});
+  }
+  return track;
+}
+}  // namespace
+
+TEST(LinkGeometryTest, MatchesLook) {
+  const GroundStation station({.latitude = 10.0 * deg_to_rad,
+                               .longitude = 5.0 * deg_to_rad,
+                               .altitude = 0.3});
+  // several chunks and a partial one
+  const auto track = Track(1000, 0.0);
+  LinkGeometry link;
+  CalcLinkGeometry(station, track, link);
+  ASSERT_EQ(link.size(), track.size());
+  for (std::size_t i = 0; i < track.size(); ++i) {
+    const auto look = station.Look(track[i]);
+    ASSERT_EQ(link.range[i], look.range) << i;
+    ASSERT_EQ(link.range_rate[i], look.range_rate) << i;
+    ASSERT_NEAR(link.azimuth[i], look.azimuth, 1e-14) << i;
+    ASSERT_NEAR(link.elevation[i], look.elevation, 1e-14) << i;
+    ASSERT_DOUBLE_EQ(link.doppler[i],
+                     1.0 - look.range_rate / speed_of_light_km_per_s);
+  }
+
+  CalcLinkGeometry(station, {}, link);
+  EXPECT_EQ(link.size(), 0U);
+}
+
+TEST(LinkGeometryTest, Doppler) {
+  const GroundStation station(
+      {.latitude = 0.0, .longitude = 0.0, .altitude = 0.0});
+  // before and after the closest approach over the station
+  const auto track = Track(601, -0.3);
+  LinkGeometry link;
+  CalcLinkGeometry(station, track, link);
+  // approaching: higher frequency, receding: lower, by up to v / c
+  EXPECT_GT(link.doppler.front(), 1.0);
+  EXPECT_LT(link.doppler.back(), 1.0);
+  EXPECT_LT(link.doppler.front() - 1.0, 7.6 / speed_of_light_km_per_s);
+  const double closest = *std::min_element(link.range.begin(),
+                                           link.range.end());
+  EXPECT_NEAR(closest, 7000.0 - 6378.135, 1.0);
+}
+
+TEST(LinkGeometryTest, Contacts) {
+  const std::vector<GroundStation> stations{
+      GroundStation({.latitude = 0.0, .longitude = 0.0, .altitude = 0.0}),
+      GroundStation({.latitude = 50.0 * deg_to_rad,
+                     .longitude = -100.0 * deg_to_rad,
+                     .altitude = 1.0})};
+  const auto a = Track(700, 0.0);
+  const auto b = Track(300, 1.0);
+  const std::vector<Contact> contacts{
+      {.station = 1, .track = a},
+      {.station = 0, .track = b},
+      {.station = 0, .track = std::span(a).subspan(100, 50)},
+      {.station = 1, .track = {}}};
+
+  for (const std::size_t threads : {1U, 3U}) {
+    std::vector<LinkGeometry> links;
+    CalcLinkGeometry(stations, contacts, links, threads);
+    ASSERT_EQ(links.size(), contacts.size());
+    for (std::size_t c = 0; c < contacts.size(); ++c) {
+      LinkGeometry expected;
+      CalcLinkGeometry(stations[contacts[c].station], contacts[c].track,
+                       expected);
+      EXPECT_EQ(links[c].range, expected.range);
+      EXPECT_EQ(links[c].range_rate, expected.range_rate);
+      EXPECT_EQ(links[c].doppler, expected.doppler);
+      EXPECT_EQ(links[c].azimuth, expected.azimuth);
+      EXPECT_EQ(links[c].elevation, expected.elevation);
+    }
+  }
+
+  std::vector<LinkGeometry> links;
+  const std::vector<Contact> bad{{.station = 2, .track = a}};
+  EXPECT_THROW(CalcLinkGeometry(stations, bad, links),
+               MyException<std::string>);
+}
@@ -3,6 +3,7 @@
 #include <chrono>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "date/date.h"
 #include "earthorbits/earthorbits.h"
@@ -41,10 +42,10 @@ TEST(EarthorbitTest, ParseTLES) {
     ASSERT_EQ(tle.line_1.launch_number, 67);
     ASSERT_EQ(tle.line_1.launch_piece, "A  ");
     ASSERT_EQ(tle.line_1.epoch_year, 24);
-    ASSERT_FLOAT_EQ(tle.line_1.epoch_day, 097.81509284);
-    ASSERT_FLOAT_EQ(tle.line_1.mean_motion_dot, .00011771);
-    ASSERT_FLOAT_EQ(tle.line_1.mean_motion_ddot, 0.0);
-    ASSERT_FLOAT_EQ(tle.line_1.bstar_drag, 0.21418e-3);
+    ASSERT_DOUBLE_EQ(tle.line_1.epoch_day, 097.81509284);
+    ASSERT_DOUBLE_EQ(tle.line_1.mean_motion_dot, .00011771);
+    ASSERT_DOUBLE_EQ(tle.line_1.mean_motion_ddot, 0.0);
+    ASSERT_DOUBLE_EQ(tle.line_1.bstar_drag, 0.21418e-3);
     ASSERT_EQ(tle.line_1.ephemeris_type, 0);
     ASSERT_EQ(tle.line_1.element_number, 999);
     ASSERT_EQ(tle.line_1.checksum, 5);
@@ -56,8 +57,8 @@ TEST(EarthorbitTest, ParseTLES) {
     ASSERT_EQ(tle.line_2.eccentricity, 0.0004792);
     ASSERT_EQ(tle.line_2.argument_of_perigree, 43.0163);
     ASSERT_EQ(tle.line_2.mean_anomaly, 63.5300);
-    ASSERT_FLOAT_EQ(tle.line_2.mean_motion, 15.49960977);
-    ASSERT_FLOAT_EQ(tle.line_2.rev_at_epoch, 44747);
+    ASSERT_DOUBLE_EQ(tle.line_2.mean_motion, 15.49960977);
+    ASSERT_EQ(tle.line_2.rev_at_epoch, 44747);
     ASSERT_EQ(tle.line_2.checksum, 3);
   }
 
@@ -77,10 +78,10 @@ TEST(EarthorbitTest, ParseTLES) {
     ASSERT_EQ(tle.line_1.launch_number, 67);
     ASSERT_EQ(tle.line_1.launch_piece, "A  ");
     ASSERT_EQ(tle.line_1.epoch_year, 24);
-    ASSERT_FLOAT_EQ(tle.line_1.epoch_day, 104.84924656);
-    ASSERT_FLOAT_EQ(tle.line_1.mean_motion_dot, .00014577);
-    ASSERT_FLOAT_EQ(tle.line_1.mean_motion_ddot, 0.0);
-    ASSERT_FLOAT_EQ(tle.line_1.bstar_drag, 0.26139e-3);
+    ASSERT_DOUBLE_EQ(tle.line_1.epoch_day, 104.84924656);
+    ASSERT_DOUBLE_EQ(tle.line_1.mean_motion_dot, .00014577);
+    ASSERT_DOUBLE_EQ(tle.line_1.mean_motion_ddot, 0.0);
+    ASSERT_DOUBLE_EQ(tle.line_1.bstar_drag, 0.26139e-3);
     ASSERT_EQ(tle.line_1.ephemeris_type, 0);
     ASSERT_EQ(tle.line_1.element_number, 999);
     ASSERT_EQ(tle.line_1.checksum, 3);
@@ -92,8 +93,8 @@ TEST(EarthorbitTest, ParseTLES) {
     ASSERT_EQ(tle.line_2.eccentricity, 0.0004733);
     ASSERT_EQ(tle.line_2.argument_of_perigree, 65.7744);
     ASSERT_EQ(tle.line_2.mean_anomaly, 78.8036);
-    ASSERT_FLOAT_EQ(tle.line_2.mean_motion, 15.50162147);
-    ASSERT_FLOAT_EQ(tle.line_2.rev_at_epoch, 44856);
+    ASSERT_DOUBLE_EQ(tle.line_2.mean_motion, 15.50162147);
+    ASSERT_EQ(tle.line_2.rev_at_epoch, 44856);
     ASSERT_EQ(tle.line_2.checksum, 1);
   }
 
@@ -113,10 +114,10 @@ TEST(EarthorbitTest, ParseTLES) {
     ASSERT_EQ(tle.line_1.launch_number, 67);
     ASSERT_EQ(tle.line_1.launch_piece, "A  ");
     ASSERT_EQ(tle.line_1.epoch_year, 8);
-    ASSERT_FLOAT_EQ(tle.line_1.epoch_day, 264.51782528);
-    ASSERT_FLOAT_EQ(tle.line_1.mean_motion_dot, -.00002182);
-    ASSERT_FLOAT_EQ(tle.line_1.mean_motion_ddot, 0.0);
-    ASSERT_FLOAT_EQ(tle.line_1.bstar_drag, -0.11606e-4);
+    ASSERT_DOUBLE_EQ(tle.line_1.epoch_day, 264.51782528);
+    ASSERT_DOUBLE_EQ(tle.line_1.mean_motion_dot, -.00002182);
+    ASSERT_DOUBLE_EQ(tle.line_1.mean_motion_ddot, 0.0);
+    ASSERT_DOUBLE_EQ(tle.line_1.bstar_drag, -0.11606e-4);
     ASSERT_EQ(tle.line_1.ephemeris_type, 0);
     ASSERT_EQ(tle.line_1.element_number, 292);
     ASSERT_EQ(tle.line_1.checksum, 7);
@@ -128,8 +129,8 @@ TEST(EarthorbitTest, ParseTLES) {
     ASSERT_EQ(tle.line_2.eccentricity, 0.0006703);
     ASSERT_EQ(tle.line_2.argument_of_perigree, 130.5360);
     ASSERT_EQ(tle.line_2.mean_anomaly, 325.0288);
-    ASSERT_FLOAT_EQ(tle.line_2.mean_motion, 15.72125391);
-    ASSERT_FLOAT_EQ(tle.line_2.rev_at_epoch, 56353);
+    ASSERT_DOUBLE_EQ(tle.line_2.mean_motion, 15.72125391);
+    ASSERT_EQ(tle.line_2.rev_at_epoch, 56353);
     ASSERT_EQ(tle.line_2.checksum, 7);
   }
 }
@@ -158,23 +159,106 @@ TEST(EarthorbitTest, ParseInvalidTLES) {
     ASSERT_THROW(auto tle = ParseTle(s), MyException<std::string>);
   }
 
-  /// TODO(tjr) guess there is a lot more to do if I want a truly robust
-  /// function. std::stoi is very forgiving.
-  //   { // Invalid days in line 1, two decimals
-  //     std::string s =
-  //         R"(1 25544U 98067A   24097.815.9284  .00011771  00000-0  21418-3 0
-  //         9995
-  // 2 25544  51.6405 309.2692 0004792  43.0163  63.5300 15.49960977447473)";
-
-  //     try {
-  //       auto tle = ParseTle(s);
-  //       std::cout << tle.line_1.epoch_day << "\n";
-  //     } catch (MyException<std::string> &e) {
-  //       std::cout << e.what() << ",where=" << e.where() << "data=" <<
-  //       e.data() << "\n";
-  //     }
-  //     ASSERT_THROW(auto tle = ParseTle(s), MyException<std::string>);
-  //   }
+  {  // Invalid days in line 1, two decimals
+    std::string s =
+        R"(1 25544U 98067A   24097.815.9284  .00011771  00000-0  21418-3 0  9995
+2 25544  51.6405 309.2692 0004792  43.0163  63.5300 15.49960977447473)";
+
+    ASSERT_THROW(auto tle = ParseTle(s), MyException<std::string>);
+  }
+}
+
+TEST(EarthorbitTest, TryParseTle) {
+  const std::string valid =
+      R"(1 25544U 98067A   24097.81509284  .00011771  00000-0  21418-3 0  9995
+2 25544  51.6405 309.2692 0004792  43.0163  63.5300 15.49960977447473)";
+
+  {
+    Tle tle;
+    auto err = TryParseTle(valid, tle);
+    ASSERT_TRUE(err.ok());
+    EXPECT_EQ(tle.line_1.satellite_number, 25544);
+    EXPECT_EQ(tle.line_2.eccentricity, 0.0004792);
+    EXPECT_DOUBLE_EQ(tle.line_1.bstar_drag, 0.21418e-3);
+    EXPECT_TRUE(ValidateTle(valid).ok());
+  }
+
+  // corrupt a single character of a valid TLE and check the diagnosis
+  auto corrupt = [&valid](std::size_t pos, char c) {
+    auto s = valid;
+    s[pos] = c;
+    return s;
+  };
+  struct Case {
+    std::string str;
+    TleErrc code;
+    TleField field;
+    int line;
+    int column;
+  };
+  const std::vector<Case> cases{
+      {valid.substr(0, 138), TleErrc::kInvalidSize, TleField::kNone, 0, 0},
+      {corrupt(69, ' '), TleErrc::kMissingLineBreak, TleField::kNone, 1, 70},
+      {corrupt(14, 'a'), TleErrc::kInvalidCharacter, TleField::kNone, 1, 15},
+      {corrupt(70 + 20, 'x'), TleErrc::kInvalidCharacter, TleField::kNone, 2,
+       21},
+      {corrupt(0, '3'), TleErrc::kInvalidLineNumber, TleField::kLine1Number,
+       1, 1},
+      {corrupt(7, 'C'), TleErrc::kInvalidClassification,
+       TleField::kClassification, 1, 8},
+      {corrupt(68, '4'), TleErrc::kChecksumMismatch, TleField::kLine1Checksum,
+       1, 69},
+      {corrupt(70 + 68, '0'), TleErrc::kChecksumMismatch,
+       TleField::kLine2Checksum, 2, 69},
+      // a corrupted digit is caught by the checksum before any decoding
+      {corrupt(29, '.'), TleErrc::kChecksumMismatch, TleField::kLine1Checksum,
+       1, 69},
+  };
+  for (const auto &[str, code, field, line, column] : cases) {
+    Tle tle{};
+    tle.line_1.satellite_number = -1;
+    auto err = TryParseTle(str, tle);
+    EXPECT_EQ(err.code, code) << to_string(err);
+    EXPECT_EQ(err.field, field) << to_string(err);
+    EXPECT_EQ(err.line, line) << to_string(err);
+    EXPECT_EQ(err.column, column) << to_string(err);
+    // output untouched on failure
+    EXPECT_EQ(tle.line_1.satellite_number, -1);
+    EXPECT_THROW(auto t = ParseTle(str), MyException<std::string>);
+  }
+
+  {  // two decimal points in the epoch, checksum still valid
+    std::string s =
+        R"(1 25544U 98067A   24097.815.9284  .00011771  00000-0  21418-3 0  9995
+2 25544  51.6405 309.2692 0004792  43.0163  63.5300 15.49960977447473)";
+    auto err = ValidateTle(s);
+    EXPECT_EQ(err.code, TleErrc::kInvalidField);
+    EXPECT_EQ(err.field, TleField::kEpochDay);
+    EXPECT_EQ(err.line, 1);
+    EXPECT_EQ(err.column, 21);
+    EXPECT_EQ(to_string(err),
+              R"(TLE rejected, error="invalid field", line=1, column=21, )"
+              R"(field="epoch day")");
+  }
+
+  {  // inclination > 180, checksum adjusted to match
+    std::string s =
+        R"(1 25544U 98067A   24097.81509284  .00011771  00000-0  21418-3 0  9995
+2 25544 181.6405 309.2692 0004792  43.0163  63.5300 15.49960977447477)";
+    auto err = ValidateTle(s);
+    EXPECT_EQ(err.code, TleErrc::kOutOfDomain);
+    EXPECT_EQ(err.field, TleField::kInclination);
+    EXPECT_EQ(err.column, 9);
+  }
+
+  {  // satellite numbers differ between lines, checksum adjusted to match
+    std::string s =
+        R"(1 25544U 98067A   24097.81509284  .00011771  00000-0  21418-3 0  9995
+2 25545  51.6405 309.2692 0004792  43.0163  63.5300 15.49960977447474)";
+    auto err = ValidateTle(s);
+    EXPECT_EQ(err.code, TleErrc::kSatelliteNumberMismatch);
+    EXPECT_EQ(err.line, 2);
+  }
 }
 
 TEST(TimeTests, ToString) {
@@ -227,3 +311,22 @@ TEST(TimeTests, GreenwichMeanTimes) {
     EXPECT_NEAR(gmst.count(), expected.count(), tolerance_s.count());
   }
 }
+
+TEST(TimeTests, GreenwichMeanTimeGrid) {
+  using namespace date;
+  using namespace std::chrono;
+
+  // starts off the step so the grid crosses midnight between samples
+  const system_clock::time_point start =
+      date::sys_days{date::May / 10 / 2024} + 20h + 7s;
+  std::vector<eob_seconds> gmst(3 * 24 * 60);
+  calc_gmst_grid<60>(start, gmst);
+  for (std::size_t i = 0; i < gmst.size(); ++i) {
+    const auto expected = calc_gmst(start + minutes(i));
+    EXPECT_NEAR(gmst[i].count(), expected.count(), 1e-6) << "sample " << i;
+  }
+
+  std::vector<eob_seconds> coarse(5);
+  calc_gmst_grid<86400>(start, coarse);
+  EXPECT_NEAR(coarse[4].count(), calc_gmst(start + days(4)).count(), 1e-6);
+}
@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "earthorbits/montecarlo.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+const ElementCovariance covariance = ToCovariance({.inclination = 1e-3,
+                                                   .raan = 2e-3,
+                                                   .eccentricity = 1e-5,
+                                                   .mean_anomaly = 0.01,
+                                                   .mean_motion = 1e-5,
+                                                   .bstar = 2e-5});
+
+/// @brief Hourly over the day after the epoch
+std::vector<std::chrono::system_clock::time_point> Times() {
+  std::vector<std::chrono::system_clock::time_point> times;
+  const auto epoch = TleEpoch(iss_2024.line_1);
+  for (int h = 1; h <= 24; ++h) {
+    times.push_back(epoch + std::chrono::hours(h));
+  }
+  return times;
+}
+}  // namespace
+
+/// Samples per second over a day of hourly statistics
+static void BM_PropagateMonteCarlo(benchmark::State &state) {
+  const ElementCloud cloud(iss_2024, covariance);
+  const auto times = Times();
+  const MonteCarloOptions options{
+      .samples = static_cast<std::size_t>(state.range(0)),
+      .threads = static_cast<std::size_t>(state.range(1))};
+  for (auto _ : state) {
+    auto stats = PropagateMonteCarlo(cloud, times, options);
+    benchmark::DoNotOptimize(stats.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["propagations"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * state.range(0)) *
+          static_cast<double>(times.size()),
+      benchmark::Counter::kIsRate);
+  state.counters["bytes"] =
+      static_cast<double>(MonteCarloBytes(times.size(), options));
+  // what keeping every state would take
+  state.counters["all_states_bytes"] = static_cast<double>(
+      options.samples * times.size() * sizeof(TemeState));
+}
+BENCHMARK(BM_PropagateMonteCarlo)
+    ->Args({10000, 1})
+    ->Args({100000, 1})
+    ->Args({100000, 0})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/// Drawing element sets alone
+static void BM_ElementCloud(benchmark::State &state) {
+  const ElementCloud cloud(iss_2024, covariance);
+  std::vector<Tle> tles(1000);
+  std::uint64_t first = 0;
+  for (auto _ : state) {
+    cloud.Sample(first, tles);
+    first += tles.size();
+    benchmark::DoNotOptimize(tles.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(tles.size()));
+}
+BENCHMARK(BM_ElementCloud);
+
+/// Keeping every state and reducing afterwards, one sample at a time
+static void BM_MonteCarloAllStates(benchmark::State &state) {
+  const ElementCloud cloud(iss_2024, covariance);
+  const auto times = Times();
+  const auto samples = static_cast<std::size_t>(state.range(0));
+  std::vector<TemeState> teme(samples * times.size());
+  for (auto _ : state) {
+    Sgp4State s;
+    for (std::size_t i = 0; i < samples; ++i) {
+      if (InitSgp4(cloud[i], s) != Sgp4Errc::kOk) {
+        continue;
+      }
+      for (std::size_t t = 0; t < times.size(); ++t) {
+        auto &out = teme[t * samples + i];
+        if (PropagateSgp4(s, MinutesSinceEpoch(s, times[t]), out) !=
+            Sgp4Errc::kOk) {
+          out = {};
+        }
+      }
+    }
+    std::array<double, 3> mean{};
+    for (std::size_t t = 0; t < times.size(); ++t) {
+      for (std::size_t i = 0; i < samples; ++i) {
+        for (std::size_t k = 0; k < 3; ++k) {
+          mean[k] += teme[t * samples + i].position[k];
+        }
+      }
+    }
+    benchmark::DoNotOptimize(mean);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["bytes"] =
+      static_cast<double>(teme.size() * sizeof(TemeState));
+}
+BENCHMARK(BM_MonteCarloAllStates)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
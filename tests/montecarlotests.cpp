@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <string>
+#include <vector>
+
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/montecarlo.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+/// @brief Correlated covariance, mean anomaly and mean motion like after an
+/// orbit determination
+ElementCovariance Correlated() {
+  auto c = ToCovariance({.inclination = 1e-3,
+                         .raan = 2e-3,
+                         .eccentricity = 1e-5,
+                         .argument_of_perigee = 0.5,
+                         .mean_anomaly = 0.5,
+                         .mean_motion = 1e-5,
+                         .bstar = 2e-5});
+  // argument of perigee and mean anomaly are anticorrelated for nearly
+  // circular orbits, mean anomaly and mean motion correlated
+  c[3][4] = c[4][3] = -0.9 * 0.5 * 0.5;
+  c[4][5] = c[5][4] = 0.3 * 0.5 * 1e-5;
+  return c;
+}
+
+std::vector<std::chrono::system_clock::time_point> Times() {
+  const auto epoch = TleEpoch(iss_2024.line_1);
+  return {epoch, epoch + std::chrono::minutes(30),
+          epoch + std::chrono::hours(6), epoch + std::chrono::days(2)};
+}
+
+std::array<double, 6> ToArray(const TemeState &s) {
+  return {s.position[0], s.position[1], s.position[2],
+          s.velocity[0], s.velocity[1], s.velocity[2]};
+}
+}  // namespace
+
+TEST(MonteCarloTest, Cloud) {
+  const auto covariance = Correlated();
+  const ElementCloud cloud(iss_2024, covariance, 3);
+  constexpr std::size_t n = 50000;
+  std::vector<Tle> tles(n);
+  cloud.Sample(0, tles);
+
+  std::array<double, tle_elements> mean{};
+  std::array<std::array<double, tle_elements>, tle_elements> second{};
+  const std::array<double, tle_elements> nominal{
+      iss_2024.line_2.inclination,  iss_2024.line_2.raan,
+      iss_2024.line_2.eccentricity, iss_2024.line_2.argument_of_perigree,
+      iss_2024.line_2.mean_anomaly, iss_2024.line_2.mean_motion,
+      iss_2024.line_1.bstar_drag};
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto &t = tles[i];
+    EXPECT_EQ(t.line_1.satellite_number, 25544);
+    EXPECT_EQ(t.line_1.epoch_day, iss_2024.line_1.epoch_day);
+    const std::array<double, tle_elements> x{
+        t.line_2.inclination,   t.line_2.raan,
+        t.line_2.eccentricity,  t.line_2.argument_of_perigree,
+        t.line_2.mean_anomaly,  t.line_2.mean_motion,
+        t.line_1.bstar_drag};
+    for (std::size_t k = 0; k < tle_elements; ++k) {
+      const double dk = x[k] - nominal[k];
+      mean[k] += dk / n;
+      for (std::size_t l = 0; l < tle_elements; ++l) {
+        second[k][l] += dk * (x[l] - nominal[l]) / n;
+      }
+    }
+  }
+  for (std::size_t k = 0; k < tle_elements; ++k) {
+    const double sigma = std::sqrt(covariance[k][k]);
+    // eccentricity is clamped at 0, slightly biased, the others aren't
+    if (k != static_cast<std::size_t>(TleElement::kEccentricity)) {
+      EXPECT_NEAR(mean[k], 0.0, 4.0 * sigma / std::sqrt(n)) << k;
+    }
+    for (std::size_t l = 0; l < tle_elements; ++l) {
+      const double scale = sigma * std::sqrt(covariance[l][l]);
+      EXPECT_NEAR(second[k][l], covariance[k][l], 0.03 * scale) << k << l;
+    }
+  }
+
+  // counter based, sample i doesn't depend on the samples drawn before
+  const auto again = cloud[12345];
+  EXPECT_EQ(again.line_2.mean_anomaly, tles[12345].line_2.mean_anomaly);
+  EXPECT_EQ(again.line_1.bstar_drag, tles[12345].line_1.bstar_drag);
+  const ElementCloud other(iss_2024, covariance, 4);
+  EXPECT_NE(other[0].line_2.mean_anomaly, tles[0].line_2.mean_anomaly);
+
+  // no variance, no perturbation
+  const ElementCloud fixed(iss_2024, ElementCovariance{});
+  EXPECT_EQ(fixed[7].line_2.mean_anomaly, iss_2024.line_2.mean_anomaly);
+  EXPECT_EQ(fixed[7].line_2.mean_motion, iss_2024.line_2.mean_motion);
+}
+
+TEST(MonteCarloTest, InvalidCovariance) {
+  auto negative = ToCovariance({.mean_anomaly = 1.0});
+  negative[6][6] = -1e-12;
+  EXPECT_THROW(ElementCloud(iss_2024, negative), MyException<std::string>);
+
+  auto asymmetric = ToCovariance({.mean_anomaly = 1.0, .mean_motion = 1.0});
+  asymmetric[4][5] = 0.5;
+  EXPECT_THROW(ElementCloud(iss_2024, asymmetric), MyException<std::string>);
+
+  auto indefinite = asymmetric;
+  indefinite[4][5] = indefinite[5][4] = 1.5;
+  EXPECT_THROW(ElementCloud(iss_2024, indefinite), MyException<std::string>);
+
+  // perfectly correlated is semidefinite, that's fine
+  auto dependent = asymmetric;
+  dependent[4][5] = dependent[5][4] = 1.0;
+  EXPECT_NO_THROW(ElementCloud(iss_2024, dependent));
+}
+
+TEST(MonteCarloTest, MatchesBruteForce) {
+  const ElementCloud cloud(iss_2024, Correlated(), 11);
+  const auto times = Times();
+  constexpr std::size_t n = 3000;
+  const auto stats = PropagateMonteCarlo(cloud, times,
+                                         {.samples = n, .threads = 1});
+  ASSERT_EQ(stats.size(), times.size());
+
+  for (std::size_t t = 0; t < times.size(); ++t) {
+    Sgp4State state;
+    TemeState nominal;
+    ASSERT_EQ(InitSgp4(iss_2024, state), Sgp4Errc::kOk);
+    ASSERT_EQ(PropagateSgp4(state, MinutesSinceEpoch(state, times[t]),
+                            nominal),
+              Sgp4Errc::kOk);
+    std::vector<std::array<double, 6>> x;
+    std::vector<double> distances;
+    for (std::size_t i = 0; i < n; ++i) {
+      TemeState teme;
+      if (InitSgp4(cloud[i], state) != Sgp4Errc::kOk ||
+          PropagateSgp4(state, MinutesSinceEpoch(state, times[t]), teme) !=
+              Sgp4Errc::kOk) {
+        continue;
+      }
+      x.push_back(ToArray(teme));
+      distances.push_back(std::hypot(teme.position[0] - nominal.position[0],
+                                     teme.position[1] - nominal.position[1],
+                                     teme.position[2] - nominal.position[2]));
+    }
+    const auto &s = stats[t];
+    EXPECT_EQ(s.time, times[t]);
+    EXPECT_EQ(s.samples, x.size());
+    EXPECT_EQ(s.samples + s.failed, n);
+    EXPECT_EQ(ToArray(s.nominal), ToArray(nominal));
+
+    std::array<double, 6> mean{};
+    for (const auto &xi : x) {
+      for (std::size_t k = 0; k < 6; ++k) {
+        mean[k] += xi[k] / static_cast<double>(x.size());
+      }
+    }
+    for (std::size_t k = 0; k < 6; ++k) {
+      EXPECT_NEAR(s.mean[k], mean[k], 1e-9 * std::max(1.0, std::abs(mean[k])))
+          << t;
+      for (std::size_t l = 0; l < 6; ++l) {
+        double c = 0.0;
+        for (const auto &xi : x) {
+          c += (xi[k] - mean[k]) * (xi[l] - mean[l]);
+        }
+        c /= static_cast<double>(x.size() - 1);
+        EXPECT_NEAR(s.covariance[k][l], c, 1e-9 * std::max(1.0, std::abs(c)))
+            << t << " " << k << l;
+      }
+    }
+
+    // within the interpolation inside a bin
+    std::sort(distances.begin(), distances.end());
+    for (const double p : {0.1, 0.5, 0.9, 0.99}) {
+      const auto rank = static_cast<std::size_t>(
+          p * static_cast<double>(distances.size()));
+      const double expected = distances[std::min(rank, distances.size() - 1)];
+      EXPECT_NEAR(s.DistancePercentile(p) / expected, 1.0, 0.08)
+          << t << " " << p;
+    }
+  }
+}
+
+TEST(MonteCarloTest, AlongTrack) {
+  // a mean anomaly error spreads along the track, the median distance of
+  // a half normal is 0.674 sigma
+  constexpr double sigma_deg = 0.01;
+  const auto times = Times();
+  const auto stats = PropagateMonteCarlo(
+      iss_2024, ToCovariance({.mean_anomaly = sigma_deg}), times,
+      {.samples = 20000});
+  const auto &s = stats[0];
+  const double r = std::hypot(s.nominal.position[0], s.nominal.position[1],
+                              s.nominal.position[2]);
+  const double sigma_km = r * sigma_deg * std::numbers::pi / 180.0;
+  EXPECT_NEAR(s.DistancePercentile(0.5), 0.674 * sigma_km, 0.05 * sigma_km);
+  EXPECT_EQ(s.failed, 0U);
+
+  // a mean motion error makes the along track error grow
+  const auto growing = PropagateMonteCarlo(
+      iss_2024, ToCovariance({.mean_motion = 1e-5}), times, {.samples = 2000});
+  for (std::size_t t = 1; t < times.size(); ++t) {
+    EXPECT_GT(growing[t].DistancePercentile(0.5),
+              growing[t - 1].DistancePercentile(0.5));
+  }
+}
+
+TEST(MonteCarloTest, Threads) {
+  const ElementCloud cloud(iss_2024, Correlated());
+  const auto times = Times();
+  // a partial batch at the end
+  const auto one = PropagateMonteCarlo(cloud, times,
+                                       {.samples = 1000, .threads = 1});
+  const auto three = PropagateMonteCarlo(cloud, times,
+                                         {.samples = 1000, .threads = 3});
+  for (std::size_t t = 0; t < times.size(); ++t) {
+    EXPECT_EQ(one[t].samples, three[t].samples);
+    EXPECT_EQ(one[t].distance_histogram, three[t].distance_histogram);
+    for (std::size_t k = 0; k < 6; ++k) {
+      EXPECT_NEAR(one[t].mean[k], three[t].mean[k],
+                  1e-12 * std::max(1.0, std::abs(one[t].mean[k])));
+      for (std::size_t l = 0; l < 6; ++l) {
+        EXPECT_NEAR(one[t].covariance[k][l], three[t].covariance[k][l],
+                    1e-9 * std::abs(one[t].covariance[k][l]));
+      }
+    }
+  }
+
+  // fixed threads, same sums
+  const auto again = PropagateMonteCarlo(cloud, times,
+                                         {.samples = 1000, .threads = 3});
+  EXPECT_EQ(again[3].mean, three[3].mean);
+  EXPECT_EQ(again[3].covariance, three[3].covariance);
+
+  EXPECT_TRUE(PropagateMonteCarlo(cloud, {}, {}).empty());
+  const auto none = PropagateMonteCarlo(cloud, times, {.samples = 0});
+  EXPECT_EQ(none[0].samples, 0U);
+  EXPECT_TRUE(std::isnan(none[0].mean[0]));
+  EXPECT_TRUE(std::isnan(none[0].DistancePercentile(0.5)));
+}
+
+TEST(MonteCarloTest, NominalFails) {
+  Tle decayed = iss_2024;
+  decayed.line_2.mean_motion = 17.5;  // perigee below the Earth's surface
+  decayed.line_2.eccentricity = 0.02;
+  const auto stats = PropagateMonteCarlo(
+      decayed, ToCovariance({.mean_anomaly = 0.1}), Times(),
+      {.samples = 100});
+  for (const auto &s : stats) {
+    EXPECT_NE(s.nominal_errc, Sgp4Errc::kOk);
+    EXPECT_TRUE(std::isnan(s.DistancePercentile(0.5)));
+    EXPECT_EQ(s.samples + s.failed, 100U);
+  }
+}
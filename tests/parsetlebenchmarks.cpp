@@ -0,0 +1,145 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/tleview.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+namespace {
+constexpr int64_t tle_record_bytes = 139;
+
+/// @brief Synthetic feed where percent_malformed of the records have a
+/// corrupted line 1 checksum, spread evenly through the feed
+std::vector<std::string> MakeTleFeed(int percent_malformed) {
+  auto feed = CachedSynthTles(1000);
+  const auto size = static_cast<int>(feed.size());
+  const int malformed = size * percent_malformed / 100;
+  for (int i = 0; i < malformed; ++i) {
+    auto &checksum = feed[static_cast<size_t>(i * size / malformed)][68];
+    checksum = static_cast<char>('0' + (checksum - '0' + 1) % 10);
+  }
+  return feed;
+}
+
+void SetCatalogCounters(benchmark::State &state, size_t records) {
+  const auto items = state.iterations() * static_cast<int64_t>(records);
+  state.SetItemsProcessed(items);
+  state.SetBytesProcessed(items * tle_record_bytes);
+}
+
+/// LEO objects have periods below 128 minutes
+constexpr double leo_min_mean_motion = 11.25;  // revolutions per day
+}  // namespace
+
+static void BM_ParseTle(benchmark::State &state) {
+  const std::string s =
+      R"(1 25544U 98067A   24097.81509284  .00011771  00000-0  21418-3 0  9995
+2 25544  51.6405 309.2692 0004792  43.0163  63.5300 15.49960977447473)";
+
+  for (auto _ : state) {
+    auto tle = ParseTle(s);
+    benchmark::DoNotOptimize(tle);
+  }
+  SetCatalogCounters(state, 1);
+}
+BENCHMARK(BM_ParseTle);
+
+static void BM_ParseTleFeedThrowing(benchmark::State &state) {
+  const auto feed = MakeTleFeed(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    int rejected = 0;
+    for (const auto &str : feed) {
+      try {
+        auto tle = ParseTle(str);
+        benchmark::DoNotOptimize(tle);
+      } catch (const MyException<std::string> &e) {
+        ++rejected;
+      }
+    }
+    benchmark::DoNotOptimize(rejected);
+  }
+  SetCatalogCounters(state, feed.size());
+}
+BENCHMARK(BM_ParseTleFeedThrowing)->Arg(0)->Arg(1)->Arg(20);
+
+static void BM_ParseTleFeedTryParse(benchmark::State &state) {
+  const auto feed = MakeTleFeed(static_cast<int>(state.range(0)));
+  Tle tle;
+  for (auto _ : state) {
+    int rejected = 0;
+    for (const auto &str : feed) {
+      auto err = TryParseTle(str, tle);
+      rejected += err.ok() ? 0 : 1;
+      benchmark::DoNotOptimize(tle);
+    }
+    benchmark::DoNotOptimize(rejected);
+  }
+  SetCatalogCounters(state, feed.size());
+}
+BENCHMARK(BM_ParseTleFeedTryParse)->Arg(0)->Arg(1)->Arg(20);
+
+/// Each benchmark thread parses its own slice of the catalog
+static void BM_ParseCatalog(benchmark::State &state) {
+  const auto &tles = CachedSynthTles(static_cast<size_t>(state.range(0)));
+  const auto threads = static_cast<size_t>(state.threads());
+  const auto chunk = (tles.size() + threads - 1) / threads;
+  const auto first =
+      std::min(tles.size(), chunk * static_cast<size_t>(state.thread_index()));
+  const auto last = std::min(tles.size(), first + chunk);
+
+  Tle tle;
+  for (auto _ : state) {
+    for (size_t i = first; i < last; ++i) {
+      auto err = TryParseTle(tles[i], tle);
+      benchmark::DoNotOptimize(err);
+      benchmark::DoNotOptimize(tle);
+    }
+  }
+  SetCatalogCounters(state, last - first);
+}
+BENCHMARK(BM_ParseCatalog)
+    ->ArgName("size")
+    ->Arg(30000)
+    ->Arg(300000)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+static void BM_FilterLeoParseTle(benchmark::State &state) {
+  const auto &catalog = CachedSynthTles(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::vector<int> leo;
+    for (const auto &str : catalog) {
+      auto tle = ParseTle(str);
+      if (tle.line_2.mean_motion > leo_min_mean_motion) {
+        leo.push_back(tle.line_1.satellite_number);
+      }
+    }
+    benchmark::DoNotOptimize(leo);
+  }
+  SetCatalogCounters(state, catalog.size());
+}
+BENCHMARK(BM_FilterLeoParseTle)->Arg(30000);
+
+static void BM_FilterLeoTleView(benchmark::State &state) {
+  const auto &catalog = CachedSynthTles(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::vector<int> leo;
+    for (const auto &str : catalog) {
+      const TleView view(str);
+      if (view.mean_motion() > leo_min_mean_motion) {
+        leo.push_back(view.satellite_number());
+      }
+    }
+    benchmark::DoNotOptimize(leo);
+  }
+  SetCatalogCounters(state, catalog.size());
+}
+BENCHMARK(BM_FilterLeoTleView)->Arg(30000);
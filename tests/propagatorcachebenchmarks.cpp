@@ -0,0 +1,173 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "earthorbits/parsetle.h"
+#include "earthorbits/propagatorcache.h"
+#include "earthorbits/sgp4.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+namespace {
+/// @brief Near Earth objects of the synthetic catalog, SGP4 supports them
+std::vector<Tle> NearEarthCatalog(std::size_t size) {
+  std::vector<Tle> catalog;
+  Sgp4State state;
+  for (const auto &str : CachedSynthTles(size)) {
+    auto tle = ParseTle(str);
+    if (InitSgp4(tle, state) == Sgp4Errc::kOk) {
+      catalog.push_back(tle);
+    }
+  }
+  return catalog;
+}
+
+/// @brief Hit rate since warm, the stats after warming up the cache
+void SetCacheCounters(benchmark::State &state, const PropagatorCache &cache,
+                      const PropagatorCacheStats &warm = {}) {
+  const auto stats = cache.Stats();
+  const auto hits = stats.hits - warm.hits;
+  const auto misses = stats.misses - warm.misses;
+  state.counters["hit_rate"] =
+      static_cast<double>(hits) /
+      static_cast<double>(std::max<std::uint64_t>(hits + misses, 1));
+  state.counters["bytes_per_satellite"] =
+      static_cast<double>(PropagatorCache::bytes_per_entry());
+}
+}  // namespace
+
+static void BM_Sgp4Init(benchmark::State &state) {
+  const auto catalog = NearEarthCatalog(1000);
+  Sgp4State s;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto err = InitSgp4(catalog[i++ % catalog.size()], s);
+    benchmark::DoNotOptimize(err);
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Sgp4Init);
+
+static void BM_Sgp4Propagate(benchmark::State &state) {
+  const auto catalog = NearEarthCatalog(1000);
+  std::vector<Sgp4State> states(catalog.size());
+  for (std::size_t i = 0; i < catalog.size(); ++i) {
+    static_cast<void>(InitSgp4(catalog[i], states[i]));
+  }
+  TemeState teme;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto err = PropagateSgp4(states[i++ % states.size()], 720.0, teme);
+    benchmark::DoNotOptimize(err);
+    benchmark::DoNotOptimize(teme);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Sgp4Propagate);
+
+/// Whole catalog to one time, in double and in single precision
+template <typename T>
+static void BM_Sgp4PropagateBatch(benchmark::State &state) {
+  const auto catalog =
+      NearEarthCatalog(static_cast<std::size_t>(state.range(0)));
+  std::vector<BasicSgp4State<T>> states;
+  Sgp4State s;
+  for (const auto &tle : catalog) {
+    static_cast<void>(InitSgp4(tle, s));
+    if constexpr (std::is_same_v<T, double>) {
+      states.push_back(s);
+    } else {
+      states.push_back(ToSinglePrecision(s));
+    }
+  }
+  std::vector<BasicTemeState<T>> teme(states.size());
+  std::vector<Sgp4Errc> errors(states.size());
+  auto tp = states.front().epoch;
+  for (auto _ : state) {
+    PropagateSgp4(states, tp, teme, errors);
+    benchmark::DoNotOptimize(teme.data());
+    tp += std::chrono::minutes(1);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(states.size()));
+  state.counters["state_bytes"] =
+      static_cast<double>(sizeof(BasicSgp4State<T>));
+}
+BENCHMARK_TEMPLATE(BM_Sgp4PropagateBatch, double)->Arg(30000);
+BENCHMARK_TEMPLATE(BM_Sgp4PropagateBatch, float)->Arg(30000);
+
+/// Initialize then propagate on every query, what the cache avoids
+static void BM_Sgp4InitAndPropagate(benchmark::State &state) {
+  const auto catalog = NearEarthCatalog(1000);
+  Sgp4State s;
+  TemeState teme;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    static_cast<void>(InitSgp4(catalog[i++ % catalog.size()], s));
+    auto err = PropagateSgp4(s, 720.0, teme);
+    benchmark::DoNotOptimize(err);
+    benchmark::DoNotOptimize(teme);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Sgp4InitAndPropagate);
+
+/// Working set fits in the cache, every lookup after the first pass hits
+static void BM_PropagatorCacheHit(benchmark::State &state) {
+  const auto catalog =
+      NearEarthCatalog(static_cast<std::size_t>(state.range(0)));
+  static PropagatorCache *cache = nullptr;
+  static PropagatorCacheStats warm;
+  if (state.thread_index() == 0) {
+    cache = new PropagatorCache(catalog.size());
+    Sgp4State s;
+    for (const auto &tle : catalog) {
+      static_cast<void>(cache->Get(tle, s));
+    }
+    warm = cache->Stats();
+  }
+  TemeState teme;
+  auto i = static_cast<std::size_t>(state.thread_index()) * 7919;
+  for (auto _ : state) {
+    auto err = cache->Propagate(catalog[i++ % catalog.size()], 720.0, teme);
+    benchmark::DoNotOptimize(err);
+    benchmark::DoNotOptimize(teme);
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    SetCacheCounters(state, *cache, warm);
+    delete cache;
+    cache = nullptr;
+  }
+}
+BENCHMARK(BM_PropagatorCacheHit)
+    ->ArgName("satellites")
+    ->Arg(1000)
+    ->Arg(30000)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+/// Working set cycles through a cache a tenth its size, every lookup misses
+/// and evicts
+static void BM_PropagatorCacheMiss(benchmark::State &state) {
+  const auto catalog =
+      NearEarthCatalog(static_cast<std::size_t>(state.range(0)));
+  PropagatorCache cache(catalog.size() / 10);
+  TemeState teme;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto err = cache.Propagate(catalog[i++ % catalog.size()], 720.0, teme);
+    benchmark::DoNotOptimize(err);
+    benchmark::DoNotOptimize(teme);
+  }
+  state.SetItemsProcessed(state.iterations());
+  SetCacheCounters(state, cache);
+}
+BENCHMARK(BM_PropagatorCacheMiss)->ArgName("satellites")->Arg(30000);
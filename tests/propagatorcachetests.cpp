@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "earthorbits/parsetle.h"
+#include "earthorbits/propagatorcache.h"
+#include "earthorbits/sgp4.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+/// @brief iss_2008 with another element number, a distinct key
+Tle ElementSet(int element_number) {
+  auto tle = iss_2008;
+  tle.line_1.element_number = element_number;
+  return tle;
+}
+}  // namespace
+
+TEST(PropagatorCacheTest, HitsAndMisses) {
+  PropagatorCache cache(8);
+  Sgp4State state;
+  ASSERT_EQ(cache.Get(iss_2008, state), Sgp4Errc::kOk);
+  ASSERT_EQ(cache.Get(iss_2008, state), Sgp4Errc::kOk);
+  EXPECT_TRUE(cache.Contains(MakePropagatorKey(iss_2008)));
+  EXPECT_FALSE(cache.Contains(MakePropagatorKey(ElementSet(1))));
+
+  const auto stats = cache.Stats();
+  EXPECT_EQ(stats.hits, 1U);
+  EXPECT_EQ(stats.misses, 1U);
+  EXPECT_EQ(stats.size, 1U);
+  EXPECT_GE(stats.capacity, 8U);
+  EXPECT_EQ(stats.bytes, PropagatorCache::bytes_per_entry());
+
+  Sgp4State expected;
+  ASSERT_EQ(InitSgp4(iss_2008, expected), Sgp4Errc::kOk);
+  TemeState cached;
+  TemeState direct;
+  ASSERT_EQ(cache.Propagate(iss_2008, 100.0, cached), Sgp4Errc::kOk);
+  ASSERT_EQ(PropagateSgp4(expected, 100.0, direct), Sgp4Errc::kOk);
+  EXPECT_EQ(cached.position, direct.position);
+  EXPECT_EQ(cached.velocity, direct.velocity);
+
+  cache.Clear();
+  EXPECT_FALSE(cache.Contains(MakePropagatorKey(iss_2008)));
+  EXPECT_EQ(cache.Stats().size, 0U);
+}
+
+TEST(PropagatorCacheTest, EvictsLeastRecentlyUsed) {
+  PropagatorCache cache(3, 1);
+  Sgp4State state;
+  for (int i = 1; i <= 3; ++i) {
+    ASSERT_EQ(cache.Get(ElementSet(i), state), Sgp4Errc::kOk);
+  }
+  // touch 1 so 2 is the least recently used
+  ASSERT_EQ(cache.Get(ElementSet(1), state), Sgp4Errc::kOk);
+  ASSERT_EQ(cache.Get(ElementSet(4), state), Sgp4Errc::kOk);
+
+  EXPECT_TRUE(cache.Contains(MakePropagatorKey(ElementSet(1))));
+  EXPECT_FALSE(cache.Contains(MakePropagatorKey(ElementSet(2))));
+  EXPECT_TRUE(cache.Contains(MakePropagatorKey(ElementSet(3))));
+  EXPECT_TRUE(cache.Contains(MakePropagatorKey(ElementSet(4))));
+  EXPECT_EQ(cache.Stats().evictions, 1U);
+  EXPECT_EQ(cache.Stats().size, 3U);
+}
+
+TEST(PropagatorCacheTest, ErrorsAreNotCached) {
+  PropagatorCache cache(4);
+  auto invalid = iss_2008;
+  invalid.line_2.eccentricity = 1.5;
+  Sgp4State state;
+  EXPECT_EQ(cache.Get(invalid, state), Sgp4Errc::kInvalidElements);
+  EXPECT_FALSE(cache.Contains(MakePropagatorKey(invalid)));
+  EXPECT_EQ(cache.Stats().size, 0U);
+}
+
+TEST(PropagatorCacheTest, Move) {
+  PropagatorCache cache(8);
+  Sgp4State state;
+  ASSERT_EQ(cache.Get(iss_2008, state), Sgp4Errc::kOk);
+  PropagatorCache moved(std::move(cache));
+  EXPECT_TRUE(moved.Contains(MakePropagatorKey(iss_2008)));
+  // NOLINTBEGIN(bugprone-use-after-move)
+  EXPECT_EQ(cache.Stats().size, 0U);
+  EXPECT_EQ(cache.Stats().capacity, 0U);
+  cache.Clear();
+  cache = std::move(moved);
+  EXPECT_TRUE(cache.Contains(MakePropagatorKey(iss_2008)));
+  EXPECT_EQ(moved.Stats().capacity, 0U);
+  // NOLINTEND(bugprone-use-after-move)
+}
+
+TEST(PropagatorCacheTest, ConcurrentAccess) {
+  constexpr int thread_count = 8;
+  constexpr int keys = 64;
+  // large enough to keep 4 shards of the minimum shard capacity
+  PropagatorCache cache(4 * 256, 4);
+  std::vector<int> failures(thread_count, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_count; ++t) {
+    threads.emplace_back([&cache, &failures, t] {
+      Sgp4State state;
+      for (int i = 0; i < 1000; ++i) {
+        const auto tle = ElementSet((i * 7 + t) % keys);
+        if (cache.Get(tle, state) != Sgp4Errc::kOk) {
+          ++failures[static_cast<std::size_t>(t)];
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (const auto count : failures) {
+    EXPECT_EQ(count, 0);
+  }
+  const auto stats = cache.Stats();
+  EXPECT_EQ(stats.size, static_cast<std::size_t>(keys));
+  EXPECT_EQ(stats.hits + stats.misses, 8000U);
+  EXPECT_LE(stats.size, stats.capacity);
+}
@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <vector>
+
+#include "date/date.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "synthcatalog.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+/// Test case 00005 of the SGP4 verification set
+/// @see https://celestrak.org/publications/AIAA/2006-6753/
+const Tle vanguard = ParseTle(
+    R"(1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753
+2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667)");
+
+void ExpectNear(const std::array<double, 3> &actual,
+                const std::array<double, 3> &expected, double tolerance) {
+  for (std::size_t i = 0; i < 3; ++i) {
+    EXPECT_NEAR(actual[i], expected[i], tolerance) << "component " << i;
+  }
+}
+}  // namespace
+
+TEST(Sgp4Test, VerificationCase00005) {
+  Sgp4State state;
+  ASSERT_EQ(InitSgp4(vanguard, state), Sgp4Errc::kOk);
+
+  TemeState teme;
+  ASSERT_EQ(PropagateSgp4(state, 0.0, teme), Sgp4Errc::kOk);
+  ExpectNear(teme.position, {7022.46529266, -1400.08296755, 0.03995155}, 1e-6);
+  ExpectNear(teme.velocity, {1.893841015, 6.405893759, 4.534807250}, 1e-9);
+
+  ASSERT_EQ(PropagateSgp4(state, 360.0, teme), Sgp4Errc::kOk);
+  ExpectNear(teme.position, {-7154.03120202, -3783.17682504, -3536.19412294},
+             1e-6);
+  ExpectNear(teme.velocity, {4.741887409, -4.151817765, -2.093935425}, 1e-9);
+
+  ASSERT_EQ(PropagateSgp4(state, 720.0, teme), Sgp4Errc::kOk);
+  ExpectNear(teme.position, {-7134.59340119, 6531.68641334, 3260.27186483},
+             1e-6);
+}
+
+TEST(Sgp4Test, VerificationCase08195) {
+  // Molniya 2-14, 12 hour resonance
+  const Tle molniya = ParseTle(
+      R"(1 08195U 75081A   06176.33215444  .00000099  00000-0  11873-3 0   813
+2 08195  64.1586 279.0717 6877146 264.7651  20.2257  2.00491383225656)");
+  Sgp4State state;
+  ASSERT_EQ(InitSgp4(molniya, state), Sgp4Errc::kOk);
+  EXPECT_TRUE(state.deep_space);
+  EXPECT_EQ(state.deep.irez, 2);
+
+  struct Expected {
+    double minutes;
+    std::array<double, 3> position;
+    std::array<double, 3> velocity;
+  };
+  const std::array<Expected, 4> expected{{
+      {0.0,
+       {2349.89483350, -14785.93811562, 0.02119378},
+       {2.721488096, -3.256811655, 4.498416672}},
+      {120.0,
+       {15223.91713658, -17852.95881713, 25280.39558224},
+       {1.079041732, 0.875187372, 2.485682813}},
+      {240.0,
+       {19752.78050009, -8600.07130962, 37522.72921090},
+       {0.238105279, 1.546110924, 0.986410447}},
+      {360.0,
+       {19089.29762968, 3107.89495018, 39958.14661370},
+       {-0.410308034, 1.640332277, -0.306873818}},
+  }};
+  TemeState teme;
+  for (const auto &e : expected) {
+    SCOPED_TRACE(e.minutes);
+    ASSERT_EQ(PropagateSgp4(state, e.minutes, teme), Sgp4Errc::kOk);
+    ExpectNear(teme.position, e.position, 1e-6);
+    ExpectNear(teme.velocity, e.velocity, 1e-9);
+  }
+
+  // the resonance keeps the osculating semi-major axis of a 12 hour orbit
+  for (int hour = 6; hour <= 10 * 24; hour += 6) {
+    ASSERT_EQ(PropagateSgp4(state, 60.0 * hour, teme), Sgp4Errc::kOk);
+    const auto &r = teme.position;
+    const auto &v = teme.velocity;
+    const double a =
+        1.0 / (2.0 / std::hypot(r[0], r[1], r[2]) -
+               (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]) / 398600.8);
+    EXPECT_NEAR(a, 26560.0, 100.0) << hour;
+  }
+}
+
+TEST(Sgp4Test, GeostationaryResonance) {
+  // test case 28626 of the verification set, a geostationary satellite
+  const Tle geo = ParseTle(
+      R"(1 28626U 05008A   06176.46683397 -.00000205  00000-0  10000-3 0  2190
+2 28626   0.0019 286.9433 0000335  13.7918  55.6504  1.00270176  4891)");
+  Sgp4State state;
+  ASSERT_EQ(InitSgp4(geo, state), Sgp4Errc::kOk);
+  EXPECT_TRUE(state.deep_space);
+  EXPECT_EQ(state.deep.irez, 1);
+
+  // stays over the same longitude, drifting slowly since its mean motion
+  // is a little below that of the Earth, which turns from the sidereal
+  // angle at the epoch at 7.29211514670698e-5 rad/s
+  const auto longitude = [&state](double minutes) {
+    TemeState teme;
+    EXPECT_EQ(PropagateSgp4(state, minutes, teme), Sgp4Errc::kOk);
+    const double earth =
+        state.deep.gsto + 7.29211514670698e-5 * 60.0 * minutes;
+    const double lon =
+        std::remainder(std::atan2(teme.position[1], teme.position[0]) - earth,
+                       2.0 * std::numbers::pi);
+    return lon * 180.0 / std::numbers::pi;
+  };
+  const double start = longitude(0.0);
+  for (int hour = 0; hour <= 10 * 24; hour += 12) {
+    SCOPED_TRACE(hour);
+    TemeState teme;
+    ASSERT_EQ(PropagateSgp4(state, 60.0 * hour, teme), Sgp4Errc::kOk);
+    const auto &r = teme.position;
+    EXPECT_NEAR(std::hypot(r[0], r[1], r[2]), 42164.7, 5.0);
+    EXPECT_LT(std::abs(r[2]), 20.0);
+    EXPECT_NEAR(longitude(60.0 * hour), start, 0.25);
+  }
+  EXPECT_LT(longitude(10.0 * 1440.0), start);
+
+  // the one day resonance accelerates the longitude, so without it the
+  // positions part quadratically in time
+  auto without = state;
+  without.deep.del1 = 0.0;
+  without.deep.del2 = 0.0;
+  without.deep.del3 = 0.0;
+  const auto apart = [&](double minutes) {
+    TemeState a;
+    TemeState b;
+    EXPECT_EQ(PropagateSgp4(state, minutes, a), Sgp4Errc::kOk);
+    EXPECT_EQ(PropagateSgp4(without, minutes, b), Sgp4Errc::kOk);
+    return std::hypot(a.position[0] - b.position[0],
+                      a.position[1] - b.position[1],
+                      a.position[2] - b.position[2]);
+  };
+  EXPECT_EQ(apart(0.0), 0.0);
+  EXPECT_GT(apart(5.0 * 1440.0), 1.0);
+  EXPECT_NEAR(apart(10.0 * 1440.0) / apart(5.0 * 1440.0), 4.0, 0.5);
+}
+
+TEST(Sgp4Test, TleEpoch) {
+  using namespace date;
+  using namespace std::chrono;
+  // day 179.78495062 of 2000 is June 27, 18:50:19.733568
+  const auto expected =
+      date::sys_days{2000_y / date::June / 27} + 18h + 50min + 19s + 733568us;
+  EXPECT_EQ(TleEpoch(vanguard.line_1), expected);
+
+  Sgp4State state;
+  ASSERT_EQ(InitSgp4(vanguard, state), Sgp4Errc::kOk);
+  EXPECT_DOUBLE_EQ(MinutesSinceEpoch(state, expected + 90min), 90.0);
+
+  auto line_1 = vanguard.line_1;
+  line_1.epoch_year = 57;
+  line_1.epoch_day = 1.0;
+  EXPECT_EQ(TleEpoch(line_1), date::sys_days{1957_y / date::jan / 1});
+}
+
+TEST(Sgp4Test, Errors) {
+  Sgp4State state;
+  EXPECT_EQ(to_string(Sgp4Errc::kPerturbedEccentricityOutOfRange),
+            "perturbed eccentricity out of range");
+
+  auto invalid = vanguard;
+  invalid.line_2.mean_motion = 0.0;
+  EXPECT_EQ(InitSgp4(invalid, state), Sgp4Errc::kInvalidElements);
+
+  // strong drag, the orbit decays within weeks
+  auto decaying = iss_2008;
+  decaying.line_1.bstar_drag = 0.01;
+  ASSERT_EQ(InitSgp4(decaying, state), Sgp4Errc::kOk);
+  TemeState teme;
+  EXPECT_EQ(PropagateSgp4(state, 1440.0, teme), Sgp4Errc::kOk);
+  EXPECT_NE(PropagateSgp4(state, 60.0 * 1440.0, teme), Sgp4Errc::kOk);
+}
+
+TEST(Sgp4Test, SinglePrecision) {
+  std::vector<Sgp4State> states;
+  Sgp4State state;
+  for (const auto &str : MakeSynthTles({.size = 300})) {
+    if (InitSgp4(ParseTle(str), state) == Sgp4Errc::kOk) {
+      states.push_back(state);
+    }
+  }
+  ASSERT_GT(states.size(), 150U);
+  std::vector<Sgp4StateF> states_f;
+  for (const auto &s : states) {
+    states_f.push_back(ToSinglePrecision(s));
+  }
+
+  // hourly for a week after each epoch
+  double max_position_error = 0.0;
+  double max_velocity_error = 0.0;
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    TemeState teme;
+    TemeStateF teme_f;
+    for (int hour = 0; hour <= 7 * 24; ++hour) {
+      const double minutes = 60.0 * hour;
+      if (PropagateSgp4(states[i], minutes, teme) != Sgp4Errc::kOk) {
+        break;
+      }
+      ASSERT_EQ(PropagateSgp4(states_f[i], minutes, teme_f), Sgp4Errc::kOk);
+      const auto &r = teme.position;
+      const auto &rf = teme_f.position;
+      max_position_error = std::max(
+          max_position_error,
+          std::hypot(rf[0] - r[0], rf[1] - r[1], rf[2] - r[2]));
+      const auto &v = teme.velocity;
+      const auto &vf = teme_f.velocity;
+      max_velocity_error = std::max(
+          max_velocity_error,
+          std::hypot(vf[0] - v[0], vf[1] - v[1], vf[2] - v[2]));
+    }
+  }
+  // ~250 m and 0.3 m/s for this catalog
+  EXPECT_LT(max_position_error, 0.5);
+  EXPECT_LT(max_velocity_error, 1e-3);
+}
+
+TEST(Sgp4Test, Batch) {
+  std::vector<Sgp4State> states;
+  Sgp4State state;
+  for (const auto &str : MakeSynthTles({.size = 100})) {
+    if (InitSgp4(ParseTle(str), state) == Sgp4Errc::kOk) {
+      states.push_back(state);
+    }
+  }
+  std::vector<Sgp4StateF> states_f;
+  for (const auto &s : states) {
+    states_f.push_back(ToSinglePrecision(s));
+  }
+  const auto tp = states.front().epoch + std::chrono::hours(30);
+
+  std::vector<TemeState> teme(states.size());
+  std::vector<Sgp4Errc> errors(states.size());
+  PropagateSgp4(states, tp, teme, errors);
+  std::vector<TemeStateF> teme_f(states.size());
+  std::vector<Sgp4Errc> errors_f(states.size());
+  PropagateSgp4(states_f, tp, teme_f, errors_f);
+
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    TemeState single{};
+    EXPECT_EQ(
+        PropagateSgp4(states[i], MinutesSinceEpoch(states[i], tp), single),
+        errors[i]);
+    if (errors[i] == Sgp4Errc::kOk) {
+      EXPECT_EQ(single.position, teme[i].position);
+    }
+    TemeStateF single_f{};
+    EXPECT_EQ(PropagateSgp4(states_f[i], MinutesSinceEpoch(states_f[i], tp),
+                            single_f),
+              errors_f[i]);
+    if (errors_f[i] == Sgp4Errc::kOk) {
+      EXPECT_EQ(single_f.position, teme_f[i].position);
+    }
+  }
+}
@@ -0,0 +1,183 @@
+#include <benchmark/benchmark.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/sharedcatalog.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+namespace {
+constexpr std::size_t catalog_size = 20000;
+
+/// @brief Memory of the process, KiB: pages only it has written to and
+/// resident shared memory
+struct Rss {
+  double private_dirty = 0.0;
+  double shmem = 0.0;
+};
+
+/// @brief Value of the line starting with key in a /proc file, KiB
+double ProcKib(const std::string &path, const std::string &key) {
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream fields(line);
+    std::string name;
+    double kib = 0.0;
+    fields >> name >> kib;
+    if (name == key) {
+      return kib;
+    }
+  }
+  return 0.0;
+}
+
+Rss ReadRss() {
+  return {.private_dirty = ProcKib("/proc/self/smaps_rollup", "Private_Dirty:"),
+          .shmem = ProcKib("/proc/self/status", "RssShmem:")};
+}
+
+/// @brief Increase of the memory of a forked worker process by what load
+/// returns, kept alive while measuring
+///
+/// Pages of the parent are shared with the worker until it writes to them,
+/// so private dirty pages count what the worker itself allocated.
+template <typename F>
+Rss WorkerRss(const F &load) {
+  std::array<int, 2> fds{};
+  if (::pipe(fds.data()) != 0) {
+    return {};
+  }
+  const pid_t pid = ::fork();
+  if (pid == 0) {
+    const auto before = ReadRss();
+    const auto kept = load();
+    benchmark::DoNotOptimize(&kept);
+    const auto after = ReadRss();
+    const Rss delta{.private_dirty = after.private_dirty - before.private_dirty,
+                    .shmem = after.shmem - before.shmem};
+    const bool written = ::write(fds[1], &delta, sizeof(delta)) ==
+                         static_cast<ssize_t>(sizeof(delta));
+    ::_exit(written ? 0 : 1);
+  }
+  Rss delta;
+  if (pid < 0 || ::read(fds[0], &delta, sizeof(delta)) !=
+                     static_cast<ssize_t>(sizeof(delta))) {
+    delta = {};
+  }
+  if (pid > 0) {
+    ::waitpid(pid, nullptr, 0);
+  }
+  ::close(fds[0]);
+  ::close(fds[1]);
+  return delta;
+}
+
+void SetRssCounters(benchmark::State &state, const Rss &worker) {
+  state.counters["worker_private_kib"] = worker.private_dirty;
+  state.counters["worker_shmem_kib"] = worker.shmem;
+}
+
+/// @brief The catalog published once for all benchmarks, removed at exit
+struct Published {
+  Published() : name{"/eobsharedcatalogbench_" + std::to_string(::getpid())} {
+    std::vector<Tle> tles;
+    for (const auto &str : CachedSynthTles(catalog_size)) {
+      tles.push_back(ParseTle(str));
+    }
+    SharedCatalogPublisher(name).Publish(tles);
+  }
+  ~Published() { RemoveSharedCatalog(name); }
+  Published(const Published &) = delete;
+  Published &operator=(const Published &) = delete;
+  Published(Published &&) = delete;
+  Published &operator=(Published &&) = delete;
+
+  std::string name;
+};
+
+const std::string &PublishedName() {
+  static const Published published;
+  return published.name;
+}
+
+/// @brief Touch every state as a worker propagating all of them would
+double TouchStates(std::span<const Sgp4State> states) {
+  double sum = 0.0;
+  for (const auto &s : states) {
+    sum += s.mean_motion;
+  }
+  return sum;
+}
+}  // namespace
+
+/// A worker attaching to the published catalog
+static void BM_AttachSharedCatalog(benchmark::State &state) {
+  const auto &name = PublishedName();
+  auto load = [&name] {
+    SharedCatalog catalog(name);
+    benchmark::DoNotOptimize(TouchStates(catalog.states()));
+    return catalog;
+  };
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(load());
+  }
+  // another worker has it mapped, so its pages count as shared
+  const auto other_worker = load();
+  SetRssCounters(state, WorkerRss(load));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AttachSharedCatalog)->Unit(benchmark::kMicrosecond);
+
+/// @brief A private copy of the catalog, parsed and initialized
+struct PrivateCatalog {
+  std::vector<Tle> tles;
+  std::vector<Sgp4State> states;
+};
+
+/// A worker parsing and initializing its own copy of the catalog
+static void BM_PrivateCatalogCopy(benchmark::State &state) {
+  const auto &text = CachedSynthTles(catalog_size);
+  auto load = [&text] {
+    PrivateCatalog catalog;
+    catalog.tles.reserve(text.size());
+    catalog.states.reserve(text.size());
+    Tle tle;
+    Sgp4State s;
+    for (const auto &str : text) {
+      if (TryParseTle(str, tle).ok() && InitSgp4(tle, s) == Sgp4Errc::kOk) {
+        catalog.tles.push_back(tle);
+        catalog.states.push_back(s);
+      }
+    }
+    benchmark::DoNotOptimize(TouchStates(catalog.states));
+    return catalog;
+  };
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(load());
+  }
+  SetRssCounters(state, WorkerRss(load));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PrivateCatalogCopy)->Unit(benchmark::kMillisecond);
+
+/// Checking for a new generation, what a worker does between requests
+static void BM_SharedCatalogStale(benchmark::State &state) {
+  const SharedCatalog catalog(PublishedName());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(catalog.Stale());
+  }
+}
+BENCHMARK(BM_SharedCatalogStale);
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/sharedcatalog.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+namespace {
+/// @brief A name no other test process uses
+std::string CatalogName(const std::string &test) {
+  return "/eobsharedcatalogtest_" + test + "_" + std::to_string(::getpid());
+}
+
+std::vector<Tle> Catalog(std::size_t size, std::uint64_t seed) {
+  std::vector<Tle> tles;
+  for (const auto &str : MakeSynthTles({.size = size, .seed = seed})) {
+    tles.push_back(ParseTle(str));
+  }
+  return tles;
+}
+
+/// @brief What a worker should see, the states SGP4 can be initialized
+/// for by satellite number
+std::map<std::uint32_t, Sgp4State> Expected(const std::vector<Tle> &tles) {
+  std::map<std::uint32_t, Sgp4State> expected;
+  Sgp4State state;
+  for (const auto &tle : tles) {
+    if (InitSgp4(tle, state) == Sgp4Errc::kOk) {
+      expected[static_cast<std::uint32_t>(tle.line_1.satellite_number)] =
+          state;
+    }
+  }
+  return expected;
+}
+
+/// @brief Whether catalog holds exactly the expected states, bitwise
+bool Matches(const SharedCatalog &catalog,
+             const std::map<std::uint32_t, Sgp4State> &expected) {
+  if (catalog.size() != expected.size()) {
+    return false;
+  }
+  std::size_t i = 0;
+  for (const auto &[number, state] : expected) {
+    if (catalog.satellite_numbers()[i] != number ||
+        std::memcmp(&catalog.states()[i], &state, sizeof(Sgp4State)) != 0 ||
+        ParseTle(std::string(catalog.tle(i))).line_1.satellite_number !=
+            static_cast<int>(number)) {
+      return false;
+    }
+    ++i;
+  }
+  return true;
+}
+}  // namespace
+
+TEST(SharedCatalogTest, PublishAndAttach) {
+  const auto name = CatalogName("attach");
+  auto tles = Catalog(300, 1);
+  // one SGP4 can't be initialized for is skipped
+  tles[7].line_2.eccentricity = 1.5;
+  const auto expected = Expected(tles);
+  ASSERT_EQ(expected.size(), 299U);
+  // an older element set of a satellite is dropped
+  auto older = tles[5];
+  older.line_1.epoch_day -= 3.0;
+  older.line_2.mean_motion += 0.01;
+  tles.push_back(older);
+
+  SharedCatalogPublisher publisher(name);
+  EXPECT_EQ(publisher.generation(), 0U);
+  EXPECT_EQ(publisher.Publish(tles), expected.size());
+  EXPECT_EQ(publisher.generation(), 1U);
+
+  const SharedCatalog catalog(name);
+  EXPECT_EQ(catalog.generation(), 1U);
+  EXPECT_FALSE(catalog.Stale());
+  EXPECT_TRUE(Matches(catalog, expected));
+  EXPECT_GT(catalog.bytes(), catalog.size() * sizeof(Sgp4State));
+
+  const auto number = expected.rbegin()->first;
+  ASSERT_TRUE(catalog.Find(number).has_value());
+  EXPECT_EQ(*catalog.Find(number), catalog.size() - 1);
+  EXPECT_FALSE(catalog.Find(99999).has_value());
+
+  // the states propagate in place
+  std::vector<TemeState> teme(catalog.size());
+  std::vector<Sgp4Errc> errors(catalog.size());
+  PropagateSgp4(catalog.states(), catalog.states()[0].epoch, teme, errors);
+  EXPECT_EQ(errors[0], Sgp4Errc::kOk);
+  RemoveSharedCatalog(name);
+}
+
+TEST(SharedCatalogTest, WorkerProcesses) {
+  const auto name = CatalogName("workers");
+  const auto first = Catalog(200, 2);
+  const auto second = Catalog(120, 3);
+  const auto expected_first = Expected(first);
+  const auto expected_second = Expected(second);
+  SharedCatalogPublisher publisher(name);
+  publisher.Publish(first);
+
+  // workers report attaching on `attached` and wait for a byte on `go`
+  // before checking for the next generation
+  std::array<int, 2> attached{};
+  std::array<int, 2> go{};
+  ASSERT_EQ(::pipe(attached.data()), 0);
+  ASSERT_EQ(::pipe(go.data()), 0);
+  constexpr int workers = 4;
+  std::vector<pid_t> pids;
+  for (int w = 0; w < workers; ++w) {
+    const pid_t pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      bool ok = false;
+      try {
+        SharedCatalog catalog(name);
+        ok = catalog.generation() == 1 && Matches(catalog, expected_first);
+        char byte = 'a';
+        ok = ::write(attached[1], &byte, 1) == 1 && ok;
+        ok = ::read(go[0], &byte, 1) == 1 && ok;
+        // the old generation is unlinked but stays mapped
+        ok = ok && catalog.Stale() && Matches(catalog, expected_first);
+        ok = ok && catalog.Refresh() && catalog.generation() == 2 &&
+             !catalog.Stale() && Matches(catalog, expected_second);
+        ok = ok && !catalog.Refresh();
+      } catch (...) {
+        ok = false;
+      }
+      ::_exit(ok ? 0 : 1);
+    }
+    pids.push_back(pid);
+  }
+  for (int w = 0; w < workers; ++w) {
+    char byte = 0;
+    ASSERT_EQ(::read(attached[0], &byte, 1), 1);
+  }
+  publisher.Publish(second);
+  for (int w = 0; w < workers; ++w) {
+    const char byte = 'g';
+    ASSERT_EQ(::write(go[1], &byte, 1), 1);
+  }
+  for (const auto pid : pids) {
+    int status = 0;
+    ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+  for (const int fd : {attached[0], attached[1], go[0], go[1]}) {
+    ::close(fd);
+  }
+
+  // a new publisher continues the generations
+  SharedCatalogPublisher restarted(name);
+  EXPECT_EQ(restarted.generation(), 2U);
+  restarted.Publish(first);
+  EXPECT_EQ(SharedCatalog(name).generation(), 3U);
+  RemoveSharedCatalog(name);
+}
+
+TEST(SharedCatalogTest, Errors) {
+  const auto name = CatalogName("errors");
+  EXPECT_THROW(SharedCatalog{name}, MyException<std::string>);
+  EXPECT_THROW(SharedCatalog{"no_slash"}, MyException<std::string>);
+  EXPECT_THROW(SharedCatalogPublisher{"/a/b"}, MyException<std::string>);
+  {
+    // created but nothing published yet
+    const SharedCatalogPublisher publisher(name);
+    EXPECT_THROW(SharedCatalog{name}, MyException<std::string>);
+  }
+  {
+    SharedCatalogPublisher publisher(name);
+    publisher.Publish(Catalog(10, 4));
+    const SharedCatalog catalog(name);
+    RemoveSharedCatalog(name);
+    EXPECT_THROW(SharedCatalog{name}, MyException<std::string>);
+    // still mapped
+    EXPECT_GT(catalog.size(), 0U);
+    EXPECT_FALSE(catalog.tle(0).empty());
+  }
+}
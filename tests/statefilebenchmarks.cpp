@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+#include <fmt/core.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "date/date.h"
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/statefile.h"
+#include "synthcatalog.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+/// @brief A day at one minute steps of each of `objects` synthetic
+/// satellites, object after object
+std::vector<StateRecord> MakeRecords(std::size_t objects) {
+  using namespace std::chrono;
+  const system_clock::time_point start =
+      date::sys_days{date::year{2024} / date::January / 1};
+  std::vector<StateRecord> records;
+  for (const auto &tle : CachedSynthTles(objects)) {
+    const auto parsed = ParseTle(tle);
+    Sgp4State state;
+    if (InitSgp4(parsed, state) != Sgp4Errc::kOk) {
+      continue;
+    }
+    for (int i = 0; i < 1440; ++i) {
+      StateRecord r{.time = start + minutes(i),
+                    .object = static_cast<std::uint32_t>(
+                        parsed.line_1.satellite_number),
+                    .state = {}};
+      if (PropagateSgp4(state, MinutesSinceEpoch(state, r.time), r.state) ==
+          Sgp4Errc::kOk) {
+        records.push_back(r);
+      }
+    }
+  }
+  return records;
+}
+
+const std::vector<StateRecord> &Records() {
+  static const auto records = MakeRecords(20);
+  return records;
+}
+}  // namespace
+
+/// Text lines as an application would write them without the state file
+static void BM_WriteStatesText(benchmark::State &state) {
+  const auto &records = Records();
+  const auto path = TempPath("eobstatefilebench.txt");
+  std::uint64_t bytes = 0;
+  for (auto _ : state) {
+    std::ofstream file(path, std::ios::trunc);
+    bytes = 0;
+    for (const auto &r : records) {
+      const auto line = fmt::format(
+          "{} {} {} {} {} {} {} {}\n", to_string(r.time), r.object,
+          r.state.position[0], r.state.position[1], r.state.position[2],
+          r.state.velocity[0], r.state.velocity[1], r.state.velocity[2]);
+      file << line;
+      bytes += line.size();
+    }
+  }
+  std::filesystem::remove(path);
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(records.size()));
+  state.counters["bytes_per_state"] =
+      static_cast<double>(bytes) / static_cast<double>(records.size());
+}
+BENCHMARK(BM_WriteStatesText)->Unit(benchmark::kMillisecond);
+
+static void BM_WriteStates(benchmark::State &state) {
+  const auto &records = Records();
+  const auto path = TempPath("eobstatefilebench.bin");
+  const StateFileOptions options{
+      .codec = static_cast<StateCodec>(state.range(0))};
+  std::uint64_t bytes = 0;
+  for (auto _ : state) {
+    StateFileWriter writer(path, options);
+    writer.Append(records);
+    writer.Close();
+    bytes = writer.bytes();
+  }
+  std::filesystem::remove(path);
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(records.size()));
+  state.counters["bytes_per_state"] =
+      static_cast<double>(bytes) / static_cast<double>(records.size());
+}
+BENCHMARK(BM_WriteStates)
+    ->Arg(static_cast<int>(StateCodec::kRaw))
+    ->Arg(static_cast<int>(StateCodec::kDeltaXor))
+    ->Unit(benchmark::kMillisecond);
+
+/// Decode one block picked at random, what a viewer seeking in a long run
+/// does
+static void BM_ReadStateBlock(benchmark::State &state) {
+  const auto &records = Records();
+  const auto path = TempPath("eobstatefilebench_read.bin");
+  {
+    StateFileWriter writer(
+        path, {.codec = static_cast<StateCodec>(state.range(0))});
+    writer.Append(records);
+  }
+  const StateFileReader reader(path);
+  std::vector<StateRecord> block;
+  std::size_t i = 0;
+  std::int64_t states = 0;
+  for (auto _ : state) {
+    reader.ReadBlock(i, block);
+    benchmark::DoNotOptimize(block.data());
+    states += static_cast<std::int64_t>(block.size());
+    i = (i * 7 + 3) % reader.block_count();
+  }
+  std::filesystem::remove(path);
+  state.SetItemsProcessed(states);
+}
+BENCHMARK(BM_ReadStateBlock)
+    ->Arg(static_cast<int>(StateCodec::kRaw))
+    ->Arg(static_cast<int>(StateCodec::kDeltaXor));
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "date/date.h"
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/statefile.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+/// @brief A day of the ISS at one minute steps, numbered like two objects
+/// taking turns every hour
+std::vector<StateRecord> IssRecords() {
+  using namespace std::chrono;
+  const auto state = InitState(iss_2008);
+  const system_clock::time_point start =
+      date::sys_days{date::year{2008} / date::September / 20} + 12h;
+  std::vector<StateRecord> records;
+  for (int i = 0; i < 1440; ++i) {
+    StateRecord r{.time = start + minutes(i),
+                  .object = (i / 60) % 2 == 0 ? 25544U : 4294967295U,
+                  .state = {}};
+    EXPECT_EQ(PropagateSgp4(state, MinutesSinceEpoch(state, r.time), r.state),
+              Sgp4Errc::kOk);
+    records.push_back(r);
+  }
+  // irregular times, including one before the epoch of the file
+  records[100].time += 3ms;
+  records[700].time = start - hours(24 * 365 * 30);
+  records[701].state.position[0] = -0.0;
+  return records;
+}
+
+void ExpectSame(const StateRecord &a, const StateRecord &b, std::size_t i) {
+  EXPECT_EQ(a.time, b.time) << i;
+  EXPECT_EQ(a.object, b.object) << i;
+  // bitwise, the codecs are lossless
+  for (std::size_t k = 0; k < 3; ++k) {
+    EXPECT_EQ(std::bit_cast<std::uint64_t>(a.state.position[k]),
+              std::bit_cast<std::uint64_t>(b.state.position[k]))
+        << i;
+    EXPECT_EQ(std::bit_cast<std::uint64_t>(a.state.velocity[k]),
+              std::bit_cast<std::uint64_t>(b.state.velocity[k]))
+        << i;
+  }
+}
+
+std::vector<StateRecord> ReadAll(const StateFileReader &reader) {
+  std::vector<StateRecord> all;
+  std::vector<StateRecord> block;
+  for (std::size_t i = 0; i < reader.block_count(); ++i) {
+    reader.ReadBlock(i, block);
+    all.insert(all.end(), block.begin(), block.end());
+  }
+  return all;
+}
+}  // namespace
+
+TEST(StateFileTest, RoundTrip) {
+  const auto records = IssRecords();
+  for (const auto codec : {StateCodec::kRaw, StateCodec::kDeltaXor}) {
+    const auto path = TempPath("eobstatefiletest.bin");
+    std::uint64_t bytes = 0;
+    {
+      // small buffer so the writer flushes more than once
+      StateFileWriter writer(
+          path, {.block_size = 256, .codec = codec, .buffer_bytes = 4096});
+      writer.Append(records);
+      writer.Close();
+      EXPECT_EQ(writer.states(), records.size());
+      bytes = writer.bytes();
+    }
+    EXPECT_EQ(std::filesystem::file_size(path), bytes);
+
+    const StateFileReader reader(path);
+    EXPECT_EQ(reader.codec(), codec);
+    EXPECT_EQ(reader.block_count(), 6);
+    EXPECT_EQ(reader.state_count(), records.size());
+    const auto read = ReadAll(reader);
+    ASSERT_EQ(read.size(), records.size());
+    for (std::size_t i = 0; i < read.size(); ++i) {
+      ExpectSame(read[i], records[i], i);
+    }
+    if (codec == StateCodec::kDeltaXor) {
+      // raw takes 60 bytes per state
+      EXPECT_LT(
+          static_cast<double>(bytes) / static_cast<double>(records.size()),
+          50.0);
+    }
+    std::filesystem::remove(path);
+  }
+}
+
+TEST(StateFileTest, RandomAccess) {
+  const auto records = IssRecords();
+  const auto path = TempPath("eobstatefiletest_random.bin");
+  {
+    StateFileWriter writer(path, {.block_size = 100});
+    for (const auto &r : records) {
+      writer.Append(r);
+    }
+    // closed by the destructor
+  }
+
+  StateFileReader reader(path);
+  ASSERT_EQ(reader.block_count(), 15);
+  std::vector<StateRecord> block;
+  for (const std::size_t i :
+       {std::size_t{14}, std::size_t{0}, std::size_t{7}, std::size_t{3}}) {
+    reader.ReadBlock(i, block);
+    ASSERT_EQ(block.size(), i == 14 ? 40 : 100);
+    EXPECT_EQ(reader.block(i).states, block.size());
+    for (std::size_t k = 0; k < block.size(); ++k) {
+      ExpectSame(block[k], records[i * 100 + k], i * 100 + k);
+    }
+  }
+  // block 7 has the record far in the past
+  EXPECT_EQ(reader.block(7).first_time, records[700].time);
+  EXPECT_EQ(reader.block(0).first_time, records[0].time);
+  EXPECT_EQ(reader.block(0).last_time, records[99].time);
+  EXPECT_THROW(reader.ReadBlock(15, block), MyException<std::string>);
+
+  const StateFileReader moved(std::move(reader));
+  moved.ReadBlock(14, block);
+  EXPECT_EQ(block.size(), 40);
+  std::filesystem::remove(path);
+}
+
+TEST(StateFileTest, Empty) {
+  const auto path = TempPath("eobstatefiletest_empty.bin");
+  StateFileWriter(path).Close();
+  const StateFileReader reader(path);
+  EXPECT_EQ(reader.block_count(), 0);
+  EXPECT_EQ(reader.state_count(), 0);
+  std::filesystem::remove(path);
+}
+
+TEST(StateFileTest, Malformed) {
+  EXPECT_THROW(StateFileReader(TempPath("eobstatefiletest_missing.bin")),
+               MyException<std::string>);
+  EXPECT_THROW(StateFileWriter(TempPath("eobstatefiletest_zero.bin"),
+                               {.block_size = 0}),
+               MyException<std::string>);
+
+  const auto path = TempPath("eobstatefiletest_malformed.bin");
+  {
+    StateFileWriter writer(path, {.block_size = 500});
+    writer.Append(IssRecords());
+  }
+  std::string bytes;
+  {
+    std::ifstream file(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(file), {});
+  }
+  auto write = [&path](const std::string &content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+  };
+
+  // truncated, the trailer is gone
+  write(bytes.substr(0, bytes.size() - 10));
+  EXPECT_THROW(StateFileReader{path}, MyException<std::string>);
+
+  // bad magic
+  auto corrupt = bytes;
+  corrupt[0] = 'X';
+  write(corrupt);
+  EXPECT_THROW(StateFileReader{path}, MyException<std::string>);
+
+  // a column length running past the block is caught when reading it
+  corrupt = bytes;
+  corrupt[32 + 3] = '\x7f';
+  write(corrupt);
+  const StateFileReader reader(path);
+  std::vector<StateRecord> block;
+  EXPECT_THROW(reader.ReadBlock(0, block), MyException<std::string>);
+  reader.ReadBlock(1, block);
+  EXPECT_EQ(block.size(), 500);
+  std::filesystem::remove(path);
+}
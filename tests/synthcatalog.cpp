@@ -0,0 +1,338 @@
+#include "synthcatalog.h"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <string>
+#include <vector>
+
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/formattle.h"
+#include "earthorbits/parsetle.h"
+
+namespace eob {
+namespace {
+constexpr double earth_radius_km = 6378.135;  // WGS-72
+constexpr double mu_km3_per_s2 = 398600.8;    // WGS-72
+constexpr double geo_semi_major_axis_km = 42164.0;
+
+/// @brief splitmix64, unlike the std distributions its output is the same
+/// for every standard library
+/// @see https://prng.di.unimi.it/splitmix64.c
+class SplitMix64 {
+ public:
+  explicit SplitMix64(std::uint64_t seed) : state_{seed} {}
+
+  std::uint64_t Next() noexcept {
+    std::uint64_t z = (state_ += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+  }
+
+  /// @brief Uniform in [lo, hi)
+  double Uniform(double lo, double hi) noexcept {
+    constexpr double two_pow_minus_53 = 1.0 / 9007199254740992.0;
+    const double u = static_cast<double>(Next() >> 11) * two_pow_minus_53;
+    return lo + (hi - lo) * u;
+  }
+
+ private:
+  std::uint64_t state_;
+};
+
+struct Elements {
+  double semi_major_axis;  // km
+  double eccentricity;
+  double inclination;  // degrees
+  double bstar;
+  double mean_motion_dot;
+};
+
+[[nodiscard]] double mean_motion_rev_per_day(double semi_major_axis) {
+  const double n = std::sqrt(mu_km3_per_s2 / std::pow(semi_major_axis, 3));
+  return n * 86400.0 / (2.0 * std::numbers::pi);
+}
+
+[[nodiscard]] Elements leo(SplitMix64 &rng) {
+  const double perigee = rng.Uniform(300.0, 1400.0);
+  const double e = rng.Uniform(0.0, 0.02);
+  const double a = (earth_radius_km + perigee) / (1.0 - e);
+  // popular inclinations: ISS, Starlink shells, sun-synchronous, Iridium
+  const double pick = rng.Uniform(0.0, 1.0);
+  double inclination = 0.0;
+  if (pick < 0.15) {
+    inclination = rng.Uniform(51.5, 51.7);
+  } else if (pick < 0.45) {
+    inclination = rng.Uniform(52.9, 53.3);
+  } else if (pick < 0.75) {
+    inclination = rng.Uniform(96.5, 99.5);
+  } else if (pick < 0.8) {
+    inclination = rng.Uniform(86.3, 86.5);
+  } else {
+    inclination = rng.Uniform(0.0, 110.0);
+  }
+  return Elements{
+      .semi_major_axis = a,
+      .eccentricity = e,
+      .inclination = inclination,
+      .bstar = rng.Uniform(1e-5, 1e-3),
+      .mean_motion_dot = rng.Uniform(-1e-5, 1e-4),
+  };
+}
+
+[[nodiscard]] Elements meo(SplitMix64 &rng) {
+  const bool gps_like = rng.Uniform(0.0, 1.0) < 0.7;
+  return Elements{
+      .semi_major_axis = earth_radius_km + rng.Uniform(19000.0, 23500.0),
+      .eccentricity = rng.Uniform(0.0, 0.01),
+      .inclination = gps_like ? rng.Uniform(54.0, 56.0)
+                              : rng.Uniform(64.5, 65.0),
+      .bstar = 0.0,
+      .mean_motion_dot = rng.Uniform(-1e-7, 1e-7),
+  };
+}
+
+[[nodiscard]] Elements geo(SplitMix64 &rng) {
+  return Elements{
+      .semi_major_axis = geo_semi_major_axis_km + rng.Uniform(-40.0, 40.0),
+      .eccentricity = rng.Uniform(0.0, 0.001),
+      .inclination = rng.Uniform(0.0, 15.0),
+      .bstar = 0.0,
+      .mean_motion_dot = rng.Uniform(-3e-6, 3e-6),
+  };
+}
+
+[[nodiscard]] Elements heo(SplitMix64 &rng) {
+  if (rng.Uniform(0.0, 1.0) < 0.4) {  // Molniya
+    return Elements{
+        .semi_major_axis = 26560.0 + rng.Uniform(-50.0, 50.0),
+        .eccentricity = rng.Uniform(0.68, 0.74),
+        .inclination = rng.Uniform(62.8, 64.0),
+        .bstar = rng.Uniform(0.0, 1e-4),
+        .mean_motion_dot = rng.Uniform(-1e-6, 1e-6),
+    };
+  }
+  // geostationary transfer orbit
+  const double perigee = earth_radius_km + rng.Uniform(250.0, 600.0);
+  const double apogee = geo_semi_major_axis_km + rng.Uniform(-500.0, 500.0);
+  return Elements{
+      .semi_major_axis = (perigee + apogee) / 2.0,
+      .eccentricity = (apogee - perigee) / (apogee + perigee),
+      .inclination = rng.Uniform(0.0, 28.5),
+      .bstar = rng.Uniform(0.0, 1e-3),
+      .mean_motion_dot = rng.Uniform(-1e-5, 1e-4),
+  };
+}
+
+/// @brief TLE "exponential" field, e.g. 0.21418e-3 -> " 21418-3"
+[[nodiscard]] std::string exponent_field(double value) {
+  if (value == 0.0) {
+    return " 00000-0";
+  }
+  int exponent = static_cast<int>(std::floor(std::log10(std::abs(value)))) + 1;
+  auto mantissa = std::lround(std::abs(value) / std::pow(10.0, exponent) * 1e5);
+  if (mantissa >= 100000) {
+    mantissa /= 10;
+    ++exponent;
+  }
+  exponent = std::clamp(exponent, -9, 9);
+  return fmt::format("{}{:05d}{}{}", value < 0.0 ? '-' : ' ', mantissa,
+                     exponent < 0 ? '-' : '+', std::abs(exponent));
+}
+
+/// @brief e.g. 0.00011771 -> " .00011771"
+[[nodiscard]] std::string mean_motion_dot_field(double value) {
+  return fmt::format("{}.{:08d}", value < 0.0 ? '-' : ' ',
+                     std::lround(std::abs(value) * 1e8));
+}
+
+[[nodiscard]] char checksum(const std::string &line) {
+  int sum = 0;
+  for (char c : line) {
+    if ('0' <= c && c <= '9') {
+      sum += c - '0';
+    } else if (c == '-') {
+      sum += 1;
+    }
+  }
+  return static_cast<char>('0' + sum % 10);
+}
+
+/// @brief wrap to [0, 360) after rounding to the 4 decimals of the field
+[[nodiscard]] double angle_field(double degrees) {
+  const double rounded = std::round(degrees * 1e4) / 1e4;
+  return rounded >= 360.0 ? rounded - 360.0 : rounded;
+}
+}  // namespace
+
+[[nodiscard]] std::vector<std::string> MakeSynthTles(
+    const SynthCatalogOptions &options) {
+  SplitMix64 rng(options.seed);
+  std::vector<std::string> tles;
+  tles.reserve(options.size);
+
+  const double leo_end = options.leo_fraction;
+  const double meo_end = leo_end + options.meo_fraction;
+  const double geo_end = meo_end + options.geo_fraction;
+
+  for (std::size_t i = 0; i < options.size; ++i) {
+    const double pick = rng.Uniform(0.0, 1.0);
+    Elements el{};
+    if (pick < leo_end) {
+      el = leo(rng);
+    } else if (pick < meo_end) {
+      el = meo(rng);
+    } else if (pick < geo_end) {
+      el = geo(rng);
+    } else {
+      el = heo(rng);
+    }
+
+    const auto satellite_number = static_cast<int>(10000 + i % 90000);
+    const int launch_year = static_cast<int>(rng.Uniform(0.0, 100.0));
+    const int launch_number = 1 + static_cast<int>(rng.Uniform(0.0, 300.0));
+    const char piece = static_cast<char>('A' + static_cast<int>(i % 20));
+    const double epoch_day = rng.Uniform(1.0, 366.0);
+    const int element_number = 1 + static_cast<int>(rng.Uniform(0.0, 999.0));
+
+    auto line_1 = fmt::format(
+        "1 {:05d}U {:02d}{:03d}{:<3} 24{:012.8f} {} {} {} 0 {:4d}",
+        satellite_number, launch_year, launch_number, piece, epoch_day,
+        mean_motion_dot_field(el.mean_motion_dot), exponent_field(0.0),
+        exponent_field(el.bstar), element_number);
+    line_1 += checksum(line_1);
+
+    const double mean_motion = mean_motion_rev_per_day(el.semi_major_axis);
+    const auto eccentricity = std::min<long>(
+        std::lround(el.eccentricity * 1e7), 9999999);
+    const int rev_at_epoch =
+        static_cast<int>(rng.Uniform(0.0, 1.0) * 99999.0);
+    auto line_2 = fmt::format(
+        "2 {:05d} {:8.4f} {:8.4f} {:07d} {:8.4f} {:8.4f} {:11.8f}{:5d}",
+        satellite_number, el.inclination,
+        angle_field(rng.Uniform(0.0, 360.0)), eccentricity,
+        angle_field(rng.Uniform(0.0, 360.0)),
+        angle_field(rng.Uniform(0.0, 360.0)), mean_motion, rev_at_epoch);
+    line_2 += checksum(line_2);
+
+    tles.push_back(line_1 + '\n' + line_2);
+  }
+  return tles;
+}
+
+[[nodiscard]] std::string MakeSynthCatalogText(
+    const SynthCatalogOptions &options) {
+  std::string text;
+  text.reserve(options.size * 140);
+  for (const auto &tle : MakeSynthTles(options)) {
+    text += tle;
+    text += '\n';
+  }
+  return text;
+}
+
+[[nodiscard]] std::vector<Tle> MakeSynthHistory(
+    const SynthHistoryOptions &options) {
+  using namespace std::chrono;
+  std::vector<Tle> objects;
+  for (const auto &text : MakeSynthTles(
+           {.size = options.objects, .seed = options.seed})) {
+    objects.push_back(ParseTle(text));
+  }
+  // J2 precession rates, degrees per day, of each object
+  std::vector<std::array<double, 2>> rates;
+  for (const auto &tle : objects) {
+    const double n = tle.line_2.mean_motion * 2.0 * std::numbers::pi / 86400.0;
+    const double a = std::cbrt(mu_km3_per_s2 / (n * n));
+    const double e = tle.line_2.eccentricity;
+    const double k = 9.964 * std::pow(earth_radius_km / a, 3.5) /
+                     ((1.0 - e * e) * (1.0 - e * e));
+    const double cos_i =
+        std::cos(tle.line_2.inclination * std::numbers::pi / 180.0);
+    rates.push_back({-k * cos_i, 0.5 * k * (5.0 * cos_i * cos_i - 1.0)});
+  }
+
+  SplitMix64 rng(options.seed ^ 0x5eed);
+  const auto start = sys_days{year{2020} / January / 1};
+  const auto rounds = static_cast<std::size_t>(
+      static_cast<double>(options.days) * options.updates_per_day);
+  std::vector<double> last_days(objects.size(), 0.0);
+  std::vector<Tle> history;
+  history.reserve(rounds * objects.size());
+  std::array<char, formatted_tle_size> text{};
+  for (std::size_t r = 0; r < rounds; ++r) {
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+      auto &tle = objects[i];
+      // days since start, the jitter keeps the epochs increasing
+      const double days =
+          (static_cast<double>(r) + rng.Uniform(0.0, 0.8)) /
+          options.updates_per_day;
+      const double dt = days - last_days[i];
+      last_days[i] = days;
+
+      auto &l1 = tle.line_1;
+      auto &l2 = tle.line_2;
+      const double revolutions =
+          l2.mean_motion * dt + l1.mean_motion_dot * dt * dt;
+      l2.mean_anomaly = angle_field(
+          std::fmod(l2.mean_anomaly + 360.0 * revolutions, 360.0));
+      l2.raan = angle_field(
+          std::fmod(l2.raan + rates[i][0] * dt + 360.0, 360.0));
+      l2.argument_of_perigree = angle_field(std::fmod(
+          l2.argument_of_perigree + rates[i][1] * dt + 360.0, 360.0));
+      l2.mean_motion = std::round((l2.mean_motion +
+                                   2.0 * l1.mean_motion_dot * dt) *
+                                  1e8) /
+                       1e8;
+      l2.rev_at_epoch =
+          (l2.rev_at_epoch + static_cast<int>(revolutions)) % 100000;
+      l1.element_number = l1.element_number % 9999 + 1;
+
+      const auto whole = std::chrono::days{static_cast<int>(days)};
+      const year_month_day ymd{start + whole};
+      const auto day_of_year =
+          (start + whole - sys_days{ymd.year() / January / 1}).count();
+      l1.epoch_year = static_cast<int>(ymd.year()) % 100;
+      l1.epoch_day = std::round((static_cast<double>(day_of_year) + 1.0 +
+                                 days - static_cast<double>(whole.count())) *
+                                1e8) /
+                     1e8;
+
+      auto error = FormatTle(tle, text);
+      if (error.ok()) {
+        error = TryParseTle({text.data(), text.size()}, tle);
+      }
+      if (!error.ok()) {
+        throw MyException<std::string>(to_string(error),
+                                       std::string(text.data(), text.size()));
+      }
+      history.push_back(tle);
+    }
+  }
+  return history;
+}
+
+[[nodiscard]] const std::vector<std::string> &CachedSynthTles(
+    std::size_t size) {
+  static std::mutex mutex;
+  static std::map<std::size_t, std::unique_ptr<std::vector<std::string>>>
+      cache;
+  const std::lock_guard lock(mutex);
+  auto &tles = cache[size];
+  if (!tles) {
+    tles = std::make_unique<std::vector<std::string>>(
+        MakeSynthTles(SynthCatalogOptions{.size = size}));
+  }
+  return *tles;
+}
+}  // namespace eob
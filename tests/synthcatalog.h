@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "earthorbits/parsetle.h"
+
+/// Deterministic synthetic TLE catalogs for tests and benchmarks.
+///
+/// Records are valid TLE text (correct field layout and checksums) with a
+/// realistic mix of LEO/MEO/GEO/HEO orbits. The random numbers don't
+/// depend on the standard library, so the same options give the same
+/// catalog everywhere and benchmark results of different commits are
+/// comparable.
+
+namespace eob {
+struct SynthCatalogOptions {
+  std::size_t size = 1000;
+  std::uint64_t seed = 1;
+  /// fractions of the catalog per regime, HEO gets the remainder
+  double leo_fraction = 0.72;
+  double meo_fraction = 0.06;
+  double geo_fraction = 0.12;
+};
+
+/// @brief One 139 character TLE record (no trailing line break) per object
+///
+/// Satellite numbers count up from 10000 and wrap after 99999, so catalogs
+/// larger than 90000 objects repeat numbers.
+[[nodiscard]] std::vector<std::string> MakeSynthTles(
+    const SynthCatalogOptions &options);
+
+/// @brief Same records as MakeSynthTles joined into one text, each record
+/// followed by a line break, like a catalog file
+[[nodiscard]] std::string MakeSynthCatalogText(
+    const SynthCatalogOptions &options);
+
+struct SynthHistoryOptions {
+  std::size_t objects = 100;
+  std::size_t days = 365;
+  /// element sets per object and day, epochs are jittered around the
+  /// evenly spaced times
+  double updates_per_day = 2.0;
+  std::uint64_t seed = 1;
+};
+
+/// @brief Element set histories of the objects of MakeSynthTles, starting
+/// 2020-01-01
+///
+/// The elements drift like a real history: the mean anomaly advances with
+/// the mean motion, RAAN and argument of perigee precess with J2 and the
+/// mean motion follows its derivative. Records are round tripped through
+/// FormatTle and ParseTle, so they hold exactly the values of TLE text.
+/// Ordered by update round, like a catalog downloaded every few hours.
+[[nodiscard]] std::vector<Tle> MakeSynthHistory(
+    const SynthHistoryOptions &options);
+
+/// @brief MakeSynthTles with default options, cached per size and safe to
+/// call from multiple benchmark threads
+[[nodiscard]] const std::vector<std::string> &CachedSynthTles(
+    std::size_t size);
+}  // namespace eob
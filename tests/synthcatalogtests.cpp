@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include "earthorbits/catalogindex.h"
+#include "earthorbits/parsetle.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+TEST(SynthCatalogTest, RecordsAreValid) {
+  const auto tles = MakeSynthTles(SynthCatalogOptions{.size = 5000});
+  ASSERT_EQ(tles.size(), 5000);
+
+  std::array<std::size_t, orbit_regime_count> regimes{};
+  for (const auto &str : tles) {
+    Tle tle;
+    auto err = TryParseTle(str, tle);
+    ASSERT_TRUE(err.ok()) << to_string(err) << "\n" << str;
+    ++regimes[static_cast<std::size_t>(SummarizeOrbit(tle.line_2).regime)];
+  }
+
+  // 72% LEO, 6% MEO, 12% GEO, 10% HEO with the default options
+  EXPECT_NEAR(static_cast<double>(regimes[static_cast<std::size_t>(
+                  OrbitRegime::kLeo)]) / 5000.0,
+              0.72, 0.03);
+  EXPECT_NEAR(static_cast<double>(regimes[static_cast<std::size_t>(
+                  OrbitRegime::kMeo)]) / 5000.0,
+              0.06, 0.02);
+  EXPECT_NEAR(static_cast<double>(regimes[static_cast<std::size_t>(
+                  OrbitRegime::kGeo)]) / 5000.0,
+              0.12, 0.02);
+  EXPECT_NEAR(static_cast<double>(regimes[static_cast<std::size_t>(
+                  OrbitRegime::kHeo)]) / 5000.0,
+              0.10, 0.02);
+}
+
+TEST(SynthCatalogTest, Deterministic) {
+  const SynthCatalogOptions options{.size = 100, .seed = 3};
+  EXPECT_EQ(MakeSynthTles(options), MakeSynthTles(options));
+  EXPECT_NE(MakeSynthTles(options),
+            MakeSynthTles(SynthCatalogOptions{.size = 100, .seed = 4}));
+
+  const auto text = MakeSynthCatalogText(options);
+  EXPECT_EQ(text.size(), 100 * 140);
+  EXPECT_EQ(text.substr(0, 139), MakeSynthTles(options).front());
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/eobmath.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+
+/// Fixtures shared by tests and benchmarks.
+
+namespace eob {
+/// ISS element set of the SGP4 verification in Vallado's "Revisiting
+/// Spacetrack Report #3"
+constexpr std::string_view iss_2008_text =
+    R"(1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927
+2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537)";
+
+/// A recent ISS element set
+constexpr std::string_view iss_2024_text =
+    R"(1 25544U 98067A   24097.81509284  .00011771  00000-0  21418-3 0  9995
+2 25544  51.6405 309.2692 0004792  43.0163  63.5300 15.49960977447473)";
+
+inline const Tle iss_2008 = ParseTle(std::string(iss_2008_text));
+inline const Tle iss_2024 = ParseTle(std::string(iss_2024_text));
+
+/// @brief InitSgp4 of tle, throws MyException<std::string> if it fails
+[[nodiscard]] inline Sgp4State InitState(const Tle &tle) {
+  Sgp4State state;
+  if (const auto errc = InitSgp4(tle, state); errc != Sgp4Errc::kOk) {
+    throw MyException<std::string>("InitSgp4 failed",
+                                   std::string(to_string(errc)));
+  }
+  return state;
+}
+
+/// @brief Mean motion of history raised by delta from first on, with mean
+/// anomalies that follow it, a maneuver SGP4 sees as one
+inline void InjectMeanMotion(std::vector<Tle> &history, std::size_t first,
+                             double delta) {
+  const auto start = TleEpoch(history[first].line_1);
+  for (std::size_t k = first; k < history.size(); ++k) {
+    auto &l2 = history[k].line_2;
+    const double days =
+        std::chrono::duration<double, std::chrono::days::period>(
+            TleEpoch(history[k].line_1) - start)
+            .count();
+    l2.mean_motion += delta;
+    l2.mean_anomaly = wrap_to_360(l2.mean_anomaly + 360.0 * delta * days);
+  }
+}
+
+/// @brief name in the temporary directory
+[[nodiscard]] inline std::string TempPath(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+}  // namespace eob
@@ -0,0 +1,166 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "date/date.h"
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/timescales.h"
+
+using namespace eob;
+
+static void BM_CalcGMST(benchmark::State &state) {
+  using namespace date;
+  using namespace std::chrono;
+  constexpr system_clock::time_point tp =
+      date::sys_days{date::May / 12 / 2024} + 20h + 33min + 5s;
+  for (auto _ : state) {
+    auto gmst = calc_gmst(tp);
+    benchmark::DoNotOptimize(gmst);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CalcGMST);
+
+/// One day at a fixed step, as used when propagating over a window
+static void BM_CalcGMSTTimeGrid(benchmark::State &state) {
+  using namespace date;
+  using namespace std::chrono;
+  const system_clock::time_point start = date::sys_days{date::May / 12 / 2024};
+  const auto step = seconds(state.range(0));
+  std::vector<system_clock::time_point> grid;
+  for (auto tp = start; tp < start + days(1); tp += step) {
+    grid.push_back(tp);
+  }
+
+  for (auto _ : state) {
+    for (const auto &tp : grid) {
+      auto gmst = calc_gmst(tp);
+      benchmark::DoNotOptimize(gmst);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(grid.size()));
+}
+BENCHMARK(BM_CalcGMSTTimeGrid)->Arg(1)->Arg(60);
+
+/// The same grid with the step fixed at compile time
+template <std::int64_t StepSeconds>
+static void BM_CalcGMSTGrid(benchmark::State &state) {
+  using namespace date;
+  using namespace std::chrono;
+  const system_clock::time_point start = date::sys_days{date::May / 12 / 2024};
+  std::vector<eob_seconds> gmst(86400 / StepSeconds);
+
+  for (auto _ : state) {
+    calc_gmst_grid<StepSeconds>(start, gmst);
+    benchmark::DoNotOptimize(gmst.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(gmst.size()));
+}
+BENCHMARK_TEMPLATE(BM_CalcGMSTGrid, 1);
+BENCHMARK_TEMPLATE(BM_CalcGMSTGrid, 60);
+
+static void BM_TimePointToString(benchmark::State &state) {
+  using namespace date;
+  using namespace std::chrono;
+  constexpr system_clock::time_point tp =
+      date::sys_days{date::May / 12 / 2024} + 20h + 33min + 5s;
+
+  for (auto _ : state) {
+    auto str = to_string(tp);
+    benchmark::DoNotOptimize(str);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimePointToString);
+
+namespace {
+/// @brief One sample a second over the 2016 leap second, spread over the
+/// year so that lookups hit different buckets
+std::vector<std::chrono::system_clock::time_point> LeapSecondSamples() {
+  using namespace date;
+  using namespace std::chrono;
+  const system_clock::time_point start = sys_days{December / 31 / 2016};
+  std::vector<system_clock::time_point> samples;
+  for (std::int64_t i = 0; i < 86400 * 2; ++i) {
+    samples.push_back(start + seconds{(i * 7919) % (86400 * 2)} -
+                      days{(i % 365)});
+  }
+  return samples;
+}
+
+/// @brief TAI - UTC by calendar date and a linear search, as is common
+std::chrono::seconds CalendarTaiMinusUtc(
+    const std::chrono::system_clock::time_point &utc) {
+  using namespace date;
+  const year_month_day ymd{floor<days>(utc)};
+  auto offset = std::chrono::seconds{10};
+  for (const auto &leap : LeapSecondTable::Embedded().leaps()) {
+    if (year_month_day{leap.day} <= ymd) {
+      offset = leap.tai_minus_utc;
+    }
+  }
+  return offset;
+}
+}  // namespace
+
+static void BM_UtcToTai(benchmark::State &state) {
+  const auto samples = LeapSecondSamples();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(UtcToTai(samples[i]));
+    i = i + 1 == samples.size() ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UtcToTai);
+
+/// The same with a calendar conversion and a search of the table
+static void BM_UtcToTaiCalendar(benchmark::State &state) {
+  const auto samples = LeapSecondSamples();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(samples[i] + CalendarTaiMinusUtc(samples[i]));
+    i = i + 1 == samples.size() ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UtcToTaiCalendar);
+
+static void BM_TaiToUtc(benchmark::State &state) {
+  const auto samples = LeapSecondSamples();
+  std::vector<eob_tai_clock::time_point> tai(samples.size());
+  UtcToTai(samples, tai);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(TaiToUtc(tai[i]));
+    i = i + 1 == tai.size() ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TaiToUtc);
+
+/// A day at 1 Hz to TT and back, as for an ephemeris over a window
+static void BM_UtcToTtBatch(benchmark::State &state) {
+  using namespace date;
+  using namespace std::chrono;
+  const system_clock::time_point start = sys_days{May / 12 / 2024};
+  std::vector<system_clock::time_point> utc;
+  for (auto tp = start; tp < start + days(1); tp += 1s) {
+    utc.push_back(tp);
+  }
+  std::vector<eob_tt_clock::time_point> tt(utc.size());
+  for (auto _ : state) {
+    UtcToTt(utc, tt);
+    benchmark::DoNotOptimize(tt.data());
+    TtToUtc(tt, utc);
+    benchmark::DoNotOptimize(utc.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(2 * utc.size()));
+}
+BENCHMARK(BM_UtcToTtBatch);
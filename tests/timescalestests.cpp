@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "date/date.h"
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/eop.h"
+#include "earthorbits/timescales.h"
+
+using namespace eob;
+
+namespace {
+std::chrono::system_clock::time_point Utc(const date::year_month_day &ymd,
+                                          std::chrono::seconds s) {
+  return date::sys_days{ymd} + s;
+}
+}  // namespace
+
+TEST(TimeScalesTest, TaiMinusUtc) {
+  using namespace date;
+  using namespace std::chrono;
+  const auto &table = LeapSecondTable::Embedded();
+  EXPECT_EQ(table.leaps().size(), 28U);
+  EXPECT_EQ(table.TaiMinusUtc(Utc(December / 31 / 2016, 86399s)), 36s);
+  EXPECT_EQ(table.TaiMinusUtc(Utc(January / 1 / 2017, 0s)), 37s);
+  EXPECT_EQ(table.TaiMinusUtc(Utc(June / 30 / 2012, 86399s)), 34s);
+  EXPECT_EQ(table.TaiMinusUtc(Utc(July / 1 / 2012, 0s)), 35s);
+  EXPECT_EQ(table.TaiMinusUtc(Utc(January / 1 / 1972, 0s)), 10s);
+  EXPECT_EQ(table.TaiMinusUtc(Utc(June / 30 / 1972, 86399s)), 10s);
+  // clamped outside of the table
+  EXPECT_EQ(table.TaiMinusUtc(Utc(January / 1 / 1970, 0s)), 10s);
+  EXPECT_EQ(table.TaiMinusUtc(Utc(May / 12 / 2024, 0s)), 37s);
+
+  // every day of the table against a linear search
+  for (auto day = sys_days{January / 1 / 1971};
+       day < sys_days{January / 1 / 2019}; day += days{1}) {
+    auto expected = table.leaps().front().tai_minus_utc;
+    for (const auto &leap : table.leaps()) {
+      if (leap.day <= day) {
+        expected = leap.tai_minus_utc;
+      }
+    }
+    ASSERT_EQ(table.TaiMinusUtc(day + 12h), expected)
+        << to_string(day);
+  }
+}
+
+TEST(TimeScalesTest, LeapSecondBoundary) {
+  using namespace date;
+  using namespace std::chrono;
+  // 2016-12-31T23:59:60 makes this second two long in TAI
+  const auto before = Utc(December / 31 / 2016, 86399s);
+  const auto after = Utc(January / 1 / 2017, 0s);
+  EXPECT_EQ(UtcToTai(after) - UtcToTai(before), 2s);
+  EXPECT_EQ(UtcToTai(after).time_since_epoch(),
+            after.time_since_epoch() + 37s);
+
+  // round trips on both sides
+  for (const auto tp : {before - 1ms, before, before + 999ms, after,
+                        after + 1ns, after + 1s}) {
+    EXPECT_EQ(TaiToUtc(UtcToTai(tp)), tp) << to_string(tp);
+    EXPECT_EQ(TtToUtc(UtcToTt(tp)), tp) << to_string(tp);
+  }
+
+  // TAI in the leap second maps to the last instant of the day
+  const auto leap = UtcToTai(before) + 1s;
+  const auto last = after - system_clock::duration{1};
+  EXPECT_EQ(TaiToUtc(leap), last);
+  EXPECT_EQ(TaiToUtc(leap + 500ms), last);
+  EXPECT_EQ(TaiToUtc(leap + 1s), after);
+  EXPECT_EQ(TaiToUtc(leap - 1ns), before + 999999999ns);
+}
+
+TEST(TimeScalesTest, TerrestrialTime) {
+  using namespace date;
+  using namespace std::chrono;
+  // J2000 is 2000-01-01 12:00:00 TT, 11:58:55.816 UTC
+  const auto j2000 = Utc(January / 1 / 2000, 11h + 58min + 55s) + 816ms;
+  const auto tt = UtcToTt(j2000);
+  EXPECT_DOUBLE_EQ(JulianDate(tt), 2451545.0);
+  EXPECT_EQ(TaiToTt(UtcToTai(j2000)), tt);
+  EXPECT_EQ(TtToTai(tt), UtcToTai(j2000));
+
+  static_assert(TaiToTt(eob_tai_clock::time_point{}).time_since_epoch() ==
+                32184ms);
+  static_assert(JulianDate(eob_tt_clock::time_point{}) == 2440587.5);
+  static_assert(JulianDate(system_clock::time_point{} + days{1}) == 2440588.5);
+
+  const auto now = system_clock::now();
+  EXPECT_LT(eob_tai_clock::now().time_since_epoch() - now.time_since_epoch(),
+            38s);
+  EXPECT_GT(eob_tt_clock::now().time_since_epoch() - now.time_since_epoch(),
+            69s);
+}
+
+TEST(TimeScalesTest, Ut1) {
+  using namespace date;
+  using namespace std::chrono;
+  const auto tp = Utc(May / 12 / 2024, 12h);
+  const EopTable none;
+  EXPECT_EQ(UtcToUt1(tp, none).time_since_epoch(), tp.time_since_epoch());
+
+  // UT1-UTC drifting, jumping by a second at a leap second
+  const int mjd = 57752;  // 2016-12-30
+  const EopTable eop(mjd, {{.ut1_utc = 0.4, .x_pole = 0.0, .y_pole = 0.0},
+                           {.ut1_utc = 0.3, .x_pole = 0.0, .y_pole = 0.0},
+                           {.ut1_utc = -0.8, .x_pole = 0.0, .y_pole = 0.0}});
+  for (const auto utc : {Utc(December / 30 / 2016, 6h),
+                         Utc(December / 31 / 2016, 86399s)}) {
+    const auto ut1 = UtcToUt1(utc, eop);
+    EXPECT_NEAR(
+        duration<double>(ut1.time_since_epoch() - utc.time_since_epoch())
+            .count(),
+        eop.Interpolate(utc).ut1_utc, 1e-9);
+    EXPECT_LE(abs(Ut1ToUtc(ut1, eop) - utc), 1us);
+    EXPECT_EQ(calc_gmst(ut1), calc_gmst(utc, eop));
+  }
+}
+
+TEST(TimeScalesTest, Batch) {
+  using namespace date;
+  using namespace std::chrono;
+  std::vector<system_clock::time_point> utc;
+  for (auto tp = Utc(December / 31 / 2016, 86000s);
+       tp < Utc(January / 1 / 2017, 400s); tp += 250ms) {
+    utc.push_back(tp);
+  }
+  std::vector<eob_tai_clock::time_point> tai(utc.size());
+  std::vector<eob_tt_clock::time_point> tt(utc.size());
+  std::vector<system_clock::time_point> back(utc.size());
+  UtcToTai(utc, tai);
+  UtcToTt(utc, tt);
+  for (std::size_t i = 0; i < utc.size(); ++i) {
+    ASSERT_EQ(tai[i], UtcToTai(utc[i]));
+    ASSERT_EQ(tt[i], UtcToTt(utc[i]));
+  }
+  TaiToUtc(tai, back);
+  EXPECT_EQ(back, utc);
+  TtToUtc(tt, back);
+  EXPECT_EQ(back, utc);
+}
+
+TEST(TimeScalesTest, ParseLeapSecondsList) {
+  using namespace date;
+  using namespace std::chrono;
+  // excerpt of the IERS file, 3692217600 = 2017-01-01
+  const std::string text =
+      "#\tUpdated through IERS Bulletin C 69\n"
+      "#$\t 3929093563\n"
+      "#@\t3960057600\n"
+      "#\n"
+      "2272060800\t10\t# 1 Jan 1972\n"
+      "2287785600\t11\t# 1 Jul 1972\n"
+      "3644697600\t36\t# 1 Jul 2015\n"
+      "3692217600\t37\t# 1 Jan 2017\n"
+      "#h\t16edd0f0 3666784f 37db6bdd e74ced87 59af48f1\n";
+  const auto table = ParseLeapSecondsList(text);
+  ASSERT_EQ(table.leaps().size(), 4U);
+  EXPECT_EQ(table.leaps()[0].day, sys_days{January / 1 / 1972});
+  EXPECT_EQ(table.leaps()[3].day, sys_days{January / 1 / 2017});
+  EXPECT_EQ(table.leaps()[3].tai_minus_utc, 37s);
+  ASSERT_TRUE(table.expires().has_value());
+  EXPECT_EQ(*table.expires(), sys_days{June / 28 / 2025});
+  EXPECT_EQ(table.TaiMinusUtc(Utc(December / 31 / 2016, 0s)), 36s);
+  EXPECT_EQ(table.TaiMinusUtc(Utc(January / 1 / 2017, 0s)), 37s);
+  EXPECT_EQ(table.TaiMinusUtc(Utc(January / 1 / 2000, 0s)), 11s);
+
+  EXPECT_THROW((void)ParseLeapSecondsList("2272060800 ten\n"),
+               MyException<std::string>);
+  EXPECT_THROW((void)ParseLeapSecondsList("2272060801 10\n"),
+               MyException<std::string>);
+  EXPECT_THROW((void)ParseLeapSecondsList("# nothing\n"),
+               MyException<std::string>);
+  EXPECT_THROW((void)LoadLeapSecondTable("/nonexistent/leap-seconds.list"),
+               MyException<std::string>);
+}
+
+TEST(TimeScalesTest, InvalidTables) {
+  using namespace date;
+  using namespace std::chrono;
+  const auto leap = [](const year_month_day &ymd, int offset) {
+    return LeapSecond{.day = sys_days{ymd}, .tai_minus_utc = seconds{offset}};
+  };
+  EXPECT_THROW(LeapSecondTable(std::vector<LeapSecond>{}),
+               MyException<std::string>);
+  EXPECT_THROW(LeapSecondTable({leap(January / 1 / 2017, 37),
+                                leap(July / 1 / 2015, 36)}),
+               MyException<std::string>);
+  EXPECT_THROW(LeapSecondTable({leap(January / 1 / 2017, 37),
+                                leap(January / 20 / 2017, 38)}),
+               MyException<std::string>);
+
+  // a negative leap second
+  const LeapSecondTable table({leap(January / 1 / 2017, 37),
+                               leap(July / 1 / 2030, 36)});
+  const auto after = Utc(July / 1 / 2030, 0s);
+  EXPECT_EQ(table.TaiMinusUtc(after - 1s), 37s);
+  EXPECT_EQ(table.TaiMinusUtc(after), 36s);
+  EXPECT_EQ(UtcToTai(after, table) - UtcToTai(after - 2s, table), 1s);
+  EXPECT_EQ(TaiToUtc(UtcToTai(after, table), table), after);
+}
+
+TEST(TimeScalesTest, LeapSecondsInConsecutiveMonths) {
+  using namespace date;
+  using namespace std::chrono;
+  const auto leap = [](const year_month_day &ymd, int offset) {
+    return LeapSecond{.day = sys_days{ymd}, .tai_minus_utc = seconds{offset}};
+  };
+  // February is the shortest gap between month starts
+  const LeapSecondTable table({leap(January / 1 / 2017, 37),
+                               leap(March / 1 / 2030, 38),
+                               leap(April / 1 / 2030, 39)});
+  const auto march = Utc(March / 1 / 2030, 0s);
+  const auto april = Utc(April / 1 / 2030, 0s);
+  EXPECT_EQ(table.TaiMinusUtc(march - 1s), 37s);
+  EXPECT_EQ(table.TaiMinusUtc(march), 38s);
+  EXPECT_EQ(table.TaiMinusUtc(april - 1s), 38s);
+  EXPECT_EQ(table.TaiMinusUtc(april), 39s);
+
+  for (auto day = sys_days{January / 1 / 2030};
+       day < sys_days{June / 1 / 2030}; day += days{1}) {
+    const auto expected = day < sys_days{March / 1 / 2030}   ? 37s
+                          : day < sys_days{April / 1 / 2030} ? 38s
+                                                             : 39s;
+    ASSERT_EQ(table.TaiMinusUtc(day + 12h), expected) << to_string(day);
+  }
+  EXPECT_THROW(LeapSecondTable({leap(January / 1 / 2017, 37),
+                                leap(March / 1 / 2030, 38),
+                                leap(March / 28 / 2030, 39)}),
+               MyException<std::string>);
+}
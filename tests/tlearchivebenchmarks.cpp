@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "earthorbits/formattle.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/tlearchive.h"
+#include "synthcatalog.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+/// a year of element sets twice a day of 500 objects
+const std::vector<Tle> &History() {
+  static const auto history = MakeSynthHistory({.objects = 500, .days = 365});
+  return history;
+}
+
+/// @brief The history as catalog text, what grep would search
+const std::string &HistoryText() {
+  static const auto text = [] {
+    const auto &history = History();
+    std::string out(history.size() * (formatted_tle_size + 1), '\0');
+    TleError error;
+    out.resize(FormatTles(history, out, error) * (formatted_tle_size + 1));
+    return out;
+  }();
+  return text;
+}
+
+/// @brief The archive of History, written once
+const TleArchiveReader &Archive() {
+  static const auto reader = [] {
+    const auto path = TempPath("eobtlearchivebench_read.bin");
+    {
+      TleArchiveWriter writer(path);
+      writer.Append(History());
+    }
+    TleArchiveReader mapped(path);
+    std::filesystem::remove(path);  // stays mapped
+    return mapped;
+  }();
+  return reader;
+}
+
+/// @brief Satellite number of query k, cycling through the objects
+std::uint32_t QueryObject(std::size_t k) {
+  const auto &history = History();
+  return static_cast<std::uint32_t>(
+      history[(k * 7919) % 500].line_1.satellite_number);
+}
+
+/// one month in the middle of the history
+const auto query_from = std::chrono::system_clock::time_point{
+    std::chrono::sys_days{std::chrono::year{2020} / std::chrono::June / 1}};
+const auto query_to = std::chrono::system_clock::time_point{
+    std::chrono::sys_days{std::chrono::year{2020} / std::chrono::July / 1}};
+}  // namespace
+
+static void BM_WriteTleArchive(benchmark::State &state) {
+  const auto &history = History();
+  const auto path = TempPath("eobtlearchivebench.bin");
+  std::uint64_t bytes = 0;
+  for (auto _ : state) {
+    TleArchiveWriter writer(path);
+    writer.Append(history);
+    writer.Close();
+    bytes = writer.bytes();
+  }
+  std::filesystem::remove(path);
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(history.size()));
+  state.counters["bytes_per_tle"] =
+      static_cast<double>(bytes) / static_cast<double>(history.size());
+  state.counters["compression_ratio"] =
+      static_cast<double>(HistoryText().size()) / static_cast<double>(bytes);
+}
+BENCHMARK(BM_WriteTleArchive)->Unit(benchmark::kMillisecond);
+
+/// All element sets of an object in a month by scanning the text for the
+/// satellite number and parsing the matches
+static void BM_TleHistoryGrep(benchmark::State &state) {
+  const std::string_view text = HistoryText();
+  constexpr std::size_t record = formatted_tle_size + 1;
+  std::vector<Tle> found;
+  std::size_t k = 0;
+  for (auto _ : state) {
+    const auto number = std::to_string(QueryObject(k++));
+    const auto padded = std::string(5 - number.size(), ' ') + number;
+    found.clear();
+    for (std::size_t at = 0; at + record <= text.size(); at += record) {
+      if (text.substr(at + 2, 5) != padded) {
+        continue;
+      }
+      Tle tle;
+      if (TryParseTle(text.substr(at, formatted_tle_size), tle).ok()) {
+        const auto epoch = TleEpoch(tle.line_1);
+        if (epoch >= query_from && epoch < query_to) {
+          found.push_back(tle);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(found.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TleHistoryGrep)->Unit(benchmark::kMillisecond);
+
+static void BM_TleHistoryArchive(benchmark::State &state) {
+  const auto &reader = Archive();
+  std::vector<Tle> found;
+  std::size_t k = 0;
+  for (auto _ : state) {
+    reader.History(QueryObject(k++), query_from, query_to, found);
+    benchmark::DoNotOptimize(found.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TleHistoryArchive)->Unit(benchmark::kMicrosecond);
+
+/// Decode every object's history, what a catalog wide analysis does
+static void BM_ScanTleArchive(benchmark::State &state) {
+  const auto &reader = Archive();
+  std::atomic<std::size_t> records{0};
+  for (auto _ : state) {
+    reader.ScanObjects(
+        [&](std::span<const Tle> tles) {
+          records.fetch_add(tles.size(), std::memory_order_relaxed);
+        },
+        static_cast<std::size_t>(state.range(0)));
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(records.load()));
+}
+BENCHMARK(BM_ScanTleArchive)
+    ->Arg(1)
+    ->Arg(0)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
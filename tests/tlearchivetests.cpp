@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/tlearchive.h"
+#include "synthcatalog.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+std::uint64_t Bits(double value) { return std::bit_cast<std::uint64_t>(value); }
+
+/// @brief Every field, doubles bitwise since the archive is lossless
+void ExpectSame(const Tle &a, const Tle &b) {
+  const auto &a1 = a.line_1;
+  const auto &b1 = b.line_1;
+  EXPECT_EQ(a1.line_number, b1.line_number);
+  EXPECT_EQ(a1.satellite_number, b1.satellite_number);
+  EXPECT_EQ(a1.classification, b1.classification);
+  EXPECT_EQ(a1.launch_year, b1.launch_year);
+  EXPECT_EQ(a1.launch_number, b1.launch_number);
+  EXPECT_EQ(a1.launch_piece, b1.launch_piece);
+  EXPECT_EQ(a1.epoch_year, b1.epoch_year);
+  EXPECT_EQ(Bits(a1.epoch_day), Bits(b1.epoch_day));
+  EXPECT_EQ(Bits(a1.mean_motion_dot), Bits(b1.mean_motion_dot));
+  EXPECT_EQ(Bits(a1.mean_motion_ddot), Bits(b1.mean_motion_ddot));
+  EXPECT_EQ(Bits(a1.bstar_drag), Bits(b1.bstar_drag));
+  EXPECT_EQ(a1.ephemeris_type, b1.ephemeris_type);
+  EXPECT_EQ(a1.element_number, b1.element_number);
+  EXPECT_EQ(a1.checksum, b1.checksum);
+  const auto &a2 = a.line_2;
+  const auto &b2 = b.line_2;
+  EXPECT_EQ(a2.line_number, b2.line_number);
+  EXPECT_EQ(a2.satellite_number, b2.satellite_number);
+  EXPECT_EQ(Bits(a2.inclination), Bits(b2.inclination));
+  EXPECT_EQ(Bits(a2.raan), Bits(b2.raan));
+  EXPECT_EQ(Bits(a2.eccentricity), Bits(b2.eccentricity));
+  EXPECT_EQ(Bits(a2.argument_of_perigree), Bits(b2.argument_of_perigree));
+  EXPECT_EQ(Bits(a2.mean_anomaly), Bits(b2.mean_anomaly));
+  EXPECT_EQ(Bits(a2.mean_motion), Bits(b2.mean_motion));
+  EXPECT_EQ(a2.rev_at_epoch, b2.rev_at_epoch);
+  EXPECT_EQ(a2.checksum, b2.checksum);
+}
+
+/// @brief History of each object in epoch order, the reference for reads
+std::map<std::uint32_t, std::vector<Tle>> ByObject(
+    const std::vector<Tle> &tles) {
+  std::map<std::uint32_t, std::vector<Tle>> objects;
+  for (const auto &tle : tles) {
+    objects[static_cast<std::uint32_t>(tle.line_1.satellite_number)]
+        .push_back(tle);
+  }
+  for (auto &[number, history] : objects) {
+    std::stable_sort(history.begin(), history.end(),
+                     [](const Tle &a, const Tle &b) {
+                       return TleEpoch(a.line_1) < TleEpoch(b.line_1);
+                     });
+  }
+  return objects;
+}
+}  // namespace
+
+TEST(TleArchiveTest, RoundTrip) {
+  auto history = MakeSynthHistory({.objects = 20, .days = 60});
+  // values that aren't decimals of TLE text take the escape path
+  history[3].line_2.inclination += 1e-9;
+  history[5].line_1.bstar_drag = 1.0 / 3.0;
+  history[7].line_2.mean_anomaly = -0.0;
+  history[9].line_1.launch_piece = "A";
+  history[11].line_1.classification = 'S';
+  history[13].line_2.rev_at_epoch = -5;
+
+  const auto path = TempPath("eobtlearchivetest.bin");
+  std::uint64_t bytes = 0;
+  {
+    // small buffer so the writer flushes more than once
+    TleArchiveWriter writer(path, {.block_size = 50, .buffer_bytes = 4096});
+    writer.Append(history);
+    writer.Close();
+    EXPECT_EQ(writer.records(), history.size());
+    bytes = writer.bytes();
+  }
+  EXPECT_EQ(std::filesystem::file_size(path), bytes);
+  // TLE text takes 140 bytes per record
+  EXPECT_LT(static_cast<double>(bytes) / static_cast<double>(history.size()),
+            30.0);
+
+  const TleArchiveReader reader(path);
+  EXPECT_EQ(reader.record_count(), history.size());
+  const auto expected = ByObject(history);
+  const auto objects = reader.Objects();
+  ASSERT_EQ(objects.size(), expected.size());
+  std::vector<Tle> read;
+  for (const auto number : objects) {
+    const auto &object = expected.at(number);
+    reader.History(number, std::chrono::system_clock::time_point::min(),
+                   std::chrono::system_clock::time_point::max(), read);
+    ASSERT_EQ(read.size(), object.size()) << number;
+    for (std::size_t i = 0; i < read.size(); ++i) {
+      ExpectSame(read[i], object[i]);
+    }
+  }
+  // blocks are of one object and ordered by satellite number and epoch
+  for (std::size_t i = 0; i < reader.block_count(); ++i) {
+    const auto &info = reader.block(i);
+    EXPECT_LE(info.records, 50U);
+    reader.ReadBlock(i, read);
+    ASSERT_EQ(read.size(), info.records);
+    EXPECT_EQ(TleEpoch(read.front().line_1), info.first_epoch);
+    EXPECT_EQ(TleEpoch(read.back().line_1), info.last_epoch);
+    for (const auto &tle : read) {
+      EXPECT_EQ(tle.line_1.satellite_number,
+                static_cast<int>(info.satellite_number));
+    }
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(TleArchiveTest, History) {
+  using namespace std::chrono;
+  const auto history = MakeSynthHistory({.objects = 30, .days = 90});
+  const auto path = TempPath("eobtlearchivetest_history.bin");
+  {
+    TleArchiveWriter writer(path, {.block_size = 64});
+    writer.Append(history);
+  }
+  const TleArchiveReader reader(path);
+  const auto expected = ByObject(history);
+  const system_clock::time_point start = sys_days{year{2020} / January / 1};
+  std::vector<Tle> read;
+  for (const auto &[number, object] : expected) {
+    for (const auto &[from, to] :
+         {std::pair{start + days(10), start + days(20)},
+          std::pair{start - days(5), start + days(1)},
+          std::pair{start + days(45) + hours(7), start + days(89)},
+          std::pair{start + days(30), start + days(30)}}) {
+      std::vector<Tle> brute;
+      for (const auto &tle : object) {
+        const auto epoch = TleEpoch(tle.line_1);
+        if (epoch >= from && epoch < to) {
+          brute.push_back(tle);
+        }
+      }
+      reader.History(number, from, to, read);
+      ASSERT_EQ(read.size(), brute.size()) << number;
+      for (std::size_t i = 0; i < read.size(); ++i) {
+        ExpectSame(read[i], brute[i]);
+      }
+    }
+  }
+  reader.History(99999, start, start + days(100), read);
+  EXPECT_TRUE(read.empty());
+  std::filesystem::remove(path);
+}
+
+TEST(TleArchiveTest, InterleavedAppends) {
+  // element sets out of epoch order and a writer flushing partial blocks
+  // give overlapping blocks of an object
+  auto history = MakeSynthHistory({.objects = 10, .days = 30});
+  std::reverse(history.begin() + 100, history.begin() + 300);
+  const auto path = TempPath("eobtlearchivetest_interleaved.bin");
+  {
+    TleArchiveWriter writer(path, {.block_size = 32, .max_buffered = 40});
+    for (const auto &tle : history) {
+      writer.Append(tle);
+    }
+  }
+  TleArchiveReader reader(TempPath("eobtlearchivetest_interleaved.bin"));
+  const TleArchiveReader moved(std::move(reader));
+  EXPECT_GT(moved.block_count(), history.size() / 32);
+  const auto expected = ByObject(history);
+
+  std::mutex mutex;
+  std::map<std::uint32_t, std::vector<Tle>> scanned;
+  moved.ScanObjects(
+      [&](std::span<const Tle> tles) {
+        const std::lock_guard lock(mutex);
+        scanned[static_cast<std::uint32_t>(tles[0].line_1.satellite_number)]
+            .assign(tles.begin(), tles.end());
+      },
+      2);
+  ASSERT_EQ(scanned.size(), expected.size());
+  for (const auto &[number, object] : expected) {
+    const auto &tles = scanned.at(number);
+    ASSERT_EQ(tles.size(), object.size());
+    for (std::size_t i = 0; i < tles.size(); ++i) {
+      ExpectSame(tles[i], object[i]);
+    }
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(TleArchiveTest, Malformed) {
+  EXPECT_THROW(TleArchiveReader(TempPath("eobtlearchivetest_missing.bin")),
+               MyException<std::string>);
+  EXPECT_THROW(TleArchiveWriter(TempPath("eobtlearchivetest_zero.bin"),
+                                {.block_size = 0}),
+               MyException<std::string>);
+
+  const auto path = TempPath("eobtlearchivetest_malformed.bin");
+  const auto history = MakeSynthHistory({.objects = 2, .days = 30});
+  {
+    TleArchiveWriter writer(path);
+    auto tle = history[0];
+    tle.line_1.launch_piece = "ABCD";
+    EXPECT_THROW(writer.Append(tle), MyException<int>);
+    tle = history[0];
+    tle.line_2.satellite_number += 1;
+    EXPECT_THROW(writer.Append(tle), MyException<int>);
+    writer.Append(history);
+    writer.Close();
+    EXPECT_THROW(writer.Append(history[0]), MyException<std::string>);
+  }
+  std::string bytes;
+  {
+    std::ifstream file(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(file), {});
+  }
+  auto write = [&path](const std::string &content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+  };
+
+  // truncated, the trailer is gone
+  write(bytes.substr(0, bytes.size() - 10));
+  EXPECT_THROW(TleArchiveReader{path}, MyException<std::string>);
+
+  // bad magic
+  auto corrupt = bytes;
+  corrupt[0] = 'X';
+  write(corrupt);
+  EXPECT_THROW(TleArchiveReader{path}, MyException<std::string>);
+
+  // a column length running past the block is caught when reading it
+  corrupt = bytes;
+  corrupt[32 + 3] = '\x7f';
+  write(corrupt);
+  const TleArchiveReader reader(path);
+  ASSERT_EQ(reader.block_count(), 2U);
+  std::vector<Tle> tles;
+  const auto first = reader.block(0).offset == 32 ? 0U : 1U;
+  EXPECT_THROW(reader.ReadBlock(first, tles), MyException<std::string>);
+  reader.ReadBlock(1 - first, tles);
+  EXPECT_EQ(tles.size(), 60U);
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/tlefit.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+namespace {
+constexpr std::size_t observations_per_satellite = 1000;
+
+/// @brief LEO satellites of the synthetic catalog, each with a day of
+/// states from its TLE and a perturbed TLE to start from
+const std::vector<TleFitProblem> &Problems() {
+  static const auto problems = [] {
+    std::vector<TleFitProblem> all;
+    for (const auto &text : CachedSynthTles(1000)) {
+      const auto tle = ParseTle(text);
+      Sgp4State state;
+      if (tle.line_2.mean_motion < 11.25 ||
+          InitSgp4(tle, state) != Sgp4Errc::kOk) {
+        continue;
+      }
+      TleFitProblem problem{.initial = tle, .observations = {}};
+      for (std::size_t i = 0; i < observations_per_satellite; ++i) {
+        TleObservation o{
+            .time = state.epoch + std::chrono::seconds(86 * i), .state = {}};
+        if (PropagateSgp4(state, MinutesSinceEpoch(state, o.time),
+                          o.state) == Sgp4Errc::kOk) {
+          problem.observations.push_back(o);
+        }
+      }
+      problem.initial.line_2.inclination += 0.01;
+      problem.initial.line_2.mean_anomaly -= 0.5;
+      problem.initial.line_2.mean_motion += 1e-4;
+      problem.initial.line_1.bstar_drag *= 1.2;
+      all.push_back(std::move(problem));
+      if (all.size() == 32) {
+        break;
+      }
+    }
+    return all;
+  }();
+  return problems;
+}
+}  // namespace
+
+/// One satellite at a time, Jacobian columns on range(0) threads
+static void BM_FitTle(benchmark::State &state) {
+  const auto &problems = Problems();
+  const TleFitOptions options{
+      .threads = static_cast<std::size_t>(state.range(0))};
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const auto &problem = problems[i++ % problems.size()];
+    auto result = FitTle(problem.observations, problem.initial, options);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FitTle)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond);
+
+/// The whole batch, satellites on range(0) threads
+static void BM_FitTles(benchmark::State &state) {
+  const auto &problems = Problems();
+  const TleFitOptions options{
+      .threads = static_cast<std::size_t>(state.range(0))};
+  for (auto _ : state) {
+    auto results = FitTles(problems, options);
+    benchmark::DoNotOptimize(results.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(problems.size()));
+}
+BENCHMARK(BM_FitTles)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/tlefit.h"
+#include "synthcatalog.h"
+#include "testutil.h"
+
+using namespace eob;
+
+namespace {
+/// @brief States of tle every step from its epoch on, with a deterministic
+/// error of up to noise km on each position component
+std::vector<TleObservation> Observe(const Tle &tle, std::size_t count,
+                                    std::chrono::seconds step,
+                                    double noise = 0.0) {
+  Sgp4State state;
+  EXPECT_EQ(InitSgp4(tle, state), Sgp4Errc::kOk);
+  std::vector<TleObservation> observations;
+  for (std::size_t i = 0; i < count; ++i) {
+    TleObservation o{.time = state.epoch + step * static_cast<int>(i),
+                     .state = {}};
+    EXPECT_EQ(PropagateSgp4(state, MinutesSinceEpoch(state, o.time), o.state),
+              Sgp4Errc::kOk);
+    for (std::size_t k = 0; k < 3; ++k) {
+      o.state.position[k] +=
+          noise * std::sin(static_cast<double>(7 * i + 3 * k) * 1.7);
+    }
+    observations.push_back(o);
+  }
+  return observations;
+}
+
+/// @brief tle with every fitted element off by a bit
+Tle Perturb(Tle tle) {
+  tle.line_2.inclination += 0.05;
+  tle.line_2.raan -= 0.05;
+  tle.line_2.eccentricity *= 1.2;
+  tle.line_2.argument_of_perigree += 2.0;
+  tle.line_2.mean_anomaly -= 1.5;
+  tle.line_2.mean_motion += 2e-4;
+  tle.line_1.bstar_drag *= 1.5;
+  return tle;
+}
+
+void ExpectElementsNear(const Tle &fitted, const Tle &truth, double scale) {
+  EXPECT_NEAR(fitted.line_2.inclination, truth.line_2.inclination,
+              1e-6 * scale);
+  EXPECT_NEAR(fitted.line_2.raan, truth.line_2.raan, 1e-6 * scale);
+  EXPECT_NEAR(fitted.line_2.eccentricity, truth.line_2.eccentricity,
+              1e-8 * scale);
+  // argument of perigee and mean anomaly are only well determined together
+  // for nearly circular orbits
+  EXPECT_NEAR(fitted.line_2.argument_of_perigree + fitted.line_2.mean_anomaly,
+              truth.line_2.argument_of_perigree + truth.line_2.mean_anomaly,
+              1e-6 * scale);
+  EXPECT_NEAR(fitted.line_2.mean_motion, truth.line_2.mean_motion,
+              1e-9 * scale);
+  EXPECT_NEAR(fitted.line_1.bstar_drag, truth.line_1.bstar_drag,
+              1e-3 * scale * std::abs(truth.line_1.bstar_drag));
+}
+}  // namespace
+
+TEST(TleFitTest, RecoversKnownTle) {
+  using namespace std::chrono_literals;
+  // a day of states, 1000 of them
+  const auto observations = Observe(iss_2024, 1000, 86s);
+  const auto fit = FitTle(observations, Perturb(iss_2024), {.threads = 4});
+  ASSERT_EQ(fit.code, TleFitErrc::kOk) << to_string(fit.code);
+  EXPECT_LE(fit.iterations, 20);
+  EXPECT_LT(fit.position_rms, 1e-6);
+  ExpectElementsNear(fit.tle, iss_2024, 1.0);
+  // only the elements change
+  EXPECT_EQ(fit.tle.line_1.epoch_day, iss_2024.line_1.epoch_day);
+  EXPECT_EQ(fit.tle.line_2.rev_at_epoch, iss_2024.line_2.rev_at_epoch);
+
+  // columns computed in parallel or not, the arithmetic is the same
+  const auto serial = FitTle(observations, Perturb(iss_2024), {.threads = 1});
+  EXPECT_EQ(serial.iterations, fit.iterations);
+  EXPECT_EQ(serial.tle.line_2.mean_motion, fit.tle.line_2.mean_motion);
+  EXPECT_EQ(serial.position_rms, fit.position_rms);
+}
+
+TEST(TleFitTest, NoisyObservations) {
+  using namespace std::chrono_literals;
+  // 100 m errors, positions only
+  const auto observations = Observe(iss_2024, 1000, 86s, 0.1);
+  const auto fit =
+      FitTle(observations, Perturb(iss_2024), {.velocity_weight = 0.0});
+  ASSERT_EQ(fit.code, TleFitErrc::kOk) << to_string(fit.code);
+  EXPECT_NEAR(fit.position_rms, 0.1 * std::sqrt(1.5), 0.02);
+  EXPECT_NEAR(fit.tle.line_2.mean_motion, iss_2024.line_2.mean_motion, 1e-6);
+  EXPECT_NEAR(fit.tle.line_2.inclination, iss_2024.line_2.inclination, 1e-3);
+}
+
+TEST(TleFitTest, Errors) {
+  using namespace std::chrono_literals;
+  const auto observations = Observe(iss_2024, 10, 60s);
+  EXPECT_EQ(FitTle(std::span(observations).first(1), iss_2024).code,
+            TleFitErrc::kTooFewObservations);
+  EXPECT_EQ(FitTle(std::span(observations).first(2), iss_2024,
+                   {.velocity_weight = 0.0})
+                .code,
+            TleFitErrc::kTooFewObservations);
+
+  auto invalid = iss_2024;
+  invalid.line_2.eccentricity = 1.5;
+  EXPECT_EQ(FitTle(observations, invalid).code,
+            TleFitErrc::kInitialTleInvalid);
+
+  // decays long before the last observation
+  auto decaying = iss_2024;
+  decaying.line_1.bstar_drag = 0.5;
+  const auto late = Observe(iss_2024, 10, 24h * 30);
+  EXPECT_EQ(FitTle(late, decaying).code, TleFitErrc::kPropagationFailed);
+
+  const auto few =
+      FitTle(observations, Perturb(iss_2024), {.max_iterations = 1});
+  EXPECT_EQ(few.code, TleFitErrc::kNotConverged);
+  EXPECT_EQ(few.iterations, 1);
+}
+
+TEST(TleFitTest, Batch) {
+  using namespace std::chrono_literals;
+  std::vector<TleFitProblem> problems;
+  std::vector<Tle> truths;
+  for (const auto &text : CachedSynthTles(200)) {
+    const auto tle = ParseTle(text);
+    // SGP4 only, LEO with drag
+    if (tle.line_2.mean_motion < 11.25 || tle.line_2.eccentricity > 0.1) {
+      continue;
+    }
+    truths.push_back(tle);
+    problems.push_back({.initial = Perturb(tle),
+                        .observations = Observe(tle, 200, 300s)});
+    if (problems.size() == 8) {
+      break;
+    }
+  }
+  ASSERT_EQ(problems.size(), 8);
+  const auto results = FitTles(problems, {.threads = 3});
+  ASSERT_EQ(results.size(), problems.size());
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i].code, TleFitErrc::kOk) << i;
+    EXPECT_LT(results[i].position_rms, 1e-4) << i;
+    EXPECT_NEAR(results[i].tle.line_2.mean_motion, truths[i].line_2.mean_motion,
+                1e-8)
+        << i;
+  }
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/tleview.h"
+
+using namespace eob;
+
+TEST(TleViewTest, MatchesParseTle) {
+  const std::string s =
+      R"(1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927
+2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537)";
+
+  const TleView view(s);
+  EXPECT_EQ(view.satellite_number(), 25544);
+  EXPECT_EQ(view.classification(), 'U');
+  EXPECT_EQ(view.launch_piece(), "A  ");
+  EXPECT_DOUBLE_EQ(view.mean_motion(), 15.72125391);
+  EXPECT_DOUBLE_EQ(view.bstar_drag(), -0.11606e-4);
+
+  const auto expected = ParseTle(s);
+  const auto tle = view.ToTle();
+  EXPECT_EQ(tle.line_1.satellite_number, expected.line_1.satellite_number);
+  EXPECT_EQ(tle.line_1.launch_year, expected.line_1.launch_year);
+  EXPECT_EQ(tle.line_1.launch_number, expected.line_1.launch_number);
+  EXPECT_EQ(tle.line_1.launch_piece, expected.line_1.launch_piece);
+  EXPECT_EQ(tle.line_1.epoch_year, expected.line_1.epoch_year);
+  EXPECT_EQ(tle.line_1.epoch_day, expected.line_1.epoch_day);
+  EXPECT_EQ(tle.line_1.mean_motion_dot, expected.line_1.mean_motion_dot);
+  EXPECT_EQ(tle.line_1.mean_motion_ddot, expected.line_1.mean_motion_ddot);
+  EXPECT_EQ(tle.line_1.bstar_drag, expected.line_1.bstar_drag);
+  EXPECT_EQ(tle.line_1.ephemeris_type, expected.line_1.ephemeris_type);
+  EXPECT_EQ(tle.line_1.element_number, expected.line_1.element_number);
+  EXPECT_EQ(tle.line_1.checksum, expected.line_1.checksum);
+  EXPECT_EQ(tle.line_2.inclination, expected.line_2.inclination);
+  EXPECT_EQ(tle.line_2.raan, expected.line_2.raan);
+  EXPECT_EQ(tle.line_2.eccentricity, expected.line_2.eccentricity);
+  EXPECT_EQ(tle.line_2.argument_of_perigree,
+            expected.line_2.argument_of_perigree);
+  EXPECT_EQ(tle.line_2.mean_anomaly, expected.line_2.mean_anomaly);
+  EXPECT_EQ(tle.line_2.mean_motion, expected.line_2.mean_motion);
+  EXPECT_EQ(tle.line_2.rev_at_epoch, expected.line_2.rev_at_epoch);
+  EXPECT_EQ(tle.line_2.checksum, expected.line_2.checksum);
+}
+
+TEST(TleViewTest, StructuralErrorsUpFront) {
+  // bad line 1 checksum
+  const std::string s =
+      R"(1 25544U 98067A   24097.81509284  .00011771  00000-0  21418-3 0  9994
+2 25544  51.6405 309.2692 0004792  43.0163  63.5300 15.49960977447473)";
+
+  TleView view;
+  auto err = TryMakeTleView(s, view);
+  EXPECT_EQ(err.code, TleErrc::kChecksumMismatch);
+  EXPECT_EQ(err.field, TleField::kLine1Checksum);
+  EXPECT_TRUE(view.str().empty());
+  EXPECT_THROW(TleView{s}, MyException<std::string>);
+}
+
+TEST(TleViewTest, MalformedFieldOnlyFailsWhenRead) {
+  // two decimal points in the epoch, checksum is still valid
+  const std::string s =
+      R"(1 25544U 98067A   24097.815.9284  .00011771  00000-0  21418-3 0  9995
+2 25544  51.6405 309.2692 0004792  43.0163  63.5300 15.49960977447473)";
+
+  TleView view;
+  ASSERT_TRUE(TryMakeTleView(s, view).ok());
+  EXPECT_DOUBLE_EQ(view.mean_motion(), 15.49960977);
+  EXPECT_THROW(static_cast<void>(view.epoch_day()), MyException<std::string>);
+  EXPECT_THROW(auto tle = view.ToTle(), MyException<std::string>);
+}
@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+#include "earthorbits/topocentric.h"
+
+using namespace eob;
+
+namespace {
+constexpr double deg_to_rad = std::numbers::pi / 180.0;
+
+const Geodetic some_station{.latitude = 39.007 * deg_to_rad,
+                            .longitude = -104.883 * deg_to_rad,
+                            .altitude = 2.19456};
+
+/// @brief Satellites spread around a 7000 km sphere
+std::vector<EcefState> SomeSatellites(std::size_t size) {
+  std::vector<EcefState> satellites;
+  for (std::size_t i = 0; i < size; ++i) {
+    const double a = 0.37 * static_cast<double>(i);
+    const double b = 0.11 * static_cast<double>(i);
+    satellites.push_back(
+        {{7000.0 * std::cos(a) * std::cos(b),
+          7000.0 * std::sin(a) * std::cos(b), 7000.0 * std::sin(b)},
+         {-7.5 * std::sin(a), 7.5 * std::cos(a), 0.0}});
+  }
+  return satellites;
+}
+}  // namespace
+
+/// Station given as geodetic coordinates on every call
+static void BM_CalcLookAngles(benchmark::State &state) {
+  const auto satellites = SomeSatellites(1024);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto look = CalcLookAngles(some_station, satellites[i++ % 1024]);
+    benchmark::DoNotOptimize(look);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CalcLookAngles);
+
+/// Station terms precomputed once
+static void BM_GroundStationLook(benchmark::State &state) {
+  const GroundStation station(some_station);
+  const auto satellites = SomeSatellites(1024);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto look = station.Look(satellites[i++ % 1024]);
+    benchmark::DoNotOptimize(look);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GroundStationLook);
+
+static void BM_GroundStationLookBatch(benchmark::State &state) {
+  const GroundStation station(some_station);
+  const auto satellites =
+      SomeSatellites(static_cast<std::size_t>(state.range(0)));
+  std::vector<LookAngles> looks(satellites.size());
+  for (auto _ : state) {
+    station.Look(satellites, looks);
+    benchmark::DoNotOptimize(looks.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(satellites.size()));
+}
+BENCHMARK(BM_GroundStationLookBatch)->Arg(30000);
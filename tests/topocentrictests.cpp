@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include "earthorbits/topocentric.h"
+
+using namespace eob;
+
+namespace {
+constexpr double deg_to_rad = std::numbers::pi / 180.0;
+}  // namespace
+
+/// Vallado, example 3-3, within the difference of WGS-72 and WGS-84
+TEST(TopocentricTest, GeodeticToEcef) {
+  const auto ecef = GeodeticToEcef({.latitude = 39.007 * deg_to_rad,
+                                    .longitude = -104.883 * deg_to_rad,
+                                    .altitude = 2.19456});
+  EXPECT_NEAR(ecef[0], -1275.1219, 0.01);
+  EXPECT_NEAR(ecef[1], -4797.9890, 0.01);
+  EXPECT_NEAR(ecef[2], 3994.2975, 0.01);
+
+  const auto pole = GeodeticToEcef(
+      {.latitude = std::numbers::pi / 2, .longitude = 0.0, .altitude = 0.0});
+  EXPECT_NEAR(pole[0], 0.0, 1e-9);
+  EXPECT_NEAR(pole[2], 6378.135 * (1.0 - 1.0 / 298.26), 1e-9);
+}
+
+TEST(TopocentricTest, LookAngles) {
+  const Geodetic geodetic{.latitude = 30.0 * deg_to_rad,
+                          .longitude = 45.0 * deg_to_rad,
+                          .altitude = 0.1};
+  const GroundStation station(geodetic);
+  const auto &r = station.ecef();
+  const double norm = std::hypot(r[0], r[1], r[2]);
+
+  // straight up along the station's radius isn't quite the zenith of the
+  // ellipsoid, so the elevation is just below 90 degrees
+  const EcefState above{{r[0] * 1.1, r[1] * 1.1, r[2] * 1.1},
+                        {r[0] / norm, r[1] / norm, r[2] / norm}};
+  const auto look = station.Look(above);
+  EXPECT_NEAR(look.range, 0.1 * norm, 1e-9);
+  EXPECT_NEAR(look.range_rate, 1.0, 1e-12);
+  EXPECT_GT(look.elevation, 89.5 * deg_to_rad);
+
+  // due north, on the polar axis
+  const EcefState north{{0.0, 0.0, 8000.0}, {0.0, 0.0, 0.0}};
+  const auto look_north = station.Look(north);
+  EXPECT_NEAR(look_north.azimuth, 0.0, 1e-9);
+  EXPECT_NEAR(look_north.range_rate, 0.0, 1e-12);
+
+  // east of the station, in the equatorial plane of its longitude + 90
+  const EcefState east{{-10000.0 * std::sin(45.0 * deg_to_rad),
+                        10000.0 * std::cos(45.0 * deg_to_rad), r[2]},
+                       {0.0, 0.0, 0.0}};
+  EXPECT_GT(station.Look(east).azimuth, 45.0 * deg_to_rad);
+  EXPECT_LT(station.Look(east).azimuth, 135.0 * deg_to_rad);
+
+  // precomputed station and the generic path agree
+  const std::vector<EcefState> satellites{above, north, east};
+  std::vector<LookAngles> looks(satellites.size());
+  station.Look(satellites, looks);
+  for (std::size_t i = 0; i < satellites.size(); ++i) {
+    const auto expected = CalcLookAngles(geodetic, satellites[i]);
+    EXPECT_EQ(looks[i].azimuth, expected.azimuth);
+    EXPECT_EQ(looks[i].elevation, expected.elevation);
+    EXPECT_EQ(looks[i].range, expected.range);
+    EXPECT_EQ(looks[i].range_rate, expected.range_rate);
+  }
+}
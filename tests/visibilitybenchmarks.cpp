@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+#include "earthorbits/frames.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/topocentric.h"
+#include "earthorbits/visibility.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+namespace {
+constexpr double deg_to_rad = std::numbers::pi / 180.0;
+constexpr double min_elevation = 10.0 * deg_to_rad;
+
+/// @brief SGP4 states of the near Earth part of the synthetic catalog
+std::vector<Sgp4State> NearEarthStates(std::size_t size) {
+  std::vector<Sgp4State> states;
+  Sgp4State state;
+  for (const auto &str : CachedSynthTles(size)) {
+    if (InitSgp4(ParseTle(str), state) == Sgp4Errc::kOk) {
+      states.push_back(state);
+    }
+  }
+  return states;
+}
+
+/// @brief 10 stations spread over latitudes 60 S to 75 N
+std::vector<GroundStation> Stations() {
+  std::vector<GroundStation> stations;
+  for (int i = 0; i < 10; ++i) {
+    const double k = static_cast<double>(i);
+    stations.emplace_back(
+        Geodetic{.latitude = (-60.0 + 15.0 * k) * deg_to_rad,
+                 .longitude = (-170.0 + 37.0 * k) * deg_to_rad,
+                 .altitude = 0.0});
+  }
+  return stations;
+}
+
+/// all synthetic TLEs have epochs in 2024
+const auto window_start = std::chrono::system_clock::time_point{
+    std::chrono::sys_days{std::chrono::year{2024} / std::chrono::June / 1}};
+}  // namespace
+
+/// One hour of 1 minute buckets for a catalog and 10 stations
+static void BM_VisibilityIndexBuild(benchmark::State &state) {
+  const auto states = NearEarthStates(static_cast<std::size_t>(state.range(0)));
+  std::size_t memory = 0;
+  std::size_t candidates = 0;
+  for (auto _ : state) {
+    VisibilityIndex index(states, Stations(), window_start,
+                          {.min_elevation = min_elevation});
+    index.Extend(window_start + std::chrono::hours(1));
+    memory = index.MemoryBytes();
+    candidates = index.Candidates(0, window_start).size();
+    benchmark::DoNotOptimize(memory);
+  }
+  state.counters["satellites"] = static_cast<double>(states.size());
+  state.counters["bytes"] = static_cast<double>(memory);
+  state.counters["candidates"] = static_cast<double>(candidates);
+  state.SetItemsProcessed(state.iterations() * 60);  // buckets
+}
+BENCHMARK(BM_VisibilityIndexBuild)
+    ->ArgName("catalog")
+    ->Arg(30000)
+    ->Unit(benchmark::kMillisecond);
+
+/// "What is above this station now", refining the candidates of the index
+static void BM_VisibilityQuery(benchmark::State &state) {
+  const auto states = NearEarthStates(30000);
+  VisibilityIndex index(states, Stations(), window_start,
+                        {.min_elevation = min_elevation});
+  index.Extend(window_start + std::chrono::hours(1));
+  std::vector<VisibleSatellite> above;
+  auto tp = window_start;
+  std::size_t station = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index.Visible(station, tp, above));
+    station = (station + 1) % index.stations().size();
+    tp += std::chrono::seconds(7);
+    if (tp >= index.end()) {
+      tp = window_start;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VisibilityQuery)->Unit(benchmark::kMicrosecond);
+
+/// The same query propagating the whole catalog
+static void BM_VisibilityQueryBruteForce(benchmark::State &state) {
+  const auto states = NearEarthStates(30000);
+  const auto stations = Stations();
+  std::vector<TemeState> teme(states.size());
+  std::vector<Sgp4Errc> errors(states.size());
+  std::vector<EcefState> ecef(states.size());
+  std::vector<std::uint32_t> above;
+  auto tp = window_start;
+  std::size_t station = 0;
+  for (auto _ : state) {
+    PropagateSgp4(states, tp, teme, errors);
+    TemeToEcef(teme, tp, EopTable{}, ecef);
+    above.clear();
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      if (errors[i] == Sgp4Errc::kOk &&
+          stations[station].Look(ecef[i]).elevation >= min_elevation) {
+        above.push_back(static_cast<std::uint32_t>(i));
+      }
+    }
+    benchmark::DoNotOptimize(above.data());
+    station = (station + 1) % stations.size();
+    tp += std::chrono::seconds(7);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VisibilityQueryBruteForce)->Unit(benchmark::kMicrosecond);
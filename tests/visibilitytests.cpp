@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <string>
+#include <vector>
+
+#include "earthorbits/earthorbits.h"
+#include "earthorbits/frames.h"
+#include "earthorbits/parsetle.h"
+#include "earthorbits/sgp4.h"
+#include "earthorbits/topocentric.h"
+#include "earthorbits/visibility.h"
+#include "synthcatalog.h"
+
+using namespace eob;
+
+namespace {
+constexpr double deg_to_rad = std::numbers::pi / 180.0;
+
+std::vector<Sgp4State> NearEarthStates(std::size_t size) {
+  std::vector<Sgp4State> states;
+  Sgp4State state;
+  for (const auto &str : MakeSynthTles({.size = size})) {
+    if (InitSgp4(ParseTle(str), state) == Sgp4Errc::kOk) {
+      states.push_back(state);
+    }
+  }
+  return states;
+}
+
+std::vector<GroundStation> Stations() {
+  return {
+      GroundStation({.latitude = 40.0 * deg_to_rad,
+                     .longitude = -105.0 * deg_to_rad,
+                     .altitude = 1.6}),
+      GroundStation({.latitude = -33.9 * deg_to_rad,
+                     .longitude = 18.4 * deg_to_rad,
+                     .altitude = 0.0}),
+      GroundStation({.latitude = 78.2 * deg_to_rad,
+                     .longitude = 15.4 * deg_to_rad,
+                     .altitude = 0.5}),
+  };
+}
+
+/// @brief Propagate every state, the reference for the index
+std::vector<std::uint32_t> BruteForce(const std::vector<Sgp4State> &states,
+                                      const GroundStation &station,
+                                      std::chrono::system_clock::time_point tp,
+                                      double min_elevation) {
+  std::vector<std::uint32_t> above;
+  TemeState teme;
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    if (PropagateSgp4(states[i], MinutesSinceEpoch(states[i], tp), teme) ==
+            Sgp4Errc::kOk &&
+        station.Look(TemeToEcef(teme, tp)).elevation >= min_elevation) {
+      above.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+  return above;
+}
+
+const auto window_start = std::chrono::system_clock::time_point{
+    std::chrono::sys_days{std::chrono::year{2024} / std::chrono::June / 1}};
+}  // namespace
+
+TEST(VisibilityTest, MatchesBruteForce) {
+  using namespace std::chrono;
+  const auto states = NearEarthStates(500);
+  const auto stations = Stations();
+  const double min_elevation = 5.0 * deg_to_rad;
+  VisibilityIndex index(states, stations, window_start,
+                        {.bucket = minutes(2), .min_elevation = min_elevation});
+  index.Extend(window_start + hours(2));
+  ASSERT_EQ(index.bucket_count(), 60U);
+  EXPECT_EQ(index.end(), window_start + hours(2));
+
+  std::vector<VisibleSatellite> above;
+  std::size_t found = 0;
+  for (auto tp = window_start; tp < index.end(); tp += seconds(37)) {
+    for (std::size_t s = 0; s < stations.size(); ++s) {
+      ASSERT_TRUE(index.Visible(s, tp, above));
+      std::vector<std::uint32_t> ids;
+      for (const auto &v : above) {
+        ids.push_back(v.satellite);
+        EXPECT_GE(v.look.elevation, min_elevation);
+      }
+      EXPECT_EQ(ids, BruteForce(states, stations[s], tp, min_elevation));
+      found += ids.size();
+      // candidates are a small part of the catalog
+      EXPECT_LT(index.Candidates(s, tp).size(), states.size() / 4);
+    }
+  }
+  EXPECT_GT(found, 0U);
+}
+
+TEST(VisibilityTest, SlidingWindow) {
+  using namespace std::chrono;
+  const auto states = NearEarthStates(100);
+  VisibilityIndex index(states, Stations(), window_start);
+  std::vector<VisibleSatellite> above;
+  EXPECT_FALSE(index.Visible(0, window_start, above));
+  EXPECT_TRUE(index.Candidates(0, window_start).empty());
+
+  // rounded up to whole buckets
+  index.Extend(window_start + seconds(90));
+  EXPECT_EQ(index.end(), window_start + minutes(2));
+  index.Extend(window_start + minutes(10));
+  EXPECT_EQ(index.bucket_count(), 10U);
+  const auto memory = index.MemoryBytes();
+
+  index.DropBefore(window_start + minutes(3) + seconds(1));
+  EXPECT_EQ(index.start(), window_start + minutes(3));
+  EXPECT_EQ(index.bucket_count(), 7U);
+  EXPECT_LT(index.MemoryBytes(), memory);
+  EXPECT_FALSE(index.Visible(0, window_start + minutes(2), above));
+  EXPECT_TRUE(index.Visible(0, window_start + minutes(3), above));
+  EXPECT_FALSE(index.Visible(0, window_start + minutes(10), above));
+  EXPECT_FALSE(
+      index.Visible(Stations().size(), window_start + minutes(3), above));
+
+  // extending after a drop continues where the window ends
+  VisibilityIndex fresh(states, Stations(), window_start + minutes(3));
+  fresh.Extend(window_start + minutes(12));
+  index.Extend(window_start + minutes(12));
+  EXPECT_EQ(index.end(), fresh.end());
+  for (auto tp = index.start(); tp < index.end(); tp += minutes(1)) {
+    const auto a = index.Candidates(1, tp);
+    const auto b = fresh.Candidates(1, tp);
+    EXPECT_TRUE(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+  }
+
+  EXPECT_THROW(VisibilityIndex(states, Stations(), window_start,
+                               {.bucket = seconds(0)}),
+               MyException<std::string>);
+}